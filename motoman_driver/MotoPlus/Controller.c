@@ -203,13 +203,23 @@ BOOL Ros_Controller_Init(Controller* controller)
 	{
 		controller->sdIoConnections[i] = INVALID_SOCKET;
 		controller->tidIoConnections[i] = INVALID_TASK;
+		controller->semIoConnection[i] = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+		controller->tidIoSubscription[i] = INVALID_TASK;
+		controller->tidIoSendSubscription[i] = INVALID_TASK;
+		controller->semIoSampleReady[i] = mpSemBCreate(SEM_Q_FIFO, SEM_EMPTY);
+		memset(&controller->ioSubscriptions[i], 0x00, sizeof(IoSubscription));
+		memset(&controller->ioSamples[i], 0x00, sizeof(IoSample));
 	}
 
 	for (i = 0; i < MAX_STATE_CONNECTIONS; i++)
 	{
 		controller->sdStateConnections[i] = INVALID_SOCKET;
 		controller->tidStateSendState[i] = INVALID_TASK;
+		controller->semStateSampleReady[i] = mpSemBCreate(SEM_Q_FIFO, SEM_EMPTY);
+		controller->stateDroppedCnt[i] = 0;
 	}
+	controller->tidStateSample = INVALID_TASK;
+	memset(&controller->stateSample, 0x00, sizeof(StateSample));
 
 	for (i = 0; i < MAX_MOTION_CONNECTIONS; i++)
 	{
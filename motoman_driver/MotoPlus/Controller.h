@@ -54,7 +54,7 @@
 #define IO_FEEDBACK_RESERVED_7				11136  //output# 903
 #define IO_FEEDBACK_RESERVED_8				11137  //output# 904 
 
-#define MAX_IO_CONNECTIONS	1
+#define MAX_IO_CONNECTIONS	4	// each connection is served by its own task: a slow request only delays its own connection
 #define MAX_MOTION_CONNECTIONS	1
 #define MAX_STATE_CONNECTIONS	4
 
@@ -108,6 +108,42 @@ typedef enum
 	IO_ROBOTSTATUS_MAX
 } IoStatusIndex;
  
+// Serialized ROBOT_STATUS message
+#define STATE_STATUS_MAX_SIZE	(sizeof(SmPrefix) + sizeof(SmHeader) + sizeof(SmBodyRobotStatus))
+
+// Serialized messages of a state sample: JOINT_FEEDBACK of each group, JOINT_FEEDBACK_EX and ROBOT_STATUS
+#define STATE_SAMPLE_MAX_SIZE	(MOT_MAX_GR * (sizeof(SmPrefix) + sizeof(SmHeader) + sizeof(SmBodyJointFeedback)) \
+								+ sizeof(SmPrefix) + sizeof(SmHeader) + sizeof(SmBodyJointFeedbackEx) \
+								+ STATE_STATUS_MAX_SIZE)
+
+typedef struct
+{
+	volatile UINT32 seqNo;									// Incremented before and after each update (odd while the sample is written)
+	int size;												// Number of bytes in data
+	char data[STATE_SAMPLE_MAX_SIZE];						// Messages, ready to be sent
+	UINT32 statusSeqNo;										// seqNo of the last sample that carried the ROBOT_STATUS message (0 if none)
+	int statusSize;											// Number of bytes in status
+	char status[STATE_STATUS_MAX_SIZE];						// ROBOT_STATUS message of that sample, for the connections that missed it
+} StateSample;
+
+typedef struct
+{
+	volatile UINT32 seqNo;									// Incremented before and after each change (odd while it is changed)
+	int numberOfElements;									// Number of elements watched (0 if none)
+	int decimation;											// Interpolation cycles between samples
+	SmIoMultiReadElement elements[ROS_MAX_IO_MULTI];		// Elements watched
+	SmIoMultiReadValue values[ROS_MAX_IO_MULTI];			// Value of each element as last sent to the client
+} IoSubscription;
+
+typedef struct
+{
+	volatile UINT32 seqNo;									// Incremented before and after each update (odd while the sample is written)
+	UINT32 subscriptionSeqNo;								// seqNo of the subscription the sample was taken for
+	UINT32 time;											// Time the sample was taken (ms)
+	int numberOfElements;									// Number of values
+	SmIoMultiReadValue values[ROS_MAX_IO_MULTI];			// Value of each element watched
+} IoSample;
+
 typedef struct
 {
 	UINT16 interpolPeriod;									// Interpolation period of the controller
@@ -131,10 +167,20 @@ typedef struct
 	// Io Server Connection
 	int	sdIoConnections[MAX_IO_CONNECTIONS];				// Socket Descriptor array for Io Server
 	int	tidIoConnections[MAX_IO_CONNECTIONS];				// ThreadId array for Io Server
+	SEM_ID semIoConnection[MAX_IO_CONNECTIONS];			// Taken to change the subscription of a connection or send on it
+	int tidIoSubscription[MAX_IO_CONNECTIONS];				// ThreadId of thread sampling the I/O each connection subscribed to
+	int tidIoSendSubscription[MAX_IO_CONNECTIONS];			// ThreadId of thread sending the I/O changes of each connection
+	SEM_ID semIoSampleReady[MAX_IO_CONNECTIONS];			// Given to each connection when a new I/O sample is ready
+	IoSubscription ioSubscriptions[MAX_IO_CONNECTIONS];		// I/O each connection subscribed to
+	IoSample ioSamples[MAX_IO_CONNECTIONS];					// Latest I/O sample of each connection
 
 	// State Server Connection
 	int tidStateSendState[MAX_STATE_CONNECTIONS];			// ThreadId of thread sending the controller state
 	int	sdStateConnections[MAX_STATE_CONNECTIONS];			// Socket Descriptor array for State Server
+	SEM_ID semStateSampleReady[MAX_STATE_CONNECTIONS];		// Given to each connection when a new state sample is ready
+	int stateDroppedCnt[MAX_STATE_CONNECTIONS];				// Samples each connection did not send (client too slow)
+	int tidStateSample;										// ThreadId of thread sampling the state for all the connections
+	StateSample stateSample;								// Latest state sample
 
 	// Motion Server Connection
 	int	sdMotionConnections[MAX_MOTION_CONNECTIONS];		// Socket Descriptor array for Motion Server
@@ -83,6 +83,7 @@ CtrlGroup* Ros_CtrlGroup_Create(int groupNo, BOOL bIsLastGrpToInit, float interp
 		
 		// Populate values
 		ctrlGroup->groupNo = groupNo;
+		ctrlGroup->lastSequence = -1;	// no trajectory point accepted yet
 		ctrlGroup->numAxes = numAxes;
 		ctrlGroup->groupId = Ros_CtrlGroup_FindGrpId(groupNo);
 		ctrlGroup->tool = 0;
@@ -129,8 +130,15 @@ CtrlGroup* Ros_CtrlGroup_Create(int groupNo, BOOL bIsLastGrpToInit, float interp
 				ctrlGroup->axisType.type[i] = AXIS_INVALID;
 		}
 
-		memset(&ctrlGroup->inc_q, 0x00, sizeof(Incremental_q));
-		ctrlGroup->inc_q.q_lock = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+		if(!Ros_IncQueue_Init(&ctrlGroup->inc_q, Q_SIZE))
+			bInitOk = FALSE;
+
+		ctrlGroup->trajPt_q.q_lock = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+		ctrlGroup->trajPt_q.data = (JointMotionData*)mpMalloc(TRAJ_PT_Q_SIZE * sizeof(JointMotionData));
+		if(ctrlGroup->trajPt_q.data != NULL)
+			ctrlGroup->trajPt_q.size = TRAJ_PT_Q_SIZE;
+		else
+			bInitOk = FALSE;
 
 #ifdef DX100		
 		speedCap = GP_getGovForIncMotion(groupNo);
@@ -192,6 +200,10 @@ CtrlGroup* Ros_CtrlGroup_Create(int groupNo, BOOL bIsLastGrpToInit, float interp
 		
 		if(bInitOk == FALSE)
 		{
+			if(ctrlGroup->inc_q.data != NULL)
+				mpFree(ctrlGroup->inc_q.data);
+			if(ctrlGroup->trajPt_q.data != NULL)
+				mpFree(ctrlGroup->trajPt_q.data);
 			mpFree(ctrlGroup);
 			ctrlGroup = NULL;
 		}
@@ -340,37 +352,15 @@ BOOL Ros_CtrlGroup_GetFBPulsePos(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_A
 }
 
 //-------------------------------------------------------------------
-// Get the corrected feedback pulse speed in pulse for each axis.
+// Correct the feedback pulse speed to account for cross-axis coupling.
+// Note: This is only required for feedback.
+// Controller handles this correction internally when 
+// dealing with command positon.
 //-------------------------------------------------------------------
-BOOL Ros_CtrlGroup_GetFBServoSpeed(CtrlGroup* ctrlGroup, long pulseSpeed[MAX_PULSE_AXES])
+static void Ros_CtrlGroup_CorrectFBServoSpeed(CtrlGroup* ctrlGroup, long pulseSpeed[MAX_PULSE_AXES])
 {
 	int i;
 
-#ifndef DUMMY_SERVO_MODE
-#if (DX100 || FS100) //Use mpSvsGetVelTrqFb for older controller models
-	MP_GRP_AXES_T dst_vel;
-	LONG status;
-
-	memset(pulseSpeed, 0x00, sizeof(long[MAX_PULSE_AXES]));
-
-	if (ctrlGroup->groupNo >= MAX_CONTROLLABLE_GROUPS)
-		return FALSE;
-	
-	memset(&dst_vel, 0x00, sizeof(MP_GRP_AXES_T));
-
-	status = mpSvsGetVelTrqFb(dst_vel, NULL); //units are 0.1 pulse/sec
-	if (status != OK)
-		return FALSE;
-
-	for (i = 0; i < MAX_PULSE_AXES; i += 1)
-	{
-		pulseSpeed[i] = dst_vel[ctrlGroup->groupNo][i] * 0.1;
-	}
-
-	// Apply correction to account for cross-axis coupling.
-	// Note: This is only required for feedback.
-	// Controller handles this correction internally when 
-	// dealing with command positon.
 	for (i = 0; i< MAX_PULSE_AXES; ++i)
 	{
 		FB_AXIS_CORRECTION *corr = &ctrlGroup->correctionData.correction[i];
@@ -381,33 +371,20 @@ BOOL Ros_CtrlGroup_GetFBServoSpeed(CtrlGroup* ctrlGroup, long pulseSpeed[MAX_PUL
 			pulseSpeed[dest_axis] -= (int)(pulseSpeed[src_axis] * corr->fCorrectionRatio);
 		}
 	}
+}
 
-#else //DX200 and newer supports the M-register analog feedback (higher precision feedback)
-	LONG status;
-	MP_IO_INFO registerInfo[MAX_PULSE_AXES * 2]; //values are 4 bytes, which consumes 2 registers
-	USHORT registerValues[MAX_PULSE_AXES * 2];
+#if !(DX100 || FS100)
+//-------------------------------------------------------------------
+// Convert the feedback speed registers of a group (2 per axis) to
+// pulse speed.
+//-------------------------------------------------------------------
+static void Ros_CtrlGroup_ConvertFBSpeedRegisters(CtrlGroup* ctrlGroup, USHORT registerValues[MAX_PULSE_AXES * 2],
+												  long pulseSpeed[MAX_PULSE_AXES])
+{
+	int i;
 	UINT32 registerValuesLong[MAX_PULSE_AXES * 2];
 	double dblRegister;
 
-	memset(pulseSpeed, 0x00, sizeof(long[MAX_PULSE_AXES]));
-
-	if (!ctrlGroup->speedFeedbackRegisterAddress.bFeedbackSpeedEnabled)
-		return FALSE;
-
-	for (i = 0; i < MAX_PULSE_AXES; i += 1)
-	{
-		registerInfo[i * 2].ulAddr = ctrlGroup->speedFeedbackRegisterAddress.cioAddressForAxis[i][0];
-		registerInfo[(i * 2) + 1].ulAddr = ctrlGroup->speedFeedbackRegisterAddress.cioAddressForAxis[i][1];
-	}
-
-	// get raw (uncorrected/unscaled) joint speeds
-	status = mpReadIO(registerInfo, registerValues, MAX_PULSE_AXES * 2);
-	if (status != OK)
-	{
-		printf("Failed to get pulse feedback speed: %u\n", status);
-		return FALSE;
-	}
-
 	for (i = 0; i < MAX_PULSE_AXES; i += 1)
 	{
 		//move to 32 bit storage
@@ -432,20 +409,178 @@ BOOL Ros_CtrlGroup_GetFBServoSpeed(CtrlGroup* ctrlGroup, long pulseSpeed[MAX_PUL
 
 		pulseSpeed[i] = (long)dblRegister;
 	}
+}
+#endif
+
+//-------------------------------------------------------------------
+// Get the corrected feedback pulse speed in pulse for each axis of
+// several control groups, all in a single read.
+//-------------------------------------------------------------------
+void Ros_CtrlGroup_GetFBServoSpeeds(CtrlGroup* ctrlGroups[], int numGroup, CtrlGroupFeedback feedback[])
+{
+	int groupNo;
+	int i;
+
+	for (groupNo = 0; groupNo < numGroup; groupNo++)
+	{
+		memset(feedback[groupNo].pulseSpeed, 0x00, sizeof(long[MAX_PULSE_AXES]));
+		feedback[groupNo].bSpeedValid = FALSE;
+	}
+
+#ifndef DUMMY_SERVO_MODE
+#if (DX100 || FS100) //Use mpSvsGetVelTrqFb for older controller models
+	{
+		MP_GRP_AXES_T dst_vel;
+		LONG status;
+
+		memset(&dst_vel, 0x00, sizeof(MP_GRP_AXES_T));
+
+		status = mpSvsGetVelTrqFb(dst_vel, NULL); //units are 0.1 pulse/sec
+		if (status != OK)
+			return;
+
+		for (groupNo = 0; groupNo < numGroup; groupNo++)
+		{
+			CtrlGroup* ctrlGroup = ctrlGroups[groupNo];
+
+			if (ctrlGroup->groupNo >= MAX_CONTROLLABLE_GROUPS)
+				continue;
+
+			for (i = 0; i < MAX_PULSE_AXES; i += 1)
+			{
+				feedback[groupNo].pulseSpeed[i] = dst_vel[ctrlGroup->groupNo][i] * 0.1;
+			}
+			Ros_CtrlGroup_CorrectFBServoSpeed(ctrlGroup, feedback[groupNo].pulseSpeed);
+			feedback[groupNo].bSpeedValid = TRUE;
+		}
+	}
+#else //DX200 and newer supports the M-register analog feedback (higher precision feedback)
+	{
+		LONG status;
+		MP_IO_INFO registerInfo[MAX_CONTROLLABLE_GROUPS * MAX_PULSE_AXES * 2]; //values are 4 bytes, which consumes 2 registers
+		USHORT registerValues[MAX_CONTROLLABLE_GROUPS * MAX_PULSE_AXES * 2];
+		int numRegisters = 0;
+
+		// the registers of all the groups are read at once
+		for (groupNo = 0; groupNo < numGroup && groupNo < MAX_CONTROLLABLE_GROUPS; groupNo++)
+		{
+			CtrlGroup* ctrlGroup = ctrlGroups[groupNo];
+
+			if (!ctrlGroup->speedFeedbackRegisterAddress.bFeedbackSpeedEnabled)
+				continue;
+
+			for (i = 0; i < MAX_PULSE_AXES; i += 1)
+			{
+				registerInfo[numRegisters++].ulAddr = ctrlGroup->speedFeedbackRegisterAddress.cioAddressForAxis[i][0];
+				registerInfo[numRegisters++].ulAddr = ctrlGroup->speedFeedbackRegisterAddress.cioAddressForAxis[i][1];
+			}
+		}
+
+		if (numRegisters == 0)
+			return;
+
+		// get raw (uncorrected/unscaled) joint speeds
+		status = mpReadIO(registerInfo, registerValues, numRegisters);
+		if (status != OK)
+		{
+			printf("Failed to get pulse feedback speed: %u\n", status);
+			return;
+		}
+
+		numRegisters = 0;
+		for (groupNo = 0; groupNo < numGroup && groupNo < MAX_CONTROLLABLE_GROUPS; groupNo++)
+		{
+			CtrlGroup* ctrlGroup = ctrlGroups[groupNo];
+
+			if (!ctrlGroup->speedFeedbackRegisterAddress.bFeedbackSpeedEnabled)
+				continue;
+
+			Ros_CtrlGroup_ConvertFBSpeedRegisters(ctrlGroup, &registerValues[numRegisters], feedback[groupNo].pulseSpeed);
+			numRegisters += MAX_PULSE_AXES * 2;
+			feedback[groupNo].bSpeedValid = TRUE;
+		}
+	}
 #endif
 
 #else //dummy-servo mode for testing
-	MP_CTRL_GRP_SEND_DATA sData;
-	MP_SERVO_SPEED_RSP_DATA pulse_data;
+	for (groupNo = 0; groupNo < numGroup; groupNo++)
+	{
+		MP_CTRL_GRP_SEND_DATA sData;
+		MP_SERVO_SPEED_RSP_DATA pulse_data;
 
-	mpGetServoSpeed(&sData, &pulse_data);
+		sData.sCtrlGrp = ctrlGroups[groupNo]->groupNo;
+		mpGetServoSpeed(&sData, &pulse_data);
 
-	// assign return value
-	for (i = 0; i<MAX_PULSE_AXES; ++i)
-		pulseSpeed[i] = pulse_data.lSpeed[i];
+		// assign return value
+		for (i = 0; i<MAX_PULSE_AXES; ++i)
+			feedback[groupNo].pulseSpeed[i] = pulse_data.lSpeed[i];
+		feedback[groupNo].bSpeedValid = TRUE;
+	}
 #endif
+}
 
-	return TRUE;
+//-------------------------------------------------------------------
+// Get the servo torque (Nm) of each axis of several control groups,
+// all in a single read.
+//-------------------------------------------------------------------
+void Ros_CtrlGroup_GetFBTorques(CtrlGroup* ctrlGroups[], int numGroup, CtrlGroupFeedback feedback[])
+{
+	MP_GRP_AXES_T dst_vel;
+	MP_TRQ_CTL_VAL dst_trq;
+	LONG status;
+	int groupNo;
+	int i;
+
+	for (groupNo = 0; groupNo < numGroup; groupNo++)
+	{
+		memset(feedback[groupNo].torque, 0x00, sizeof(double[MAX_PULSE_AXES]));
+		feedback[groupNo].bTorqueValid = FALSE;
+	}
+
+	memset(dst_trq.data, 0, sizeof(MP_TRQCTL_DATA));
+	dst_trq.unit = TRQ_NEWTON_METER; //request data in Nm
+
+	memset(&dst_vel, 0x00, sizeof(MP_GRP_AXES_T));
+
+	status = mpSvsGetVelTrqFb(dst_vel, &dst_trq);
+	if (status != OK)
+		return;
+
+	for (groupNo = 0; groupNo < numGroup; groupNo++)
+	{
+		CtrlGroup* ctrlGroup = ctrlGroups[groupNo];
+
+		if (ctrlGroup->groupNo >= MAX_CONTROLLABLE_GROUPS)
+			continue;
+
+		for (i = 0; i < MAX_PULSE_AXES; i += 1)
+		{
+			feedback[groupNo].torque[i] = (double)dst_trq.data[ctrlGroup->groupNo][i] * 0.000001;
+		}
+		feedback[groupNo].bTorqueValid = TRUE;
+	}
+}
+
+//-------------------------------------------------------------------
+// Capture the feedback of several control groups as one snapshot:
+// the positions of all the groups are read back to back, then their
+// speeds and torques in a single read each, before any of it is
+// converted.
+//-------------------------------------------------------------------
+void Ros_CtrlGroup_GetFBSnapshot(CtrlGroup* ctrlGroups[], int numGroup, BOOL bWithTorque, CtrlGroupFeedback feedback[])
+{
+	int groupNo;
+
+	for (groupNo = 0; groupNo < numGroup; groupNo++)
+	{
+		feedback[groupNo].bPosValid = Ros_CtrlGroup_GetFBPulsePos(ctrlGroups[groupNo], feedback[groupNo].pulsePos);
+		feedback[groupNo].bTorqueValid = FALSE;
+	}
+
+	Ros_CtrlGroup_GetFBServoSpeeds(ctrlGroups, numGroup, feedback);
+
+	if (bWithTorque)
+		Ros_CtrlGroup_GetFBTorques(ctrlGroups, numGroup, feedback);
 }
 
 //-------------------------------------------------------------------
@@ -616,6 +751,81 @@ void Ros_CtrlGroup_ConvertToMotoPos(CtrlGroup* ctrlGroup, float radPos[MAX_PULSE
 	}
 }
 
+//-------------------------------------------------------------------
+// Get the Ros axis, Motoman pulse axis and radian (or meter) to pulse
+// conversion ratio of each axis converted by Ros_CtrlGroup_ConvertToMotoPos
+// Returns the number of axes in the map
+//-------------------------------------------------------------------
+int Ros_CtrlGroup_GetPulseAxisMap(CtrlGroup* ctrlGroup, int rosAxis[MAX_PULSE_AXES], int pulseAxis[MAX_PULSE_AXES],
+									float conversion[MAX_PULSE_AXES])
+{
+	int i;
+	int cnt = 0;
+	int mpi = 0; //motopos index
+
+	if ((ctrlGroup->numAxes == 7) && Ros_CtrlGroup_IsRobot(ctrlGroup))
+	{
+		// Adjust joint order for 7 axis robot (SLEURBT > SLURBTE); All rotary axes
+		for (i = 0; i < ctrlGroup->numAxes; i++)
+		{
+			if (i < 2)
+				mpi = i;
+			else if (i == 2)
+				mpi = 6;
+			else
+				mpi = i - 1;
+
+			rosAxis[cnt] = i;
+			pulseAxis[cnt] = mpi;
+			conversion[cnt] = ctrlGroup->pulseToRad.PtoR[mpi];
+			cnt++;
+		}
+	}
+	else if (Ros_CtrlGroup_IsRobot(ctrlGroup) && ctrlGroup->numAxes < 6)
+	{
+		// Skip the unused pulse axes (see Ros_CtrlGroup_ConvertToMotoPos)
+		for (i = mpi = 0; i < ctrlGroup->numAxes; i += 1, mpi += 1)
+		{
+			while (ctrlGroup->axisType.type[mpi] == AXIS_INVALID)
+			{
+				mpi += 1;
+				if (mpi >= MAX_PULSE_AXES)
+					return cnt;
+			}
+
+			rosAxis[cnt] = i;
+			pulseAxis[cnt] = mpi;
+			if (ctrlGroup->axisType.type[mpi] == AXIS_ROTATION)
+				conversion[cnt] = ctrlGroup->pulseToRad.PtoR[mpi];
+			else if (ctrlGroup->axisType.type[mpi] == AXIS_LINEAR)
+				conversion[cnt] = ctrlGroup->pulseToMeter.PtoM[mpi];
+			else
+				conversion[cnt] = 1.0;
+			cnt++;
+		}
+	}
+	else
+	{
+		for (i = 0; i < ctrlGroup->numAxes && i < MAX_PULSE_AXES; i++)
+		{
+			if (ctrlGroup->axisType.type[i] == AXIS_INVALID)
+				continue;
+
+			rosAxis[cnt] = i;
+			pulseAxis[cnt] = i;
+			if (ctrlGroup->axisType.type[i] == AXIS_ROTATION)
+				conversion[cnt] = ctrlGroup->pulseToRad.PtoR[i];
+			else if (ctrlGroup->axisType.type[i] == AXIS_LINEAR)
+				conversion[cnt] = ctrlGroup->pulseToMeter.PtoM[i];
+			else
+				conversion[cnt] = 1.0;
+			cnt++;
+		}
+	}
+
+	return cnt;
+}
+
 //-------------------------------------------------------------------
 // Returns a bit wise axis configuration for the increment move API
 //-------------------------------------------------------------------
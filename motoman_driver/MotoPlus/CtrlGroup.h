@@ -33,16 +33,21 @@
 #define CTRLGROUP_H
 
 
-#define Q_SIZE 200
+#ifndef Q_SIZE
+#define Q_SIZE 256  // depth of the incremental queue of each group (power of 2)
+#endif
+#define Q_SIZE_MAX 4096  // largest depth of the incremental queue (ROS_CMD_SET_QUEUE_SIZE)
+
+#ifndef TRAJ_PT_Q_SIZE
+#define TRAJ_PT_Q_SIZE 16  // depth of the trajectory point queue of each group
+#endif
+#define TRAJ_PT_Q_SIZE_MAX 1024  // largest depth of the trajectory point queue (ROS_CMD_SET_QUEUE_SIZE)
 
 #if (DX100 || DX200 || FS100)
-#define Q_LOCK_TIMEOUT 1000
+#define TRAJ_PT_Q_LOCK_TIMEOUT 1000
 #else
-#define Q_LOCK_TIMEOUT 5000  //YRC1000 tick period is 0.2 ms
+#define TRAJ_PT_Q_LOCK_TIMEOUT 5000  //YRC1000 tick period is 0.2 ms
 #endif
-
-#define	Q_OFFSET_IDX( a, b, c )	(((a)+(b)) >= (c) ) ? ((a)+(b)-(c)) \
-				: ( (((a)+(b)) < 0 ) ? ((a)+(b)+(c)) : ((a)+(b)) )
 		
 #define RAD_PER_DEGREE (0.0174533)
 
@@ -55,12 +60,14 @@ typedef struct
 	LONG inc[MP_GRP_AXES_NUM];
 } Incremental_data;
 
+// Lock free single producer / single consumer queue (see IncQueue.c)
 typedef struct
 {
-	SEM_ID q_lock;
-	LONG cnt;
-	LONG idx;
-	Incremental_data data[Q_SIZE];
+	UINT32 size;					// number of elements in data (power of 2)
+	volatile UINT32 writeCnt;		// number of elements added (producer)
+	volatile UINT32 readCnt;		// number of elements removed (consumer)
+	volatile UINT32 truncateCnt;	// number of truncations of the queue
+	Incremental_data* data;
 } Incremental_q;
 
 // jointMotionData values are in radian and joint order in sequential order 
@@ -73,6 +80,18 @@ typedef struct
 	float acc[MP_GRP_AXES_NUM];		// acceleration in radians/s^2
 } JointMotionData;
 
+// Queue of the trajectory points waiting to be interpolated.  Both the
+// message task and the AddToIncQueue task run at normal priority.
+typedef struct
+{
+	SEM_ID q_lock;
+	int size;						// number of elements in data
+	int cnt;						// number of points in the queue
+	int idx;						// index of the first point
+	int lastTime;					// time in millisecond of the last point accepted
+	JointMotionData* data;
+} TrajPoint_q;
+
 //---------------------------------------------------------------
 // CtrlGroup:
 // Structure containing all the data related to a control group 
@@ -94,7 +113,12 @@ typedef struct
 	
 	JointMotionData jointMotionData;			// joint motion command data in radian
 	JointMotionData jointMotionDataToProcess;	// joint motion command data in radian to process
-	BOOL hasDataToProcess;						// indicates that there is data to process
+	TrajPoint_q trajPt_q;						// trajectory points waiting to be processed
+	BOOL hasDataToProcess;						// indicates that there is data to process (queued or being processed)
+	BOOL bProcessingTrajPoint;					// indicates that a point taken from trajPt_q is being interpolated
+	BOOL bHoldTrajPointQ;						// the points of trajPt_q are not taken while a truncate waits (Ros_MotionServer_TruncateQ_All)
+	int lastSequence;							// sequence number of the last trajectory point accepted for processing
+	JointMotionData firstPoint;					// first point of the trajectory, to recognize it when it is resent
 	int tidAddToIncQueue;						// ThreadId to add incremental values to the queue
 	int timeLeftover_ms;						// Time left over after reaching the end of a trajectory to complete the interpolation period
 	long prevPulsePos[MAX_PULSE_AXES];			// The commanded pulse position that the trajectory starts at (Ros_MotionServer_StartTrajMode)
@@ -105,6 +129,17 @@ typedef struct
 	JOINT_FEEDBACK_SPEED_ADDRESSES speedFeedbackRegisterAddress; //CIO address for the registers containing feedback speed
 } CtrlGroup;
 
+// Feedback of a control group, as captured by Ros_CtrlGroup_GetFBSnapshot
+typedef struct
+{
+	BOOL bPosValid;								// pulsePos could be read
+	BOOL bSpeedValid;							// pulseSpeed could be read
+	BOOL bTorqueValid;							// torque could be read
+	long pulsePos[MAX_PULSE_AXES];				// Corrected feedback position (pulse)
+	long pulseSpeed[MAX_PULSE_AXES];			// Corrected feedback speed (pulse/sec)
+	double torque[MAX_PULSE_AXES];				// Servo torque (Nm, or N for linear axes), in pulse axis order
+} CtrlGroupFeedback;
+
 
 //---------------------------------
 // External Functions Declaration
@@ -119,12 +154,19 @@ extern CtrlGroup* Ros_CtrlGroup_Create(int groupNo, BOOL bIsLastGrpToInit, float
 
 extern BOOL Ros_CtrlGroup_GetPulsePosCmd(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_AXES]);
 extern BOOL Ros_CtrlGroup_GetFBPulsePos(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_AXES]);
-extern BOOL Ros_CtrlGroup_GetFBServoSpeed(CtrlGroup* ctrlGroup, long pulseSpeed[MAX_PULSE_AXES]);
+extern void Ros_CtrlGroup_GetFBServoSpeeds(CtrlGroup* ctrlGroups[], int numGroup, CtrlGroupFeedback feedback[]);
+
+extern void Ros_CtrlGroup_GetFBTorques(CtrlGroup* ctrlGroups[], int numGroup, CtrlGroupFeedback feedback[]);
+
+//Capture the feedback position, speed and (if bWithTorque) torque of several groups (e.g. all the groups of
+//the controller) at once, so that they are consistent with each other.
+extern void Ros_CtrlGroup_GetFBSnapshot(CtrlGroup* ctrlGroups[], int numGroup, BOOL bWithTorque, CtrlGroupFeedback feedback[]);
 
 extern BOOL Ros_CtrlGroup_GetTorque(CtrlGroup* ctrlGroup, double torqueValues[MAX_PULSE_AXES]);
 
 extern void Ros_CtrlGroup_ConvertToRosPos(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_AXES], float rosPos[MAX_PULSE_AXES]);
 extern void Ros_CtrlGroup_ConvertToMotoPos(CtrlGroup* ctrlGroup, float radPos[MAX_PULSE_AXES], long pulsePos[MAX_PULSE_AXES]);
+extern int Ros_CtrlGroup_GetPulseAxisMap(CtrlGroup* ctrlGroup, int rosAxis[MAX_PULSE_AXES], int pulseAxis[MAX_PULSE_AXES], float conversion[MAX_PULSE_AXES]);
 
 extern UCHAR Ros_CtrlGroup_GetAxisConfig(CtrlGroup* ctrlGroup);
 
@@ -0,0 +1,295 @@
+//IncQueue.c
+//
+// Single producer / single consumer ring buffer of incremental moves.
+// writeCnt and readCnt count the elements added and removed since the
+// creation of the queue; they wrap around together, so the element index
+// is the count modulo the (power of 2) size of the queue.
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#include "MotoROS.h"
+
+//-----------------------
+// Memory ordering
+//-----------------------
+#if DX100
+// No atomic builtins in the DX100 compiler (single core x86)
+static BOOL Q_CAS(volatile UINT32* ptr, UINT32 oldVal, UINT32 newVal)
+{
+	UINT32 prevVal;
+
+	__asm__ __volatile__("lock; cmpxchgl %2,%1"
+						: "=a"(prevVal), "+m"(*ptr)
+						: "r"(newVal), "0"(oldVal)
+						: "memory");
+	return (prevVal == oldVal);
+}
+#else
+#define Q_CAS(ptr, oldVal, newVal)	__sync_bool_compare_and_swap((ptr), (oldVal), (newVal))
+#endif
+
+// Read an index, later accesses are not moved before it
+#define Q_LOAD_ACQUIRE(idx, val)	do { (val) = (idx); Q_MEMORY_BARRIER(); } while (0)
+// Write an index, earlier accesses are not moved after it
+#define Q_STORE_RELEASE(idx, val)	do { Q_MEMORY_BARRIER(); (idx) = (val); } while (0)
+
+#define Q_INDEX(q, cnt)				((cnt) & ((q)->size - 1))
+
+// A removal only has to be retried when a truncate runs at the same time on another CPU
+#define Q_POP_ATTEMPTS				2
+
+// The host test (IncQueueTest.c) switches tasks at these points, to check
+// interleavings that are too unlikely to happen in a stress test
+#ifndef Q_SYNC_POINT
+#define Q_SYNC_POINT(point)
+#endif
+
+//-----------------------
+// Function implementation
+//-----------------------
+
+//-------------------------------------------------------------------
+// Initialize the queue with storage for the specified number of elements
+//-------------------------------------------------------------------
+BOOL Ros_IncQueue_Init(Incremental_q* q, int size)
+{
+	memset(q, 0x00, sizeof(Incremental_q));
+
+	if((size <= 0) || ((size & (size - 1)) != 0))
+	{
+		printf("ERROR: Incremental queue size (%d) must be a power of 2\r\n", size);
+		return FALSE;
+	}
+
+	q->data = (Incremental_data*)mpMalloc(size * sizeof(Incremental_data));
+	if(q->data == NULL)
+	{
+		printf("ERROR: Unable to allocate the incremental queue (%d elements)\r\n", size);
+		return FALSE;
+	}
+	memset(q->data, 0x00, size * sizeof(Incremental_data));
+	q->size = size;
+
+	return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Replace the storage of an empty queue
+//-------------------------------------------------------------------
+BOOL Ros_IncQueue_Resize(Incremental_q* q, int size)
+{
+	Incremental_data* oldData;
+	Incremental_data* newData;
+
+	if((size <= 0) || ((size & (size - 1)) != 0))
+	{
+		printf("ERROR: Incremental queue size (%d) must be a power of 2\r\n", size);
+		return FALSE;
+	}
+
+	if(size == (int)q->size)
+		return TRUE;
+
+	if(Ros_IncQueue_GetCnt(q) > 0)
+		return FALSE;
+
+	newData = (Incremental_data*)mpMalloc(size * sizeof(Incremental_data));
+	if(newData == NULL)
+	{
+		printf("ERROR: Unable to allocate the incremental queue (%d elements)\r\n", size);
+		return FALSE;
+	}
+	memset(newData, 0x00, size * sizeof(Incremental_data));
+
+	// The consumer doesn't access the storage of an empty queue, and the
+	// indexes are kept so that it keeps seeing the queue as empty
+	oldData = q->data;
+	q->data = newData;
+	Q_STORE_RELEASE(q->size, size);
+	mpFree(oldData);
+
+	return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Number of elements in the queue
+//-------------------------------------------------------------------
+int Ros_IncQueue_GetCnt(Incremental_q* q)
+{
+	UINT32 readCnt;
+	UINT32 writeCnt;
+	int cnt;
+
+	Q_LOAD_ACQUIRE(q->readCnt, readCnt);
+	Q_LOAD_ACQUIRE(q->writeCnt, writeCnt);
+
+	// The consumer may be undoing a removal that raced with a truncate
+	cnt = (int)(writeCnt - readCnt);
+	return (cnt > 0) ? cnt : 0;
+}
+
+//-------------------------------------------------------------------
+// Producer: add an element at the end of the queue
+//-------------------------------------------------------------------
+BOOL Ros_IncQueue_Push(Incremental_q* q, Incremental_data* data)
+{
+	UINT32 readCnt;
+	UINT32 writeCnt = q->writeCnt;
+
+	Q_LOAD_ACQUIRE(q->readCnt, readCnt);
+	if((int)(writeCnt - readCnt) >= (int)q->size)
+		return FALSE;  // queue is full
+
+	// Fill the element before making it visible to the consumer
+	q->data[Q_INDEX(q, writeCnt)] = *data;
+	Q_STORE_RELEASE(q->writeCnt, writeCnt + 1);
+
+	return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Consumer: copy the first element without removing it
+//-------------------------------------------------------------------
+BOOL Ros_IncQueue_Peek(Incremental_q* q, Incremental_data* data)
+{
+	UINT32 readCnt;
+	UINT32 writeCnt;
+
+	Q_LOAD_ACQUIRE(q->readCnt, readCnt);
+	Q_LOAD_ACQUIRE(q->writeCnt, writeCnt);
+	if((int)(writeCnt - readCnt) <= 0)
+		return FALSE;  // queue is empty
+
+	*data = q->data[Q_INDEX(q, readCnt)];
+	return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Consumer: copy and remove the first element
+//-------------------------------------------------------------------
+BOOL Ros_IncQueue_Pop(Incremental_q* q, Incremental_data* data)
+{
+	UINT32 truncateCnt;
+	UINT32 readCnt;
+	UINT32 writeCnt;
+	int attempt;
+
+	for(attempt = 0; attempt < Q_POP_ATTEMPTS; attempt++)
+	{
+		Q_LOAD_ACQUIRE(q->truncateCnt, truncateCnt);
+		Q_LOAD_ACQUIRE(q->readCnt, readCnt);
+		Q_LOAD_ACQUIRE(q->writeCnt, writeCnt);
+		if((int)(writeCnt - readCnt) <= 0)
+			return FALSE;  // queue is empty
+
+		*data = q->data[Q_INDEX(q, readCnt)];
+		Q_SYNC_POINT(POP_COPIED);
+
+		// Fails if the queue was cleared while copying (the copy may be overwritten data)
+		if(!Q_CAS(&q->readCnt, readCnt, readCnt + 1))
+			return FALSE;
+
+		// A truncate may have removed the element (and the producer may have reused
+		// its storage) after the end of the queue was read: give it back and read
+		// the queue again (see Ros_IncQueue_Truncate). A truncate that was counted
+		// before truncateCnt was read, but moved writeCnt after it was read, is
+		// only seen in writeCnt.
+		Q_LOAD_ACQUIRE(q->writeCnt, writeCnt);
+		if(((int)(writeCnt - readCnt) > 0) && (q->truncateCnt == truncateCnt))
+			return TRUE;
+
+		if(!Q_CAS(&q->readCnt, readCnt + 1, readCnt))
+			return FALSE;  // cleared in the mean time
+	}
+
+	return FALSE;
+}
+
+//-------------------------------------------------------------------
+// Remove all the elements
+//-------------------------------------------------------------------
+void Ros_IncQueue_Clear(Incremental_q* q)
+{
+	UINT32 readCnt;
+	UINT32 writeCnt;
+
+	// Move the start of the queue to its end, unless the consumer moved it first
+	do
+	{
+		Q_LOAD_ACQUIRE(q->readCnt, readCnt);
+		Q_LOAD_ACQUIRE(q->writeCnt, writeCnt);
+	} while(!Q_CAS(&q->readCnt, readCnt, writeCnt));
+}
+
+//-------------------------------------------------------------------
+// Copy the element at the specified position without removing it
+//-------------------------------------------------------------------
+BOOL Ros_IncQueue_PeekAt(Incremental_q* q, UINT32 pos, Incremental_data* data)
+{
+	UINT32 writeCnt;
+
+	Q_LOAD_ACQUIRE(q->writeCnt, writeCnt);
+	if(((int)(writeCnt - pos) <= 0) || ((int)(writeCnt - pos) > (int)q->size))
+		return FALSE;
+
+	*data = q->data[Q_INDEX(q, pos)];
+	return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Remove the elements from the specified position to the end
+//-------------------------------------------------------------------
+BOOL Ros_IncQueue_Truncate(Incremental_q* q, UINT32 endPos)
+{
+	UINT32 readCnt;
+	UINT32 writeCnt = q->writeCnt;
+
+	if((int)(writeCnt - endPos) <= 0)
+		return TRUE;  // nothing to remove
+
+	// Any removal in progress will be given back
+	Q_STORE_RELEASE(q->truncateCnt, q->truncateCnt + 1);
+	Q_MEMORY_BARRIER();
+	Q_SYNC_POINT(TRUNCATE_COUNTED);
+	Q_STORE_RELEASE(q->writeCnt, endPos);
+	Q_MEMORY_BARRIER();
+	Q_LOAD_ACQUIRE(q->readCnt, readCnt);
+
+	if((int)(readCnt - endPos) > 0)
+	{
+		// The consumer already removed the element at endPos: either it was
+		// executed, or Ros_IncQueue_Pop is giving it back. Restore the queue
+		// in both cases (an element given back is removed again later).
+		Q_STORE_RELEASE(q->writeCnt, writeCnt);
+		return FALSE;
+	}
+
+	return TRUE;
+}
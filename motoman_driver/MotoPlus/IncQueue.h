@@ -0,0 +1,84 @@
+//IncQueue.h
+//
+// Single producer / single consumer ring buffer of incremental moves.
+// The producer (Ros_MotionServer_AddToIncQueueProcess task) only advances
+// writeCnt and the consumer (IP_CLK priority Ros_MotionServer_IncMoveLoopStart
+// task) only advances readCnt, so neither of them ever waits on a lock.
+// Clear and truncate are performed from other tasks by moving the index
+// owned by the other side; the consumer detects it and discards the element.
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#ifndef INCQUEUE_H
+#define INCQUEUE_H
+
+// Full memory barrier (also used by the state sample shared with the state server connections)
+#if DX100
+// No atomic builtins in the DX100 compiler (single core x86)
+#define Q_MEMORY_BARRIER()		__asm__ __volatile__("lock; addl $0,0(%%esp)" ::: "memory")
+#else
+#define Q_MEMORY_BARRIER()		__sync_synchronize()
+#endif
+
+// Initialize the queue with storage for the specified number of elements (power of 2)
+extern BOOL Ros_IncQueue_Init(Incremental_q* q, int size);
+
+// Replace the storage of an empty queue by storage for the specified number of elements (power of 2).
+// Must not be called while the producer is adding elements. Returns FALSE if the queue is not
+// empty or if the storage can't be allocated (the queue is then left unchanged).
+extern BOOL Ros_IncQueue_Resize(Incremental_q* q, int size);
+
+// Number of elements in the queue
+extern int Ros_IncQueue_GetCnt(Incremental_q* q);
+
+// Producer: add an element at the end of the queue. Returns FALSE if the queue is full.
+extern BOOL Ros_IncQueue_Push(Incremental_q* q, Incremental_data* data);
+
+// Consumer: copy the first element without removing it. Returns FALSE if the queue is empty.
+extern BOOL Ros_IncQueue_Peek(Incremental_q* q, Incremental_data* data);
+
+// Consumer: copy and remove the first element. Returns FALSE if the queue is
+// empty or if the element was removed by a clear or truncate in the mean time.
+extern BOOL Ros_IncQueue_Pop(Incremental_q* q, Incremental_data* data);
+
+// Remove all the elements (any task)
+extern void Ros_IncQueue_Clear(Incremental_q* q);
+
+// Copy the element at the specified position (before writeCnt) without removing it. An element
+// that the consumer already removed can still be read until the producer reuses its storage.
+// Returns FALSE if that element is not in the queue storage.
+extern BOOL Ros_IncQueue_PeekAt(Incremental_q* q, UINT32 pos, Incremental_data* data);
+
+// Remove the elements from the specified position (between readCnt and writeCnt) to the end.
+// Must not be called while the producer is adding elements. Returns FALSE if the consumer
+// already removed the element at that position (the queue is then left unchanged).
+extern BOOL Ros_IncQueue_Truncate(Incremental_q* q, UINT32 endPos);
+
+#endif
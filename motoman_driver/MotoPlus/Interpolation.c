@@ -0,0 +1,139 @@
+//Interpolation.c
+//
+// Cubic interpolation of a trajectory segment by forward differencing.
+// Interpolation is based on position, velocity and time.
+// Acceleration is modeled by a linear equation acc = accCoef1 + accCoef2 * time
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#include "MotoROS.h"
+
+//-----------------------
+// Function implementation
+//-----------------------
+
+//-----------------------------------------------------------------------
+// Calculate the polynomial of the segment and initialize the forward
+// differences in pulse for the interpolation cycles starting at firstTime_ms
+//-----------------------------------------------------------------------
+BOOL Ros_Interpolation_InitSegment(InterpolationSegment* segment, CtrlGroup* ctrlGroup,
+									JointMotionData* startTrajData, JointMotionData* endTrajData,
+									int firstTime_ms, int interpolPeriod)
+{
+	int i, k;
+	int rosAxis[MAX_PULSE_AXES];
+	float conversion[MAX_PULSE_AXES];
+	float interval;						// Time between startTime and the new data time
+	double t, h;						// time of the first cycle and interpolation period in second
+	double c0, c1, c2, c3;				// polynomial coefficients in pulse
+
+	memset(segment, 0x00, sizeof(InterpolationSegment));
+
+	segment->startTime = startTrajData->time;
+	memcpy(segment->startPos, startTrajData->pos, sizeof(segment->startPos));
+	memcpy(segment->startVel, startTrajData->vel, sizeof(segment->startVel));
+
+	// Calculate an acceleration coefficients
+	interval = (endTrajData->time - startTrajData->time) / 1000.0f;  // time difference in sec
+	if (interval > 0.0)
+	{
+		for (i = 0; i < ctrlGroup->numAxes; i++)
+		{
+			segment->accCoef1[i] = ( 6 * (endTrajData->pos[i] - startTrajData->pos[i]) / (interval * interval) )
+								 - ( 2 * (endTrajData->vel[i] + 2 * startTrajData->vel[i]) / interval);
+			segment->accCoef2[i] = ( -12 * (endTrajData->pos[i] - startTrajData->pos[i]) / (interval * interval * interval))
+								 + ( 6 * (endTrajData->vel[i] + startTrajData->vel[i]) / (interval * interval) );
+		}
+	}
+
+	// Express the polynomial of each mapped axis in pulse and take its
+	// forward differences at t, t+h, t+2h, ...
+	segment->numAxes = Ros_CtrlGroup_GetPulseAxisMap(ctrlGroup, rosAxis, segment->pulseAxis, conversion);
+
+	t = (firstTime_ms - startTrajData->time) / 1000.0;
+	h = interpolPeriod / 1000.0;
+	for (k = 0; k < segment->numAxes; k++)
+	{
+		i = rosAxis[k];
+		c0 = (double)segment->startPos[i] * conversion[k];
+		c1 = (double)segment->startVel[i] * conversion[k];
+		c2 = (double)segment->accCoef1[i] * conversion[k] / 2;
+		c3 = (double)segment->accCoef2[i] * conversion[k] / 6;
+
+		segment->pos[k] = c0 + t * (c1 + t * (c2 + t * c3));
+		segment->diff1[k] = c1 * h + c2 * (2 * t * h + h * h) + c3 * (3 * t * t * h + 3 * t * h * h + h * h * h);
+		segment->diff2[k] = 2 * c2 * h * h + c3 * (6 * t * h * h + 6 * h * h * h);
+		segment->diff3[k] = 6 * c3 * h * h * h;
+	}
+
+	return (interval > 0.0);
+}
+
+//-----------------------------------------------------------------------
+// Output the pulse position of the next interpolation cycle and advance
+// the forward differences by one interpolation period
+//-----------------------------------------------------------------------
+void Ros_Interpolation_NextPulsePos(InterpolationSegment* segment, long pulsePos[MAX_PULSE_AXES])
+{
+	int k;
+
+	for (k = 0; k < segment->numAxes; k++)
+	{
+		// Truncate like Ros_CtrlGroup_ConvertToMotoPos
+		pulsePos[segment->pulseAxis[k]] = (long)segment->pos[k];
+
+		segment->pos[k] += segment->diff1[k];
+		segment->diff1[k] += segment->diff2[k];
+		segment->diff2[k] += segment->diff3[k];
+	}
+}
+
+//-----------------------------------------------------------------------
+// Evaluate the polynomial of the segment at the specified time
+//-----------------------------------------------------------------------
+void Ros_Interpolation_GetJointMotionData(InterpolationSegment* segment, CtrlGroup* ctrlGroup,
+										int time_ms, JointMotionData* jointMotionData)
+{
+	int i;
+	float interpolTime = (time_ms - segment->startTime) / 1000.0f;
+
+	jointMotionData->time = time_ms;
+	for (i = 0; i < ctrlGroup->numAxes; i++)
+	{
+		jointMotionData->pos[i] = segment->startPos[i]
+			+ segment->startVel[i] * interpolTime
+			+ segment->accCoef1[i] * interpolTime * interpolTime / 2
+			+ segment->accCoef2[i] * interpolTime * interpolTime * interpolTime / 6;
+
+		jointMotionData->vel[i] = segment->startVel[i]
+			+ segment->accCoef1[i] * interpolTime
+			+ segment->accCoef2[i] * interpolTime * interpolTime / 2;
+	}
+}
@@ -0,0 +1,74 @@
+//Interpolation.h
+//
+// Cubic interpolation of a trajectory segment by forward differencing.
+// The position of every axis of the control group is kept in pulse, in
+// structure-of-arrays form, so that each interpolation cycle costs three
+// additions per axis instead of a full evaluation of the polynomial.
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#ifndef INTERPOLATION_H
+#define INTERPOLATION_H
+
+typedef struct
+{
+	// Polynomial in ROS joint order (radian or meter) used for direct evaluation
+	int startTime;							// time in millisecond at the start of the segment
+	float startPos[MP_GRP_AXES_NUM];		// position at the start of the segment
+	float startVel[MP_GRP_AXES_NUM];		// velocity at the start of the segment
+	float accCoef1[MP_GRP_AXES_NUM];		// acceleration coefficient 1 (acc = accCoef1 + accCoef2 * time)
+	float accCoef2[MP_GRP_AXES_NUM];		// acceleration coefficient 2
+
+	// Forward differences in pulse of the axes mapped to a pulse axis
+	int numAxes;							// number of interpolated axes
+	int pulseAxis[MAX_PULSE_AXES];			// pulse axis index of each interpolated axis
+	double pos[MAX_PULSE_AXES];				// position in pulse at the next interpolation cycle
+	double diff1[MAX_PULSE_AXES];			// first order forward difference
+	double diff2[MAX_PULSE_AXES];			// second order forward difference
+	double diff3[MAX_PULSE_AXES];			// third order forward difference (constant for a cubic)
+} InterpolationSegment;
+
+// Prepare the interpolation of the segment between startTrajData and endTrajData.
+// The first call to Ros_Interpolation_NextPulsePos returns the position at firstTime_ms,
+// each following call advances by interpolPeriod.
+// Returns FALSE if the segment has no duration (the position is then held).
+extern BOOL Ros_Interpolation_InitSegment(InterpolationSegment* segment, CtrlGroup* ctrlGroup,
+										JointMotionData* startTrajData, JointMotionData* endTrajData,
+										int firstTime_ms, int interpolPeriod);
+
+// Write the pulse position of the interpolated axes for the next interpolation cycle.
+// The pulse position of axes that are not interpolated is left unchanged.
+extern void Ros_Interpolation_NextPulsePos(InterpolationSegment* segment, long pulsePos[MAX_PULSE_AXES]);
+
+// Evaluate the position and velocity (ROS joint order) at the specified time.
+extern void Ros_Interpolation_GetJointMotionData(InterpolationSegment* segment, CtrlGroup* ctrlGroup,
+										int time_ms, JointMotionData* jointMotionData);
+
+#endif
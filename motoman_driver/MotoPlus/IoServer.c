@@ -76,6 +76,10 @@ ATTEMPT_IO_CONNECTION:
 		}
 	}
 
+	//a task deleted while it held the lock of this slot (see Ros_IoServer_StopConnection) left it taken
+	mpSemGive(controller->semIoConnection[connectionIndex]);
+	controller->ioSubscriptions[connectionIndex].numberOfElements = 0;
+
 	//This timeout detection takes two hours. So, it's not terribly useful. But, it still serves a purpose
 	sockOpt = 1;
 	mpSetsockopt(sd, SOL_SOCKET, SO_KEEPALIVE, (char*)&sockOpt, sizeof(sockOpt));
@@ -121,6 +125,17 @@ void Ros_IoServer_StopConnection(Controller* controller, int connectionIndex)
 	mpClose(controller->sdIoConnections[connectionIndex]);
 	//mark connection as invalid
 	controller->sdIoConnections[connectionIndex] = INVALID_SOCKET;
+	controller->ioSubscriptions[connectionIndex].numberOfElements = 0;
+
+	// Stop subscription sampling and sending tasks (they never stop the connection themselves)
+	tid = controller->tidIoSubscription[connectionIndex];
+	controller->tidIoSubscription[connectionIndex] = INVALID_TASK;
+	if (tid != INVALID_TASK)
+		mpDeleteTask(tid);
+	tid = controller->tidIoSendSubscription[connectionIndex];
+	controller->tidIoSendSubscription[connectionIndex] = INVALID_TASK;
+	if (tid != INVALID_TASK)
+		mpDeleteTask(tid);
 
 	// Stop message receiption task
 	tid = controller->tidIoConnections[connectionIndex];
@@ -130,7 +145,7 @@ void Ros_IoServer_StopConnection(Controller* controller, int connectionIndex)
 	mpDeleteTask(tid);
 }
 
-int Ros_IoServer_GetExpectedByteSizeForMessageType(SimpleMsg* receiveMsg)
+int Ros_IoServer_GetExpectedByteSizeForMessageType(SimpleMsg* receiveMsg, int recvByteSize)
 {
 	int minSize = sizeof(SmPrefix) + sizeof(SmHeader);
 	int expectedSize;
@@ -155,6 +170,36 @@ int Ros_IoServer_GetExpectedByteSizeForMessageType(SimpleMsg* receiveMsg)
 	case ROS_MSG_MOTO_WRITE_MREGISTER:
 		expectedSize = minSize + sizeof(SmBodyMotoWriteIOMRegister);
 		break;
+	case ROS_MSG_MOTO_READ_IO_MULTI:
+		//Only the elements in use are sent
+		expectedSize = minSize + sizeof(int);
+		if (recvByteSize >= expectedSize) //make sure I can get to the [numberOfElements] field
+		{
+			if (receiveMsg->body.readIOMulti.numberOfElements > 0 && receiveMsg->body.readIOMulti.numberOfElements <= ROS_MAX_IO_MULTI)
+				expectedSize += sizeof(SmIoMultiReadElement) * receiveMsg->body.readIOMulti.numberOfElements;
+			//else the header is processed alone and rejected as invalid
+		}
+		break;
+	case ROS_MSG_MOTO_WRITE_IO_MULTI:
+		//Only the elements in use are sent
+		expectedSize = minSize + sizeof(int);
+		if (recvByteSize >= expectedSize) //make sure I can get to the [numberOfElements] field
+		{
+			if (receiveMsg->body.writeIOMulti.numberOfElements > 0 && receiveMsg->body.writeIOMulti.numberOfElements <= ROS_MAX_IO_MULTI)
+				expectedSize += sizeof(SmIoMultiWriteElement) * receiveMsg->body.writeIOMulti.numberOfElements;
+			//else the header is processed alone and rejected as invalid
+		}
+		break;
+	case ROS_MSG_MOTO_IO_SUBSCRIBE:
+		//Only the elements in use are sent
+		expectedSize = minSize + (sizeof(int) * 2);
+		if (recvByteSize >= expectedSize) //make sure I can get to the [numberOfElements] field
+		{
+			if (receiveMsg->body.ioSubscribe.numberOfElements > 0 && receiveMsg->body.ioSubscribe.numberOfElements <= ROS_MAX_IO_MULTI)
+				expectedSize += sizeof(SmIoMultiReadElement) * receiveMsg->body.ioSubscribe.numberOfElements;
+			//else the header is processed alone (and rejected unless it stops the subscription)
+		}
+		break;
 	default: //invalid message type
 		return -1;
 	}
@@ -202,6 +247,16 @@ int Ros_IoServer_SimpleMsgProcess(SimpleMsg* receiveMsg, SimpleMsg* replyMsg)
 		ret = Ros_IoServer_WriteIORegister(receiveMsg, replyMsg);
 		break;
 
+		//-----------------------
+	case ROS_MSG_MOTO_READ_IO_MULTI:
+		ret = Ros_IoServer_ReadIOMulti(receiveMsg, replyMsg);
+		break;
+
+		//-----------------------
+	case ROS_MSG_MOTO_WRITE_IO_MULTI:
+		ret = Ros_IoServer_WriteIOMulti(receiveMsg, replyMsg);
+		break;
+
 		//-----------------------
 	default:
 		printf("Invalid message type: %d\n", receiveMsg->header.msgType);
@@ -241,8 +296,8 @@ void Ros_IoServer_WaitForSimpleMsg(Controller* controller, int connectionIndex)
 		if (!bSkipNetworkRecv)
 		{
 			//Receive message from the PC
-			memset((&receiveMsg) + partialMsgByteCount, 0x00, sizeof(SimpleMsg) - partialMsgByteCount);
-			byteSize = mpRecv(controller->sdIoConnections[connectionIndex], (char*)((&receiveMsg) + partialMsgByteCount), sizeof(SimpleMsg) - partialMsgByteCount, 0);
+			memset((char*)&receiveMsg + partialMsgByteCount, 0x00, sizeof(SimpleMsg) - partialMsgByteCount);
+			byteSize = mpRecv(controller->sdIoConnections[connectionIndex], (char*)&receiveMsg + partialMsgByteCount, sizeof(SimpleMsg) - partialMsgByteCount, 0);
 			if (byteSize <= 0)
 				break; //end connection
 
@@ -256,21 +311,34 @@ void Ros_IoServer_WaitForSimpleMsg(Controller* controller, int connectionIndex)
 			bSkipNetworkRecv = FALSE;
 		}
 
+		//Process the message and send the reply as a whole: no IO_CHANGED message is sent in between
+		mpSemTake(controller->semIoConnection[connectionIndex], WAIT_FOREVER);
+
 		// Determine the expected size of the message
 		expectedSize = -1;
 		if (byteSize >= minSize)
 		{
-			expectedSize = Ros_IoServer_GetExpectedByteSizeForMessageType(&receiveMsg);
+			expectedSize = Ros_IoServer_GetExpectedByteSizeForMessageType(&receiveMsg, byteSize);
 
 			if (expectedSize == -1)
 			{
 				printf("Unknown Message Received (%d)\r\n", receiveMsg.header.msgType);
 				Ros_SimpleMsg_IoReply(ROS_RESULT_INVALID, ROS_RESULT_INVALID_MSGTYPE, &replyMsg);
 			}
+			else if (byteSize < expectedSize && expectedSize <= (int)sizeof(SimpleMsg))
+			{
+				// Large messages (e.g. multi-element I/O) may arrive in several segments: wait for the rest
+				mpSemGive(controller->semIoConnection[connectionIndex]);
+				partialMsgByteCount = byteSize;
+				continue;
+			}
 			else if (byteSize >= expectedSize) // Check message size
 			{
 				// Process the simple message
-				ret = Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
+				if (receiveMsg.header.msgType == ROS_MSG_MOTO_IO_SUBSCRIBE)
+					ret = Ros_IoServer_Subscribe(controller, connectionIndex, &receiveMsg, &replyMsg);
+				else
+					ret = Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
 				if (ret != OK) //error during processing
 				{
 					bDisconnect = TRUE;
@@ -285,7 +353,7 @@ void Ros_IoServer_WaitForSimpleMsg(Controller* controller, int connectionIndex)
 					//Did I receive multiple full messages at once that all need to be processed before listening for new data?
 					if (partialMsgByteCount >= minSize)
 					{
-						expectedSize = Ros_IoServer_GetExpectedByteSizeForMessageType(&receiveMsg);
+						expectedSize = Ros_IoServer_GetExpectedByteSizeForMessageType(&receiveMsg, partialMsgByteCount);
 						bSkipNetworkRecv = (partialMsgByteCount >= expectedSize); //does my modified receiveMsg buffer contain a full message to process?
 					}
 				}
@@ -306,6 +374,7 @@ void Ros_IoServer_WaitForSimpleMsg(Controller* controller, int connectionIndex)
 
 		//Send reply message
 		byteSizeResponse = mpSend(controller->sdIoConnections[connectionIndex], (char*)(&replyMsg), replyMsg.prefix.length + sizeof(SmPrefix), 0);        
+		mpSemGive(controller->semIoConnection[connectionIndex]);
 		if (byteSizeResponse <= 0)
 			break;	// Close the connection
 	}
@@ -568,73 +637,603 @@ int Ros_IoServer_WriteIORegister(SimpleMsg* receiveMsg, SimpleMsg* replyMsg)
 	return OK; //keep connection alive regardless of any error code
 }
 
-BOOL Ros_IoServer_IsValidReadAddress(UINT32 address, IoAccessSize size)
+//-----------------------------------------------------------------------
+// Resolve the address of an element of a multi-element I/O message.
+// Returns FALSE if the element size is unknown.
+//-----------------------------------------------------------------------
+static BOOL Ros_IoServer_GetMultiElementAccess(UINT32* address, IoMultiSize multiSize, IoAccessSize* size)
 {
-	int mod = 0;
+	switch (multiSize)
+	{
+	case IO_MULTI_BIT:
+		*size = IO_ACCESS_BIT;
+		return TRUE;
+	case IO_MULTI_GROUP:
+		*size = IO_ACCESS_GROUP;
+		return TRUE;
+	case IO_MULTI_MREGISTER:
+		*size = IO_ACCESS_REGISTER;
+		if (*address < 1000000)
+			*address += 1000000;
+		return TRUE;
+	default:
+		return FALSE;
+	}
+}
 
-	if (size == IO_ACCESS_GROUP)
-		address *= 10;
+//-----------------------------------------------------------------------
+// Read up to ROS_MAX_IO_MULTI bits, groups and M registers.
+// The signals of all valid elements are read with a single mpReadIO. If
+// that fails, each element is read again on its own to find which failed.
+// Returns IO_RESULT_OK if all elements were read, else the result of the
+// first element that failed.
+//-----------------------------------------------------------------------
+static IoResultCodes Ros_IoServer_ReadElements(int numberOfElements, SmIoMultiReadElement* elements, SmIoMultiReadValue* values)
+{
+	MP_IO_INFO ioReadInfo[ROS_MAX_IO_MULTI * QUANTITY_BYTE];
+	USHORT ioValue[ROS_MAX_IO_MULTI * QUANTITY_BYTE];
+	int firstSignal[ROS_MAX_IO_MULTI];
+	int signalCount[ROS_MAX_IO_MULTI];
+	int numberOfSignals = 0;
+	int apiRet = OK;
+	UINT32 address;
+	IoAccessSize size;
+	IoResultCodes resultCode;
+	int i, j;
+
+	for (i = 0; i < numberOfElements; i += 1)
+	{
+		address = elements[i].ioAddress;
+		firstSignal[i] = numberOfSignals;
+		signalCount[i] = 0;
+		values[i].value = 0;
 
-	mod = address % 10;
+		if (!Ros_IoServer_GetMultiElementAccess(&address, elements[i].size, &size) ||
+			!Ros_IoServer_IsValidReadAddress(address, size))
+		{
+			values[i].resultCode = IO_RESULT_READ_ADDRESS_INVALID;
+			continue;
+		}
 
-	//last digit cannot end in 8 or 9, unless it is an M Register
-	if (size != IO_ACCESS_REGISTER && mod > 7)
-		return FALSE;
-	
-	if ((address >= GENERALINMIN && address <= GENERALINMAX) ||
-		(address >= GENERALOUTMIN && address <= GENERALOUTMAX) ||
-		(address >= EXTERNALINMIN && address <= EXTERNALINMAX) ||
-		(address >= NETWORKINMIN && address <= NETWORKINMAX) ||
-		(address >= NETWORKOUTMIN && address <= NETWORKOUTMAX) ||
-		(address >= EXTERNALOUTMIN && address <= EXTERNALOUTMAX) ||
-		(address >= SPECIFICINMIN && address <= SPECIFICINMAX) ||
-		(address >= SPECIFICOUTMIN && address <= SPECIFICOUTMAX) ||
-		(address >= IFPANELMIN && address <= IFPANELMAX) ||
-		(address >= AUXRELAYMIN && address <= AUXRELAYMAX) ||
-		(address >= CONTROLSTATUSMIN && address <= CONTROLSTATUSMAX) ||
-		(address >= PSEUDOINPUTMIN && address <= PSEUDOINPUTMAX) ||
-		(address >= REGISTERMIN && address <= REGISTERMAX_READ))
+		if (size == IO_ACCESS_GROUP)
+		{
+			for (j = 0; j < QUANTITY_BYTE; j += 1)
+				ioReadInfo[numberOfSignals++].ulAddr = (address * 10) + j;
+		}
+		else
+			ioReadInfo[numberOfSignals++].ulAddr = address;
+		signalCount[i] = numberOfSignals - firstSignal[i];
+	}
+
+	if (numberOfSignals > 0)
+		apiRet = mpReadIO(ioReadInfo, ioValue, numberOfSignals);
+
+	for (i = 0; i < numberOfElements; i += 1)
 	{
-		return TRUE;
+		if (signalCount[i] == 0)
+			continue;
+
+		if (apiRet != OK && mpReadIO(&ioReadInfo[firstSignal[i]], &ioValue[firstSignal[i]], signalCount[i]) != OK)
+		{
+			values[i].resultCode = IO_RESULT_READ_API_ERROR;
+			continue;
+		}
+
+		for (j = 0; j < signalCount[i]; j += 1)
+			values[i].value |= (ioValue[firstSignal[i] + j] << j);
+		values[i].resultCode = IO_RESULT_OK;
+	}
+
+	resultCode = IO_RESULT_OK;
+	for (i = 0; i < numberOfElements && resultCode == IO_RESULT_OK; i += 1)
+		resultCode = values[i].resultCode;
+	return resultCode;
+}
+
+//-----------------------------------------------------------------------
+// Read up to ROS_MAX_IO_MULTI bits, groups and M registers.
+// Each element has its own result code; the reply fails if any element did.
+//-----------------------------------------------------------------------
+int Ros_IoServer_ReadIOMulti(SimpleMsg* receiveMsg, SimpleMsg* replyMsg)
+{
+	SmBodyMotoReadIOMulti* request = &receiveMsg->body.readIOMulti;
+	SmBodyMotoReadIOMultiReply* reply;
+
+	if (request->numberOfElements <= 0 || request->numberOfElements > ROS_MAX_IO_MULTI)
+	{
+		printf("Invalid number of I/O elements: %d\r\n", request->numberOfElements);
+		Ros_SimpleMsg_IoReply(ROS_RESULT_INVALID, ROS_RESULT_INVALID_DATA, replyMsg);
+		return OK; //keep connection alive
 	}
+
+	//initialize memory
+	memset(replyMsg, 0x00, sizeof(SimpleMsg));
+	reply = &replyMsg->body.readIOMultiReply;
+
+	// set prefix: length of message excluding the prefix (only the elements read are sent)
+	replyMsg->prefix.length = sizeof(SmHeader) + (sizeof(int) * 2) + (sizeof(SmIoMultiReadValue) * request->numberOfElements);
+
+	// set header information of the reply
+	replyMsg->header.msgType = ROS_MSG_MOTO_READ_IO_MULTI_REPLY;
+	replyMsg->header.commType = ROS_COMM_SERVICE_REPLY;
+
+	reply->numberOfElements = request->numberOfElements;
+	reply->resultCode = Ros_IoServer_ReadElements(request->numberOfElements, request->elements, reply->values);
+	replyMsg->header.replyType = (reply->resultCode == IO_RESULT_OK) ? ROS_REPLY_SUCCESS : ROS_REPLY_FAILURE;
+
+	return OK; //keep connection alive regardless of any error code
+}
+
+//-----------------------------------------------------------------------
+// Write up to ROS_MAX_IO_MULTI bits, groups and M registers.
+// The signals of all valid elements are written with a single mpWriteIO. If
+// that fails, each element is written again on its own to find which failed.
+// Invalid elements are skipped: the others are still written.
+//-----------------------------------------------------------------------
+int Ros_IoServer_WriteIOMulti(SimpleMsg* receiveMsg, SimpleMsg* replyMsg)
+{
+	SmBodyMotoWriteIOMulti* request = &receiveMsg->body.writeIOMulti;
+	SmBodyMotoWriteIOMultiReply* reply;
+	MP_IO_DATA ioWriteData[ROS_MAX_IO_MULTI * QUANTITY_BYTE];
+	int firstSignal[ROS_MAX_IO_MULTI];
+	int signalCount[ROS_MAX_IO_MULTI];
+	int numberOfSignals = 0;
+	int apiRet = OK;
+	UINT32 address;
+	UINT32 value;
+	IoAccessSize size;
+	int i, j;
+
+	if (request->numberOfElements <= 0 || request->numberOfElements > ROS_MAX_IO_MULTI)
+	{
+		printf("Invalid number of I/O elements: %d\r\n", request->numberOfElements);
+		Ros_SimpleMsg_IoReply(ROS_RESULT_INVALID, ROS_RESULT_INVALID_DATA, replyMsg);
+		return OK; //keep connection alive
+	}
+
+	//initialize memory
+	memset(replyMsg, 0x00, sizeof(SimpleMsg));
+	reply = &replyMsg->body.writeIOMultiReply;
+
+	// set prefix: length of message excluding the prefix (only the elements written are sent)
+	replyMsg->prefix.length = sizeof(SmHeader) + (sizeof(int) * 2) + (sizeof(IoResultCodes) * request->numberOfElements);
+
+	// set header information of the reply
+	replyMsg->header.msgType = ROS_MSG_MOTO_WRITE_IO_MULTI_REPLY;
+	replyMsg->header.commType = ROS_COMM_SERVICE_REPLY;
+
+	reply->numberOfElements = request->numberOfElements;
+
+	for (i = 0; i < request->numberOfElements; i += 1)
+	{
+		address = request->elements[i].ioAddress;
+		value = request->elements[i].value;
+		firstSignal[i] = numberOfSignals;
+		signalCount[i] = 0;
+
+		if (!Ros_IoServer_GetMultiElementAccess(&address, request->elements[i].size, &size) ||
+			!Ros_IoServer_IsValidWriteAddress(address, size))
+		{
+			reply->resultCodes[i] = IO_RESULT_WRITE_ADDRESS_INVALID;
+			continue;
+		}
+		if (!Ros_IoServer_IsValidWriteValue(value, size))
+		{
+			reply->resultCodes[i] = IO_RESULT_WRITE_VALUE_INVALID;
+			continue;
+		}
+
+		if (size == IO_ACCESS_GROUP)
+		{
+			for (j = 0; j < QUANTITY_BYTE; j += 1)
+			{
+				ioWriteData[numberOfSignals].ulAddr = (address * 10) + j;
+				ioWriteData[numberOfSignals++].ulValue = (value & (1 << j)) >> j;
+			}
+		}
+		else
+		{
+			ioWriteData[numberOfSignals].ulAddr = address;
+			ioWriteData[numberOfSignals++].ulValue = value;
+		}
+		signalCount[i] = numberOfSignals - firstSignal[i];
+	}
+
+	if (numberOfSignals > 0)
+		apiRet = mpWriteIO(ioWriteData, numberOfSignals);
+
+	for (i = 0; i < request->numberOfElements; i += 1)
+	{
+		if (signalCount[i] == 0)
+			continue;
+
+		if (apiRet != OK && mpWriteIO(&ioWriteData[firstSignal[i]], signalCount[i]) != OK)
+			reply->resultCodes[i] = IO_RESULT_WRITE_API_ERROR;
+		else
+			reply->resultCodes[i] = IO_RESULT_OK;
+	}
+
+	reply->resultCode = IO_RESULT_OK;
+	for (i = 0; i < request->numberOfElements && reply->resultCode == IO_RESULT_OK; i += 1)
+		reply->resultCode = reply->resultCodes[i];
+	replyMsg->header.replyType = (reply->resultCode == IO_RESULT_OK) ? ROS_REPLY_SUCCESS : ROS_REPLY_FAILURE;
+
+	return OK; //keep connection alive regardless of any error code
+}
+
+//-----------------------------------------------------------------------
+// Replace the I/O elements watched on a connection (none stops watching).
+// The reply carries the value of each element now: from then on, the
+// sending task sends an IO_CHANGED message with the elements that changed.
+// Called with the lock of the connection taken, which the reply is sent
+// under: the first IO_CHANGED message always comes after it.
+//-----------------------------------------------------------------------
+int Ros_IoServer_Subscribe(Controller* controller, int connectionIndex, SimpleMsg* receiveMsg, SimpleMsg* replyMsg)
+{
+	SmBodyMotoIoSubscribe* request = &receiveMsg->body.ioSubscribe;
+	IoSubscription* subscription = &controller->ioSubscriptions[connectionIndex];
+	SmBodyMotoReadIOMultiReply* reply;
+
+	if (request->numberOfElements < 0 || request->numberOfElements > ROS_MAX_IO_MULTI || request->period < 0)
+	{
+		printf("Invalid I/O subscription: %d elements every %d ms\r\n", request->numberOfElements, request->period);
+		Ros_SimpleMsg_IoReply(ROS_RESULT_INVALID, ROS_RESULT_INVALID_DATA, replyMsg);
+		return OK; //keep connection alive
+	}
+
+	if (request->numberOfElements > 0 && controller->tidIoSubscription[connectionIndex] == INVALID_TASK)
+	{
+		// Send at normal priority: the socket is never waited on from the interpolation clock
+		mpSemTake(controller->semIoSampleReady[connectionIndex], NO_WAIT);
+		controller->tidIoSendSubscription[connectionIndex] = mpCreateTask(MP_PRI_TIME_NORMAL, MP_STACK_SIZE,
+													(FUNCPTR)Ros_IoServer_SendSubscription,
+													(int)controller, connectionIndex, 0, 0, 0, 0, 0, 0, 0, 0);
+
+		// Sample on the interpolation clock, at its priority: the samples are evenly spaced
+		if (controller->tidIoSendSubscription[connectionIndex] != ERROR)
+			controller->tidIoSubscription[connectionIndex] = mpCreateTask(MP_PRI_IP_CLK_TAKE, MP_STACK_SIZE,
+													(FUNCPTR)Ros_IoServer_SampleSubscription,
+													(int)controller, connectionIndex, 0, 0, 0, 0, 0, 0, 0, 0);
+
+		if (controller->tidIoSendSubscription[connectionIndex] == ERROR || controller->tidIoSubscription[connectionIndex] == ERROR)
+		{
+			puts("Could not create new task in the IO server.  Check robot parameters.");
+			if (controller->tidIoSendSubscription[connectionIndex] != ERROR)
+				mpDeleteTask(controller->tidIoSendSubscription[connectionIndex]);
+			controller->tidIoSendSubscription[connectionIndex] = INVALID_TASK;
+			controller->tidIoSubscription[connectionIndex] = INVALID_TASK;
+			Ros_SimpleMsg_IoReply(ROS_RESULT_MP_FAILURE, 0, replyMsg);
+			return OK; //keep connection alive
+		}
+	}
+
+	//initialize memory
+	memset(replyMsg, 0x00, sizeof(SimpleMsg));
+	reply = &replyMsg->body.ioSubscribeReply;
+
+	// set prefix: length of message excluding the prefix (only the elements watched are sent)
+	replyMsg->prefix.length = sizeof(SmHeader) + (sizeof(int) * 2) + (sizeof(SmIoMultiReadValue) * request->numberOfElements);
+
+	// set header information of the reply
+	replyMsg->header.msgType = ROS_MSG_MOTO_IO_SUBSCRIBE_REPLY;
+	replyMsg->header.commType = ROS_COMM_SERVICE_REPLY;
+
+	reply->numberOfElements = request->numberOfElements;
+	reply->resultCode = Ros_IoServer_ReadElements(request->numberOfElements, request->elements, reply->values);
+	replyMsg->header.replyType = (reply->resultCode == IO_RESULT_OK) ? ROS_REPLY_SUCCESS : ROS_REPLY_FAILURE;
+
+	// Elements that could not be read are still watched: they are sent once they can be.
+	// The samples taken meanwhile, or for the previous subscription, are dropped (see seqNo).
+	subscription->seqNo++;
+	Q_MEMORY_BARRIER();
+	memcpy(subscription->elements, request->elements, sizeof(SmIoMultiReadElement) * request->numberOfElements);
+	memcpy(subscription->values, reply->values, sizeof(SmIoMultiReadValue) * request->numberOfElements);
+	subscription->decimation = max((request->period + controller->interpolPeriod - 1) / controller->interpolPeriod, 1);
+	subscription->numberOfElements = request->numberOfElements;
+	Q_MEMORY_BARRIER();
+	subscription->seqNo++;
+
+	if (subscription->numberOfElements > 0)
+		printf("IO Server connection %d watches %d I/O element(s) every %d ms\r\n", connectionIndex,
+			subscription->numberOfElements, subscription->decimation * controller->interpolPeriod);
 	else
-		return FALSE;
+		printf("IO Server connection %d stops watching I/O\r\n", connectionIndex);
+
+	return OK; //keep connection alive regardless of any error code
 }
 
-BOOL Ros_IoServer_IsValidWriteAddress(UINT32 address, IoAccessSize size)
+//-----------------------------------------------------------------------
+// Sample the I/O a connection subscribed to, on the interpolation clock,
+// and publish the sample for the sending task of the connection. Runs as
+// long as the connection; it never waits on the connection itself.
+//-----------------------------------------------------------------------
+void Ros_IoServer_SampleSubscription(Controller* controller, int connectionIndex)
 {
-	int mod = 0;
+	IoSubscription* subscription = &controller->ioSubscriptions[connectionIndex];
+	IoSample* published = &controller->ioSamples[connectionIndex];
+	SmIoMultiReadElement elements[ROS_MAX_IO_MULTI];
+	SmIoMultiReadValue values[ROS_MAX_IO_MULTI];
+	UINT32 subscriptionSeqNo;
+	int numberOfElements;
+	UINT32 time = 0;
+	int cycleCnt = 0;
+
+	printf("Starting IO Server subscription task (connectionIndex = %d)\r\n", connectionIndex);
+
+	FOREVER
+	{
+		mpClkAnnounce(MP_INTERPOLATION_CLK);
+		time += controller->interpolPeriod;
+		if (++cycleCnt < subscription->decimation)
+			continue;
+		cycleCnt = 0;
+
+		// Copy the elements watched: if the subscription changes meanwhile, the new one is sampled next cycle
+		subscriptionSeqNo = subscription->seqNo;
+		Q_MEMORY_BARRIER();
+		numberOfElements = subscription->numberOfElements;
+		if ((subscriptionSeqNo & 1) != 0 || numberOfElements <= 0 || numberOfElements > ROS_MAX_IO_MULTI)
+			continue;
+		memcpy(elements, subscription->elements, sizeof(SmIoMultiReadElement) * numberOfElements);
+		Q_MEMORY_BARRIER();
+		if (subscription->seqNo != subscriptionSeqNo)
+			continue;
+
+		Ros_IoServer_ReadElements(numberOfElements, elements, values);
+
+		published->seqNo++;
+		Q_MEMORY_BARRIER();
+		published->subscriptionSeqNo = subscriptionSeqNo;
+		published->time = time;
+		published->numberOfElements = numberOfElements;
+		memcpy(published->values, values, sizeof(SmIoMultiReadValue) * numberOfElements);
+		Q_MEMORY_BARRIER();
+		published->seqNo++;
+
+		mpSemGive(controller->semIoSampleReady[connectionIndex]);
+	}
+}
 
+//-----------------------------------------------------------------------
+// Send the elements that changed in the latest sample of a connection.
+// Runs as long as the connection; sending waits while the connection is
+// busy replying to a request. The samples published meanwhile are
+// skipped: their changes are in the next one.
+//-----------------------------------------------------------------------
+void Ros_IoServer_SendSubscription(Controller* controller, int connectionIndex)
+{
+	IoSample sample;
+	UINT32 lastSentTime = 0;
+	int ret;
+
+	printf("Starting IO Server subscription send task (connectionIndex = %d)\r\n", connectionIndex);
+
+	FOREVER
+	{
+		mpSemTake(controller->semIoSampleReady[connectionIndex], WAIT_FOREVER);
+
+		if (!Ros_IoServer_GetSample(controller, connectionIndex, &sample))
+			continue; //a newer sample is ready
+
+		mpSemTake(controller->semIoConnection[connectionIndex], WAIT_FOREVER);
+		ret = Ros_IoServer_SendChanges(controller, connectionIndex, &sample,
+									   (sample.time - lastSentTime >= IO_SUBSCRIPTION_KEEPALIVE_PERIOD));
+		if (ret < 0)
+		{
+			// Leave it to the receiving task to close the connection
+			printf("IO Server subscription send failure (connectionIndex = %d)\r\n", connectionIndex);
+			controller->ioSubscriptions[connectionIndex].numberOfElements = 0;
+		}
+		mpSemGive(controller->semIoConnection[connectionIndex]);
+
+		if (ret > 0)
+			lastSentTime = sample.time;
+	}
+}
+
+//-----------------------------------------------------------------------
+// Copy the latest I/O sample of a connection
+// return FALSE if it kept being overwritten while it was copied
+//-----------------------------------------------------------------------
+BOOL Ros_IoServer_GetSample(Controller* controller, int connectionIndex, IoSample* sample)
+{
+	IoSample* published = &controller->ioSamples[connectionIndex];
+	int attempt;
+	UINT32 seqNo;
+
+	for (attempt = 0; attempt < IO_SAMPLE_READ_ATTEMPTS; attempt++)
+	{
+		seqNo = published->seqNo;
+		Q_MEMORY_BARRIER();
+		sample->numberOfElements = published->numberOfElements;
+		if ((seqNo & 1) == 0 && sample->numberOfElements >= 0 && sample->numberOfElements <= ROS_MAX_IO_MULTI)
+		{
+			sample->subscriptionSeqNo = published->subscriptionSeqNo;
+			sample->time = published->time;
+			memcpy(sample->values, published->values, sizeof(SmIoMultiReadValue) * sample->numberOfElements);
+			Q_MEMORY_BARRIER();
+			if (published->seqNo == seqNo)
+			{
+				sample->seqNo = seqNo;
+				return TRUE;
+			}
+		}
+		Ros_Sleep(0); //let the sampling task finish
+	}
+
+	return FALSE;
+}
+
+//-----------------------------------------------------------------------
+// Send an IO_CHANGED message with the elements of a sample that changed
+// since they were last sent, if any (or without elements if bKeepalive).
+// Elements are only marked as sent once the message is. A sample taken
+// for another subscription than the current one is not sent.
+// Called with the lock of the connection taken.
+// return 1 if the message was sent, 0 if not, -1 on transmission error
+//-----------------------------------------------------------------------
+int Ros_IoServer_SendChanges(Controller* controller, int connectionIndex, IoSample* sample, BOOL bKeepalive)
+{
+	IoSubscription* subscription = &controller->ioSubscriptions[connectionIndex];
+	SmIoMultiReadValue* values = sample->values;
+	SmBodyMotoIoChanged* changes;
+	SimpleMsg sendMsg;
+	int sd = controller->sdIoConnections[connectionIndex];
+	struct fd_set fds;
+	struct timeval timeout;
+	int ret;
+	int i;
+
+	if (subscription->numberOfElements == 0 || sample->subscriptionSeqNo != subscription->seqNo
+		|| sample->numberOfElements != subscription->numberOfElements)
+		return 0;
+
+	changes = &sendMsg.body.ioChanged;
+	changes->time = sample->time;
+	changes->numberOfElements = 0;
+	for (i = 0; i < subscription->numberOfElements; i += 1)
+	{
+		if (values[i].resultCode != IO_RESULT_OK)
+			continue;
+		if (subscription->values[i].resultCode == IO_RESULT_OK && subscription->values[i].value == values[i].value)
+			continue;
+
+		changes->elements[changes->numberOfElements].ioAddress = subscription->elements[i].ioAddress;
+		changes->elements[changes->numberOfElements].size = subscription->elements[i].size;
+		changes->elements[changes->numberOfElements].value = values[i].value;
+		changes->numberOfElements++;
+	}
+
+	if (changes->numberOfElements == 0 && !bKeepalive)
+		return 0;
+
+	// set prefix: length of message excluding the prefix (only the elements that changed are sent)
+	sendMsg.prefix.length = sizeof(SmHeader) + sizeof(UINT32) + sizeof(int) + (sizeof(SmIoMultiWriteElement) * changes->numberOfElements);
+
+	// set header information
+	sendMsg.header.msgType = ROS_MSG_MOTO_IO_CHANGED;
+	sendMsg.header.commType = ROS_COMM_TOPIC;
+	sendMsg.header.replyType = ROS_REPLY_INVALID;
+
+	FD_ZERO(&fds);
+	FD_SET(sd, &fds);
+	timeout.tv_sec = 0;
+	timeout.tv_usec = IO_SUBSCRIPTION_SEND_BUDGET * 1000;
+
+	ret = mpSelect(sd + 1, NULL, &fds, NULL, &timeout);
+	if (ret == 0)
+		return 0; //the client doesn't keep up: the changes are sent with a later sample
+
+	if (ret > 0)
+		ret = mpSend(sd, (char*)&sendMsg, sendMsg.prefix.length + sizeof(SmPrefix), 0);
+	if (ret <= 0)
+		return -1;
+
+	for (i = 0; i < subscription->numberOfElements; i += 1)
+	{
+		if (values[i].resultCode == IO_RESULT_OK)
+			subscription->values[i] = values[i];
+	}
+
+	return 1;
+}
+
+//-----------------------------------------------------------------------
+// Valid I/O addresses, as ranges sorted by address for the binary search
+// of Ros_IoServer_IsInRanges (the address map is in this order on all
+// controllers). The bit, group and M register paths share them: a group
+// is checked by the address of its first bit.
+//-----------------------------------------------------------------------
+typedef struct
+{
+	UINT32 min;
+	UINT32 max;
+} IoAddressRange;
+
+static const IoAddressRange readableRanges[] =
+{
+	{ GENERALINMIN, GENERALINMAX },
+	{ GENERALOUTMIN, GENERALOUTMAX },
+	{ EXTERNALINMIN, EXTERNALINMAX },
+	{ NETWORKINMIN, NETWORKINMAX },
+	{ EXTERNALOUTMIN, EXTERNALOUTMAX },
+	{ NETWORKOUTMIN, NETWORKOUTMAX },
+	{ SPECIFICINMIN, SPECIFICINMAX },
+	{ SPECIFICOUTMIN, SPECIFICOUTMAX },
+	{ IFPANELMIN, IFPANELMAX },
+	{ AUXRELAYMIN, AUXRELAYMAX },
+	{ CONTROLSTATUSMIN, CONTROLSTATUSMAX },
+	{ PSEUDOINPUTMIN, PSEUDOINPUTMAX },
+	{ REGISTERMIN, REGISTERMAX_READ }
+};
+
+static const IoAddressRange writableRanges[] =
+{
+	{ GENERALOUTMIN, GENERALOUTMAX },
+	{ NETWORKINMIN, NETWORKINMAX },
+	{ IFPANELMIN, IFPANELMAX },
+	{ REGISTERMIN, REGISTERMAX_WRITE }
+};
+
+// Largest value that can be written, by IoAccessSize
+static const UINT32 maxWriteValues[] = { 1, 0xFF, 0xFFFF };
+
+#define IO_NUMBER_OF_RANGES(ranges) (sizeof(ranges) / sizeof(IoAddressRange))
+
+//-----------------------------------------------------------------------
+// Returns the address of the first bit of an element, or 0 (never valid)
+// if the element cannot be addressed: the last digit of a bit cannot be
+// 8 or 9, unless it is an M register.
+//-----------------------------------------------------------------------
+static UINT32 Ros_IoServer_GetBitAddress(UINT32 address, IoAccessSize size)
+{
 	if (size == IO_ACCESS_GROUP)
 		address *= 10;
 
-	mod = address % 10;
+	if (size != IO_ACCESS_REGISTER && address % 10 > 7)
+		return 0;
 
-	//last digit cannot end in 8 or 9, unless it is an M Register
-	if (size != IO_ACCESS_REGISTER && mod > 7)
-		return FALSE;
+	return address;
+}
+
+//-----------------------------------------------------------------------
+// Binary search of an address in sorted, disjoint ranges
+//-----------------------------------------------------------------------
+static BOOL Ros_IoServer_IsInRanges(UINT32 address, const IoAddressRange* ranges, int numberOfRanges)
+{
+	int low = 0;
+	int high = numberOfRanges;
+	int mid;
 
-	if ((address >= GENERALOUTMIN && address <= GENERALOUTMAX) ||
-		(address >= NETWORKINMIN && address <= NETWORKINMAX) ||
-		(address >= IFPANELMIN && address <= IFPANELMAX) ||
-		(address >= REGISTERMIN && address <= REGISTERMAX_WRITE))
+	// find the last range starting at or before the address
+	while (low < high)
 	{
-		return TRUE;
+		mid = (low + high) / 2;
+		if (ranges[mid].min <= address)
+			low = mid + 1;
+		else
+			high = mid;
 	}
-	else
-		return FALSE;
+
+	return (low > 0 && address <= ranges[low - 1].max);
 }
 
-BOOL Ros_IoServer_IsValidWriteValue(UINT32 value, IoAccessSize size)
+BOOL Ros_IoServer_IsValidReadAddress(UINT32 address, IoAccessSize size)
 {
-	if (size == IO_ACCESS_REGISTER && value > 0xFFFF)
-		return FALSE;
-	
-	if (size == IO_ACCESS_GROUP && value > 0xFF)
-		return FALSE;
+	return Ros_IoServer_IsInRanges(Ros_IoServer_GetBitAddress(address, size),
+		readableRanges, IO_NUMBER_OF_RANGES(readableRanges));
+}
 
-	if (size == IO_ACCESS_BIT && value > 1)
-		return FALSE;
+BOOL Ros_IoServer_IsValidWriteAddress(UINT32 address, IoAccessSize size)
+{
+	return Ros_IoServer_IsInRanges(Ros_IoServer_GetBitAddress(address, size),
+		writableRanges, IO_NUMBER_OF_RANGES(writableRanges));
+}
 
-	return TRUE;
-}
\ No newline at end of file
+BOOL Ros_IoServer_IsValidWriteValue(UINT32 value, IoAccessSize size)
+{
+	if ((UINT32)size >= sizeof(maxWriteValues) / sizeof(UINT32))
+		return TRUE;
+
+	return (value <= maxWriteValues[size]);
+}
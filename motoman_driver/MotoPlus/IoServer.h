@@ -45,6 +45,23 @@ extern int Ros_IoServer_ReadIOGroup(SimpleMsg* receiveMsg, SimpleMsg* replyMsg);
 extern int Ros_IoServer_WriteIOGroup(SimpleMsg* receiveMsg, SimpleMsg* replyMsg);
 extern int Ros_IoServer_ReadIORegister(SimpleMsg* receiveMsg, SimpleMsg* replyMsg);
 extern int Ros_IoServer_WriteIORegister(SimpleMsg* receiveMsg, SimpleMsg* replyMsg);
+extern int Ros_IoServer_ReadIOMulti(SimpleMsg* receiveMsg, SimpleMsg* replyMsg);
+extern int Ros_IoServer_WriteIOMulti(SimpleMsg* receiveMsg, SimpleMsg* replyMsg);
+extern int Ros_IoServer_Subscribe(Controller* controller, int connectionIndex, SimpleMsg* receiveMsg, SimpleMsg* replyMsg);
+extern void Ros_IoServer_SampleSubscription(Controller* controller, int connectionIndex);
+extern void Ros_IoServer_SendSubscription(Controller* controller, int connectionIndex);
+extern BOOL Ros_IoServer_GetSample(Controller* controller, int connectionIndex, IoSample* sample);
+extern int Ros_IoServer_SendChanges(Controller* controller, int connectionIndex, IoSample* sample, BOOL bKeepalive);
+
+// IO_CHANGED is sent whenever a subscribed element changes, and at least every
+// IO_SUBSCRIPTION_KEEPALIVE_PERIOD ms otherwise (without elements).
+#define IO_SUBSCRIPTION_KEEPALIVE_PERIOD 1000
+
+// Longest the sending task waits for the socket to accept an IO_CHANGED message (ms). Past it, the
+// changes are sent with the next sample instead: they are never lost, only delayed.
+#define IO_SUBSCRIPTION_SEND_BUDGET 2
+
+#define IO_SAMPLE_READ_ATTEMPTS 3   // Reads of a sample that was overwritten while it was copied
 
 typedef enum
 {
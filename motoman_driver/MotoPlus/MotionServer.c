@@ -54,6 +54,9 @@ int Ros_MotionServer_InitTrajPointFullEx(CtrlGroup* ctrlGroup, SmBodyJointTrajPt
 int Ros_MotionServer_AddTrajPointFull(CtrlGroup* ctrlGroup, SmBodyJointTrajPtFull* jointTrajData);
 int Ros_MotionServer_AddTrajPointFullEx(CtrlGroup* ctrlGroup, SmBodyJointTrajPtExData* jointTrajDataEx, int sequence);
 int Ros_MotionServer_JointTrajPtFullExProcess(Controller* controller, SimpleMsg* receiveMsg, SimpleMsg* replyMsg);
+int Ros_MotionServer_JointTrajPtFullBatchProcess(Controller* controller, SimpleMsg* receiveMsg, SimpleMsg* replyMsg);
+int Ros_MotionServer_AddTrajPointEx(Controller* controller, int numberOfValidGroups, int sequence,
+									SmBodyJointTrajPtExData* jointTrajPtData, int* subcode, int* groupNo);
 int Ros_MotionServer_GetDhParameters(Controller* controller, SimpleMsg* replyMsg);
 int Ros_MotionServer_SetSelectedTool(Controller* controller, SimpleMsg* receiveMsg, SimpleMsg* replyMsg);
 void Ros_MotionServer_EnsureEcoModeIsDisabled(Controller* controller);
@@ -62,9 +65,18 @@ void Ros_MotionServer_EnsureEcoModeIsDisabled(Controller* controller);
 void Ros_MotionServer_AddToIncQueueProcess(Controller* controller, int groupNo);
 void Ros_MotionServer_JointTrajDataToIncQueue(Controller* controller, int groupNo);
 BOOL Ros_MotionServer_AddPulseIncPointToQ(Controller* controller, int groupNo, Incremental_data* dataToEnQ);
+BOOL Ros_MotionServer_AddTrajPointToQ(CtrlGroup* ctrlGroup, JointMotionData* jointData);
+BOOL Ros_MotionServer_GetNextTrajPoint(CtrlGroup* ctrlGroup);
+BOOL Ros_MotionServer_IsTrajPointQFull(CtrlGroup* ctrlGroup);
+void Ros_MotionServer_ClearTrajPointQ(CtrlGroup* ctrlGroup);
 BOOL Ros_MotionServer_ClearQ_All(Controller* controller);
+int Ros_MotionServer_TruncateQ_All(Controller* controller, int leadTime_ms);
+BOOL Ros_MotionServer_TruncateQ(Controller* controller, int groupNo, int leadTime_ms);
 BOOL Ros_MotionServer_HasDataInQueue(Controller* controller);
 int Ros_MotionServer_GetQueueCnt(Controller* controller, int groupNo);
+void Ros_MotionServer_GetQueueFill(Controller* controller, int groupNo, SmBodyMotoMotionReply* motionReply);
+void Ros_MotionServer_GetQueueEndState(Controller* controller, int groupNo, BOOL bVelocity, SmBodyMotoMotionReply* motionReply);
+int Ros_MotionServer_SetQueueSize(Controller* controller, int incQSize, int trajPtQSize);
 void Ros_MotionServer_IncMoveLoopStart(Controller* controller);
 
 // Utility functions:
@@ -228,9 +240,11 @@ void Ros_MotionServer_StopConnection(Controller* controller, int connectionIndex
 		for(i=0; i < controller->numGroup; i++)
 		{
 			controller->ctrlGroups[i]->hasDataToProcess = FALSE;
+			Ros_MotionServer_ClearTrajPointQ(controller->ctrlGroups[i]);
 			tid = controller->ctrlGroups[i]->tidAddToIncQueue;
 			controller->ctrlGroups[i]->tidAddToIncQueue = INVALID_TASK;
 			mpDeleteTask(tid);
+			controller->ctrlGroups[i]->bProcessingTrajPoint = FALSE;
 		}
 		
 		// terminate the inc_move task
@@ -278,10 +292,26 @@ int Ros_MotionServer_GetExpectedByteSizeForMessageType(SimpleMsg* receiveMsg, in
 		{
 			expectedSize = minSize + (sizeof(int) * 2);
 			expectedSize += (sizeof(SmBodyJointTrajPtExData) * receiveMsg->body.jointTrajDataEx.numberOfValidGroups); //check the number of groups to determine size of data
+
+			//Some clients send the data of all groups anyway: consume it, so that it isn't taken for the next message
+			if (receiveMsg->prefix.length == (int)(sizeof(SmHeader) + sizeof(SmBodyJointTrajPtFullEx)))
+				expectedSize = minSize + sizeof(SmBodyJointTrajPtFullEx);
 		}
 		else
 			expectedSize = minSize + sizeof(SmBodyJointTrajPtFullEx);
 		break;
+	case ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH:
+		//Only the points and groups in use are sent
+		expectedSize = minSize + (sizeof(int) * 3);
+		if (recvByteSize >= expectedSize) //make sure I can get to the [numberOfPoints] and [numberOfValidGroups] fields
+		{
+			SmBodyJointTrajPtFullBatch* batch = &receiveMsg->body.jointTrajDataBatch;
+			if (batch->numberOfPoints > 0 && batch->numberOfValidGroups > 0 && batch->numberOfValidGroups <= MOT_MAX_GR &&
+				batch->numberOfPoints * batch->numberOfValidGroups <= ROS_MAX_BATCH_DATA)
+				expectedSize += sizeof(SmBodyJointTrajPtExData) * batch->numberOfPoints * batch->numberOfValidGroups;
+			//else the header is processed alone and rejected as invalid
+		}
+		break;
 	case ROS_MSG_MOTO_JOINT_FEEDBACK_EX:
 		expectedSize = minSize + sizeof(SmBodyJointFeedbackEx);
 		break;
@@ -330,8 +360,8 @@ void Ros_MotionServer_WaitForSimpleMsg(Controller* controller, int connectionInd
 		if (!bSkipNetworkRecv) //if I don't already have an extra complete packet buffered from the previous recv
 		{
 			//Receive message from the PC
-			memset((&receiveMsg) + partialMsgByteCount, 0x00, sizeof(SimpleMsg) - partialMsgByteCount);
-			byteSize = mpRecv(controller->sdMotionConnections[connectionIndex], (char*)((&receiveMsg) + partialMsgByteCount), sizeof(SimpleMsg) - partialMsgByteCount, 0);
+			memset((char*)&receiveMsg + partialMsgByteCount, 0x00, sizeof(SimpleMsg) - partialMsgByteCount);
+			byteSize = mpRecv(controller->sdMotionConnections[connectionIndex], (char*)&receiveMsg + partialMsgByteCount, sizeof(SimpleMsg) - partialMsgByteCount, 0);
 			if (byteSize <= 0)
 				break; //end connection
 
@@ -356,6 +386,12 @@ void Ros_MotionServer_WaitForSimpleMsg(Controller* controller, int connectionInd
 				printf("Unknown Message Received (%d)\r\n", receiveMsg.header.msgType);
 				Ros_SimpleMsg_MotionReply(&receiveMsg, ROS_RESULT_INVALID, ROS_RESULT_INVALID_MSGTYPE, &replyMsg, 0);
 			}			
+			else if (byteSize < expectedSize && expectedSize <= (int)sizeof(SimpleMsg))
+			{
+				// Large messages (e.g. batches) may arrive in several segments: wait for the rest
+				partialMsgByteCount = byteSize;
+				continue;
+			}
 			else if (byteSize >= expectedSize) // Check message size
 			{
 				// Process the simple message
@@ -366,26 +402,16 @@ void Ros_MotionServer_WaitForSimpleMsg(Controller* controller, int connectionInd
 				}
 				else if (byteSize > expectedSize) // Received extra data in single message
 				{
-					//Special case where ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_EX message could have different lengths
-					if (receiveMsg.header.msgType == ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_EX &&
-						byteSize == (int)(minSize + sizeof(SmBodyJointTrajPtFullEx)))
-					{
-						// All good
-						partialMsgByteCount = 0;
-					}
-					else
-					{
-						// Preserve the remaining bytes and treat them as the start of a new message
-						Db_Print("MessageReceived(%d bytes): expectedSize=%d, processing rest of bytes (%d, %d, %d)\r\n", byteSize, expectedSize, sizeof(receiveMsg), receiveMsg.body.jointTrajData.sequence, ((int*)((char*)&receiveMsg + expectedSize))[5]);
-						partialMsgByteCount = byteSize - expectedSize;
-						memmove(&receiveMsg, (char*)&receiveMsg + expectedSize, partialMsgByteCount);
+					// Preserve the remaining bytes and treat them as the start of a new message
+					Db_Print("MessageReceived(%d bytes): expectedSize=%d, processing rest of bytes (%d, %d, %d)\r\n", byteSize, expectedSize, sizeof(receiveMsg), receiveMsg.body.jointTrajData.sequence, ((int*)((char*)&receiveMsg + expectedSize))[5]);
+					partialMsgByteCount = byteSize - expectedSize;
+					memmove(&receiveMsg, (char*)&receiveMsg + expectedSize, partialMsgByteCount);
 
-						//Did I receive multiple full messages at once that all need to be processed before listening for new data?
-						if (partialMsgByteCount >= minSize)
-						{
-							expectedSize = Ros_MotionServer_GetExpectedByteSizeForMessageType(&receiveMsg, partialMsgByteCount);
-							bSkipNetworkRecv = (partialMsgByteCount >= expectedSize); //does my modified receiveMsg buffer contain a full message to process?
-						}
+					//Did I receive multiple full messages at once that all need to be processed before listening for new data?
+					if (partialMsgByteCount >= minSize)
+					{
+						expectedSize = Ros_MotionServer_GetExpectedByteSizeForMessageType(&receiveMsg, partialMsgByteCount);
+						bSkipNetworkRecv = (partialMsgByteCount >= expectedSize); //does my modified receiveMsg buffer contain a full message to process?
 					}
 				}
 				else // All good
@@ -454,6 +480,11 @@ int Ros_MotionServer_SimpleMsgProcess(Controller* controller, SimpleMsg* receive
 		ret = Ros_MotionServer_JointTrajPtFullExProcess(controller, receiveMsg, replyMsg);
 		break;
 
+	//-----------------------
+	case ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH:
+		ret = Ros_MotionServer_JointTrajPtFullBatchProcess(controller, receiveMsg, replyMsg);
+		break;
+
 
 //Maintain backward compatibility for users who are sending I/O over motion-server
 	//-----------------------
@@ -512,16 +543,14 @@ int Ros_MotionServer_JointTrajPtFullExProcess(Controller* controller, SimpleMsg*
 											  SimpleMsg* replyMsg)
 {
 	SmBodyJointTrajPtFullEx* msgBody;	
-	CtrlGroup* ctrlGroup;
-	int ret, i;
-	FlagsValidFields validationFlags;
+	int result, subcode, groupNo, i;
 
 	msgBody = &receiveMsg->body.jointTrajDataEx;
 
 	// Check if controller is able to receive incremental move and if the incremental move thread is running
 	if(!Ros_Controller_IsMotionReady(controller))
 	{
-		int subcode = Ros_Controller_GetNotReadySubcode(controller);
+		subcode = Ros_Controller_GetNotReadySubcode(controller);
 		printf("ERROR: Controller is not ready (code: %d).  Can't process ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_EX.\r\n", subcode);
 		for (i = 0; i < msgBody->numberOfValidGroups; i += 1)
 		{
@@ -530,87 +559,163 @@ int Ros_MotionServer_JointTrajPtFullExProcess(Controller* controller, SimpleMsg*
 		return 0;
 	}
 
+	result = Ros_MotionServer_AddTrajPointEx(controller, msgBody->numberOfValidGroups, msgBody->sequence,
+											 msgBody->jointTrajPtData, &subcode, &groupNo);
+	Ros_SimpleMsg_MotionReply(receiveMsg, result, subcode, replyMsg, groupNo);
+
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------
+// Processes message of type: ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH
+// The points are added in sequence until one is rejected.  A single reply
+// covers the whole batch: it carries the result of the first rejected
+// point (or success) and the number of points accepted in data[0].
+// Return -1=Failure; 0=Success; 1=CloseConnection; 
+//-----------------------------------------------------------------------
+int Ros_MotionServer_JointTrajPtFullBatchProcess(Controller* controller, SimpleMsg* receiveMsg, 
+												 SimpleMsg* replyMsg)
+{
+	SmBodyJointTrajPtFullBatch* msgBody;
+	int result = ROS_RESULT_SUCCESS;
+	int subcode = 0;
+	int groupNo;
+	int i;
+
+	msgBody = &receiveMsg->body.jointTrajDataBatch;
+	groupNo = msgBody->jointTrajPtData[0].groupNo;
+
+	if (msgBody->numberOfPoints <= 0 || msgBody->numberOfValidGroups <= 0 || msgBody->numberOfValidGroups > MOT_MAX_GR ||
+		msgBody->numberOfPoints * msgBody->numberOfValidGroups > ROS_MAX_BATCH_DATA)
+	{
+		printf("ERROR: Invalid batch of %d points of %d groups\r\n", msgBody->numberOfPoints, msgBody->numberOfValidGroups);
+		Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_INVALID, ROS_RESULT_INVALID_DATA, replyMsg, groupNo);
+		return 0;
+	}
+
+	// Check if controller is able to receive incremental move and if the incremental move thread is running
+	if(!Ros_Controller_IsMotionReady(controller))
+	{
+		subcode = Ros_Controller_GetNotReadySubcode(controller);
+		printf("ERROR: Controller is not ready (code: %d).  Can't process ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH.\r\n", subcode);
+		Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_NOT_READY, subcode, replyMsg, groupNo);
+		return 0;
+	}
+
+	for (i = 0; i < msgBody->numberOfPoints; i += 1)
+	{
+		result = Ros_MotionServer_AddTrajPointEx(controller, msgBody->numberOfValidGroups, msgBody->sequence + i,
+												 &msgBody->jointTrajPtData[i * msgBody->numberOfValidGroups], &subcode, &groupNo);
+		if (result != ROS_RESULT_SUCCESS)
+			break;
+	}
+
+	Ros_SimpleMsg_MotionReply(receiveMsg, result, subcode, replyMsg, groupNo);
+	replyMsg->body.motionReply.data[0] = i; // number of points accepted
+
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------
+// Adds a multi-group trajectory point to the trajectory of each group
+// Return the result of the point; *subcode and *groupNo are set to the
+// reply subcode and the group it applies to
+//-----------------------------------------------------------------------
+int Ros_MotionServer_AddTrajPointEx(Controller* controller, int numberOfValidGroups, int sequence,
+									SmBodyJointTrajPtExData* jointTrajPtData, int* subcode, int* groupNo)
+{
+	CtrlGroup* ctrlGroup;
+	int ret, i;
+	FlagsValidFields validationFlags;
+
+	*subcode = 0;
+	*groupNo = jointTrajPtData[0].groupNo;
+
 	// Pre-check to ensure no groups are busy
-	for (i = 0; i < msgBody->numberOfValidGroups; i += 1)
+	for (i = 0; i < numberOfValidGroups; i += 1)
 	{
-		if (Ros_Controller_IsValidGroupNo(controller, msgBody->jointTrajPtData[i].groupNo))
+		*groupNo = jointTrajPtData[i].groupNo;
+
+		if (Ros_Controller_IsValidGroupNo(controller, jointTrajPtData[i].groupNo))
 		{
-			ctrlGroup = controller->ctrlGroups[msgBody->jointTrajPtData[i].groupNo];
-			if (ctrlGroup->hasDataToProcess)
+			ctrlGroup = controller->ctrlGroups[jointTrajPtData[i].groupNo];
+			if (sequence > 0 && ctrlGroup->lastSequence < 0)
 			{
-				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_BUSY, 0, replyMsg, msgBody->jointTrajPtData[i].groupNo);
-				return 0;
+				// No trajectory started (or it was cleared): the point can't be accepted
+				*subcode = ROS_RESULT_INVALID_SEQUENCE;
+				return ROS_RESULT_INVALID;
+			}
+			if (Ros_MotionServer_IsTrajPointQFull(ctrlGroup) ||
+				(sequence > ctrlGroup->lastSequence + 1))
+			{
+				return ROS_RESULT_BUSY;
 			}
 		}
 		else
 		{
-			printf("ERROR: GroupNo %d is not valid\n", msgBody->jointTrajPtData[i].groupNo);
-			Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_INVALID, ROS_RESULT_INVALID_GROUPNO, replyMsg, msgBody->jointTrajPtData[i].groupNo);
-			return 0;
+			printf("ERROR: GroupNo %d is not valid\n", jointTrajPtData[i].groupNo);
+			*subcode = ROS_RESULT_INVALID_GROUPNO;
+			return ROS_RESULT_INVALID;
 		}
 			
 		// Check that minimum information (time, position, velocity) is valid
 		validationFlags = Valid_Time | Valid_Position | Valid_Velocity;
-		if( (msgBody->jointTrajPtData[i].validFields & validationFlags) != validationFlags)
+		if( (jointTrajPtData[i].validFields & validationFlags) != validationFlags)
 		{
-			printf("ERROR: Validfields = %d\r\n", msgBody->jointTrajPtData[i].validFields);
-			Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_INVALID, ROS_RESULT_INVALID_DATA_INSUFFICIENT, replyMsg, msgBody->jointTrajPtData[i].groupNo);
-			return 0;
+			printf("ERROR: Validfields = %d\r\n", jointTrajPtData[i].validFields);
+			*subcode = ROS_RESULT_INVALID_DATA_INSUFFICIENT;
+			return ROS_RESULT_INVALID;
 		}
 	}
 
-	for (i = 0; i < msgBody->numberOfValidGroups; i += 1)
+	for (i = 0; i < numberOfValidGroups; i += 1)
 	{
-		ctrlGroup = controller->ctrlGroups[msgBody->jointTrajPtData[i].groupNo];
+		ctrlGroup = controller->ctrlGroups[jointTrajPtData[i].groupNo];
+		*groupNo = jointTrajPtData[i].groupNo;
 		
 		// Check the trajectory sequence code
-		if(msgBody->sequence == 0) // First trajectory point
+		if(sequence == 0) // First trajectory point
 		{
             //It's possible for energy-saving mode to activate between /robot_enable and the first trajectory point.
             Ros_MotionServer_EnsureEcoModeIsDisabled(controller); //make sure that Ros_Controller_IsMotionReady gets called above before calling this
 
 			// Initialize first point variables
-			ret = Ros_MotionServer_InitTrajPointFullEx(ctrlGroup, &msgBody->jointTrajPtData[i], msgBody->sequence);
+			ret = Ros_MotionServer_InitTrajPointFullEx(ctrlGroup, &jointTrajPtData[i], sequence);
 		
-			// set reply
-			if(ret == 0)
-				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_SUCCESS, 0, replyMsg, msgBody->jointTrajPtData[i].groupNo);
-			else
+			if(ret != 0)
 			{
 				printf("ERROR: Ros_MotionServer_InitTrajPointFullEx returned %d\n", ret);
-				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_INVALID, ret, replyMsg, msgBody->jointTrajPtData[i].groupNo);
-				return 0; //stop processing other groups in this loop
+				*subcode = ret;
+				return ROS_RESULT_INVALID; //stop processing other groups in this loop
 			}
 		}
-		else if(msgBody->sequence > 0)// Subsequent trajectory points
+		else if(sequence > 0)// Subsequent trajectory points
 		{
 			// Add the point to the trajectory
-			ret = Ros_MotionServer_AddTrajPointFullEx(ctrlGroup, &msgBody->jointTrajPtData[i], msgBody->sequence);
+			ret = Ros_MotionServer_AddTrajPointFullEx(ctrlGroup, &jointTrajPtData[i], sequence);
 		
-			// ser reply
-			if(ret == 0)
-				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_SUCCESS, 0, replyMsg, msgBody->jointTrajPtData[i].groupNo);
-			else if(ret == 1)
+			if(ret == 1)
 			{
 				printf("ERROR: Ros_MotionServer_AddTrajPointFullEx returned %d\n", ret);
-				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_BUSY, 0, replyMsg, msgBody->jointTrajPtData[i].groupNo);
-				return 0; //stop processing other groups in this loop
+				return ROS_RESULT_BUSY; //stop processing other groups in this loop
 			}
-			else
+			else if(ret != 0)
 			{
 				printf("ERROR: Ros_MotionServer_AddTrajPointFullEx returned %d\n", ret);
-				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_INVALID, ret, replyMsg, msgBody->jointTrajPtData[i].groupNo);
-				return 0; //stop processing other groups in this loop
+				*subcode = ret;
+				return ROS_RESULT_INVALID; //stop processing other groups in this loop
 			}
 		}
 		else
 		{
-			Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_INVALID, ROS_RESULT_INVALID_SEQUENCE, replyMsg, msgBody->jointTrajPtData[i].groupNo);
-			return 0; //stop processing other groups in this loop
+			*subcode = ROS_RESULT_INVALID_SEQUENCE;
+			return ROS_RESULT_INVALID; //stop processing other groups in this loop
 		}
 	}
 
-	return 0;
+	return ROS_RESULT_SUCCESS;
 }
 
 
@@ -641,11 +746,45 @@ int Ros_MotionServer_MotionCtrlProcess(Controller* controller, SimpleMsg* receiv
 		{
 			int count = Ros_MotionServer_GetQueueCnt(controller, motionCtrl->groupNo);
 			if(count >= 0)
+			{
 				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_TRUE, count, replyMsg, receiveMsg->body.motionCtrl.groupNo);
+				Ros_MotionServer_GetQueueFill(controller, motionCtrl->groupNo, &replyMsg->body.motionReply);
+			}
 			else
 				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_FAILURE, count, replyMsg, receiveMsg->body.motionCtrl.groupNo);
 			break;
 		}
+		case ROS_CMD_GET_QUEUE_END_STATE:
+		{
+			// State the next trajectory point is interpolated from (see Ros_MotionServer_TruncateQ)
+			if(Ros_Controller_IsValidGroupNo(controller, motionCtrl->groupNo))
+			{
+				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_SUCCESS, 0, replyMsg, receiveMsg->body.motionCtrl.groupNo);
+				Ros_MotionServer_GetQueueEndState(controller, motionCtrl->groupNo, (motionCtrl->data[0] != 0.0f), 
+					&replyMsg->body.motionReply);
+			}
+			else
+				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_INVALID, ROS_RESULT_INVALID_GROUPNO, replyMsg, 
+					receiveMsg->body.motionCtrl.groupNo);
+			break;
+		}
+		case ROS_CMD_SET_QUEUE_SIZE:
+		{
+			// Change the depth of the queues (0 keeps the current depth)
+			int ret = Ros_MotionServer_SetQueueSize(controller, (int)motionCtrl->data[0], (int)motionCtrl->data[1]);
+			int groupNo = motionCtrl->groupNo;
+
+			Ros_SimpleMsg_MotionReply(receiveMsg, ret, (ret == ROS_RESULT_INVALID) ? ROS_RESULT_INVALID_DATA : 0, 
+				replyMsg, receiveMsg->body.motionCtrl.groupNo);
+			if(!Ros_Controller_IsValidGroupNo(controller, groupNo))
+				groupNo = 0;
+
+			// Report the resulting depth of the queues
+			replyMsg->body.motionReply.data[0] = controller->ctrlGroups[groupNo]->inc_q.size;
+			replyMsg->body.motionReply.data[1] = controller->ctrlGroups[groupNo]->trajPt_q.size;
+			replyMsg->body.motionReply.data[2] = controller->ctrlGroups[groupNo]->inc_q.size * controller->interpolPeriod / 1000.0f;
+			break;
+		}
 		case ROS_CMD_STOP_MOTION:
 		{
 			// Stop Motion
@@ -694,6 +833,24 @@ int Ros_MotionServer_MotionCtrlProcess(Controller* controller, SimpleMsg* receiv
 				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_FAILURE, 0, replyMsg, receiveMsg->body.motionCtrl.groupNo);
 			break;
 		}
+		case ROS_CMD_TRUNCATE_TRAJ:
+		{
+			// Drop the queued motion past the splice time, so a new trajectory can continue from there
+			int ret = Ros_MotionServer_TruncateQ_All(controller, (int)(motionCtrl->data[0] * 1000.0f));
+			int groupNo = motionCtrl->groupNo;
+
+			Ros_SimpleMsg_MotionReply(receiveMsg, ret, 0, replyMsg, receiveMsg->body.motionCtrl.groupNo);
+			if(ret == ROS_RESULT_SUCCESS)
+			{
+				if(!Ros_Controller_IsValidGroupNo(controller, groupNo))
+					groupNo = 0;
+
+				// Report the time at which the remaining motion ends and the time currently executing
+				replyMsg->body.motionReply.data[0] = controller->ctrlGroups[groupNo]->jointMotionData.time / 1000.0f;
+				replyMsg->body.motionReply.data[1] = controller->ctrlGroups[groupNo]->q_time / 1000.0f;
+			}
+			break;
+		}
 		case ROS_CMD_START_TRAJ_MODE:
 		{
 			// Start Trajectory mode by starting the INIT_ROS job on the controller
@@ -719,6 +876,12 @@ int Ros_MotionServer_MotionCtrlProcess(Controller* controller, SimpleMsg* receiv
 				Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_FAILURE, 0, replyMsg, receiveMsg->body.motionCtrl.groupNo);
 			break;
 		}
+		default:
+		{
+			printf("Invalid motion control command: %d\r\n", motionCtrl->command);
+			Ros_SimpleMsg_MotionReply(receiveMsg, ROS_RESULT_INVALID, ROS_RESULT_INVALID_COMMAND, replyMsg, receiveMsg->body.motionCtrl.groupNo);
+			break;
+		}
 	}
 
 	return 0;
@@ -738,6 +901,10 @@ BOOL Ros_MotionServer_StopMotion(Controller* controller)
 		
 	// Stop any motion from being processed further
 	controller->bStopMotion = TRUE;
+
+	// Drop the trajectory points waiting to be processed
+	for(groupNo=0; groupNo<controller->numGroup; groupNo++)
+		Ros_MotionServer_ClearTrajPointQ(controller->ctrlGroups[groupNo]);
 	
 	// Check that background processing of message has been stopped
 	for(checkCnt=0; checkCnt<MOTION_STOP_TIMEOUT; checkCnt++) 
@@ -1201,30 +1368,40 @@ int Ros_MotionServer_InitTrajPointFull(CtrlGroup* ctrlGroup, SmBodyJointTrajPtFu
 {
 	long pulsePos[MAX_PULSE_AXES];
 	long curPos[MAX_PULSE_AXES];
+	JointMotionData firstPoint;
+	JointMotionData startData;
 	int i;
 
 	if(ctrlGroup->groupNo == jointTrajData->groupNo)
 	{
-		// Assign start position
-		Ros_MotionServer_ConvertToJointMotionData(jointTrajData, &ctrlGroup->jointMotionData);
-		ctrlGroup->timeLeftover_ms = 0;
-		ctrlGroup->q_time = ctrlGroup->jointMotionData.time;
+		// A client that missed the reply resends the first point while the trajectory is
+		// already queued: acknowledge it, as Ros_MotionServer_AddTrajPointFull does for the
+		// other points, instead of restarting the trajectory.  Only the same point is taken
+		// for a resend, since a new trajectory may start while the tail of the previous one
+		// is still in the queues.
+		Ros_MotionServer_ConvertToJointMotionData(jointTrajData, &firstPoint);
+		if(ctrlGroup->lastSequence >= 0
+			&& (ctrlGroup->trajPt_q.cnt > 0 || ctrlGroup->hasDataToProcess || Ros_IncQueue_GetCnt(&ctrlGroup->inc_q) > 0)
+			&& firstPoint.time == ctrlGroup->firstPoint.time
+			&& memcmp(firstPoint.pos, ctrlGroup->firstPoint.pos, sizeof(firstPoint.pos)) == 0)
+			return 0;
+
+		// Start position.  The group state is only updated once the point is validated,
+		// so that a rejected point leaves the current trajectory untouched.
+		startData = firstPoint;
 		
 		// For MPL80/100 robot type (SLUBT): Controller automatically moves the B-axis
 		// to maintain orientation as other axes are moved.
 		if (ctrlGroup->bIsBaxisSlave)
 		{
 			//ROS joint order
-			ctrlGroup->jointMotionData.pos[3] += -ctrlGroup->jointMotionData.pos[1] + ctrlGroup->jointMotionData.pos[2];
-			ctrlGroup->jointMotionData.vel[3] += -ctrlGroup->jointMotionData.vel[1] + ctrlGroup->jointMotionData.vel[2];
+			startData.pos[3] += -startData.pos[1] + startData.pos[2];
+			startData.vel[3] += -startData.vel[1] + startData.vel[2];
 		}
 
 		// Convert start position to pulse format
-		Ros_CtrlGroup_ConvertToMotoPos(ctrlGroup, ctrlGroup->jointMotionData.pos, pulsePos);
+		Ros_CtrlGroup_ConvertToMotoPos(ctrlGroup, startData.pos, pulsePos);
 		Ros_CtrlGroup_GetPulsePosCmd(ctrlGroup, curPos);
-
-		// Initialize prevPulsePos to the current position
-		Ros_CtrlGroup_GetPulsePosCmd(ctrlGroup, ctrlGroup->prevPulsePos);
 		
 		// Check for each axis
 		for(i=0; i<MAX_PULSE_AXES; i++)
@@ -1241,22 +1418,30 @@ int Ros_MotionServer_InitTrajPointFull(CtrlGroup* ctrlGroup, SmBodyJointTrajPtFu
 					curPos[0], curPos[1], curPos[2],
 					curPos[3], curPos[4], curPos[5],
 					curPos[6], curPos[7]);
-				printf(" - ctrlGroup->prevPulsePos: %ld, %ld, %ld, %ld, %ld, %ld, %ld, %ld\r\n",
-					ctrlGroup->prevPulsePos[0], ctrlGroup->prevPulsePos[1], ctrlGroup->prevPulsePos[2],
-					ctrlGroup->prevPulsePos[3], ctrlGroup->prevPulsePos[4], ctrlGroup->prevPulsePos[5],
-					ctrlGroup->prevPulsePos[6], ctrlGroup->prevPulsePos[7]);
 
 				return ROS_RESULT_INVALID_DATA_START_POS;
 			}
 			
 			// Check maximum velocity limit
-			if(abs(ctrlGroup->jointMotionData.vel[i]) > ctrlGroup->maxSpeed[i])
+			if(abs(startData.vel[i]) > ctrlGroup->maxSpeed[i])
 			{
 				// excessive speed
 				return ROS_RESULT_INVALID_DATA_SPEED;
 			}
 		}		
 
+		// Assign start position
+		ctrlGroup->jointMotionData = startData;
+		ctrlGroup->timeLeftover_ms = 0;
+		ctrlGroup->q_time = startData.time;
+		ctrlGroup->trajPt_q.lastTime = startData.time;
+		ctrlGroup->lastSequence = jointTrajData->sequence;
+
+		// Initialize prevPulsePos to the current position
+		memcpy(ctrlGroup->prevPulsePos, curPos, sizeof(curPos));
+
+		ctrlGroup->firstPoint = firstPoint;
+
 		//printf("Trajectory Start Initialized\r\n");
 		// Return success
 		return 0;
@@ -1293,12 +1478,24 @@ int Ros_MotionServer_AddTrajPointFull(CtrlGroup* ctrlGroup, SmBodyJointTrajPtFul
 	int i;
 	JointMotionData jointData;
 
-	// Check that there isn't data current being processed
-	if(ctrlGroup->hasDataToProcess)
+	// Check that there is room in the queue of points to process
+	if(Ros_MotionServer_IsTrajPointQFull(ctrlGroup))
 	{
 		// Busy
 		return ROS_RESULT_BUSY;
 	}
+
+	// Points may be streamed several at a time, so they must be accepted in order.
+	// A point that was already accepted (resent after a lost reply) is acknowledged again.
+	// A point past the next expected one is rejected as busy; the client will resend it
+	// after resending the point it skipped.  Without a first point there is no
+	// trajectory to add to.
+	if(ctrlGroup->lastSequence < 0)
+		return ROS_RESULT_INVALID_SEQUENCE;
+	if(jointTrajData->sequence <= ctrlGroup->lastSequence)
+		return 0;
+	if(jointTrajData->sequence != ctrlGroup->lastSequence + 1)
+		return ROS_RESULT_BUSY;
 	
 	// Convert message data to a jointMotionData
 	Ros_MotionServer_ConvertToJointMotionData(jointTrajData, &jointData);
@@ -1324,9 +1521,10 @@ int Ros_MotionServer_AddTrajPointFull(CtrlGroup* ctrlGroup, SmBodyJointTrajPtFul
 		}
 	}			
 
-	// Store of the message trajectory data to the control group for processing 
-	memcpy(&ctrlGroup->jointMotionDataToProcess, &jointData, sizeof(JointMotionData));
-	ctrlGroup->hasDataToProcess = TRUE;
+	// Queue the message trajectory data of the control group for processing 
+	if(!Ros_MotionServer_AddTrajPointToQ(ctrlGroup, &jointData))
+		return ROS_RESULT_BUSY;
+	ctrlGroup->lastSequence = jointTrajData->sequence;
 
 	return 0;
 }
@@ -1345,19 +1543,18 @@ void Ros_MotionServer_AddToIncQueueProcess(Controller* controller, int groupNo)
 	// Initialization of pointers and memory
 	interpolPeriod = controller->interpolPeriod; 
 	ctrlGroup->hasDataToProcess = FALSE;
+	ctrlGroup->bProcessingTrajPoint = FALSE;
 
 	FOREVER
 	{
-		// if there is no message to process delay and try agsain
-		if(ctrlGroup->hasDataToProcess)
+		// Process the queued points (the last one marks the data as processed)
+		while(Ros_MotionServer_GetNextTrajPoint(ctrlGroup))
 		{
 			// Interpolate increment move to reach position data
 			Ros_MotionServer_JointTrajDataToIncQueue(controller, groupNo);
-			
-			// Mark message as processed 
-			ctrlGroup->hasDataToProcess = FALSE;
 		}
 		
+		// if there is no message to process delay and try agsain
 		Ros_Sleep(interpolPeriod);
 	}		
 }
@@ -1366,8 +1563,7 @@ void Ros_MotionServer_AddToIncQueueProcess(Controller* controller, int groupNo)
 //-----------------------------------------------------------------------
 // Decompose the message type: ROS_MSG_JOINT_TRAJ_PT_FULL into incremental
 // moves to be added to the inc move queue.
-// Interpolation is based on position, velocity and time
-// Acceleration is modeled by a linear equation acc = accCoef1 + accCoef2 * time
+// The pulse positions are interpolated by forward differencing (see Interpolation.c)
 //-----------------------------------------------------------------------
 void Ros_MotionServer_JointTrajDataToIncQueue(Controller* controller, int groupNo)
 {
@@ -1378,12 +1574,9 @@ void Ros_MotionServer_JointTrajDataToIncQueue(Controller* controller, int groupN
 	JointMotionData* startTrajData;
 	JointMotionData* endTrajData;
 	JointMotionData* curTrajData;
-	float interval;						// Time between startTime and the new data time
-	float accCoef1[MP_GRP_AXES_NUM];    // Acceleration coefficient 1
-	float accCoef2[MP_GRP_AXES_NUM];    // Acceleration coefficient 2
+	InterpolationSegment segment;
 	int timeInc_ms;						// time increment in millisecond
 	int calculationTime_ms;				// time in ms at which the interpolation takes place
-	float interpolTime;      			// time increment in second
 	long newPulsePos[MP_GRP_AXES_NUM];
 	Incremental_data incData;
 
@@ -1405,65 +1598,39 @@ void Ros_MotionServer_JointTrajDataToIncQueue(Controller* controller, int groupN
 		endTrajData->vel[3] += -endTrajData->vel[1] + endTrajData->vel[2];
 	}
 
-	memset(newPulsePos, 0x00, sizeof(newPulsePos));
+	// Axes that are not interpolated keep their position
+	memcpy(newPulsePos, ctrlGroup->prevPulsePos, sizeof(newPulsePos));
 	memset(&incData, 0x00, sizeof(incData));
 	incData.frame = MP_INC_PULSE_DTYPE;
 	// also prevents ROS_MSG_MOTO_SELECT_TOOL from changing the active tool while processing
 	incData.tool = ctrlGroup->tool;
 	
-	// Calculate an acceleration coefficients
-	memset(&accCoef1, 0x00, sizeof(accCoef1));
-	memset(&accCoef2, 0x00, sizeof(accCoef2));
-	interval = (endTrajData->time - startTrajData->time) / 1000.0f;  // time difference in sec
-	if (interval > 0.0)
-	{
-		for (i = 0; i < ctrlGroup->numAxes; i++)
-		{	
-			//Calculate acceleration coefficient (convert interval to seconds
-			accCoef1[i] = ( 6 * (endTrajData->pos[i] - startTrajData->pos[i]) / (interval * interval) )
-						- ( 2 * (endTrajData->vel[i] + 2 * startTrajData->vel[i]) / interval);
-			accCoef2[i] = ( -12 * (endTrajData->pos[i] - startTrajData->pos[i]) / (interval * interval * interval))
-						+ ( 6 * (endTrajData->vel[i] + startTrajData->vel[i]) / (interval * interval) );
-		}
-	}
-	else
-	{
-		printf("Warning: Group %d - Time difference between endTrajData (%d) and startTrajData (%d) is 0 or less.\r\n", groupNo, endTrajData->time, startTrajData->time);
-	}
-	
 	// Initialize calculation variable before entering while loop
 	calculationTime_ms = startTrajData->time;
 	if(ctrlGroup->timeLeftover_ms == 0)
 		timeInc_ms = interpolPeriod;
 	else
 		timeInc_ms = ctrlGroup->timeLeftover_ms;
+
+	// Calculate the segment polynomial and its forward differences from the first interpolation cycle
+	if(!Ros_Interpolation_InitSegment(&segment, ctrlGroup, startTrajData, endTrajData, calculationTime_ms + timeInc_ms, interpolPeriod))
+	{
+		printf("Warning: Group %d - Time difference between endTrajData (%d) and startTrajData (%d) is 0 or less.\r\n", groupNo, endTrajData->time, startTrajData->time);
+	}
 		
 	// While interpolation time is smaller than new ROS point time
 	while( (curTrajData->time < endTrajData->time) && Ros_Controller_IsMotionReady(controller))
 	{
 		// Increment calculation time by next time increment
 		calculationTime_ms += timeInc_ms;
-		interpolTime = (calculationTime_ms - startTrajData->time) / 1000.0f;
 			
 		if( calculationTime_ms < endTrajData->time )  // Make calculation for full interpolation clock
 		{	   
 			// Set new interpolation time to calculation time
 			curTrajData->time = calculationTime_ms;
 				
-			// For each axis calculate the new position at the interpolation time
-			for (i = 0; i < ctrlGroup->numAxes; i++)
-			{
-				// Add position change for new interpolation time 
-				curTrajData->pos[i] = startTrajData->pos[i] 						// initial position component
-					+ startTrajData->vel[i] * interpolTime  						// initial velocity component
-					+ accCoef1[i] * interpolTime * interpolTime / 2 				// accCoef1 component
-					+ accCoef2[i] * interpolTime * interpolTime * interpolTime / 6;	// accCoef2 component
-	
-				// Add velocity change for new interpolation time
-				curTrajData->vel[i] = startTrajData->vel[i]   						// initial velocity component
-					+ accCoef1[i] * interpolTime 									// accCoef1 component
-					+ accCoef2[i] * interpolTime * interpolTime / 2;				// accCoef2 component
-			}
+			// Get the pulse position of all the axes at the interpolation time
+			Ros_Interpolation_NextPulsePos(&segment, newPulsePos);
 	
 			// Reset the timeInc_ms for the next interpolation cycle
 			if(timeInc_ms < interpolPeriod)
@@ -1482,10 +1649,10 @@ void Ros_MotionServer_JointTrajDataToIncQueue(Controller* controller, int groupN
 			{
 				ctrlGroup->timeLeftover_ms = calculationTime_ms - endTrajData->time;
 			} 
+
+			// Convert position in motoman pulse joint (exact end position of the segment)
+			Ros_CtrlGroup_ConvertToMotoPos(ctrlGroup, curTrajData->pos, newPulsePos);
 		}
-	
-		// Convert position in motoman pulse joint
-		Ros_CtrlGroup_ConvertToMotoPos(ctrlGroup, curTrajData->pos, newPulsePos);
 		
 		// Calculate the increment
 		incData.time = curTrajData->time;
@@ -1504,6 +1671,10 @@ void Ros_MotionServer_JointTrajDataToIncQueue(Controller* controller, int groupN
 		// Copy data to the previous pulse position for next iteration
 		memcpy(ctrlGroup->prevPulsePos, newPulsePos, sizeof(ctrlGroup->prevPulsePos));
 	}
+
+	// Interpolation was interrupted: update the position and velocity at the last interpolation time
+	if(curTrajData->time < endTrajData->time)
+		Ros_Interpolation_GetJointMotionData(&segment, ctrlGroup, curTrajData->time, curTrajData);
 }
 
 
@@ -1512,12 +1683,11 @@ void Ros_MotionServer_JointTrajDataToIncQueue(Controller* controller, int groupN
 //-------------------------------------------------------------------
 BOOL Ros_MotionServer_AddPulseIncPointToQ(Controller* controller, int groupNo, Incremental_data* dataToEnQ)
 {	
-	int index;
-	
 	// Set pointer to specified queue
 	Incremental_q* q = &controller->ctrlGroups[groupNo]->inc_q;
 
-	while( q->cnt >= Q_SIZE ) //queue is full
+	// Add the data at the end of the queue (fails if the queue is full)
+	while( !Ros_IncQueue_Push(q, dataToEnQ) )
 	{
 		//wait for items to be removed from the queue
 		Ros_Sleep(controller->interpolPeriod);
@@ -1529,59 +1699,133 @@ BOOL Ros_MotionServer_AddPulseIncPointToQ(Controller* controller, int groupNo, I
 		}
 	}
 	
+	return TRUE;
+}
+
+
+//-------------------------------------------------------------------
+// Adds a trajectory point at the end of the queue of points to interpolate
+// Return: FALSE if the queue is full or locked up
+//-------------------------------------------------------------------
+BOOL Ros_MotionServer_AddTrajPointToQ(CtrlGroup* ctrlGroup, JointMotionData* jointData)
+{
+	TrajPoint_q* q = &ctrlGroup->trajPt_q;
+	BOOL bRet = FALSE;
+
 	// Lock the q before manipulating it
-	if(mpSemTake(q->q_lock, Q_LOCK_TIMEOUT) == OK)
+	if(mpSemTake(q->q_lock, TRAJ_PT_Q_LOCK_TIMEOUT) != OK)
+	{
+		printf("ERROR: Unable to add point to trajectory queue.  Queue is locked up!\r\n");
+		return FALSE;
+	}
+
+	if(q->cnt < q->size)
 	{
-		// Get the index of the end of the queue
-		index = Q_OFFSET_IDX( q->idx, q->cnt , Q_SIZE );
 		// Copy data at the end of the queue
-		q->data[index] = *dataToEnQ;
-		// increase the count of elements in the queue
+		memcpy(&q->data[(q->idx + q->cnt) % q->size], jointData, sizeof(JointMotionData));
 		q->cnt++;
-		
-		// Unlock the q
-		mpSemGive(q->q_lock);
+		q->lastTime = jointData->time;
+		ctrlGroup->hasDataToProcess = TRUE;
+		ctrlGroup->bHoldTrajPointQ = FALSE;	// a new point cancels a pending truncate
+		bRet = TRUE;
 	}
-	else
+
+	// Unlock the q
+	mpSemGive(q->q_lock);
+
+	return bRet;
+}
+
+
+//-------------------------------------------------------------------
+// Moves the next trajectory point of the queue to jointMotionDataToProcess.
+// Marks the data as processed when the queue is empty.  Held points are
+// left in the queue (see Ros_MotionServer_TruncateQ_All).
+// Return: TRUE if there is a point to interpolate
+//-------------------------------------------------------------------
+BOOL Ros_MotionServer_GetNextTrajPoint(CtrlGroup* ctrlGroup)
+{
+	TrajPoint_q* q = &ctrlGroup->trajPt_q;
+	BOOL bRet = FALSE;
+
+	// Lock the q before manipulating it
+	if(mpSemTake(q->q_lock, TRAJ_PT_Q_LOCK_TIMEOUT) != OK)
 	{
-		printf("ERROR: Unable to add point to queue.  Queue is locked up!\r\n");
+		printf("ERROR: Can't get data from trajectory queue. Queue is locked up.\r\n");
 		return FALSE;
 	}
-	
-	return TRUE;
+
+	if(q->cnt > 0 && !ctrlGroup->bHoldTrajPointQ)
+	{
+		memcpy(&ctrlGroup->jointMotionDataToProcess, &q->data[q->idx], sizeof(JointMotionData));
+		q->idx = (q->idx + 1) % q->size;
+		q->cnt--;
+		bRet = TRUE;
+	}
+	else if(q->cnt == 0)
+		ctrlGroup->hasDataToProcess = FALSE;
+	ctrlGroup->bProcessingTrajPoint = bRet;
+
+	// Unlock the q
+	mpSemGive(q->q_lock);
+
+	return bRet;
 }
 
 
 //-------------------------------------------------------------------
-// Clears the inc move queue
+// Check that there is no room for another point in the trajectory queue
 //-------------------------------------------------------------------
-BOOL Ros_MotionServer_ClearQ(Controller* controller, int groupNo)
+BOOL Ros_MotionServer_IsTrajPointQFull(CtrlGroup* ctrlGroup)
 {
-	Incremental_q* q;
-
-	// Check group number valid
-	if(!Ros_Controller_IsValidGroupNo(controller, groupNo))
-		return FALSE;
+	// Only the message task adds points, so the queue can't fill up after this check
+	return (ctrlGroup->trajPt_q.cnt >= ctrlGroup->trajPt_q.size);
+}
 
-	// Stop addtional items from being added to the queue
-	controller->ctrlGroups[groupNo]->hasDataToProcess = FALSE;
 
-	// Set pointer to specified queue
-	q = &controller->ctrlGroups[groupNo]->inc_q;
+//-------------------------------------------------------------------
+// Drops the trajectory points that are not interpolated yet.  The point
+// being interpolated, if any, is still processed.
+//-------------------------------------------------------------------
+void Ros_MotionServer_ClearTrajPointQ(CtrlGroup* ctrlGroup)
+{
+	TrajPoint_q* q = &ctrlGroup->trajPt_q;
 
 	// Lock the q before manipulating it
-	if(mpSemTake(q->q_lock, Q_LOCK_TIMEOUT) == OK)
+	if(mpSemTake(q->q_lock, TRAJ_PT_Q_LOCK_TIMEOUT) == OK)
 	{
 		// Reset the queue.  No need to modify index or delete data
 		q->cnt = 0;
-		
+		ctrlGroup->bHoldTrajPointQ = FALSE;
+
 		// Unlock the q
 		mpSemGive(q->q_lock);
-		
-		return TRUE;
 	}
+	else
+		printf("ERROR: Unable to clear trajectory queue.  Queue is locked up!\r\n");
+}
 
-	return FALSE;
+
+//-------------------------------------------------------------------
+// Clears the inc move queue
+//-------------------------------------------------------------------
+BOOL Ros_MotionServer_ClearQ(Controller* controller, int groupNo)
+{
+	// Check group number valid
+	if(!Ros_Controller_IsValidGroupNo(controller, groupNo))
+		return FALSE;
+
+	// Stop addtional items from being added to the queue
+	Ros_MotionServer_ClearTrajPointQ(controller->ctrlGroups[groupNo]);
+	controller->ctrlGroups[groupNo]->hasDataToProcess = FALSE;
+
+	// Reset the queue.  No need to delete data
+	Ros_IncQueue_Clear(&controller->ctrlGroups[groupNo]->inc_q);
+
+	// The next trajectory must start again from its first point
+	controller->ctrlGroups[groupNo]->lastSequence = -1;
+
+	return TRUE;
 }
 
 
@@ -1604,34 +1848,289 @@ BOOL Ros_MotionServer_ClearQ_All(Controller* controller)
 }
 
 
+//-------------------------------------------------------------------
+// Drops the queued motion of all groups past the splice time, so that
+// a new trajectory can be spliced in without stopping.
+// Return: ROS_RESULT_SUCCESS; ROS_RESULT_BUSY if a point is still being
+// interpolated; ROS_RESULT_FAILURE
+//-------------------------------------------------------------------
+int Ros_MotionServer_TruncateQ_All(Controller* controller, int leadTime_ms)
+{
+	int groupNo;
+	CtrlGroup* ctrlGroup;
+	BOOL bBusy = FALSE;
+	BOOL bRet = TRUE;
+
+	// The points not interpolated yet would all add increments past the queued ones:
+	// hold them, so that they are only dropped once the truncate can complete.  A BUSY
+	// reply leaves them in the queue (they are processed again if no truncate follows,
+	// see Ros_MotionServer_AddTrajPointToQ and Ros_MotionServer_ClearTrajPointQ).
+	for(groupNo=0; groupNo<controller->numGroup; groupNo++)
+	{
+		ctrlGroup = controller->ctrlGroups[groupNo];
+		if(mpSemTake(ctrlGroup->trajPt_q.q_lock, TRAJ_PT_Q_LOCK_TIMEOUT) != OK)
+		{
+			printf("ERROR: Unable to hold trajectory queue.  Queue is locked up!\r\n");
+			return ROS_RESULT_FAILURE;
+		}
+		ctrlGroup->bHoldTrajPointQ = TRUE;
+		bBusy |= ctrlGroup->bProcessingTrajPoint;
+		mpSemGive(ctrlGroup->trajPt_q.q_lock);
+	}
+
+	// The point being interpolated would add increments past the splice time
+	if(bBusy)
+		return ROS_RESULT_BUSY;
+
+	for(groupNo=0; groupNo<controller->numGroup; groupNo++)
+		Ros_MotionServer_ClearTrajPointQ(controller->ctrlGroups[groupNo]);
+
+	for(groupNo=0; groupNo<controller->numGroup; groupNo++)
+	{
+		bRet &= Ros_MotionServer_TruncateQ(controller, groupNo, leadTime_ms);
+		controller->ctrlGroups[groupNo]->trajPt_q.lastTime = controller->ctrlGroups[groupNo]->jointMotionData.time;
+	}
+
+	return bRet ? ROS_RESULT_SUCCESS : ROS_RESULT_FAILURE;
+}
+
+
+//-------------------------------------------------------------------
+// Drops the increments queued more than leadTime_ms after the increment
+// currently being executed.  The state at the end of the remaining
+// increments becomes the start of the interpolation of the next point.
+//-------------------------------------------------------------------
+BOOL Ros_MotionServer_TruncateQ(Controller* controller, int groupNo, int leadTime_ms)
+{
+	CtrlGroup* ctrlGroup = controller->ctrlGroups[groupNo];
+	Incremental_q* q = &ctrlGroup->inc_q;
+	Incremental_data incData;
+	long spliceTime;
+	long prevTime;
+	long lastTime;
+	long nextTime = 0;
+	long lastInc[MP_GRP_AXES_NUM];
+	long endPulsePos[MAX_PULSE_AXES];
+	long prevPulsePos[MAX_PULSE_AXES];
+	float prevPos[MAX_PULSE_AXES];
+	UINT32 startPos, endPos, keepPos, pos;
+	int keepCnt;
+	int i, axis;
+
+	memset(lastInc, 0x00, sizeof(lastInc));
+	memset(prevPulsePos, 0x00, sizeof(prevPulsePos));
+	memset(prevPos, 0x00, sizeof(prevPos));
+
+	// The producer is idle (see Ros_MotionServer_TruncateQ_All): only the
+	// IP_CLK task removes increments from the queue while it is scanned
+	startPos = q->readCnt;
+	endPos = q->writeCnt;
+
+	spliceTime = ctrlGroup->q_time + leadTime_ms;
+	prevTime = lastTime = ctrlGroup->q_time;
+
+	// Keep the increments up to the splice time
+	for(keepPos = startPos; keepPos != endPos; keepPos++)
+	{
+		Ros_IncQueue_PeekAt(q, keepPos, &incData);
+		if(incData.time > spliceTime)
+		{
+			nextTime = incData.time;
+			break;
+		}
+
+		prevTime = lastTime;
+		lastTime = incData.time;
+		memcpy(lastInc, incData.inc, sizeof(lastInc));
+	}
+	keepCnt = (int)(keepPos - startPos);
+
+	if(keepPos == endPos)
+	{
+		// Nothing queued past the splice time, the motion already ends there
+		return TRUE;
+	}
+
+	// Rewind the pulse position to the end of the kept increments
+	memcpy(endPulsePos, ctrlGroup->prevPulsePos, sizeof(endPulsePos));
+	for(pos = keepPos; pos != endPos; pos++)
+	{
+		Ros_IncQueue_PeekAt(q, pos, &incData);
+		for(axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+			endPulsePos[axis] -= incData.inc[axis];
+	}
+
+	// Drop the increments past the splice time
+	if(!Ros_IncQueue_Truncate(q, keepPos))
+	{
+		printf("ERROR: Unable to truncate queue.  Motion already past the splice time!\r\n");
+		return FALSE;
+	}
+	memcpy(ctrlGroup->prevPulsePos, endPulsePos, sizeof(ctrlGroup->prevPulsePos));
+
+	// A partial interpolation period was kept if the first dropped increment completes it
+	if(keepCnt > 0 && (nextTime - lastTime < controller->interpolPeriod))
+		ctrlGroup->timeLeftover_ms = nextTime - lastTime;
+	else
+		ctrlGroup->timeLeftover_ms = 0;
+
+	ctrlGroup->jointMotionData.time = lastTime;
+
+	// Rebuild the start state of the next interpolation from the pulse position
+	// and the last kept increment
+	for(axis = 0; axis < MAX_PULSE_AXES; axis++)
+		prevPulsePos[axis] = ctrlGroup->prevPulsePos[axis] - lastInc[axis];
+	Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, ctrlGroup->prevPulsePos, ctrlGroup->jointMotionData.pos);
+	Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, prevPulsePos, prevPos);
+	for(i = 0; i < MP_GRP_AXES_NUM; i++)
+	{
+		if(keepCnt > 0 && ctrlGroup->jointMotionData.time > prevTime)
+			ctrlGroup->jointMotionData.vel[i] = (ctrlGroup->jointMotionData.pos[i] - prevPos[i]) * 1000.0f
+				/ (ctrlGroup->jointMotionData.time - prevTime);
+		else
+			ctrlGroup->jointMotionData.vel[i] = 0.0f;
+		ctrlGroup->jointMotionData.acc[i] = 0.0f;
+	}
+
+	return TRUE;
+}
+
+
 //-------------------------------------------------------------------
 // Check the number of inc_move currently in the specified queue
 //-------------------------------------------------------------------
 int Ros_MotionServer_GetQueueCnt(Controller* controller, int groupNo)
 {
-	Incremental_q* q;
-	int count;
-	
 	// Check group number valid
 	if(!Ros_Controller_IsValidGroupNo(controller, groupNo))
 		return -1;
 
-	// Set pointer to specified queue
-	q = &controller->ctrlGroups[groupNo]->inc_q;
-	
-	// Lock the q before manipulating it
-	if(mpSemTake(q->q_lock, Q_LOCK_TIMEOUT) == OK)
-	{			
-		count = q->cnt;
-			
-		// Unlock the q
-		mpSemGive(q->q_lock);
-		
-		return count;
+	return Ros_IncQueue_GetCnt(&controller->ctrlGroups[groupNo]->inc_q);
+}
+
+
+//-------------------------------------------------------------------
+// Reports how much motion is buffered for the specified group, in seconds:
+// data[0]: total, data[1]: in the inc move queue, data[2]: capacity of
+// the inc move queue, data[3]: in the trajectory point queue (including
+// the point being interpolated), data[4]: number of queued points,
+// data[5]: depth of the trajectory point queue
+//-------------------------------------------------------------------
+void Ros_MotionServer_GetQueueFill(Controller* controller, int groupNo, SmBodyMotoMotionReply* motionReply)
+{
+	CtrlGroup* ctrlGroup = controller->ctrlGroups[groupNo];
+	int incTime_ms = 0;
+	int trajPtTime_ms = 0;
+	int interpolatedTime;
+
+	// Time up to which the points were interpolated
+	interpolatedTime = ctrlGroup->jointMotionData.time;
+
+	if(Ros_IncQueue_GetCnt(&ctrlGroup->inc_q) > 0)
+		incTime_ms = max(interpolatedTime - (int)ctrlGroup->q_time, 0);
+	if(ctrlGroup->hasDataToProcess)
+		trajPtTime_ms = max(ctrlGroup->trajPt_q.lastTime - interpolatedTime, 0);
+
+	motionReply->data[0] = (incTime_ms + trajPtTime_ms) / 1000.0f;
+	motionReply->data[1] = incTime_ms / 1000.0f;
+	motionReply->data[2] = ctrlGroup->inc_q.size * controller->interpolPeriod / 1000.0f;
+	motionReply->data[3] = trajPtTime_ms / 1000.0f;
+	motionReply->data[4] = ctrlGroup->trajPt_q.cnt;
+	motionReply->data[5] = ctrlGroup->trajPt_q.size;
+}
+
+
+//-------------------------------------------------------------------
+// Reports the joint positions (or velocities) at the end of the queued
+// motion of the specified group, in ROS joint order.  After a truncate,
+// a new trajectory must continue from this state.
+//-------------------------------------------------------------------
+void Ros_MotionServer_GetQueueEndState(Controller* controller, int groupNo, BOOL bVelocity, SmBodyMotoMotionReply* motionReply)
+{
+	CtrlGroup* ctrlGroup = controller->ctrlGroups[groupNo];
+	float* endState;
+	int i;
+
+	endState = bVelocity ? ctrlGroup->jointMotionData.vel : ctrlGroup->jointMotionData.pos;
+	for(i = 0; i < MP_GRP_AXES_NUM; i++)
+		motionReply->data[i] = endState[i];
+
+	// For MPL80/100 robot type (SLUBT): report the B-axis the way ROS commands it
+	if (ctrlGroup->bIsBaxisSlave)
+		motionReply->data[3] -= -motionReply->data[1] + motionReply->data[2];
+}
+
+
+//-------------------------------------------------------------------
+// Changes the depth of the inc move queue and of the trajectory point
+// queue of all the groups.  A size of 0 keeps the current depth.  The
+// inc move queue depth is rounded up to a power of 2.
+// Return: ROS_RESULT_SUCCESS; ROS_RESULT_BUSY if motion is queued;
+// ROS_RESULT_INVALID; ROS_RESULT_FAILURE
+//-------------------------------------------------------------------
+int Ros_MotionServer_SetQueueSize(Controller* controller, int incQSize, int trajPtQSize)
+{
+	int groupNo;
+	int size;
+	CtrlGroup* ctrlGroup;
+	JointMotionData* newData;
+	BOOL bRet = TRUE;
+
+	if((incQSize < 0) || (incQSize > Q_SIZE_MAX) || (trajPtQSize < 0) || (trajPtQSize > TRAJ_PT_Q_SIZE_MAX))
+	{
+		printf("ERROR: Invalid queue size (%d increments, %d points)\r\n", incQSize, trajPtQSize);
+		return ROS_RESULT_INVALID;
 	}
-		
-	printf("ERROR: Unable to access queue count.  Queue is locked up!\r\n");
-	return ERROR;
+
+	// The queues can only be replaced while they are empty.  Points are only
+	// added by the message task that is processing this command.
+	for(groupNo=0; groupNo<controller->numGroup; groupNo++)
+	{
+		if(controller->ctrlGroups[groupNo]->hasDataToProcess || (Ros_MotionServer_GetQueueCnt(controller, groupNo) != 0))
+			return ROS_RESULT_BUSY;
+	}
+
+	for(groupNo=0; groupNo<controller->numGroup; groupNo++)
+	{
+		ctrlGroup = controller->ctrlGroups[groupNo];
+
+		if(incQSize > 0)
+		{
+			for(size = 1; size < incQSize; size <<= 1)
+				;
+			bRet &= Ros_IncQueue_Resize(&ctrlGroup->inc_q, size);
+		}
+
+		if((trajPtQSize > 0) && (trajPtQSize != ctrlGroup->trajPt_q.size))
+		{
+			newData = (JointMotionData*)mpMalloc(trajPtQSize * sizeof(JointMotionData));
+			if(newData == NULL)
+			{
+				printf("ERROR: Unable to allocate the trajectory queue (%d points)\r\n", trajPtQSize);
+				bRet = FALSE;
+			}
+			else if(mpSemTake(ctrlGroup->trajPt_q.q_lock, TRAJ_PT_Q_LOCK_TIMEOUT) == OK)
+			{
+				mpFree(ctrlGroup->trajPt_q.data);
+				ctrlGroup->trajPt_q.data = newData;
+				ctrlGroup->trajPt_q.size = trajPtQSize;
+				ctrlGroup->trajPt_q.cnt = 0;
+				ctrlGroup->trajPt_q.idx = 0;
+				mpSemGive(ctrlGroup->trajPt_q.q_lock);
+			}
+			else
+			{
+				printf("ERROR: Unable to resize trajectory queue.  Queue is locked up!\r\n");
+				mpFree(newData);
+				bRet = FALSE;
+			}
+		}
+
+		printf("Group %d: queue depth %d increments (%d ms), %d points\r\n", groupNo,
+			(int)ctrlGroup->inc_q.size, (int)ctrlGroup->inc_q.size * controller->interpolPeriod, ctrlGroup->trajPt_q.size);
+	}
+
+	return bRet ? ROS_RESULT_SUCCESS : ROS_RESULT_FAILURE;
 }
 
 
@@ -1670,6 +2169,7 @@ void Ros_MotionServer_IncMoveLoopStart(Controller* controller) //<-- IP_CLK prio
 #endif
 
 	Incremental_q* q;
+	Incremental_data incData;
 	int i;
 	int ret;
 	LONG time;
@@ -1750,87 +2250,71 @@ void Ros_MotionServer_IncMoveLoopStart(Controller* controller) //<-- IP_CLK prio
 				}
 				else
 				{
-					// Retrieve position increment from the queue.
+					// Retrieve position increment from the queue (never blocks).
 					q = &controller->ctrlGroups[i]->inc_q;
 
-					// Lock the q before manipulating it
-					if (mpSemTake(q->q_lock, Q_LOCK_TIMEOUT) == OK)
+					if (Ros_IncQueue_Pop(q, &incData))
 					{
-						if (q->cnt > 0)
-						{
-							// Initialize moveData with the next data from the queue
-							time = q->data[q->idx].time;
-							q_time = controller->ctrlGroups[i]->q_time;
-							moveData.grp_pos_info[i].pos_tag.data[2] = q->data[q->idx].tool;
-							moveData.grp_pos_info[i].pos_tag.data[3] = q->data[q->idx].frame;
-							moveData.grp_pos_info[i].pos_tag.data[4] = q->data[q->idx].user;
-
-							memcpy(&moveData.grp_pos_info[i].pos, &q->data[q->idx].inc, sizeof(LONG) * MP_GRP_AXES_NUM);
-							queueRead[i] = TRUE;
+						// Initialize moveData with the next data from the queue
+						time = incData.time;
+						q_time = controller->ctrlGroups[i]->q_time;
+						moveData.grp_pos_info[i].pos_tag.data[2] = incData.tool;
+						moveData.grp_pos_info[i].pos_tag.data[3] = incData.frame;
+						moveData.grp_pos_info[i].pos_tag.data[4] = incData.user;
+
+						memcpy(&moveData.grp_pos_info[i].pos, &incData.inc, sizeof(LONG) * MP_GRP_AXES_NUM);
+						queueRead[i] = TRUE;
 #ifdef DEBUG
-							Debug_BroadcastMsg("New Inc from Buffer: %d, %d, %d, %d, %d, %d\r\n", 
-								moveData.grp_pos_info[i].pos[0], moveData.grp_pos_info[i].pos[1], moveData.grp_pos_info[i].pos[2],
-								moveData.grp_pos_info[i].pos[3], moveData.grp_pos_info[i].pos[4], moveData.grp_pos_info[i].pos[5]);
+						Debug_BroadcastMsg("New Inc from Buffer: %d, %d, %d, %d, %d, %d\r\n", 
+							moveData.grp_pos_info[i].pos[0], moveData.grp_pos_info[i].pos[1], moveData.grp_pos_info[i].pos[2],
+							moveData.grp_pos_info[i].pos[3], moveData.grp_pos_info[i].pos[4], moveData.grp_pos_info[i].pos[5]);
 #endif
-							// increment index in the queue and decrease the count
-							q->idx = Q_OFFSET_IDX(q->idx, 1, Q_SIZE);
-							q->cnt--;
-
-							// Check if complet interpolation period covered.
-							// (Because time period of data received from ROS may not be a multiple of the 
-							// controller interpolation clock period, the queue may contain partiel period and 
-							// more than one queue increment maybe required to complete the interpolation period)
-							while (q->cnt > 0)
+
+						// Check if complet interpolation period covered.
+						// (Because time period of data received from ROS may not be a multiple of the 
+						// controller interpolation clock period, the queue may contain partiel period and 
+						// more than one queue increment maybe required to complete the interpolation period)
+						while (Ros_IncQueue_Peek(q, &incData))
+						{
+							if ((q_time <= incData.time)
+								&& (incData.time - q_time <= controller->interpolPeriod))
 							{
-								if ((q_time <= q->data[q->idx].time)
-									&& (q->data[q->idx].time - q_time <= controller->interpolPeriod))
-								{
-									// next incMove is part of same interpolation period
-
-									// check that information is in the same format
-									if ((moveData.grp_pos_info[i].pos_tag.data[2] != q->data[q->idx].tool)
-										|| (moveData.grp_pos_info[i].pos_tag.data[3] != q->data[q->idx].frame)
-										|| (moveData.grp_pos_info[i].pos_tag.data[4] != q->data[q->idx].user))
-									{
-										// Different format can't combine information
-										break;
-									}
-
-									// add next incMove to current incMove
-									for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
-										moveData.grp_pos_info[i].pos[axis] += q->data[q->idx].inc[axis];
-									time = q->data[q->idx].time;
-
-									// increment index in the queue and decrease the count
-									q->idx = Q_OFFSET_IDX(q->idx, 1, Q_SIZE);
-									q->cnt--;
-								}
-								else
+								// next incMove is part of same interpolation period
+
+								// check that information is in the same format
+								if ((moveData.grp_pos_info[i].pos_tag.data[2] != incData.tool)
+									|| (moveData.grp_pos_info[i].pos_tag.data[3] != incData.frame)
+									|| (moveData.grp_pos_info[i].pos_tag.data[4] != incData.user))
 								{
-									// interpolation period complet
+									// Different format can't combine information
 									break;
 								}
-							}
 
-							controller->ctrlGroups[i]->q_time = time;
-						}
-						else
-						{
-							// Queue is empty, initialize to 0 pulse increment
-							moveData.grp_pos_info[i].pos_tag.data[2] = 0;
-							moveData.grp_pos_info[i].pos_tag.data[3] = MP_INC_PULSE_DTYPE;
-							moveData.grp_pos_info[i].pos_tag.data[4] = 0;
-							memset(&moveData.grp_pos_info[i].pos, 0x00, sizeof(LONG) * MP_GRP_AXES_NUM);
+								// remove it from the queue (unless it was just cleared or truncated)
+								if (!Ros_IncQueue_Pop(q, &incData))
+									break;
+
+								// add next incMove to current incMove
+								for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+									moveData.grp_pos_info[i].pos[axis] += incData.inc[axis];
+								time = incData.time;
+							}
+							else
+							{
+								// interpolation period complet
+								break;
+							}
 						}
 
-						// Unlock the q					
-						mpSemGive(q->q_lock);
+						controller->ctrlGroups[i]->q_time = time;
 					}
 					else
 					{
-						printf("ERROR: Can't get data from queue. Queue is locked up.\r\n");
+						// Queue is empty, initialize to 0 pulse increment
+						moveData.grp_pos_info[i].pos_tag.data[2] = 0;
+						moveData.grp_pos_info[i].pos_tag.data[3] = MP_INC_PULSE_DTYPE;
+						moveData.grp_pos_info[i].pos_tag.data[4] = 0;
 						memset(&moveData.grp_pos_info[i].pos, 0x00, sizeof(LONG) * MP_GRP_AXES_NUM);
-						continue;
 					}
 				}
 			}
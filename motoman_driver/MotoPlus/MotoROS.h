@@ -37,6 +37,8 @@
 #include "MotoPlus.h"
 #include "ParameterExtraction.h"
 #include "CtrlGroup.h"
+#include "IncQueue.h"
+#include "Interpolation.h"
 #include "SimpleMessage.h"
 #include "Controller.h"
 #include "IoServer.h"
@@ -47,13 +47,15 @@
 
 // Creates a simple message of type: ROS_MSG_JOINT_FEEDBACK = 15
 // Simple message containing a the current joint position
-// of the specified control group
-int Ros_SimpleMsg_JointFeedback(CtrlGroup* ctrlGroup, SimpleMsg* sendMsg)
+// of the specified control group, from its captured feedback
+int Ros_SimpleMsg_JointFeedback(CtrlGroup* ctrlGroup, CtrlGroupFeedback* feedback, SimpleMsg* sendMsg)
 {
-	int bRet;
-	long pulsePos[MAX_PULSE_AXES];
-	long pulseSpeed[MAX_PULSE_AXES];
-	
+	int rosAxis[MAX_PULSE_AXES];
+	int pulseAxis[MAX_PULSE_AXES];
+	float conversion[MAX_PULSE_AXES];
+	int numAxes;
+	int i;
+
 	//initialize memory
 	memset(sendMsg, 0x00, sizeof(SimpleMsg));
 	
@@ -70,18 +72,25 @@ int Ros_SimpleMsg_JointFeedback(CtrlGroup* ctrlGroup, SimpleMsg* sendMsg)
 	sendMsg->body.jointFeedback.validFields = Valid_Position;
 	
 	//feedback position
-	bRet = Ros_CtrlGroup_GetFBPulsePos(ctrlGroup, pulsePos);
-	if(bRet!=TRUE)
+	if(feedback->bPosValid!=TRUE)
 		return 0;				
-	Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, pulsePos, sendMsg->body.jointFeedback.pos);
+	Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, feedback->pulsePos, sendMsg->body.jointFeedback.pos);
 
 	//servo speed
-	bRet = Ros_CtrlGroup_GetFBServoSpeed(ctrlGroup, pulseSpeed);
-	if (bRet == TRUE)
+	if (feedback->bSpeedValid == TRUE)
 	{
-		Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, pulseSpeed, sendMsg->body.jointFeedback.vel);
+		Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, feedback->pulseSpeed, sendMsg->body.jointFeedback.vel);
 		sendMsg->body.jointFeedback.validFields |= Valid_Velocity;
 	}
+
+	//servo torque: in the acceleration field, in the same joint order as the position
+	if (feedback->bTorqueValid == TRUE)
+	{
+		numAxes = Ros_CtrlGroup_GetPulseAxisMap(ctrlGroup, rosAxis, pulseAxis, conversion);
+		for (i = 0; i < numAxes; i++)
+			sendMsg->body.jointFeedback.acc[rosAxis[i]] = (float)feedback->torque[pulseAxis[i]];
+		sendMsg->body.jointFeedback.validFields |= Valid_Effort;
+	}
 	
 	return(sendMsg->prefix.length + sizeof(SmPrefix));
 }
@@ -150,6 +159,11 @@ int Ros_SimpleMsg_MotionReply(SimpleMsg* receiveMsg, int result, int subcode, Si
 		replyMsg->body.motionReply.sequence = receiveMsg->body.jointTrajDataEx.sequence;
 		replyMsg->body.motionReply.command = ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_EX;
 	}
+	else if (receiveMsg->header.msgType == ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH)
+	{
+		replyMsg->body.motionReply.sequence = receiveMsg->body.jointTrajDataBatch.sequence;
+		replyMsg->body.motionReply.command = ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH;
+	}
 	else if (receiveMsg->header.msgType == ROS_MSG_MOTO_SELECT_TOOL)
 	{
 		replyMsg->body.motionReply.sequence = receiveMsg->body.selectTool.sequence;
@@ -77,7 +77,18 @@ typedef enum
 	ROS_MSG_MOTO_JOINT_FEEDBACK_EX = 2017,
 	ROS_MSG_MOTO_SELECT_TOOL = 2018,
 
-	ROS_MSG_MOTO_GET_DH_PARAMETERS = 2020
+	ROS_MSG_MOTO_GET_DH_PARAMETERS = 2020,
+
+	ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH = 2021,
+
+	ROS_MSG_MOTO_READ_IO_MULTI = 2022,
+	ROS_MSG_MOTO_READ_IO_MULTI_REPLY = 2023,
+	ROS_MSG_MOTO_WRITE_IO_MULTI = 2024,
+	ROS_MSG_MOTO_WRITE_IO_MULTI_REPLY = 2025,
+
+	ROS_MSG_MOTO_IO_SUBSCRIBE = 2026,
+	ROS_MSG_MOTO_IO_SUBSCRIBE_REPLY = 2027,
+	ROS_MSG_MOTO_IO_CHANGED = 2028
 } SmMsgType;
 
 
@@ -101,11 +112,14 @@ typedef enum
 typedef enum
 {
 	ROS_CMD_CHECK_MOTION_READY = 200101,
-	ROS_CMD_CHECK_QUEUE_CNT = 200102,
+	ROS_CMD_CHECK_QUEUE_CNT = 200102, // also reports the motion buffered (see Ros_MotionServer_GetQueueFill)
+	ROS_CMD_SET_QUEUE_SIZE = 200103, // sets the depth of the queues: data[0] increments, data[1] trajectory points
+	ROS_CMD_GET_QUEUE_END_STATE = 200104, // reports the state at the end of the queued motion: data[0] 0 positions, 1 velocities
 	ROS_CMD_STOP_MOTION = 200111,
 	ROS_CMD_START_SERVOS = 200112, // starts the servo motors
 	ROS_CMD_STOP_SERVOS = 200113, // stops the servo motors and motion
 	ROS_CMD_RESET_ALARM = 200114, // clears the error in the current controller
+	ROS_CMD_TRUNCATE_TRAJ = 200115, // drops queued motion past data[0] seconds ahead of the executing increment
 	ROS_CMD_START_TRAJ_MODE = 200121,
 	ROS_CMD_STOP_TRAJ_MODE = 200122,
 	ROS_CMD_DISCONNECT = 200130
@@ -177,8 +191,12 @@ typedef enum
 	Valid_Time = 1,
 	Valid_Position = 2,
 	Valid_Velocity = 4,
-	Valid_Acceleration = 8
+	Valid_Acceleration = 8,
+	Valid_Effort = 16		// JOINT_FEEDBACK only: acc holds the joint efforts (never sent with Valid_Acceleration)
 } FlagsValidFields;
+// NOTE: Valid_Effort is a MotoROS extension of the simple message protocol, only sent with
+// STATE_STREAM_EFFORT enabled (off by default). A client that does not know the flag must not
+// read acc as accelerations when it is set.
 
 //--------------
 // Body Section
@@ -215,7 +233,7 @@ struct _SmBodyJointFeedback		// ROS_MSG_JOINT_FEEDBACK = 15
 	float time;					// Timestamp associated with this trajectory point; Units: in seconds 
 	float pos[ROS_MAX_JOINT];	// Feedback joint positions in radian.  Base to Tool joint order  
 	float vel[ROS_MAX_JOINT];	// Feedback joint velocities in radian/sec.  
-	float acc[ROS_MAX_JOINT];	// Feedback joint accelerations in radian/sec^2.
+	float acc[ROS_MAX_JOINT];	// Feedback joint accelerations in radian/sec^2, or joint efforts in Nm (N for linear axes) with Valid_Effort.
 } __attribute__((__packed__));
 typedef struct _SmBodyJointFeedback SmBodyJointFeedback;
 
@@ -260,6 +278,17 @@ struct _SmBodyJointTrajPtFullEx
 } __attribute__((__packed__));
 typedef struct _SmBodyJointTrajPtFullEx SmBodyJointTrajPtFullEx;
 
+#define ROS_MAX_BATCH_DATA	16	// max number of group data (points x groups) in a batch
+
+struct _SmBodyJointTrajPtFullBatch	// ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH = 2021
+{
+	int numberOfPoints;			// Number of consecutive trajectory points in this message
+	int numberOfValidGroups;	// Number of groups in each point
+	int sequence;				// Sequence of the first point; the following points are numbered consecutively
+	SmBodyJointTrajPtExData	jointTrajPtData[ROS_MAX_BATCH_DATA];	// numberOfValidGroups data for each point, point after point
+} __attribute__((__packed__));
+typedef struct _SmBodyJointTrajPtFullBatch SmBodyJointTrajPtFullBatch;
+
 
 struct _SmBodyJointFeedbackEx
 {
@@ -375,6 +404,85 @@ struct _SmBodyMotoWriteIOMRegisterReply
 } __attribute__((__packed__));
 typedef struct _SmBodyMotoWriteIOMRegisterReply SmBodyMotoWriteIOMRegisterReply;
 
+#define ROS_MAX_IO_MULTI	64	// max number of I/O elements in a READ_IO_MULTI or WRITE_IO_MULTI message
+
+typedef enum
+{
+	IO_MULTI_BIT = 0,			// single I/O signal, addressed as by READ_IO_BIT
+	IO_MULTI_GROUP = 1,			// 8 I/O signals, addressed as by READ_IO_GROUP
+	IO_MULTI_MREGISTER = 2		// M register, addressed as by READ_MREGISTER
+} IoMultiSize;
+
+struct _SmIoMultiReadElement
+{
+	UINT32 ioAddress;
+	IoMultiSize size;
+} __attribute__((__packed__));
+typedef struct _SmIoMultiReadElement SmIoMultiReadElement;
+
+struct _SmBodyMotoReadIOMulti	// ROS_MSG_MOTO_READ_IO_MULTI = 2022
+{
+	int numberOfElements;		// Number of elements to read; only these are sent
+	SmIoMultiReadElement elements[ROS_MAX_IO_MULTI];
+} __attribute__((__packed__));
+typedef struct _SmBodyMotoReadIOMulti SmBodyMotoReadIOMulti;
+
+struct _SmIoMultiReadValue
+{
+	UINT32 value;
+	IoResultCodes resultCode;
+} __attribute__((__packed__));
+typedef struct _SmIoMultiReadValue SmIoMultiReadValue;
+
+struct _SmBodyMotoReadIOMultiReply	// ROS_MSG_MOTO_READ_IO_MULTI_REPLY = 2023
+{
+	int numberOfElements;		// Number of elements read, in the order of the request; only these are sent
+	IoResultCodes resultCode;	// IO_RESULT_OK if all elements were read, else the result of the first failed element
+	SmIoMultiReadValue values[ROS_MAX_IO_MULTI];
+} __attribute__((__packed__));
+typedef struct _SmBodyMotoReadIOMultiReply SmBodyMotoReadIOMultiReply;
+
+struct _SmIoMultiWriteElement
+{
+	UINT32 ioAddress;
+	IoMultiSize size;
+	UINT32 value;
+} __attribute__((__packed__));
+typedef struct _SmIoMultiWriteElement SmIoMultiWriteElement;
+
+struct _SmBodyMotoWriteIOMulti	// ROS_MSG_MOTO_WRITE_IO_MULTI = 2024
+{
+	int numberOfElements;		// Number of elements to write; only these are sent
+	SmIoMultiWriteElement elements[ROS_MAX_IO_MULTI];
+} __attribute__((__packed__));
+typedef struct _SmBodyMotoWriteIOMulti SmBodyMotoWriteIOMulti;
+
+struct _SmBodyMotoWriteIOMultiReply	// ROS_MSG_MOTO_WRITE_IO_MULTI_REPLY = 2025
+{
+	int numberOfElements;		// Number of elements, in the order of the request; only these are sent
+	IoResultCodes resultCode;	// IO_RESULT_OK if all elements were written, else the result of the first failed element
+	IoResultCodes resultCodes[ROS_MAX_IO_MULTI];
+} __attribute__((__packed__));
+typedef struct _SmBodyMotoWriteIOMultiReply SmBodyMotoWriteIOMultiReply;
+
+struct _SmBodyMotoIoSubscribe	// ROS_MSG_MOTO_IO_SUBSCRIBE = 2026
+{
+	int numberOfElements;		// Number of elements to watch, replacing those watched so far (0 stops watching); only these are sent
+	int period;					// Time between samples (ms), rounded up to whole interpolation cycles
+	SmIoMultiReadElement elements[ROS_MAX_IO_MULTI];
+} __attribute__((__packed__));
+typedef struct _SmBodyMotoIoSubscribe SmBodyMotoIoSubscribe;
+
+// ROS_MSG_MOTO_IO_SUBSCRIBE_REPLY = 2027 is a SmBodyMotoReadIOMultiReply: the value of each element when subscribed
+
+struct _SmBodyMotoIoChanged	// ROS_MSG_MOTO_IO_CHANGED = 2028
+{
+	UINT32 time;				// Time of the sample (ms on the interpolation clock, counted from the first subscription of the connection)
+	int numberOfElements;		// Number of elements that changed (0 for a keepalive); only these are sent
+	SmIoMultiWriteElement elements[ROS_MAX_IO_MULTI];	// Address, size and new value of each element that changed
+} __attribute__((__packed__));
+typedef struct _SmBodyMotoIoChanged SmBodyMotoIoChanged;
+
 //--------------
 // DH Parameters
 //--------------
@@ -397,6 +505,7 @@ typedef union
 	SmBodyMotoMotionCtrl motionCtrl;
 	SmBodyMotoMotionReply motionReply;
 	SmBodyJointTrajPtFullEx jointTrajDataEx;
+	SmBodyJointTrajPtFullBatch jointTrajDataBatch;
 	SmBodyJointFeedbackEx jointFeedbackEx;
 	SmBodySelectTool selectTool;
 	SmBodyMotoReadIOBit readIOBit;
@@ -413,6 +522,13 @@ typedef union
 	SmBodyMotoReadIOMRegisterReply readRegisterReply;
 	SmBodyMotoWriteIOMRegister writeRegister;
 	SmBodyMotoWriteIOMRegisterReply writeRegisterReply;
+	SmBodyMotoReadIOMulti readIOMulti;
+	SmBodyMotoReadIOMultiReply readIOMultiReply;
+	SmBodyMotoWriteIOMulti writeIOMulti;
+	SmBodyMotoWriteIOMultiReply writeIOMultiReply;
+	SmBodyMotoIoSubscribe ioSubscribe;
+	SmBodyMotoReadIOMultiReply ioSubscribeReply;
+	SmBodyMotoIoChanged ioChanged;
 } SmBody;
 
 //-------------------
@@ -431,7 +547,7 @@ typedef struct _SimpleMsg SimpleMsg;
 // Function Section
 //-------------------
 
-extern int Ros_SimpleMsg_JointFeedback(CtrlGroup* ctrlGroup, SimpleMsg* sendMsg);
+extern int Ros_SimpleMsg_JointFeedback(CtrlGroup* ctrlGroup, CtrlGroupFeedback* feedback, SimpleMsg* sendMsg);
 extern void Ros_SimpleMsg_JointFeedbackEx_Init(int numberOfGroups, SimpleMsg* sendMsg);
 extern int Ros_SimpleMsg_JointFeedbackEx_Build(int groupIndex, SimpleMsg* src_msgFeedback, SimpleMsg* dst_msgExtendedFeedback);
 
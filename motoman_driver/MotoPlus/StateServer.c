@@ -34,8 +34,14 @@
 //-----------------------
 // Function Declarations
 //-----------------------
+void Ros_StateServer_SampleState(Controller* controller);
+int Ros_StateServer_BuildSample(Controller* controller, int sampleTime, char* data);
+int Ros_StateServer_BuildStatus(Controller* controller, BOOL bKeepalive, SmBodyRobotStatus* lastStatus, char* data);
+void Ros_StateServer_PublishSample(Controller* controller, StateSample* sample, int statusSize);
+BOOL Ros_StateServer_IsConnected(Controller* controller);
 void Ros_StateServer_SendState(Controller* controller, int connectionIndex);
-BOOL Ros_StateServer_SendMsgToAllClient(Controller* controller, int connectionIndex, SimpleMsg* sendMsg, int msgSize);
+BOOL Ros_StateServer_GetSample(Controller* controller, StateSample* sample);
+int Ros_StateServer_SendSample(Controller* controller, int connectionIndex, StateSample* sample);
 void Ros_StateServer_StopConnection(Controller* controller, int connectionIndex);
 
 //-----------------------
@@ -45,6 +51,8 @@ void Ros_StateServer_StopConnection(Controller* controller, int connectionIndex)
 //-----------------------------------------------------------------------
 // Start the task for a new state server connection:
 // - Ros_StateServer_SendState: Task that broadcasts controller & robot state to the connected client
+// and, for the first connection, the task sampling the state for all of them:
+// - Ros_StateServer_SampleState
 //-----------------------------------------------------------------------
 void Ros_StateServer_StartNewConnection(Controller* controller, int sd)
 {
@@ -83,6 +91,30 @@ ATTEMPT_STATE_CONNECTION:
 	sockOpt = 1;
 	mpSetsockopt(sd, SOL_SOCKET, SO_KEEPALIVE, (char*)&sockOpt, sizeof(sockOpt));
 
+	// If not started, start the task that samples the state (there should be only one instance of this thread)
+	if (controller->tidStateSample == INVALID_TASK)
+	{
+		puts("Creating new task: StateSampleTask");
+
+#if (STATE_STREAM_DECIMATION > 0)
+		controller->tidStateSample = mpCreateTask(MP_PRI_IP_CLK_TAKE, MP_STACK_SIZE,
+#else
+		controller->tidStateSample = mpCreateTask(MP_PRI_TIME_NORMAL, MP_STACK_SIZE,
+#endif
+													(FUNCPTR)Ros_StateServer_SampleState,
+													(int)controller, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+		if (controller->tidStateSample == INVALID_TASK)
+		{
+			mpSetAlarm(8004, "MOTOROS FAILED TO CREATE TASK", 3);
+			Ros_StateServer_StopConnection(controller, connectionIndex);
+			return;
+		}
+	}
+
+	//discard the notification of a sample left over by the previous connection
+	mpSemTake(controller->semStateSampleReady[connectionIndex], NO_WAIT);
+	controller->stateDroppedCnt[connectionIndex] = 0;
+
 	//start task that will send the controller state
 	controller->tidStateSendState[connectionIndex] = mpCreateTask(MP_PRI_TIME_NORMAL, MP_STACK_SIZE,
 																	(FUNCPTR)Ros_StateServer_SendState,
@@ -126,84 +158,316 @@ void Ros_StateServer_StopConnection(Controller* controller, int connectionIndex)
 
 
 //-----------------------------------------------------------------------
-// Send state (robot position and controller status) as long as there is
-// an active connection
+// Sample the state (robot position and controller status) for all the
+// connections. With STATE_STREAM_DECIMATION, samples are taken on the
+// interpolation clock, so they are evenly spaced. Sending is left to the
+// connection tasks: a slow client never delays a sample.
+// Each sample is stamped with the time it was taken on the interpolation
+// clock, so the client can tell when it was taken and which were dropped.
+// The controller status is only sent when it changes (and as a keepalive):
+// the first sample after a change carries it, with the time of that sample.
+// A connection that does not send that sample (a new one, or one that
+// dropped it) sends the latest status along with its next sample.
 //-----------------------------------------------------------------------
-void Ros_StateServer_SendState(Controller* controller, int connectionIndex)
+void Ros_StateServer_SampleState(Controller* controller)
+{
+	StateSample sample;
+	SmBodyRobotStatus lastStatus;
+	int samplePeriod;
+	int keepaliveSamples;
+	int samplesSinceStatus;
+	int statusSize;
+	int sampleTime = -1;	// ms, -1 if the samples are not taken on the clock
+#if (STATE_STREAM_DECIMATION > 0)
+	int cycleCnt = 0;
+	ULONG tickTime;
+
+	samplePeriod = controller->interpolPeriod * STATE_STREAM_DECIMATION;
+#else
+	samplePeriod = STATE_UPDATE_MIN_PERIOD;
+#endif
+	// the controller status is sent at least every STATE_STATUS_KEEPALIVE_PERIOD
+	keepaliveSamples = max(STATE_STATUS_KEEPALIVE_PERIOD / samplePeriod, 1);
+	samplesSinceStatus = keepaliveSamples;
+	memset(&lastStatus, 0x00, sizeof(SmBodyRobotStatus));
+
+	printf("Starting State Server Sample State task (every %d ms)\r\n", samplePeriod);
+	printf("Controller number of group = %d\r\n", controller->numGroup);
+
+	FOREVER
+	{
+#if (STATE_STREAM_DECIMATION > 0)
+		mpClkAnnounce(MP_INTERPOLATION_CLK);
+		if (++cycleCnt < STATE_STREAM_DECIMATION)
+			continue;
+		cycleCnt = 0;
+
+		// Time the sample is taken, from the system clock: cycles this task missed show up as a gap.
+		// It is rounded to the interpolation cycle the sample belongs to, as the task wakes up a bit after it.
+		tickTime = tickGet() * (ULONG)mpGetRtc();
+		tickTime = (tickTime + controller->interpolPeriod / 2) / controller->interpolPeriod * controller->interpolPeriod;
+		sampleTime = (int)(tickTime % (STATE_TIME_WRAP * 1000));
+#else
+		Ros_Sleep(STATE_UPDATE_MIN_PERIOD);
+#endif
+
+		if (!Ros_StateServer_IsConnected(controller))
+			continue;
+
+		sample.size = Ros_StateServer_BuildSample(controller, sampleTime, sample.data);
+		statusSize = Ros_StateServer_BuildStatus(controller, (++samplesSinceStatus >= keepaliveSamples),
+												 &lastStatus, sample.data + sample.size);
+		sample.size += statusSize;
+		if (statusSize > 0)
+			samplesSinceStatus = 0;
+
+		Ros_StateServer_PublishSample(controller, &sample, statusSize);
+	}
+}
+
+//-----------------------------------------------------------------------
+// Publish a sample for all the connections. The last statusSize bytes of
+// its data are the ROBOT_STATUS message (0 if it doesn't carry one).
+// A connection that reads it meanwhile sees seqNo odd or changed and reads it again.
+//-----------------------------------------------------------------------
+void Ros_StateServer_PublishSample(Controller* controller, StateSample* sample, int statusSize)
+{
+	int connectionIndex;
+
+	controller->stateSample.seqNo++;
+	Q_MEMORY_BARRIER();
+	controller->stateSample.size = sample->size;
+	memcpy(controller->stateSample.data, sample->data, sample->size);
+	if (statusSize > 0)
+	{
+		controller->stateSample.statusSeqNo = controller->stateSample.seqNo + 1;
+		controller->stateSample.statusSize = statusSize;
+		memcpy(controller->stateSample.status, sample->data + sample->size - statusSize, statusSize);
+	}
+	Q_MEMORY_BARRIER();
+	controller->stateSample.seqNo++;
+
+	for (connectionIndex = 0; connectionIndex < MAX_STATE_CONNECTIONS; connectionIndex++)
+	{
+		if (controller->sdStateConnections[connectionIndex] != INVALID_SOCKET)
+			mpSemGive(controller->semStateSampleReady[connectionIndex]);
+	}
+}
+
+//-----------------------------------------------------------------------
+// Serialize the feedback messages: JOINT_FEEDBACK for each control group
+// and JOINT_FEEDBACK_EX when there are multiple groups. The feedback of
+// all the groups is captured at once. sampleTime (ms) is the time the sample is taken, sent as
+// the feedback time, or -1 to leave the time out.
+// return the number of bytes written to data
+//-----------------------------------------------------------------------
+int Ros_StateServer_BuildSample(Controller* controller, int sampleTime, char* data)
 {
 	int groupNo;
+	CtrlGroupFeedback feedback[MAX_CONTROLLABLE_GROUPS];
 	SimpleMsg sendMsg;
 	SimpleMsg sendMsgFEx;
 	int msgSize, fexMsgSize = 0;
+	int size = 0;
 	BOOL bOkToSendExFeedback;
-	BOOL bSuccesfulSend;
-	
-	printf("Starting State Server Send State task\r\n");
-	printf("Controller number of group = %d\r\n", controller->numGroup);
-	
-	while(TRUE) //loop will break when there is a transmission error
-	{
-		Ros_SimpleMsg_JointFeedbackEx_Init(controller->numGroup, &sendMsgFEx);
-		bOkToSendExFeedback = TRUE;
+	BOOL bSendGroupFeedback;
+
+	Ros_SimpleMsg_JointFeedbackEx_Init(controller->numGroup, &sendMsgFEx);
+	bOkToSendExFeedback = TRUE;
+	bSendGroupFeedback = (STATE_STREAM_GROUP_FEEDBACK || controller->numGroup < 2);
+
+	Ros_CtrlGroup_GetFBSnapshot(controller->ctrlGroups, controller->numGroup, STATE_STREAM_EFFORT, feedback);
 
-		// Send feedback position for each control group
-		for(groupNo=0; groupNo < controller->numGroup; groupNo++)
+	// Feedback position for each control group
+	for(groupNo=0; groupNo < controller->numGroup; groupNo++)
+	{
+		msgSize = Ros_SimpleMsg_JointFeedback(controller->ctrlGroups[groupNo], &feedback[groupNo], &sendMsg);
+		if (sampleTime >= 0)
 		{
-			msgSize = Ros_SimpleMsg_JointFeedback(controller->ctrlGroups[groupNo], &sendMsg);
-			fexMsgSize = Ros_SimpleMsg_JointFeedbackEx_Build(groupNo, &sendMsg, &sendMsgFEx);
-			if(msgSize > 0)
-			{
-				bSuccesfulSend = Ros_StateServer_SendMsgToAllClient(controller, connectionIndex, &sendMsg, msgSize);
-				if (!bSuccesfulSend)
-					break;
-			}
-			else
+			sendMsg.body.jointFeedback.time = sampleTime / 1000.0f;
+			sendMsg.body.jointFeedback.validFields |= Valid_Time;
+		}
+		fexMsgSize = Ros_SimpleMsg_JointFeedbackEx_Build(groupNo, &sendMsg, &sendMsgFEx);
+		if(msgSize > 0)
+		{
+			if (bSendGroupFeedback)
 			{
-				printf("Ros_SimpleMsg_JointFeedback returned a message size of 0\r\n");
-				bOkToSendExFeedback = FALSE;
+				memcpy(data + size, &sendMsg, msgSize);
+				size += msgSize;
 			}
 		}
-
-		if (controller->numGroup < 2) //only send the ROS_MSG_MOTO_JOINT_FEEDBACK_EX message if we have multiple control groups
+		else
+		{
+			printf("Ros_SimpleMsg_JointFeedback returned a message size of 0\r\n");
 			bOkToSendExFeedback = FALSE;
+		}
+	}
+
+	if (controller->numGroup < 2) //only send the ROS_MSG_MOTO_JOINT_FEEDBACK_EX message if we have multiple control groups
+		bOkToSendExFeedback = FALSE;
+
+	if (bOkToSendExFeedback) //extended-feedback message
+	{
+		memcpy(data + size, &sendMsgFEx, fexMsgSize);
+		size += fexMsgSize;
+	}
 
-		if (bOkToSendExFeedback) //send extended-feedback message
+	return size;
+}
+
+//-----------------------------------------------------------------------
+// Serialize the ROBOT_STATUS message if the status differs from lastStatus
+// (the status last sent, updated), or if bKeepalive.
+// return the number of bytes written to data (0 if the status is not sent)
+//-----------------------------------------------------------------------
+int Ros_StateServer_BuildStatus(Controller* controller, BOOL bKeepalive, SmBodyRobotStatus* lastStatus, char* data)
+{
+	SimpleMsg sendMsg;
+	int msgSize;
+
+	msgSize = Ros_Controller_StatusToMsg(controller, &sendMsg);
+	if (msgSize <= 0)
+		return 0;
+
+	if (!bKeepalive && memcmp(&sendMsg.body.robotStatus, lastStatus, sizeof(SmBodyRobotStatus)) == 0)
+		return 0;
+
+	*lastStatus = sendMsg.body.robotStatus;
+	memcpy(data, &sendMsg, msgSize);
+	return msgSize;
+}
+
+//-----------------------------------------------------------------------
+// return TRUE if at least one client is connected to the state server
+//-----------------------------------------------------------------------
+BOOL Ros_StateServer_IsConnected(Controller* controller)
+{
+	int connectionIndex;
+
+	for (connectionIndex = 0; connectionIndex < MAX_STATE_CONNECTIONS; connectionIndex++)
+	{
+		if (controller->sdStateConnections[connectionIndex] != INVALID_SOCKET)
+			return TRUE;
+	}
+	return FALSE;
+}
+
+
+//-----------------------------------------------------------------------
+// Send state (robot position and controller status) as long as there is
+// an active connection: each sample, as soon as it is taken. All the
+// connections send the same bytes, serialized once by the sampling task.
+// The samples a connection skips (while its previous send was pending, or
+// because the socket did not accept them in time) are counted in
+// stateDroppedCnt: a slow client only drops its own samples.
+// As the status is only sent when it changes, a connection that did not
+// send the sample carrying the latest status sends it with the next one.
+//-----------------------------------------------------------------------
+void Ros_StateServer_SendState(Controller* controller, int connectionIndex)
+{
+	StateSample sample;
+	UINT32 lastSeqNo = 0;
+	UINT32 lastStatusSeqNo = 0;	// statusSeqNo of the last status sent
+	int ret;
+
+	printf("Starting State Server Send State task\r\n");
+
+	FOREVER //loop will break when there is a transmission error
+	{
+		mpSemTake(controller->semStateSampleReady[connectionIndex], WAIT_FOREVER);
+
+		if (!Ros_StateServer_GetSample(controller, &sample))
+			continue; //a newer sample is ready
+
+		//each sample advances seqNo by 2: count the samples published since the last one without being sent
+		if (lastSeqNo != 0 && sample.seqNo - lastSeqNo > 2)
+			controller->stateDroppedCnt[connectionIndex] += (sample.seqNo - lastSeqNo) / 2 - 1;
+		lastSeqNo = sample.seqNo;
+
+		if (sample.statusSeqNo != lastStatusSeqNo && sample.statusSeqNo != sample.seqNo)
 		{
-			bSuccesfulSend = Ros_StateServer_SendMsgToAllClient(controller, connectionIndex, &sendMsgFEx, fexMsgSize);
-			if (!bSuccesfulSend)
-				break;
+			memcpy(sample.data + sample.size, sample.status, sample.statusSize);
+			sample.size += sample.statusSize;
 		}
 
-		// Send controller/robot status
-		msgSize = Ros_Controller_StatusToMsg(controller, &sendMsg);
-		if(msgSize > 0)
+		ret = Ros_StateServer_SendSample(controller, connectionIndex, &sample);
+		if (ret < 0)
+			break;
+		if (ret > 0)
+			lastStatusSeqNo = sample.statusSeqNo;
+	}
+
+	printf("State Server Send State task was terminated (%d samples dropped)\r\n", controller->stateDroppedCnt[connectionIndex]);
+	Ros_StateServer_StopConnection(controller, connectionIndex);
+}
+
+
+//-----------------------------------------------------------------------
+// Copy the latest state sample, and the latest status
+// return FALSE if it kept being overwritten while it was copied
+//-----------------------------------------------------------------------
+BOOL Ros_StateServer_GetSample(Controller* controller, StateSample* sample)
+{
+	int attempt;
+	UINT32 seqNo;
+
+	for (attempt = 0; attempt < STATE_SAMPLE_READ_ATTEMPTS; attempt++)
+	{
+		seqNo = controller->stateSample.seqNo;
+		Q_MEMORY_BARRIER();
+		sample->size = controller->stateSample.size;
+		sample->statusSize = controller->stateSample.statusSize;
+		if ((seqNo & 1) == 0 && sample->size >= 0 && sample->size <= (int)STATE_SAMPLE_MAX_SIZE
+			&& sample->statusSize >= 0 && sample->statusSize <= (int)STATE_STATUS_MAX_SIZE)
 		{
-			bSuccesfulSend = Ros_StateServer_SendMsgToAllClient(controller, connectionIndex, &sendMsg, msgSize);
-			if (!bSuccesfulSend)
-				break;
+			memcpy(sample->data, controller->stateSample.data, sample->size);
+			sample->statusSeqNo = controller->stateSample.statusSeqNo;
+			memcpy(sample->status, controller->stateSample.status, sample->statusSize);
+			Q_MEMORY_BARRIER();
+			if (controller->stateSample.seqNo == seqNo)
+			{
+				sample->seqNo = seqNo;
+				return TRUE;
+			}
 		}
-		Ros_Sleep(STATE_UPDATE_MIN_PERIOD);
+		Ros_Sleep(0); //let the sampling task finish
 	}
-	
-	printf("State Server Send State task was terminated\r\n");
-	Ros_StateServer_StopConnection(controller, connectionIndex);
+
+	return FALSE;
 }
 
 
 //-----------------------------------------------------------------------
-// Send state message to all active connections
-// return TRUE if message was send to at least one client
+// Send a state sample, unless the socket doesn't accept it within
+// STATE_STREAM_SEND_BUDGET ms: the sample is then dropped.
+// return the number of bytes sent, 0 if the sample was dropped, -1 on transmission error
 //-----------------------------------------------------------------------
-BOOL Ros_StateServer_SendMsgToAllClient(Controller* controller, int connectionIndex, SimpleMsg* sendMsg, int msgSize)
+int Ros_StateServer_SendSample(Controller* controller, int connectionIndex, StateSample* sample)
 {
 	int ret;
-	
-	ret = mpSend(controller->sdStateConnections[connectionIndex], (char*)(sendMsg), msgSize, 0);
+	int sd = controller->sdStateConnections[connectionIndex];
+	struct fd_set fds;
+	struct timeval timeout;
+
+	FD_ZERO(&fds);
+	FD_SET(sd, &fds);
+	timeout.tv_sec = 0;
+	timeout.tv_usec = STATE_STREAM_SEND_BUDGET * 1000;
+
+	ret = mpSelect(sd + 1, NULL, &fds, NULL, &timeout);
+	if (ret == 0)
+	{
+		controller->stateDroppedCnt[connectionIndex]++;
+		return 0;
+	}
+
+	if (ret > 0)
+		ret = mpSend(sd, sample->data, sample->size, 0);
 	if(ret <= 0)
 	{
 		printf("StateServer Send failure.  Closing state server connection.\r\n");
-		return FALSE;
+		return -1;
 	}
 
-	return TRUE;
+	return ret;
 }
@@ -32,7 +32,35 @@
 #ifndef STATESERVER_H
 #define STATESERVER_H
 
-#define STATE_UPDATE_MIN_PERIOD 25   // Time delay between each state update
+#define STATE_UPDATE_MIN_PERIOD 25   // Time delay between each state update (without STATE_STREAM_DECIMATION)
+
+// ROBOT_STATUS is sent with the first sample after the status changed, and at least every
+// STATE_STATUS_KEEPALIVE_PERIOD ms otherwise.
+#define STATE_STATUS_KEEPALIVE_PERIOD 100
+
+// Interpolation cycles between state samples: the state is then sampled on the interpolation clock
+// (every 4 ms on most controllers, with 1) and stamped with the time it was taken. 0 (the default)
+// samples every STATE_UPDATE_MIN_PERIOD ms, as MotoROS always did.
+#define STATE_STREAM_DECIMATION 0
+
+// With multiple control groups, send the JOINT_FEEDBACK message of each group along with the JOINT_FEEDBACK_EX
+// message. 0 only sends JOINT_FEEDBACK_EX: the per-group topics on the ROS side are then no longer published.
+#define STATE_STREAM_GROUP_FEEDBACK 1
+
+// 1 sends the servo torque of each axis in JOINT_FEEDBACK: the acc field then holds joint efforts, flagged
+// by Valid_Effort (see SimpleMessage.h). Only enable it with a ROS driver that knows that flag: other
+// clients read the efforts as accelerations. 0 (the default) leaves acc out, as MotoROS always did.
+#define STATE_STREAM_EFFORT 0
+
+// Longest a connection waits for its socket to accept a sample (ms). Past it, the sample is dropped
+// for that connection, which then gets the next one: a slow client gets fewer, but current samples.
+#define STATE_STREAM_SEND_BUDGET 2
+
+// The time of each sample (sent as the JOINT_FEEDBACK time, in sec) wraps around every STATE_TIME_WRAP sec,
+// so that it keeps a sub-millisecond resolution as a float. The ROS side unwraps it with the same period.
+#define STATE_TIME_WRAP 1024
+
+#define STATE_SAMPLE_READ_ATTEMPTS 3   // Reads of a sample that was overwritten while it was copied
 
 extern void Ros_StateServer_StartNewConnection(Controller* controller, int sd);
 
@@ -0,0 +1,495 @@
+//IncQueueTest.c
+//
+// Stress test and benchmark of the incremental move queue (IncQueue.c).
+// A producer and a consumer thread exchange numbered increments while the
+// queue is truncated (by the producer, as Ros_MotionServer_TruncateQ does)
+// or cleared (by a third thread, as Ros_MotionServer_ClearQ does).
+// The consumer log is then checked for lost, duplicated, corrupted or
+// truncated increments. The truncations of the head phase remove the
+// increment that the consumer is about to take, to hit the window between
+// the copy and the removal in Ros_IncQueue_Pop; that window is also
+// checked step by step, since the threads rarely switch inside it (it never
+// happens on a single CPU). The time taken by each
+// removal is also recorded:
+// the consumer never waits on the producer, so it only depends on the
+// scheduling of the consumer thread itself.
+//
+// Usage: IncQueueTest [increments_per_phase]
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "MotoROS.h"
+
+// The queue is compiled in, to switch threads at its sync points
+static void Test_SyncPoint(const char* point);
+#define Q_SYNC_POINT(point)	Test_SyncPoint(#point)
+#include "IncQueue.c"
+
+#define TEST_DEFAULT_INCREMENTS		1000000
+#define TEST_MAX_GENERATIONS		100000
+#define TEST_STALL_US				1000.0		// removal slower than this is counted as a stall
+
+typedef enum
+{
+	TEST_PHASE_STREAM,		// producer and consumer only
+	TEST_PHASE_TRUNCATE,	// producer truncates the queue periodically
+	TEST_PHASE_HEAD,		// producer truncates the queue at its head, very often
+	TEST_PHASE_CLEAR		// a third thread clears the queue periodically
+} TestPhase;
+
+typedef struct
+{
+	LONG pos;				// position of the increment in the queue when it was added
+	LONG generation;		// number of successful truncations before it was added
+} TestLogEntry;
+
+static Incremental_q testQ;
+static TestPhase testPhase;
+static int testIncrements;
+static volatile BOOL bProducerDone;
+static volatile BOOL bConsumerDone;
+
+static UINT32 truncateEnd[TEST_MAX_GENERATIONS];	// first position removed by each truncation
+static volatile int truncateOk;
+static int truncateFailed;
+static volatile int clearCnt;
+
+static pthread_mutex_t syncLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t syncCond = PTHREAD_COND_INITIALIZER;
+static const char* syncPoints[3];	// sync points at which the threads switch, in order (NULL terminated)
+static int syncStep;				// number of sync points reached
+static Incremental_data syncPopData;
+static BOOL bSyncPopped;
+
+static TestLogEntry* consumerLog;
+static int consumerLogCnt;
+static double popTimeTotal_us;
+static double popTimeMax_us;
+static long popCnt;
+static long stallCnt;
+
+static double Test_Now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// time holds the position and inc[0] the generation, the other fields are derived from them
+static void Test_FillIncrement(Incremental_data* data, LONG pos, LONG generation)
+{
+	int axis;
+
+	memset(data, 0x00, sizeof(Incremental_data));
+	data->time = pos;
+	data->tool = (UCHAR)pos;
+	data->inc[0] = generation;
+	for(axis = 1; axis < MP_GRP_AXES_NUM; axis++)
+		data->inc[axis] = (pos ^ (axis << 24)) + generation;
+}
+
+static BOOL Test_CheckIncrement(Incremental_data* data)
+{
+	int axis;
+
+	for(axis = 1; axis < MP_GRP_AXES_NUM; axis++)
+	{
+		if(data->inc[axis] != (data->time ^ (axis << 24)) + data->inc[0])
+			return FALSE;
+	}
+	return (data->tool == (UCHAR)data->time);
+}
+
+//-------------------------------------------------------------------
+// Producer: adds the increments, truncates the queue in the truncate phase
+//-------------------------------------------------------------------
+static void* Test_Producer(void* arg)
+{
+	Incremental_data data;
+	int added = 0;
+	int period = 0;
+	int keep;
+	UINT32 startPos;
+
+	if(testPhase == TEST_PHASE_TRUNCATE)
+		period = 97;
+	else if(testPhase == TEST_PHASE_HEAD)
+		period = 7;
+
+	while(added < testIncrements)
+	{
+		Test_FillIncrement(&data, (LONG)testQ.writeCnt, truncateOk);
+		if(!Ros_IncQueue_Push(&testQ, &data))
+		{
+			sched_yield();
+			continue;
+		}
+		added++;
+
+		if((period > 0) && (added % period == 0) && (truncateOk < TEST_MAX_GENERATIONS - 1))
+		{
+			// Keep a few increments after the one being executed, like a splice
+			startPos = testQ.readCnt;
+			keep = (testPhase == TEST_PHASE_HEAD) ? 0 : rand() % 8;
+			if((int)(testQ.writeCnt - startPos) > keep)
+			{
+				if(Ros_IncQueue_Truncate(&testQ, startPos + keep))
+				{
+					truncateEnd[truncateOk] = startPos + keep;
+					truncateOk++;
+				}
+				else
+					truncateFailed++;
+			}
+		}
+	}
+
+	bProducerDone = TRUE;
+	return NULL;
+}
+
+//-------------------------------------------------------------------
+// Consumer: removes the increments and logs them, like the IP_CLK task
+//-------------------------------------------------------------------
+static void* Test_Consumer(void* arg)
+{
+	Incremental_data data;
+	double t0, dt;
+	BOOL bPopped;
+
+	for(;;)
+	{
+		t0 = Test_Now_us();
+		bPopped = Ros_IncQueue_Pop(&testQ, &data);
+		dt = Test_Now_us() - t0;
+
+		popTimeTotal_us += dt;
+		popTimeMax_us = max(popTimeMax_us, dt);
+		popCnt++;
+		if(dt > TEST_STALL_US)
+			stallCnt++;
+
+		if(bPopped)
+		{
+			consumerLog[consumerLogCnt].pos = data.time;
+			consumerLog[consumerLogCnt].generation = data.inc[0];
+			if(!Test_CheckIncrement(&data))
+				consumerLog[consumerLogCnt].generation = -1;
+			consumerLogCnt++;
+		}
+		else if(bProducerDone && (Ros_IncQueue_GetCnt(&testQ) == 0))
+			break;
+	}
+
+	bConsumerDone = TRUE;
+	return NULL;
+}
+
+//-------------------------------------------------------------------
+// Clears the queue periodically in the clear phase
+//-------------------------------------------------------------------
+static void* Test_Clearer(void* arg)
+{
+	while(!bConsumerDone)
+	{
+		Ros_IncQueue_Clear(&testQ);
+		clearCnt++;
+		usleep(50 + rand() % 200);
+	}
+	return NULL;
+}
+
+//-------------------------------------------------------------------
+// Checks the consumer log of a phase
+//-------------------------------------------------------------------
+static BOOL Test_CheckLog(const char* name)
+{
+	int i;
+	LONG generation;
+
+	// An increment added before truncation g is removed by it, or by any later
+	// truncation, if its position is past the end of the truncated queue
+	for(i = truncateOk - 2; i >= 0; i--)
+		truncateEnd[i] = min(truncateEnd[i], truncateEnd[i + 1]);
+
+	for(i = 0; i < consumerLogCnt; i++)
+	{
+		generation = consumerLog[i].generation;
+		if(generation < 0)
+		{
+			printf("%s: increment %d (position %ld) is corrupted\r\n", name, i, consumerLog[i].pos);
+			return FALSE;
+		}
+
+		// Truncated increments must never be executed
+		if((generation < truncateOk) && ((UINT32)consumerLog[i].pos >= truncateEnd[generation]))
+		{
+			printf("%s: increment %d (position %ld) was truncated at position %u\r\n",
+				name, i, consumerLog[i].pos, truncateEnd[generation]);
+			return FALSE;
+		}
+
+		if(i == 0)
+			continue;
+
+		if(testPhase == TEST_PHASE_CLEAR)
+		{
+			// Cleared increments are skipped, but never executed twice
+			if(consumerLog[i].pos <= consumerLog[i - 1].pos)
+			{
+				printf("%s: position %ld executed after %ld\r\n", name, consumerLog[i].pos, consumerLog[i - 1].pos);
+				return FALSE;
+			}
+		}
+		else if(consumerLog[i].pos != consumerLog[i - 1].pos + 1)
+		{
+			printf("%s: position %ld executed after %ld\r\n", name, consumerLog[i].pos, consumerLog[i - 1].pos);
+			return FALSE;
+		}
+	}
+
+	if((testPhase == TEST_PHASE_STREAM) && (consumerLogCnt != testIncrements))
+	{
+		printf("%s: %d increments executed, %d added\r\n", name, consumerLogCnt, testIncrements);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static BOOL Test_RunPhase(TestPhase phase, const char* name)
+{
+	pthread_t producer, consumer, clearer;
+	double t0, elapsed_us;
+	BOOL bOk;
+
+	testPhase = phase;
+	bProducerDone = FALSE;
+	bConsumerDone = FALSE;
+	truncateOk = 0;
+	truncateFailed = 0;
+	clearCnt = 0;
+	consumerLogCnt = 0;
+	popTimeTotal_us = 0.0;
+	popTimeMax_us = 0.0;
+	popCnt = 0;
+	stallCnt = 0;
+
+	if(!Ros_IncQueue_Init(&testQ, Q_SIZE))
+		return FALSE;
+
+	t0 = Test_Now_us();
+	pthread_create(&consumer, NULL, Test_Consumer, NULL);
+	pthread_create(&producer, NULL, Test_Producer, NULL);
+	if(phase == TEST_PHASE_CLEAR)
+		pthread_create(&clearer, NULL, Test_Clearer, NULL);
+
+	pthread_join(producer, NULL);
+	pthread_join(consumer, NULL);
+	if(phase == TEST_PHASE_CLEAR)
+		pthread_join(clearer, NULL);
+	elapsed_us = Test_Now_us() - t0;
+
+	bOk = Test_CheckLog(name);
+
+	printf("%-9s %8d added, %8d executed, %5d truncated (%d refused), %5d cleared, %6.1f ns/increment\r\n",
+		name, testIncrements, consumerLogCnt, truncateOk, truncateFailed, clearCnt, 1000.0 * elapsed_us / testIncrements);
+	printf("%-9s removal: %6.3f us average, %8.3f us max, %ld slower than %.0f us (preempted)\r\n",
+		"", popTimeTotal_us / max(popCnt, 1), popTimeMax_us, stallCnt, TEST_STALL_US);
+
+	mpFree(testQ.data);
+	return bOk;
+}
+
+//-------------------------------------------------------------------
+// Hands over to the other thread when the next sync point is reached,
+// and waits until the other thread reaches the following one
+//-------------------------------------------------------------------
+static void Test_SyncPoint(const char* point)
+{
+	int step;
+
+	pthread_mutex_lock(&syncLock);
+	if((syncPoints[syncStep] != NULL) && (strcmp(point, syncPoints[syncStep]) == 0))
+	{
+		step = ++syncStep;
+		pthread_cond_broadcast(&syncCond);
+		while(syncStep == step)
+			pthread_cond_wait(&syncCond, &syncLock);
+	}
+	pthread_mutex_unlock(&syncLock);
+}
+
+static void Test_SyncAdvance(int step)
+{
+	pthread_mutex_lock(&syncLock);
+	while(syncStep < step - 1)
+		pthread_cond_wait(&syncCond, &syncLock);
+	syncStep = step;
+	pthread_cond_broadcast(&syncCond);
+	pthread_mutex_unlock(&syncLock);
+}
+
+static void* Test_SyncConsumer(void* arg)
+{
+	// Starts removing the first element once the truncate is counted
+	pthread_mutex_lock(&syncLock);
+	while(syncStep < 1)
+		pthread_cond_wait(&syncCond, &syncLock);
+	pthread_mutex_unlock(&syncLock);
+
+	bSyncPopped = Ros_IncQueue_Pop(&testQ, &syncPopData);
+	return NULL;
+}
+
+//-------------------------------------------------------------------
+// Truncates the queue at the element being removed, while the removal
+// reads the new truncateCnt but the old writeCnt: the element must not
+// be executed and the queue must stay consistent
+//-------------------------------------------------------------------
+static BOOL Test_PopTruncateRace(void)
+{
+	pthread_t consumer;
+	Incremental_data data;
+	BOOL bOk = TRUE;
+	BOOL bTruncated;
+	int i;
+
+	if(!Ros_IncQueue_Init(&testQ, Q_SIZE))
+		return FALSE;
+
+	for(i = 0; i < 4; i++)
+	{
+		Test_FillIncrement(&data, i, 0);
+		Ros_IncQueue_Push(&testQ, &data);
+	}
+	bOk &= Ros_IncQueue_Pop(&testQ, &data) && (data.time == 0);
+
+	// Truncate at position 1: the removal of 1 runs from the count of the
+	// truncate up to the copy of the element, then the truncate completes
+	syncPoints[0] = "TRUNCATE_COUNTED";
+	syncPoints[1] = "POP_COPIED";
+	syncPoints[2] = NULL;
+	syncStep = 0;
+	pthread_create(&consumer, NULL, Test_SyncConsumer, NULL);
+	bTruncated = Ros_IncQueue_Truncate(&testQ, 1);
+	Test_SyncAdvance(3);
+	pthread_join(consumer, NULL);
+	syncPoints[0] = NULL;
+	syncStep = 0;
+
+	if(bTruncated)
+		bOk &= !bSyncPopped && (Ros_IncQueue_GetCnt(&testQ) == 0) && (testQ.readCnt == testQ.writeCnt);
+	else
+		bOk &= bSyncPopped && (syncPopData.time == 1) && (Ros_IncQueue_GetCnt(&testQ) == 2);
+
+	// The queue goes on from the end of the truncated queue
+	Test_FillIncrement(&data, testQ.writeCnt, 1);
+	bOk &= Ros_IncQueue_Push(&testQ, &data);
+	bOk &= Ros_IncQueue_Pop(&testQ, &data) && (data.time == (LONG)testQ.readCnt - 1) && Test_CheckIncrement(&data);
+
+	printf("%-9s %s (%s)\r\n", "race", bOk ? "ok" : "failed", bTruncated ? "truncated" : "refused");
+
+	mpFree(testQ.data);
+	return bOk;
+}
+
+//-------------------------------------------------------------------
+// Checks that the queue can only be resized while it is empty
+//-------------------------------------------------------------------
+static BOOL Test_Resize(void)
+{
+	Incremental_data data;
+	BOOL bOk = TRUE;
+	int i;
+
+	if(!Ros_IncQueue_Init(&testQ, Q_SIZE))
+		return FALSE;
+
+	// Move the indexes so that the queue wraps around in the new storage
+	for(i = 0; i < Q_SIZE + Q_SIZE / 2; i++)
+	{
+		Test_FillIncrement(&data, i, 0);
+		bOk &= Ros_IncQueue_Push(&testQ, &data);
+		bOk &= Ros_IncQueue_Pop(&testQ, &data);
+	}
+
+	Test_FillIncrement(&data, i, 0);
+	Ros_IncQueue_Push(&testQ, &data);
+	bOk &= !Ros_IncQueue_Resize(&testQ, 4 * Q_SIZE);	// not empty
+	bOk &= !Ros_IncQueue_Resize(&testQ, 3 * Q_SIZE);	// not a power of 2
+	Ros_IncQueue_Clear(&testQ);
+	bOk &= Ros_IncQueue_Resize(&testQ, 4 * Q_SIZE);
+	bOk &= (testQ.size == 4 * Q_SIZE) && (Ros_IncQueue_GetCnt(&testQ) == 0);
+
+	// The larger queue is filled up to its new depth, in order
+	for(i = 0; i < 4 * Q_SIZE; i++)
+	{
+		Test_FillIncrement(&data, i, 0);
+		bOk &= Ros_IncQueue_Push(&testQ, &data);
+	}
+	bOk &= !Ros_IncQueue_Push(&testQ, &data);
+	for(i = 0; i < 4 * Q_SIZE; i++)
+		bOk &= Ros_IncQueue_Pop(&testQ, &data) && (data.time == i) && Test_CheckIncrement(&data);
+
+	printf("%-9s %s\r\n", "resize", bOk ? "ok" : "failed");
+
+	mpFree(testQ.data);
+	return bOk;
+}
+
+int main(int argc, char** argv)
+{
+	BOOL bOk = TRUE;
+
+	testIncrements = TEST_DEFAULT_INCREMENTS;
+	if(argc > 1)
+		testIncrements = atoi(argv[1]);
+
+	consumerLog = (TestLogEntry*)malloc(testIncrements * sizeof(TestLogEntry));
+	srand(1);
+
+	bOk &= Test_RunPhase(TEST_PHASE_STREAM, "stream");
+	bOk &= Test_RunPhase(TEST_PHASE_TRUNCATE, "truncate");
+	bOk &= Test_RunPhase(TEST_PHASE_HEAD, "head");
+	bOk &= Test_PopTruncateRace();
+	bOk &= Test_RunPhase(TEST_PHASE_CLEAR, "clear");
+	bOk &= Test_Resize();
+
+	free(consumerLog);
+
+	printf("%s\r\n", bOk ? "PASSED" : "FAILED");
+	return bOk ? 0 : 1;
+}
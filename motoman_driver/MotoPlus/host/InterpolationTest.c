@@ -0,0 +1,366 @@
+//InterpolationTest.c
+//
+// Compares the forward differencing interpolation (Interpolation.c) with
+// the direct evaluation of the cubic polynomial that it replaces, on random
+// trajectories for several robot configurations and interpolation periods.
+// The reference evaluates the polynomial in single precision, so it can be
+// off by a few pulses on large positions. Every interpolation cycle must be
+// within one pulse of the polynomial evaluated in extended precision and no
+// further from the reference than the reference is from that value (plus
+// the truncation). Every segment must end on exactly the same pulse position.
+//
+// Usage: InterpolationTest [segments_per_case]
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#include <time.h>
+
+#include "MotoROS.h"
+
+#define TEST_DEFAULT_SEGMENTS	2000
+#define TEST_MAX_CYCLES			(2 * 1000 + 1)		// longest segment / shortest period + leftover cycle
+
+typedef struct
+{
+	const char* name;
+	int numAxes;
+	MP_GRP_ID_TYPE groupId;
+	int axisType[MAX_PULSE_AXES];
+	int interpolPeriod;
+} TestCase;
+
+static const TestCase testCases[] =
+{
+	{ "6 axis robot, 4 ms", 6, MP_R1_GID, { AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_INVALID, AXIS_INVALID }, 4 },
+	{ "6 axis robot, 1 ms", 6, MP_R1_GID, { AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_INVALID, AXIS_INVALID }, 1 },
+	{ "7 axis robot, 4 ms", 7, MP_R1_GID, { AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_ROTATION, AXIS_INVALID }, 4 },
+	{ "4 axis scara, 2 ms", 4, MP_R1_GID, { AXIS_ROTATION, AXIS_ROTATION, AXIS_LINEAR, AXIS_INVALID, AXIS_INVALID, AXIS_ROTATION, AXIS_INVALID, AXIS_INVALID }, 2 },
+	{ "2 axis station, 4 ms", 2, MP_S1_GID, { AXIS_ROTATION, AXIS_LINEAR, AXIS_INVALID, AXIS_INVALID, AXIS_INVALID, AXIS_INVALID, AXIS_INVALID, AXIS_INVALID }, 4 },
+};
+
+static long refPulsePos[TEST_MAX_CYCLES][MAX_PULSE_AXES];
+static long exactPulsePos[TEST_MAX_CYCLES][MAX_PULSE_AXES];
+static long newPulsePos[TEST_MAX_CYCLES][MAX_PULSE_AXES];
+
+static double Test_Random(double min, double max)
+{
+	return min + (max - min) * rand() / (double)RAND_MAX;
+}
+
+static double Test_Now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+//-----------------------------------------------------------------------
+// Previous implementation of Ros_MotionServer_JointTrajDataToIncQueue:
+// evaluates the polynomial of every axis at each interpolation cycle.
+// The same polynomial evaluated in extended precision is returned in exactPos.
+//-----------------------------------------------------------------------
+static int Test_ReferenceSegment(CtrlGroup* ctrlGroup, int interpolPeriod, JointMotionData* startTrajData,
+								JointMotionData* endTrajData, int* timeLeftover_ms, long pulsePos[][MAX_PULSE_AXES],
+								long exactPos[][MAX_PULSE_AXES])
+{
+	int i, k, cnt = 0;
+	int mapCnt;
+	int rosAxis[MAX_PULSE_AXES];
+	int pulseAxis[MAX_PULSE_AXES];
+	float conversion[MAX_PULSE_AXES];
+	long double t;
+	JointMotionData curTrajData;
+	float interval;
+	float accCoef1[MP_GRP_AXES_NUM];
+	float accCoef2[MP_GRP_AXES_NUM];
+	int timeInc_ms;
+	int calculationTime_ms;
+	float interpolTime;
+
+	memcpy(&curTrajData, startTrajData, sizeof(JointMotionData));
+
+	memset(&accCoef1, 0x00, sizeof(accCoef1));
+	memset(&accCoef2, 0x00, sizeof(accCoef2));
+	interval = (endTrajData->time - startTrajData->time) / 1000.0f;
+	if (interval > 0.0)
+	{
+		for (i = 0; i < ctrlGroup->numAxes; i++)
+		{
+			accCoef1[i] = ( 6 * (endTrajData->pos[i] - startTrajData->pos[i]) / (interval * interval) )
+						- ( 2 * (endTrajData->vel[i] + 2 * startTrajData->vel[i]) / interval);
+			accCoef2[i] = ( -12 * (endTrajData->pos[i] - startTrajData->pos[i]) / (interval * interval * interval))
+						+ ( 6 * (endTrajData->vel[i] + startTrajData->vel[i]) / (interval * interval) );
+		}
+	}
+
+	mapCnt = Ros_CtrlGroup_GetPulseAxisMap(ctrlGroup, rosAxis, pulseAxis, conversion);
+
+	calculationTime_ms = startTrajData->time;
+	if(*timeLeftover_ms == 0)
+		timeInc_ms = interpolPeriod;
+	else
+		timeInc_ms = *timeLeftover_ms;
+
+	while(curTrajData.time < endTrajData->time)
+	{
+		calculationTime_ms += timeInc_ms;
+		interpolTime = (calculationTime_ms - startTrajData->time) / 1000.0f;
+
+		if( calculationTime_ms < endTrajData->time )
+		{
+			curTrajData.time = calculationTime_ms;
+			for (i = 0; i < ctrlGroup->numAxes; i++)
+			{
+				curTrajData.pos[i] = startTrajData->pos[i]
+					+ startTrajData->vel[i] * interpolTime
+					+ accCoef1[i] * interpolTime * interpolTime / 2
+					+ accCoef2[i] * interpolTime * interpolTime * interpolTime / 6;
+			}
+			if(timeInc_ms < interpolPeriod)
+			{
+				timeInc_ms = interpolPeriod;
+				*timeLeftover_ms = 0;
+			}
+		}
+		else
+		{
+			memcpy(&curTrajData, endTrajData, sizeof(JointMotionData));
+			if(calculationTime_ms > endTrajData->time)
+				*timeLeftover_ms = calculationTime_ms - endTrajData->time;
+		}
+
+		Ros_CtrlGroup_ConvertToMotoPos(ctrlGroup, curTrajData.pos, pulsePos[cnt]);
+
+		memcpy(exactPos[cnt], pulsePos[cnt], sizeof(exactPos[cnt]));
+		t = (calculationTime_ms - startTrajData->time) / 1000.0L;
+		for (k = 0; k < mapCnt; k++)
+		{
+			i = rosAxis[k];
+			exactPos[cnt][pulseAxis[k]] = (long)((startTrajData->pos[i] + startTrajData->vel[i] * t
+				+ accCoef1[i] * t * t / 2 + accCoef2[i] * t * t * t / 6) * conversion[k]);
+		}
+		cnt++;
+	}
+
+	return cnt;
+}
+
+//-----------------------------------------------------------------------
+// Same segment with the forward differencing used by the motion server
+//-----------------------------------------------------------------------
+static int Test_ForwardDiffSegment(CtrlGroup* ctrlGroup, int interpolPeriod, JointMotionData* startTrajData,
+								JointMotionData* endTrajData, int* timeLeftover_ms, long pulsePos[][MAX_PULSE_AXES])
+{
+	int cnt = 0;
+	int curTime = startTrajData->time;
+	InterpolationSegment segment;
+	JointMotionData curTrajData;
+	int timeInc_ms;
+	int calculationTime_ms;
+	long prevPulsePos[MAX_PULSE_AXES];
+
+	Ros_CtrlGroup_ConvertToMotoPos(ctrlGroup, startTrajData->pos, prevPulsePos);
+
+	calculationTime_ms = startTrajData->time;
+	if(*timeLeftover_ms == 0)
+		timeInc_ms = interpolPeriod;
+	else
+		timeInc_ms = *timeLeftover_ms;
+
+	Ros_Interpolation_InitSegment(&segment, ctrlGroup, startTrajData, endTrajData, calculationTime_ms + timeInc_ms, interpolPeriod);
+
+	while(curTime < endTrajData->time)
+	{
+		calculationTime_ms += timeInc_ms;
+		memcpy(pulsePos[cnt], prevPulsePos, sizeof(prevPulsePos));
+
+		if( calculationTime_ms < endTrajData->time )
+		{
+			curTime = calculationTime_ms;
+			Ros_Interpolation_NextPulsePos(&segment, pulsePos[cnt]);
+			if(timeInc_ms < interpolPeriod)
+			{
+				timeInc_ms = interpolPeriod;
+				*timeLeftover_ms = 0;
+			}
+		}
+		else
+		{
+			memcpy(&curTrajData, endTrajData, sizeof(JointMotionData));
+			curTime = endTrajData->time;
+			if(calculationTime_ms > endTrajData->time)
+				*timeLeftover_ms = calculationTime_ms - endTrajData->time;
+			Ros_CtrlGroup_ConvertToMotoPos(ctrlGroup, curTrajData.pos, pulsePos[cnt]);
+		}
+
+		memcpy(prevPulsePos, pulsePos[cnt], sizeof(prevPulsePos));
+		cnt++;
+	}
+
+	return cnt;
+}
+
+static void Test_InitCtrlGroup(CtrlGroup* ctrlGroup, const TestCase* testCase)
+{
+	int i;
+
+	memset(ctrlGroup, 0x00, sizeof(CtrlGroup));
+	ctrlGroup->numAxes = testCase->numAxes;
+	ctrlGroup->groupId = testCase->groupId;
+	for(i = 0; i < MAX_PULSE_AXES; i++)
+	{
+		ctrlGroup->axisType.type[i] = testCase->axisType[i];
+		ctrlGroup->pulseToRad.PtoR[i] = (float)Test_Random(50000.0, 400000.0);
+		ctrlGroup->pulseToMeter.PtoM[i] = (float)Test_Random(500000.0, 2000000.0);
+	}
+}
+
+static void Test_RandomPoint(CtrlGroup* ctrlGroup, JointMotionData* prev, JointMotionData* point)
+{
+	int i;
+
+	memset(point, 0x00, sizeof(JointMotionData));
+	// Mostly streaming rates, with some long and some zero length segments
+	switch(rand() % 8)
+	{
+		case 0: point->time = prev->time; break;
+		case 1: point->time = prev->time + 100 + rand() % 1900; break;
+		default: point->time = prev->time + 1 + rand() % 50; break;
+	}
+	for(i = 0; i < ctrlGroup->numAxes; i++)
+	{
+		point->pos[i] = (float)Test_Random(-3.0, 3.0);
+		point->vel[i] = (float)Test_Random(-2.0, 2.0);
+	}
+}
+
+static BOOL Test_RunCase(const TestCase* testCase, int segments, double* refTime_us, double* newTime_us, long* totalCycles)
+{
+	CtrlGroup ctrlGroup;
+	JointMotionData startTrajData, endTrajData;
+	int refLeftover = 0, newLeftover = 0;
+	int refCnt, newCnt;
+	int n, c, a;
+	long diff, refError, maxDiff = 0;
+	long cycles = 0, mismatches = 0;
+	double t0;
+	BOOL bOk = TRUE;
+
+	Test_InitCtrlGroup(&ctrlGroup, testCase);
+	memset(&startTrajData, 0x00, sizeof(startTrajData));
+
+	for(n = 0; n < segments; n++)
+	{
+		Test_RandomPoint(&ctrlGroup, &startTrajData, &endTrajData);
+
+		t0 = Test_Now_us();
+		refCnt = Test_ReferenceSegment(&ctrlGroup, testCase->interpolPeriod, &startTrajData, &endTrajData, &refLeftover, refPulsePos, exactPulsePos);
+		*refTime_us += Test_Now_us() - t0;
+
+		t0 = Test_Now_us();
+		newCnt = Test_ForwardDiffSegment(&ctrlGroup, testCase->interpolPeriod, &startTrajData, &endTrajData, &newLeftover, newPulsePos);
+		*newTime_us += Test_Now_us() - t0;
+
+		if((refCnt != newCnt) || (refLeftover != newLeftover))
+		{
+			printf("%s: segment %d has %d cycles (leftover %d ms), expected %d (leftover %d ms)\r\n",
+				testCase->name, n, newCnt, newLeftover, refCnt, refLeftover);
+			return FALSE;
+		}
+
+		for(c = 0; c < refCnt; c++)
+		{
+			BOOL bMatch = TRUE;
+			for(a = 0; a < MAX_PULSE_AXES; a++)
+			{
+				diff = labs(newPulsePos[c][a] - refPulsePos[c][a]);
+				maxDiff = max(maxDiff, diff);
+				if(diff != 0)
+					bMatch = FALSE;
+
+				if(c == refCnt - 1)
+				{
+					// End of the segment
+					if(diff != 0)
+					{
+						printf("%s: segment %d ends at %ld pulse on axis %d, expected %ld\r\n",
+							testCase->name, n, newPulsePos[c][a], a, refPulsePos[c][a]);
+						bOk = FALSE;
+					}
+				}
+				else
+				{
+					refError = labs(refPulsePos[c][a] - exactPulsePos[c][a]);
+					if((labs(newPulsePos[c][a] - exactPulsePos[c][a]) > 1) || (diff > refError + 1))
+					{
+						printf("%s: segment %d cycle %d/%d axis %d is %ld pulse, expected %ld (exact %ld)\r\n",
+							testCase->name, n, c, refCnt, a, newPulsePos[c][a], refPulsePos[c][a], exactPulsePos[c][a]);
+						bOk = FALSE;
+					}
+				}
+			}
+			if(!bMatch)
+				mismatches++;
+		}
+		cycles += refCnt;
+
+		if(!bOk)
+			return FALSE;
+
+		memcpy(&startTrajData, &endTrajData, sizeof(JointMotionData));
+	}
+
+	printf("%-22s %8ld cycles, %6.3f%% not bit-exact, max difference %ld pulse\r\n",
+		testCase->name, cycles, 100.0 * mismatches / max(cycles, 1), maxDiff);
+	*totalCycles += cycles;
+	return TRUE;
+}
+
+int main(int argc, char** argv)
+{
+	int i;
+	int segments = TEST_DEFAULT_SEGMENTS;
+	double refTime_us = 0.0, newTime_us = 0.0;
+	long totalCycles = 0;
+	BOOL bOk = TRUE;
+
+	if(argc > 1)
+		segments = atoi(argv[1]);
+
+	srand(1);
+	for(i = 0; i < (int)(sizeof(testCases) / sizeof(testCases[0])); i++)
+		bOk &= Test_RunCase(&testCases[i], segments, &refTime_us, &newTime_us, &totalCycles);
+
+	printf("Reference: %.1f ns/cycle, forward differencing: %.1f ns/cycle\r\n",
+		1000.0 * refTime_us / max(totalCycles, 1), 1000.0 * newTime_us / max(totalCycles, 1));
+
+	printf("%s\r\n", bOk ? "PASSED" : "FAILED");
+	return bOk ? 0 : 1;
+}
@@ -0,0 +1,480 @@
+//IoServerTest.c
+//
+// Test of the multi-element I/O messages (READ_IO_MULTI and WRITE_IO_MULTI)
+// of the IO server against the simulated I/O of mpSim.c. Values written by
+// a WRITE_IO_MULTI must be read back by the single-element messages and by
+// a READ_IO_MULTI, invalid elements must be reported on their own without
+// failing the others, and malformed messages must be rejected.
+// An IO_SUBSCRIBE must reply with the current values and then stream an
+// IO_CHANGED message with only the elements that changed, plus keepalives.
+// All MAX_IO_CONNECTIONS connections must be served at once: a connection
+// waiting for the rest of a message must not delay the others.
+// The address and value validation must accept exactly what the original
+// chains of range comparisons accepted, over the whole address space.
+//
+// Usage: IoServerTest
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "MotoROS.h"
+#include "mpSim.h"
+
+static SimpleMsg receiveMsg;
+static SimpleMsg replyMsg;
+
+static void Test_InitMsg(SmMsgType msgType)
+{
+	memset(&receiveMsg, 0x00, sizeof(SimpleMsg));
+	receiveMsg.header.msgType = msgType;
+	receiveMsg.header.commType = ROS_COMM_SERVICE_REQUEST;
+}
+
+static void Test_AddWrite(UINT32 ioAddress, IoMultiSize size, UINT32 value)
+{
+	SmIoMultiWriteElement* element = &receiveMsg.body.writeIOMulti.elements[receiveMsg.body.writeIOMulti.numberOfElements++];
+
+	element->ioAddress = ioAddress;
+	element->size = size;
+	element->value = value;
+}
+
+static void Test_AddRead(UINT32 ioAddress, IoMultiSize size)
+{
+	SmIoMultiReadElement* element = &receiveMsg.body.readIOMulti.elements[receiveMsg.body.readIOMulti.numberOfElements++];
+
+	element->ioAddress = ioAddress;
+	element->size = size;
+}
+
+static BOOL Test_ReplyLength(int bodySize)
+{
+	return (replyMsg.prefix.length == (int)(sizeof(SmHeader) + bodySize));
+}
+
+static BOOL Test_WriteRead(void)
+{
+	BOOL bOk = TRUE;
+	int i;
+
+	Test_InitMsg(ROS_MSG_MOTO_WRITE_IO_MULTI);
+	Test_AddWrite(10020, IO_MULTI_BIT, 1);
+	Test_AddWrite(1003, IO_MULTI_GROUP, 0xA5);
+	Test_AddWrite(5, IO_MULTI_MREGISTER, 1234);
+	Test_AddWrite(1000006, IO_MULTI_MREGISTER, 0xFFFF);
+	bOk &= (Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg) == OK);
+	bOk &= (replyMsg.header.msgType == ROS_MSG_MOTO_WRITE_IO_MULTI_REPLY) && (replyMsg.header.replyType == ROS_REPLY_SUCCESS);
+	bOk &= Test_ReplyLength(sizeof(int) * 2 + sizeof(IoResultCodes) * 4);
+	bOk &= (replyMsg.body.writeIOMultiReply.numberOfElements == 4) && (replyMsg.body.writeIOMultiReply.resultCode == IO_RESULT_OK);
+	for (i = 0; i < 4; i++)
+		bOk &= (replyMsg.body.writeIOMultiReply.resultCodes[i] == IO_RESULT_OK);
+
+	// The single-element messages see the same values
+	Test_InitMsg(ROS_MSG_MOTO_READ_IO_GROUP);
+	receiveMsg.body.readIOGroup.ioAddress = 1003;
+	Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
+	bOk &= (replyMsg.body.readIOGroupReply.value == 0xA5);
+
+	Test_InitMsg(ROS_MSG_MOTO_READ_MREGISTER);
+	receiveMsg.body.readRegister.registerNumber = 5;
+	Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
+	bOk &= (replyMsg.body.readRegisterReply.value == 1234);
+
+	Test_InitMsg(ROS_MSG_MOTO_READ_IO_MULTI);
+	Test_AddRead(1000006, IO_MULTI_MREGISTER);
+	Test_AddRead(10020, IO_MULTI_BIT);
+	Test_AddRead(10021, IO_MULTI_BIT);
+	Test_AddRead(1003, IO_MULTI_GROUP);
+	Test_AddRead(5, IO_MULTI_MREGISTER);
+	bOk &= (Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg) == OK);
+	bOk &= (replyMsg.header.msgType == ROS_MSG_MOTO_READ_IO_MULTI_REPLY) && (replyMsg.header.replyType == ROS_REPLY_SUCCESS);
+	bOk &= Test_ReplyLength(sizeof(int) * 2 + sizeof(SmIoMultiReadValue) * 5);
+	bOk &= (replyMsg.body.readIOMultiReply.numberOfElements == 5) && (replyMsg.body.readIOMultiReply.resultCode == IO_RESULT_OK);
+	bOk &= (replyMsg.body.readIOMultiReply.values[0].value == 0xFFFF);
+	bOk &= (replyMsg.body.readIOMultiReply.values[1].value == 1);
+	bOk &= (replyMsg.body.readIOMultiReply.values[2].value == 0);
+	bOk &= (replyMsg.body.readIOMultiReply.values[3].value == 0xA5);
+	bOk &= (replyMsg.body.readIOMultiReply.values[4].value == 1234);
+
+	printf("%-9s %s\r\n", "write", bOk ? "ok" : "failed");
+	return bOk;
+}
+
+static BOOL Test_InvalidElements(void)
+{
+	BOOL bOk = TRUE;
+
+	Test_InitMsg(ROS_MSG_MOTO_WRITE_IO_MULTI);
+	Test_AddWrite(10030, IO_MULTI_BIT, 1);
+	Test_AddWrite(10, IO_MULTI_BIT, 1);				// general input: read-only
+	Test_AddWrite(10031, IO_MULTI_BIT, 2);
+	Test_AddWrite(10032, (IoMultiSize)7, 1);
+	Test_AddWrite(1004, IO_MULTI_GROUP, 0x3C);
+	Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
+	bOk &= (replyMsg.header.replyType == ROS_REPLY_FAILURE);
+	bOk &= (replyMsg.body.writeIOMultiReply.resultCode == IO_RESULT_WRITE_ADDRESS_INVALID);
+	bOk &= (replyMsg.body.writeIOMultiReply.resultCodes[0] == IO_RESULT_OK);
+	bOk &= (replyMsg.body.writeIOMultiReply.resultCodes[1] == IO_RESULT_WRITE_ADDRESS_INVALID);
+	bOk &= (replyMsg.body.writeIOMultiReply.resultCodes[2] == IO_RESULT_WRITE_VALUE_INVALID);
+	bOk &= (replyMsg.body.writeIOMultiReply.resultCodes[3] == IO_RESULT_WRITE_ADDRESS_INVALID);
+	bOk &= (replyMsg.body.writeIOMultiReply.resultCodes[4] == IO_RESULT_OK);
+
+	// The valid elements were written regardless
+	Test_InitMsg(ROS_MSG_MOTO_READ_IO_MULTI);
+	Test_AddRead(10030, IO_MULTI_BIT);
+	Test_AddRead(9, IO_MULTI_BIT);					// last digit 9
+	Test_AddRead(1004, IO_MULTI_GROUP);
+	Test_AddRead(2000000, IO_MULTI_MREGISTER);
+	Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
+	bOk &= (replyMsg.header.replyType == ROS_REPLY_FAILURE);
+	bOk &= (replyMsg.body.readIOMultiReply.resultCode == IO_RESULT_READ_ADDRESS_INVALID);
+	bOk &= (replyMsg.body.readIOMultiReply.values[0].resultCode == IO_RESULT_OK) && (replyMsg.body.readIOMultiReply.values[0].value == 1);
+	bOk &= (replyMsg.body.readIOMultiReply.values[1].resultCode == IO_RESULT_READ_ADDRESS_INVALID);
+	bOk &= (replyMsg.body.readIOMultiReply.values[2].resultCode == IO_RESULT_OK) && (replyMsg.body.readIOMultiReply.values[2].value == 0x3C);
+	bOk &= (replyMsg.body.readIOMultiReply.values[3].resultCode == IO_RESULT_READ_ADDRESS_INVALID);
+
+	printf("%-9s %s\r\n", "invalid", bOk ? "ok" : "failed");
+	return bOk;
+}
+
+static BOOL Test_Malformed(void)
+{
+	BOOL bOk = TRUE;
+	int i;
+
+	Test_InitMsg(ROS_MSG_MOTO_READ_IO_MULTI);
+	Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
+	bOk &= (replyMsg.header.msgType == ROS_MSG_MOTO_MOTION_REPLY);
+	bOk &= (replyMsg.body.ioCtrlReply.result == ROS_RESULT_INVALID) && (replyMsg.body.ioCtrlReply.subcode == ROS_RESULT_INVALID_DATA);
+
+	Test_InitMsg(ROS_MSG_MOTO_WRITE_IO_MULTI);
+	receiveMsg.body.writeIOMulti.numberOfElements = ROS_MAX_IO_MULTI + 1;
+	Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
+	bOk &= (replyMsg.header.msgType == ROS_MSG_MOTO_MOTION_REPLY);
+	bOk &= (replyMsg.body.ioCtrlReply.result == ROS_RESULT_INVALID) && (replyMsg.body.ioCtrlReply.subcode == ROS_RESULT_INVALID_DATA);
+
+	// A full message of groups
+	Test_InitMsg(ROS_MSG_MOTO_READ_IO_MULTI);
+	for (i = 0; i < ROS_MAX_IO_MULTI; i++)
+		Test_AddRead(1001 + i, IO_MULTI_GROUP);
+	Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
+	bOk &= (replyMsg.header.replyType == ROS_REPLY_SUCCESS) && (replyMsg.body.readIOMultiReply.values[3].value == 0x3C);
+
+	printf("%-9s %s\r\n", "malformed", bOk ? "ok" : "failed");
+	return bOk;
+}
+
+// Receive the next IO_CHANGED message sent to the client end of the connection
+static BOOL Test_RecvChanged(int sd, int timeout_ms, SimpleMsg* msg)
+{
+	struct timeval timeout;
+	int byteSize;
+
+	timeout.tv_sec = timeout_ms / 1000;
+	timeout.tv_usec = (timeout_ms % 1000) * 1000;
+	mpSetsockopt(sd, SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof(timeout));
+
+	memset(msg, 0x00, sizeof(SimpleMsg));
+	if (recv(sd, msg, sizeof(SmPrefix), MSG_WAITALL) != (int)sizeof(SmPrefix))
+		return FALSE;
+	byteSize = recv(sd, (char*)msg + sizeof(SmPrefix), msg->prefix.length, MSG_WAITALL);
+	return (byteSize == msg->prefix.length) && (msg->header.msgType == ROS_MSG_MOTO_IO_CHANGED);
+}
+
+static BOOL Test_Subscription(void)
+{
+	static Controller controller;
+	SimpleMsg changedMsg;
+	SmBodyMotoIoChanged* changed = &changedMsg.body.ioChanged;
+	int sds[2];
+	BOOL bOk = TRUE;
+
+	socketpair(AF_UNIX, SOCK_STREAM, 0, sds);
+	controller.interpolPeriod = simConfig.interpolPeriod;
+	controller.sdIoConnections[0] = sds[0];
+	controller.tidIoConnections[0] = INVALID_TASK;
+	controller.semIoConnection[0] = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+	controller.tidIoSubscription[0] = INVALID_TASK;
+	controller.tidIoSendSubscription[0] = INVALID_TASK;
+	controller.semIoSampleReady[0] = mpSemBCreate(SEM_Q_FIFO, SEM_EMPTY);
+
+	Test_InitMsg(ROS_MSG_MOTO_WRITE_IO_MULTI);
+	Test_AddWrite(7, IO_MULTI_MREGISTER, 100);
+	Test_AddWrite(1004, IO_MULTI_GROUP, 0x11);
+	Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
+
+	// Subscribe as the receiving task does: with the lock of the connection taken
+	Test_InitMsg(ROS_MSG_MOTO_IO_SUBSCRIBE);
+	receiveMsg.body.ioSubscribe.period = 10;
+	receiveMsg.body.ioSubscribe.numberOfElements = 3;
+	receiveMsg.body.ioSubscribe.elements[0].ioAddress = 7;
+	receiveMsg.body.ioSubscribe.elements[0].size = IO_MULTI_MREGISTER;
+	receiveMsg.body.ioSubscribe.elements[1].ioAddress = 1004;
+	receiveMsg.body.ioSubscribe.elements[1].size = IO_MULTI_GROUP;
+	receiveMsg.body.ioSubscribe.elements[2].ioAddress = 99999;
+	receiveMsg.body.ioSubscribe.elements[2].size = IO_MULTI_BIT;
+	mpSemTake(controller.semIoConnection[0], WAIT_FOREVER);
+	bOk &= (Ros_IoServer_Subscribe(&controller, 0, &receiveMsg, &replyMsg) == OK);
+	mpSemGive(controller.semIoConnection[0]);
+	bOk &= (replyMsg.header.msgType == ROS_MSG_MOTO_IO_SUBSCRIBE_REPLY) && (replyMsg.header.replyType == ROS_REPLY_FAILURE);
+	bOk &= Test_ReplyLength(sizeof(int) * 2 + sizeof(SmIoMultiReadValue) * 3);
+	bOk &= (replyMsg.body.ioSubscribeReply.values[0].value == 100) && (replyMsg.body.ioSubscribeReply.values[1].value == 0x11);
+	bOk &= (replyMsg.body.ioSubscribeReply.values[2].resultCode == IO_RESULT_READ_ADDRESS_INVALID);
+
+	// Only the element that changed is sent
+	Test_InitMsg(ROS_MSG_MOTO_WRITE_IO_MULTI);
+	Test_AddWrite(1004, IO_MULTI_GROUP, 0x22);
+	Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
+	bOk &= Test_RecvChanged(sds[1], 500, &changedMsg);
+	bOk &= (changedMsg.prefix.length == (int)(sizeof(SmHeader) + sizeof(UINT32) + sizeof(int) + sizeof(SmIoMultiWriteElement)));
+	bOk &= (changedMsg.header.commType == ROS_COMM_TOPIC) && (changed->numberOfElements == 1);
+	bOk &= (changed->elements[0].ioAddress == 1004) && (changed->elements[0].size == IO_MULTI_GROUP) && (changed->elements[0].value == 0x22);
+	bOk &= (changed->time > 0) && (changed->time % simConfig.interpolPeriod == 0);
+
+	// Nothing changes: a keepalive without elements
+	bOk &= Test_RecvChanged(sds[1], IO_SUBSCRIPTION_KEEPALIVE_PERIOD * 2, &changedMsg);
+	bOk &= (changed->numberOfElements == 0);
+
+	// Unsubscribed: nothing more is sent
+	Test_InitMsg(ROS_MSG_MOTO_IO_SUBSCRIBE);
+	mpSemTake(controller.semIoConnection[0], WAIT_FOREVER);
+	Ros_IoServer_Subscribe(&controller, 0, &receiveMsg, &replyMsg);
+	mpSemGive(controller.semIoConnection[0]);
+	bOk &= (replyMsg.header.replyType == ROS_REPLY_SUCCESS) && Test_ReplyLength(sizeof(int) * 2);
+	Test_InitMsg(ROS_MSG_MOTO_WRITE_IO_MULTI);
+	Test_AddWrite(7, IO_MULTI_MREGISTER, 101);
+	Ros_IoServer_SimpleMsgProcess(&receiveMsg, &replyMsg);
+	bOk &= !Test_RecvChanged(sds[1], 100, &changedMsg);
+
+	mpDeleteTask(controller.tidIoSubscription[0]);
+	mpDeleteTask(controller.tidIoSendSubscription[0]);
+	close(sds[0]);
+	close(sds[1]);
+
+	printf("%-9s %s\r\n", "subscribe", bOk ? "ok" : "failed");
+	return bOk;
+}
+
+// Send the client part of a request frame: its first byteSize bytes, or all of it
+static void Test_SendRequest(int sd, int bodySize, int byteSize)
+{
+	receiveMsg.prefix.length = sizeof(SmHeader) + bodySize;
+	if (byteSize < 0)
+		byteSize = sizeof(SmPrefix) + receiveMsg.prefix.length;
+	send(sd, &receiveMsg, byteSize, 0);
+}
+
+static BOOL Test_RecvReply(int sd, int timeout_ms, SmMsgType msgType)
+{
+	struct timeval timeout;
+	SimpleMsg msg;
+
+	timeout.tv_sec = timeout_ms / 1000;
+	timeout.tv_usec = (timeout_ms % 1000) * 1000;
+	mpSetsockopt(sd, SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof(timeout));
+
+	memset(&msg, 0x00, sizeof(SimpleMsg));
+	if (recv(sd, &msg, sizeof(SmPrefix), MSG_WAITALL) != (int)sizeof(SmPrefix))
+		return FALSE;
+	return (recv(sd, (char*)&msg + sizeof(SmPrefix), msg.prefix.length, MSG_WAITALL) == msg.prefix.length) &&
+		(msg.header.msgType == msgType) && (msg.header.replyType == ROS_REPLY_SUCCESS);
+}
+
+static BOOL Test_Connections(void)
+{
+	static Controller controller;
+	int readSize = sizeof(int) + sizeof(SmIoMultiReadElement) * 4;
+	int sds[MAX_IO_CONNECTIONS][2];
+	int i;
+	BOOL bOk = TRUE;
+
+	controller.interpolPeriod = simConfig.interpolPeriod;
+	for (i = 0; i < MAX_IO_CONNECTIONS; i++)
+	{
+		controller.sdIoConnections[i] = INVALID_SOCKET;
+		controller.tidIoConnections[i] = INVALID_TASK;
+		controller.semIoConnection[i] = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+		controller.tidIoSubscription[i] = INVALID_TASK;
+		controller.tidIoSendSubscription[i] = INVALID_TASK;
+	}
+
+	for (i = 0; i < MAX_IO_CONNECTIONS; i++)
+	{
+		socketpair(AF_UNIX, SOCK_STREAM, 0, sds[i]);
+		Ros_IoServer_StartNewConnection(&controller, sds[i][0]);
+		bOk &= (controller.sdIoConnections[i] == sds[i][0]) && (controller.tidIoConnections[i] != INVALID_TASK);
+	}
+
+	Test_InitMsg(ROS_MSG_MOTO_READ_IO_MULTI);
+	for (i = 0; i < 4; i++)
+		Test_AddRead(1001 + i, IO_MULTI_GROUP);
+
+	// The first connection waits for the rest of its request...
+	Test_SendRequest(sds[0][1], readSize, sizeof(SmPrefix) + sizeof(SmHeader) + sizeof(int));
+
+	// ...while the others are served
+	for (i = 1; i < MAX_IO_CONNECTIONS; i++)
+		Test_SendRequest(sds[i][1], readSize, -1);
+	for (i = MAX_IO_CONNECTIONS - 1; i > 0; i--)
+		bOk &= Test_RecvReply(sds[i][1], 500, ROS_MSG_MOTO_READ_IO_MULTI_REPLY);
+	bOk &= !Test_RecvReply(sds[0][1], 100, ROS_MSG_MOTO_READ_IO_MULTI_REPLY);
+
+	send(sds[0][1], (char*)&receiveMsg + sizeof(SmPrefix) + sizeof(SmHeader) + sizeof(int), readSize - sizeof(int), 0);
+	bOk &= Test_RecvReply(sds[0][1], 500, ROS_MSG_MOTO_READ_IO_MULTI_REPLY);
+
+	// Closing the client ends stops the connections
+	for (i = 0; i < MAX_IO_CONNECTIONS; i++)
+		close(sds[i][1]);
+	Ros_Sleep(200);
+	for (i = 0; i < MAX_IO_CONNECTIONS; i++)
+		bOk &= (controller.sdIoConnections[i] == INVALID_SOCKET) && (controller.tidIoConnections[i] == INVALID_TASK);
+
+	printf("%-9s %s\r\n", "connect", bOk ? "ok" : "failed");
+	return bOk;
+}
+
+//-----------------------------------------------------------------------
+// Reference: the validation as it was before the range tables
+//-----------------------------------------------------------------------
+static BOOL Test_RefIsValidReadAddress(UINT32 address, IoAccessSize size)
+{
+	if (size == IO_ACCESS_GROUP)
+		address *= 10;
+
+	if (size != IO_ACCESS_REGISTER && address % 10 > 7)
+		return FALSE;
+
+	return ((address >= GENERALINMIN && address <= GENERALINMAX) ||
+		(address >= GENERALOUTMIN && address <= GENERALOUTMAX) ||
+		(address >= EXTERNALINMIN && address <= EXTERNALINMAX) ||
+		(address >= NETWORKINMIN && address <= NETWORKINMAX) ||
+		(address >= NETWORKOUTMIN && address <= NETWORKOUTMAX) ||
+		(address >= EXTERNALOUTMIN && address <= EXTERNALOUTMAX) ||
+		(address >= SPECIFICINMIN && address <= SPECIFICINMAX) ||
+		(address >= SPECIFICOUTMIN && address <= SPECIFICOUTMAX) ||
+		(address >= IFPANELMIN && address <= IFPANELMAX) ||
+		(address >= AUXRELAYMIN && address <= AUXRELAYMAX) ||
+		(address >= CONTROLSTATUSMIN && address <= CONTROLSTATUSMAX) ||
+		(address >= PSEUDOINPUTMIN && address <= PSEUDOINPUTMAX) ||
+		(address >= REGISTERMIN && address <= REGISTERMAX_READ));
+}
+
+static BOOL Test_RefIsValidWriteAddress(UINT32 address, IoAccessSize size)
+{
+	if (size == IO_ACCESS_GROUP)
+		address *= 10;
+
+	if (size != IO_ACCESS_REGISTER && address % 10 > 7)
+		return FALSE;
+
+	return ((address >= GENERALOUTMIN && address <= GENERALOUTMAX) ||
+		(address >= NETWORKINMIN && address <= NETWORKINMAX) ||
+		(address >= IFPANELMIN && address <= IFPANELMAX) ||
+		(address >= REGISTERMIN && address <= REGISTERMAX_WRITE));
+}
+
+static BOOL Test_RefIsValidWriteValue(UINT32 value, IoAccessSize size)
+{
+	if (size == IO_ACCESS_REGISTER && value > 0xFFFF)
+		return FALSE;
+
+	if (size == IO_ACCESS_GROUP && value > 0xFF)
+		return FALSE;
+
+	if (size == IO_ACCESS_BIT && value > 1)
+		return FALSE;
+
+	return TRUE;
+}
+
+// Addresses below it cover the whole address map (the last M register is 1000999)
+#define TEST_VALIDATION_ADDRESSES 0x200000
+
+static UINT32 Test_CompareValidation(UINT32 address, IoAccessSize size)
+{
+	// the value check is compared on the same numbers
+	if ((!Ros_IoServer_IsValidReadAddress(address, size) != !Test_RefIsValidReadAddress(address, size)) ||
+		(!Ros_IoServer_IsValidWriteAddress(address, size) != !Test_RefIsValidWriteAddress(address, size)) ||
+		(!Ros_IoServer_IsValidWriteValue(address, size) != !Test_RefIsValidWriteValue(address, size)))
+	{
+		printf("validation mismatch: %u (size %d)\r\n", address, size);
+		return 1;
+	}
+	return 0;
+}
+
+static BOOL Test_Validation(void)
+{
+	IoAccessSize size;
+	UINT32 address;
+	UINT32 wrap;
+	UINT32 mismatches = 0;
+
+	for (size = IO_ACCESS_BIT; size <= IO_ACCESS_REGISTER; size += 1)
+	{
+		for (address = 0; address < TEST_VALIDATION_ADDRESSES; address += 1)
+			mismatches += Test_CompareValidation(address, size);
+
+		// the largest numbers
+		for (address = 0xFFFFFFFF; address > 0xFFFFFFFF - TEST_VALIDATION_ADDRESSES; address -= 1)
+			mismatches += Test_CompareValidation(address, size);
+	}
+
+	// groups which bit address overflows back into the address map
+	for (wrap = 1; wrap < 10; wrap += 1)
+	{
+		address = (UINT32)((wrap * 0x100000000ULL + 9) / 10);
+		for (; address * 10 < TEST_VALIDATION_ADDRESSES; address += 1)
+			mismatches += Test_CompareValidation(address, IO_ACCESS_GROUP);
+	}
+
+	printf("%-9s %s\r\n", "validate", (mismatches == 0) ? "ok" : "failed");
+	return (mismatches == 0);
+}
+
+int main(int argc, char** argv)
+{
+	BOOL bOk = TRUE;
+
+	Sim_Init();
+
+	bOk &= Test_WriteRead();
+	bOk &= Test_InvalidElements();
+	bOk &= Test_Malformed();
+	bOk &= Test_Subscription();
+	bOk &= Test_Connections();
+	bOk &= Test_Validation();
+
+	printf("%s\r\n", bOk ? "PASSED" : "FAILED");
+	return bOk ? 0 : 1;
+}
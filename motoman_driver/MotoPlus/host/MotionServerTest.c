@@ -0,0 +1,336 @@
+//MotionServerTest.c
+//
+// Test of the trajectory point sequencing of the motion server: the points
+// of a trajectory are accepted in order, a resent point (after a lost reply)
+// is acknowledged without being queued twice, a point past the next expected
+// one and a point sent to a full queue are rejected as busy, and a point that
+// doesn't follow a first point is rejected as an invalid sequence. A first
+// point that fails validation must leave the current trajectory untouched.
+//
+// Usage: MotionServerTest
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#include "MotoROS.h"
+#include "mpSim.h"
+
+// Not exported by MotionServer.h
+extern int Ros_MotionServer_AddTrajPointEx(Controller* controller, int numberOfValidGroups, int sequence,
+											SmBodyJointTrajPtExData* jointTrajPtData, int* subcode, int* groupNo);
+extern int Ros_MotionServer_InitTrajPointFull(CtrlGroup* ctrlGroup, SmBodyJointTrajPtFull* jointTrajData);
+extern int Ros_MotionServer_AddTrajPointFull(CtrlGroup* ctrlGroup, SmBodyJointTrajPtFull* jointTrajData);
+extern BOOL Ros_MotionServer_GetNextTrajPoint(CtrlGroup* ctrlGroup);
+extern BOOL Ros_MotionServer_ClearQ(Controller* controller, int groupNo);
+extern void Ros_MotionServer_JointTrajDataToIncQueue(Controller* controller, int groupNo);
+extern int Ros_MotionServer_MotionCtrlProcess(Controller* controller, SimpleMsg* receiveMsg, SimpleMsg* replyMsg);
+
+static Controller controller;
+static CtrlGroup* ctrlGroup;
+static float startPos[MAX_PULSE_AXES];
+
+static void Test_Point(int sequence, float time, float offset, SmBodyJointTrajPtFull* point)
+{
+	int i;
+
+	memset(point, 0x00, sizeof(SmBodyJointTrajPtFull));
+	point->groupNo = 0;
+	point->sequence = sequence;
+	point->validFields = Valid_Time | Valid_Position | Valid_Velocity;
+	point->time = time;
+	for (i = 0; i < ctrlGroup->numAxes; i++)
+		point->pos[i] = startPos[i] + offset;
+}
+
+static int Test_Init(int sequence, float time, float offset)
+{
+	SmBodyJointTrajPtFull point;
+
+	Test_Point(sequence, time, offset, &point);
+	return Ros_MotionServer_InitTrajPointFull(ctrlGroup, &point);
+}
+
+static int Test_Add(int sequence)
+{
+	SmBodyJointTrajPtFull point;
+
+	Test_Point(sequence, 0.1f * sequence, 0.001f * sequence, &point);
+	return Ros_MotionServer_AddTrajPointFull(ctrlGroup, &point);
+}
+
+static int Test_AddEx(int sequence, int* subcode)
+{
+	SmBodyJointTrajPtFull point;
+	SmBodyJointTrajPtExData pointEx;
+	int groupNo;
+
+	Test_Point(sequence, 0.1f * sequence, 0.001f * sequence, &point);
+	pointEx.groupNo = point.groupNo;
+	pointEx.validFields = point.validFields;
+	pointEx.time = point.time;
+	memcpy(pointEx.pos, point.pos, sizeof(pointEx.pos));
+	memcpy(pointEx.vel, point.vel, sizeof(pointEx.vel));
+	memcpy(pointEx.acc, point.acc, sizeof(pointEx.acc));
+	return Ros_MotionServer_AddTrajPointEx(&controller, 1, sequence, &pointEx, subcode, &groupNo);
+}
+
+static BOOL Test_Sequence(void)
+{
+	BOOL bOk = TRUE;
+
+	// No trajectory yet
+	bOk &= (ctrlGroup->lastSequence == -1);
+	bOk &= (Test_Add(1) == ROS_RESULT_INVALID_SEQUENCE);
+	bOk &= (ctrlGroup->trajPt_q.cnt == 0);
+
+	bOk &= (Test_Init(0, 0.0f, 0.0f) == 0);
+	bOk &= (ctrlGroup->lastSequence == 0);
+	bOk &= (Test_Add(1) == 0) && (Test_Add(2) == 0);
+	bOk &= (ctrlGroup->trajPt_q.cnt == 2) && (ctrlGroup->lastSequence == 2);
+
+	// Resent points are acknowledged, not queued again
+	bOk &= (Test_Add(2) == 0) && (Test_Add(1) == 0);
+	bOk &= (ctrlGroup->trajPt_q.cnt == 2) && (ctrlGroup->lastSequence == 2);
+
+	// Out of order: busy until the missing point arrives
+	bOk &= (Test_Add(4) == ROS_RESULT_BUSY);
+	bOk &= (ctrlGroup->trajPt_q.cnt == 2) && (ctrlGroup->lastSequence == 2);
+	bOk &= (Test_Add(3) == 0) && (Test_Add(4) == 0);
+	bOk &= (ctrlGroup->trajPt_q.cnt == 4) && (ctrlGroup->lastSequence == 4);
+
+	// The first point resent while its trajectory is queued doesn't restart it
+	bOk &= (Test_Init(0, 0.0f, 0.0f) == 0);
+	bOk &= (ctrlGroup->trajPt_q.cnt == 4) && (ctrlGroup->lastSequence == 4);
+
+	printf("%-9s %s\r\n", "sequence", bOk ? "ok" : "failed");
+	return bOk;
+}
+
+static BOOL Test_QueueFull(void)
+{
+	BOOL bOk = TRUE;
+	int seq;
+
+	seq = ctrlGroup->lastSequence + 1;
+	while (ctrlGroup->trajPt_q.cnt < ctrlGroup->trajPt_q.size)
+		bOk &= (Test_Add(seq++) == 0);
+
+	// Every point is busy while the queue is full, even a resent one
+	bOk &= (Test_Add(seq) == ROS_RESULT_BUSY);
+	bOk &= (Test_Add(seq - 1) == ROS_RESULT_BUSY);
+	bOk &= (ctrlGroup->lastSequence == seq - 1);
+
+	// Room for the next point once one is interpolated
+	bOk &= Ros_MotionServer_GetNextTrajPoint(ctrlGroup);
+	bOk &= (Test_Add(seq) == 0);
+	bOk &= (ctrlGroup->trajPt_q.cnt == ctrlGroup->trajPt_q.size) && (ctrlGroup->lastSequence == seq);
+
+	printf("%-9s %s\r\n", "full", bOk ? "ok" : "failed");
+	return bOk;
+}
+
+static BOOL Test_RejectedStart(void)
+{
+	BOOL bOk = TRUE;
+	CtrlGroup before;
+
+	before = *ctrlGroup;
+
+	// A new trajectory that doesn't start at the current position
+	bOk &= (Test_Init(0, 0.0f, 0.5f) == ROS_RESULT_INVALID_DATA_START_POS);
+	bOk &= (memcmp(&before, ctrlGroup, sizeof(CtrlGroup)) == 0);
+
+	// ... or that starts too fast (not at the time of the queued first point, which would be a resend)
+	{
+		SmBodyJointTrajPtFull point;
+
+		Test_Point(0, 0.5f, 0.0f, &point);
+		point.vel[0] = ctrlGroup->maxSpeed[0] * 2;
+		bOk &= (Ros_MotionServer_InitTrajPointFull(ctrlGroup, &point) == ROS_RESULT_INVALID_DATA_SPEED);
+		bOk &= (memcmp(&before, ctrlGroup, sizeof(CtrlGroup)) == 0);
+	}
+
+	// The trajectory continues
+	bOk &= (Ros_MotionServer_GetNextTrajPoint(ctrlGroup));
+	bOk &= (Test_Add(ctrlGroup->lastSequence + 1) == 0);
+
+	printf("%-9s %s\r\n", "rejected", bOk ? "ok" : "failed");
+	return bOk;
+}
+
+static BOOL Test_Clear(void)
+{
+	BOOL bOk = TRUE;
+	int subcode;
+
+	bOk &= Ros_MotionServer_ClearQ(&controller, 0);
+	bOk &= (ctrlGroup->lastSequence == -1) && (ctrlGroup->trajPt_q.cnt == 0);
+
+	// The rest of the cleared trajectory is rejected instead of busy forever
+	bOk &= (Test_Add(5) == ROS_RESULT_INVALID_SEQUENCE);
+	bOk &= (Test_AddEx(5, &subcode) == ROS_RESULT_INVALID) && (subcode == ROS_RESULT_INVALID_SEQUENCE);
+	bOk &= (ctrlGroup->trajPt_q.cnt == 0);
+
+	// Multi-group messages follow the same sequencing
+	bOk &= (Test_AddEx(0, &subcode) == ROS_RESULT_SUCCESS);
+	bOk &= (Test_AddEx(2, &subcode) == ROS_RESULT_BUSY);
+	bOk &= (Test_AddEx(1, &subcode) == ROS_RESULT_SUCCESS);
+	bOk &= (Test_AddEx(1, &subcode) == ROS_RESULT_SUCCESS);
+	bOk &= (ctrlGroup->trajPt_q.cnt == 1) && (ctrlGroup->lastSequence == 1);
+
+	printf("%-9s %s\r\n", "clear", bOk ? "ok" : "failed");
+	return bOk;
+}
+
+static int Test_MotionCtrl(int command, float data, SimpleMsg* replyMsg)
+{
+	SimpleMsg receiveMsg;
+
+	memset(&receiveMsg, 0x00, sizeof(receiveMsg));
+	memset(replyMsg, 0x00, sizeof(SimpleMsg));
+	receiveMsg.header.msgType = ROS_MSG_MOTO_MOTION_CTRL;
+	receiveMsg.body.motionCtrl.groupNo = 0;
+	receiveMsg.body.motionCtrl.command = command;
+	receiveMsg.body.motionCtrl.data[0] = data;
+	Ros_MotionServer_MotionCtrlProcess(&controller, &receiveMsg, replyMsg);
+	return replyMsg->body.motionReply.result;
+}
+
+static BOOL Test_Truncate(void)
+{
+	BOOL bOk = TRUE;
+	SmBodyJointTrajPtFull point;
+	SimpleMsg replyMsg;
+	Incremental_data incData;
+	Incremental_data lastKept;
+	long pulsePos[MAX_PULSE_AXES];
+	float endTime, t, s, pos, vel;
+	float pulseTol = 2.0f / simConfig.pulsePerRad;
+	int segTime_ms = 200 * controller.interpolPeriod;
+	int leadTime_ms = 100;
+	int i, axis;
+
+	bOk &= Ros_MotionServer_ClearQ(&controller, 0);
+	controller.bRobotJobReady = TRUE;
+	controller.ioStatus[IO_ROBOTSTATUS_OPERATING] = 1;
+	controller.ioStatus[IO_ROBOTSTATUS_REMOTE] = 1;
+
+	// A 0.2 rad move, interpolated into the inc move queue
+	Ros_CtrlGroup_GetPulsePosCmd(ctrlGroup, pulsePos);
+	bOk &= (Test_Init(0, 0.0f, 0.0f) == 0);
+	Test_Point(1, segTime_ms / 1000.0f, 0.2f, &point);
+	bOk &= (Ros_MotionServer_AddTrajPointFull(ctrlGroup, &point) == 0);
+	while (Ros_MotionServer_GetNextTrajPoint(ctrlGroup))
+		Ros_MotionServer_JointTrajDataToIncQueue(&controller, 0);
+	bOk &= (Ros_IncQueue_GetCnt(&ctrlGroup->inc_q) == 200);
+
+	// A quarter of it is executed
+	for (i = 0; i < 50; i++)
+	{
+		bOk &= Ros_IncQueue_Pop(&ctrlGroup->inc_q, &incData);
+		for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+			pulsePos[axis] += incData.inc[axis];
+		ctrlGroup->q_time = incData.time;
+	}
+
+	bOk &= (Test_MotionCtrl(ROS_CMD_TRUNCATE_TRAJ, leadTime_ms / 1000.0f, &replyMsg) == ROS_RESULT_SUCCESS);
+	endTime = replyMsg.body.motionReply.data[0];
+	bOk &= (replyMsg.body.motionReply.data[1] * 1000.0f == ctrlGroup->q_time);
+
+	// Only the increments up to the splice time are left, ending at the reported state
+	bOk &= (Ros_IncQueue_GetCnt(&ctrlGroup->inc_q) == leadTime_ms / controller.interpolPeriod);
+	for (i = 0; Ros_IncQueue_PeekAt(&ctrlGroup->inc_q, ctrlGroup->inc_q.readCnt + i, &incData); i++)
+	{
+		for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+			pulsePos[axis] += incData.inc[axis];
+		lastKept = incData;
+	}
+	bOk &= (lastKept.time == ctrlGroup->jointMotionData.time);
+	bOk &= (lastKept.time * 0.001f == endTime) && (lastKept.time <= ctrlGroup->q_time + leadTime_ms);
+	bOk &= (memcmp(pulsePos, ctrlGroup->prevPulsePos, sizeof(pulsePos)) == 0);
+
+	// The end state is the interpolated motion at that time
+	t = lastKept.time;
+	s = t / segTime_ms;
+	pos = 0.2f * (3.0f * s * s - 2.0f * s * s * s);
+	vel = 0.2f * (6.0f * s - 6.0f * s * s) * 1000.0f / segTime_ms;
+	bOk &= (Test_MotionCtrl(ROS_CMD_GET_QUEUE_END_STATE, 0.0f, &replyMsg) == ROS_RESULT_SUCCESS);
+	for (axis = 0; axis < ctrlGroup->numAxes; axis++)
+		bOk &= (fabs(replyMsg.body.motionReply.data[axis] - (startPos[axis] + pos)) <= pulseTol);
+	bOk &= (Test_MotionCtrl(ROS_CMD_GET_QUEUE_END_STATE, 1.0f, &replyMsg) == ROS_RESULT_SUCCESS);
+	for (axis = 0; axis < ctrlGroup->numAxes; axis++)
+		bOk &= (fabs(replyMsg.body.motionReply.data[axis] - vel) <= 0.01f * vel + pulseTol * 1000.0f / controller.interpolPeriod);
+
+	// A trajectory continued from there starts without a jump
+	Test_Point(ctrlGroup->lastSequence + 1, segTime_ms / 1000.0f, 0.2f, &point);
+	bOk &= (Ros_MotionServer_AddTrajPointFull(ctrlGroup, &point) == 0);
+	while (Ros_MotionServer_GetNextTrajPoint(ctrlGroup))
+		Ros_MotionServer_JointTrajDataToIncQueue(&controller, 0);
+	bOk &= Ros_IncQueue_PeekAt(&ctrlGroup->inc_q, ctrlGroup->inc_q.readCnt + leadTime_ms / controller.interpolPeriod, &incData);
+	bOk &= (incData.time == lastKept.time + controller.interpolPeriod);
+	for (axis = 0; axis < ctrlGroup->numAxes; axis++)
+		bOk &= (labs(incData.inc[axis] - lastKept.inc[axis]) <= 2);
+
+	// Nothing past the splice time: the queue is left as it is
+	Ros_IncQueue_Clear(&ctrlGroup->inc_q);
+	bOk &= (Test_MotionCtrl(ROS_CMD_TRUNCATE_TRAJ, leadTime_ms / 1000.0f, &replyMsg) == ROS_RESULT_SUCCESS);
+
+	Ros_MotionServer_ClearQ(&controller, 0);
+	printf("%-9s %s\r\n", "truncate", bOk ? "ok" : "failed");
+	return bOk;
+}
+
+int main(int argc, char** argv)
+{
+	BOOL bOk = TRUE;
+	long pulsePos[MAX_PULSE_AXES];
+
+	Sim_Init();
+
+	controller.numGroup = 1;
+	controller.interpolPeriod = simConfig.interpolPeriod;
+	ctrlGroup = Ros_CtrlGroup_Create(0, TRUE, controller.interpolPeriod);
+	if (ctrlGroup == NULL)
+	{
+		printf("FAILED\r\n");
+		return 1;
+	}
+	controller.ctrlGroups[0] = ctrlGroup;
+	Ros_CtrlGroup_GetPulsePosCmd(ctrlGroup, pulsePos);
+	Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, pulsePos, startPos);
+
+	bOk &= Test_Sequence();
+	bOk &= Test_QueueFull();
+	bOk &= Test_RejectedStart();
+	bOk &= Test_Clear();
+	bOk &= Test_Truncate();
+
+	printf("%s\r\n", bOk ? "PASSED" : "FAILED");
+	return bOk ? 0 : 1;
+}
@@ -0,0 +1,356 @@
+//MotoPlus.h
+//
+// Host (Linux) replacement for the MotoPlus SDK header.
+// Declares the subset of the mp* API used by MotoROS so the controller
+// application can be built and run as a local process against the
+// simulated robot implemented in mpSim.c.
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#ifndef MOTOPLUS_HOST_H
+#define MOTOPLUS_HOST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+//-----------------------
+// VxWorks base types
+//-----------------------
+typedef int				BOOL;
+typedef int				STATUS;
+typedef unsigned char	UCHAR;
+typedef unsigned short	USHORT;
+typedef unsigned int	UINT;
+typedef long			LONG;
+typedef unsigned long	ULONG;
+typedef short			INT16;
+typedef int				INT32;
+typedef unsigned short	UINT16;
+typedef unsigned int	UINT32;
+typedef void*			SEM_ID;
+typedef int				(*FUNCPTR)();
+
+#ifndef TRUE
+#define TRUE			1
+#endif
+#ifndef FALSE
+#define FALSE			0
+#endif
+#define OK				0
+#define ERROR			(-1)
+#define NG				(-1)
+#define ON				1
+#define OFF				0
+#define FOREVER			for(;;)
+
+#define NO_WAIT			0
+#define WAIT_FOREVER	(-1)
+
+#ifndef min
+#define min(a, b)		(((a) < (b)) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b)		(((a) > (b)) ? (a) : (b))
+#endif
+
+// VxWorks names the select() descriptor set as a struct tag
+struct fd_set
+{
+	fd_set set;
+};
+#undef FD_ZERO
+#undef FD_SET
+#undef FD_CLR
+#undef FD_ISSET
+#define FD_ZERO(s)			memset(&(s)->set, 0x00, sizeof(fd_set))
+#define FD_SET(fd, s)		__FD_SET((fd), &(s)->set)
+#define FD_CLR(fd, s)		__FD_CLR((fd), &(s)->set)
+#define FD_ISSET(fd, s)		__FD_ISSET((fd), &(s)->set)
+
+// The application declares the VxWorks setsockopt() prototype itself
+#define setsockopt		mpSimSetsockopt
+
+//-----------------------
+// Semaphores and tasks
+//-----------------------
+#define SEM_Q_FIFO		0x00
+#define SEM_Q_PRIORITY	0x01
+#define SEM_EMPTY		0
+#define SEM_FULL		1
+
+#define MP_PRI_IP_CLK_TAKE		1
+#define MP_PRI_TIME_CRITICAL	2
+#define MP_PRI_TIME_NORMAL		3
+
+#define MP_STACK_SIZE			(64 * 1024)
+
+#define MP_INTERPOLATION_CLK	1
+
+//-----------------------
+// Control groups
+//-----------------------
+#define MAX_PULSE_AXES			8
+#define MP_GRP_AXES_NUM			8
+#define MP_GRP_NUM				32
+
+typedef enum
+{
+	MP_R1_GID = 0,
+	MP_R2_GID,
+	MP_R3_GID,
+	MP_R4_GID,
+	MP_R5_GID,
+	MP_R6_GID,
+	MP_R7_GID,
+	MP_R8_GID,
+	MP_B1_GID,
+	MP_B2_GID,
+	MP_B3_GID,
+	MP_B4_GID,
+	MP_B5_GID,
+	MP_B6_GID,
+	MP_B7_GID,
+	MP_B8_GID,
+	MP_S1_GID,
+	MP_S2_GID,
+	MP_S3_GID,
+	MP_S4_GID,
+	MP_S5_GID,
+	MP_S6_GID,
+	MP_S7_GID,
+	MP_S8_GID
+} MP_GRP_ID_TYPE;
+
+typedef LONG MP_GRP_AXES_T[MP_GRP_NUM][MP_GRP_AXES_NUM];
+
+typedef struct
+{
+	USHORT sCtrlGrp;
+} MP_CTRL_GRP_SEND_DATA;
+
+typedef struct
+{
+	LONG lPos[MAX_PULSE_AXES];
+} MP_PULSE_POS_RSP_DATA;
+
+typedef struct
+{
+	LONG lPos[MAX_PULSE_AXES];
+} MP_FB_PULSE_POS_RSP_DATA;
+
+typedef struct
+{
+	LONG lSpeed[MAX_PULSE_AXES];
+} MP_SERVO_SPEED_RSP_DATA;
+
+#define TRQ_PERCENTAGE			0
+#define TRQ_NEWTON_METER		1
+
+typedef LONG MP_TRQCTL_DATA[MP_GRP_NUM][MP_GRP_AXES_NUM];
+
+typedef struct
+{
+	int unit;
+	MP_TRQCTL_DATA data;
+} MP_TRQ_CTL_VAL;
+
+//-----------------------
+// Incremental motion
+//-----------------------
+#define MP_INC_PULSE_DTYPE		0
+#define MP_INC_ANGLE_DTYPE		1
+#define MP_INC_BF_DTYPE			16
+#define MP_INC_RF_DTYPE			17
+#define MP_INC_TF_DTYPE			18
+#define MP_INC_UF_DTYPE			19
+
+#define E_EXRCS_CTRL_GRP		(-1)
+#define E_EXRCS_IMOV_UNREADY	(-2)
+
+#define MP_SL_ID1				1
+#define MP_SL_ID2				2
+
+typedef struct
+{
+	UCHAR data[8];
+} MP_POS_TAG;
+
+typedef struct
+{
+	MP_POS_TAG pos_tag;
+	LONG pos[MP_GRP_AXES_NUM];
+} MP_GRP_POS_INFO;
+
+typedef struct
+{
+	int ctrl_grp;
+	int m_ctrl_grp;
+	int s_ctrl_grp;
+	MP_GRP_POS_INFO grp_pos_info[MP_GRP_NUM];
+} MP_EXPOS_DATA;
+
+typedef MP_EXPOS_DATA MP_POS_DATA;
+
+//-----------------------
+// I/O
+//-----------------------
+typedef struct
+{
+	ULONG ulAddr;
+} MP_IO_INFO;
+
+typedef struct
+{
+	ULONG ulAddr;
+	ULONG ulValue;
+} MP_IO_DATA;
+
+//-----------------------
+// System commands
+//-----------------------
+#define MAX_JOB_NAME_LEN		33
+#define MAX_ALARM_COUNT			4
+
+typedef struct
+{
+	USHORT err_no;
+	UCHAR reserved[2];
+} MP_STD_RSP_DATA;
+
+typedef struct
+{
+	USHORT sServoPower;
+} MP_SERVO_POWER_SEND_DATA;
+
+typedef struct
+{
+	USHORT sTaskNo;
+	char cJobName[MAX_JOB_NAME_LEN];
+} MP_START_JOB_SEND_DATA;
+
+typedef struct
+{
+	USHORT sRobotNo;
+	USHORT sToolNo;
+} MP_SET_TOOL_NO_SEND_DATA;
+
+typedef struct
+{
+	USHORT sIsAlarm;
+} MP_ALARM_STATUS_RSP_DATA;
+
+typedef struct
+{
+	USHORT usAlarmNo[MAX_ALARM_COUNT];
+	USHORT usAlarmData[MAX_ALARM_COUNT];
+} MP_ALARM_DATA;
+
+typedef struct
+{
+	USHORT usErrorNo;
+	USHORT usErrorData;
+	USHORT usAlarmNum;
+	MP_ALARM_DATA AlarmData;
+} MP_ALARM_CODE_RSP_DATA;
+
+typedef struct
+{
+	char AppName[32];
+	char Version[32];
+	char Comment[64];
+} MP_APPINFO_SEND_DATA;
+
+//-----------------------
+// API
+//-----------------------
+extern void mpUsrRoot(int arg1, int arg2, int arg3, int arg4, int arg5, int arg6, int arg7, int arg8, int arg9, int arg10);
+
+extern int mpCreateTask(int priority, int stackSize, FUNCPTR entryPt,
+						int arg1, int arg2, int arg3, int arg4, int arg5, int arg6, int arg7, int arg8, int arg9, int arg10);
+extern STATUS mpDeleteTask(int tid);
+#define mpDeleteSelf	mpDeleteTask(0)
+#define mpExitUsrRoot	mpDeleteTask(0)
+extern STATUS mpTaskDelay(int ticks);
+extern int mpGetRtc(void);
+extern ULONG tickGet(void);
+extern int mpClkAnnounce(int clkType);
+
+extern SEM_ID mpSemBCreate(int options, int initialState);
+extern STATUS mpSemTake(SEM_ID semId, int timeout);
+extern STATUS mpSemGive(SEM_ID semId);
+
+extern void* mpMalloc(size_t nBytes);
+extern void mpFree(void* ptr);
+
+extern int mpSocket(int domain, int type, int protocol);
+extern int mpBind(int s, struct sockaddr* name, int namelen);
+extern int mpListen(int s, int backlog);
+extern int mpAccept(int s, struct sockaddr* addr, int* addrlen);
+extern int mpSelect(int width, struct fd_set* readFds, struct fd_set* writeFds, struct fd_set* exceptFds, struct timeval* timeout);
+extern int mpRecv(int s, char* buf, int bufLen, int flags);
+extern int mpSend(int s, char* buf, int bufLen, int flags);
+extern int mpSendTo(int s, char* buf, int bufLen, int flags, struct sockaddr* to, int tolen);
+extern int mpSetsockopt(int s, int level, int optname, char* optval, int optlen);
+extern STATUS mpSimSetsockopt(int s, int level, int optname, char* optval, int optlen);
+extern STATUS mpClose(int s);
+extern USHORT mpHtons(USHORT hostshort);
+extern int mpNICData(USHORT if_no, ULONG* ip_addr, ULONG* subnet_mask, UCHAR* mac_addr, ULONG* default_gw);
+
+extern int mpCtrlGrpId2GrpNo(MP_GRP_ID_TYPE grp_id);
+extern LONG mpGetPulsePos(MP_CTRL_GRP_SEND_DATA* sData, MP_PULSE_POS_RSP_DATA* rData);
+extern LONG mpGetFBPulsePos(MP_CTRL_GRP_SEND_DATA* sData, MP_FB_PULSE_POS_RSP_DATA* rData);
+extern LONG mpGetServoSpeed(MP_CTRL_GRP_SEND_DATA* sData, MP_SERVO_SPEED_RSP_DATA* rData);
+extern LONG mpSvsGetVelTrqFb(MP_GRP_AXES_T dst_vel, MP_TRQ_CTL_VAL* dst_trq);
+extern int mpExRcsIncrementMove(MP_EXPOS_DATA* src_p);
+extern int mpMeiIncrementMove(int sl_id, MP_POS_DATA* src_p);
+
+extern LONG mpReadIO(MP_IO_INFO* sData, USHORT* rData, LONG num);
+extern LONG mpWriteIO(MP_IO_DATA* sData, LONG num);
+
+extern LONG mpSetServoPower(MP_SERVO_POWER_SEND_DATA* sData, MP_STD_RSP_DATA* rData);
+extern LONG mpStartJob(MP_START_JOB_SEND_DATA* sData, MP_STD_RSP_DATA* rData);
+extern LONG mpSetToolNo(MP_SET_TOOL_NO_SEND_DATA* sData, MP_STD_RSP_DATA* rData);
+extern LONG mpGetAlarmStatus(MP_ALARM_STATUS_RSP_DATA* rData);
+extern LONG mpGetAlarmCode(MP_ALARM_CODE_RSP_DATA* rData);
+extern LONG mpResetAlarm(MP_STD_RSP_DATA* rData);
+extern LONG mpCancelError(MP_STD_RSP_DATA* rData);
+extern int mpSetAlarm(short alm_code, char* alm_msg, UCHAR sub_code);
+extern LONG mpApplicationInfoNotify(MP_APPINFO_SEND_DATA* sData, MP_STD_RSP_DATA* rData);
+
+#endif
@@ -0,0 +1,211 @@
+//StateServerTest.c
+//
+// Test of the ROBOT_STATUS fan-out of the state server: the status is only
+// carried by the sample taken after it changes, so a connection that does
+// not send that sample (a new connection, a sample it skipped, or one the
+// socket did not accept in time) must send the latest status along with its
+// next sample, and only then.
+//
+// Usage: StateServerTest
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "MotoROS.h"
+#include "mpSim.h"
+
+// Not exported by StateServer.h
+extern void Ros_StateServer_SendState(Controller* controller, int connectionIndex);
+extern void Ros_StateServer_PublishSample(Controller* controller, StateSample* sample, int statusSize);
+
+#define TEST_MAX_FRAMES 8
+
+static Controller controller;
+static int sds[2];
+
+// Serialize a message of the given body size at the end of the sample
+static int Test_AddMsg(StateSample* sample, SimpleMsg* msg, SmMsgType msgType, int bodySize)
+{
+	int msgSize = sizeof(SmPrefix) + sizeof(SmHeader) + bodySize;
+
+	msg->prefix.length = sizeof(SmHeader) + bodySize;
+	msg->header.msgType = msgType;
+	msg->header.commType = ROS_COMM_TOPIC;
+	msg->header.replyType = ROS_REPLY_INVALID;
+	memcpy(sample->data + sample->size, msg, msgSize);
+	sample->size += msgSize;
+	return msgSize;
+}
+
+// Publish a sample with the feedback of group groupNo, and the status with errorCode if errorCode >= 0.
+// bNotify FALSE publishes it without notifying the connection: it then misses it.
+static void Test_Publish(int groupNo, int errorCode, BOOL bNotify)
+{
+	StateSample sample;
+	SimpleMsg msg;
+	int statusSize = 0;
+
+	memset(&msg, 0x00, sizeof(SimpleMsg));
+	sample.size = 0;
+	msg.body.jointFeedback.groupNo = groupNo;
+	Test_AddMsg(&sample, &msg, ROS_MSG_JOINT_FEEDBACK, sizeof(SmBodyJointFeedback));
+	if (errorCode >= 0)
+	{
+		msg.body.robotStatus.error_code = errorCode;
+		statusSize = Test_AddMsg(&sample, &msg, ROS_MSG_ROBOT_STATUS, sizeof(SmBodyRobotStatus));
+	}
+
+	if (!bNotify)
+		controller.sdStateConnections[0] = INVALID_SOCKET;
+	Ros_StateServer_PublishSample(&controller, &sample, statusSize);
+	controller.sdStateConnections[0] = sds[0];
+}
+
+// Receive the messages sent to the client end of the connection: the feedback group, then the status
+// error code if there is one (-1 if not). return FALSE if they are not the expected ones.
+static BOOL Test_Recv(int groupNo, int errorCode)
+{
+	struct timeval timeout;
+	SimpleMsg msgs[TEST_MAX_FRAMES];
+	int msgCnt = 0;
+
+	timeout.tv_sec = 0;
+	timeout.tv_usec = 100000;
+	mpSetsockopt(sds[1], SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof(timeout));
+
+	while (msgCnt < TEST_MAX_FRAMES)
+	{
+		memset(&msgs[msgCnt], 0x00, sizeof(SimpleMsg));
+		if (recv(sds[1], &msgs[msgCnt], sizeof(SmPrefix), MSG_WAITALL) != (int)sizeof(SmPrefix))
+			break;
+		if (recv(sds[1], (char*)&msgs[msgCnt] + sizeof(SmPrefix), msgs[msgCnt].prefix.length, MSG_WAITALL) !=
+			msgs[msgCnt].prefix.length)
+			return FALSE;
+		msgCnt++;
+	}
+
+	if (msgCnt != ((errorCode >= 0) ? 2 : 1))
+		return FALSE;
+	if (msgs[0].header.msgType != ROS_MSG_JOINT_FEEDBACK || msgs[0].body.jointFeedback.groupNo != groupNo)
+		return FALSE;
+	return (errorCode < 0) ||
+		(msgs[1].header.msgType == ROS_MSG_ROBOT_STATUS && msgs[1].body.robotStatus.error_code == errorCode);
+}
+
+// Fill the socket buffer of the connection, so that it doesn't accept the next sample
+static void Test_FillSocket(void)
+{
+	char bytes[1024];
+
+	memset(bytes, 0x00, sizeof(bytes));
+	fcntl(sds[0], F_SETFL, fcntl(sds[0], F_GETFL) | O_NONBLOCK);
+	while (send(sds[0], bytes, sizeof(bytes), 0) > 0)
+		;
+	while (send(sds[0], bytes, 1, 0) > 0)
+		;
+	fcntl(sds[0], F_SETFL, fcntl(sds[0], F_GETFL) & ~O_NONBLOCK);
+}
+
+static void Test_DrainSocket(void)
+{
+	char bytes[1024];
+
+	while (recv(sds[1], bytes, sizeof(bytes), MSG_DONTWAIT) > 0)
+		;
+}
+
+static BOOL Test_StatusFanOut(void)
+{
+	int tid;
+	BOOL bOk = TRUE;
+
+	socketpair(AF_UNIX, SOCK_STREAM, 0, sds);
+	controller.sdStateConnections[0] = sds[0];
+	controller.semStateSampleReady[0] = mpSemBCreate(SEM_Q_FIFO, SEM_EMPTY);
+	controller.stateDroppedCnt[0] = 0;
+	for (tid = 1; tid < MAX_STATE_CONNECTIONS; tid++)
+		controller.sdStateConnections[tid] = INVALID_SOCKET;
+
+	// The status was sent before the connection started: it comes with its first sample
+	Test_Publish(0, 1, FALSE);
+	tid = mpCreateTask(MP_PRI_TIME_NORMAL, MP_STACK_SIZE, (FUNCPTR)Ros_StateServer_SendState,
+					   (int)&controller, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+	Test_Publish(1, -1, TRUE);
+	bOk &= Test_Recv(1, 1);
+
+	// Sent once
+	Test_Publish(2, -1, TRUE);
+	bOk &= Test_Recv(2, -1);
+	Test_Publish(3, 2, TRUE);
+	bOk &= Test_Recv(3, 2);
+	Test_Publish(4, -1, TRUE);
+	bOk &= Test_Recv(4, -1);
+
+	// The sample carrying the status is skipped: the next one carries it
+	Test_Publish(5, 3, FALSE);
+	Test_Publish(6, -1, TRUE);
+	bOk &= Test_Recv(6, 3) && (controller.stateDroppedCnt[0] == 1);
+	Test_Publish(7, -1, TRUE);
+	bOk &= Test_Recv(7, -1);
+
+	// The sample carrying the status is dropped: the next one carries it
+	Test_FillSocket();
+	Test_Publish(8, 4, TRUE);
+	Ros_Sleep(100);
+	bOk &= (controller.stateDroppedCnt[0] == 2);
+	Test_DrainSocket();
+	Test_Publish(9, -1, TRUE);
+	bOk &= Test_Recv(9, 4);
+	Test_Publish(10, -1, TRUE);
+	bOk &= Test_Recv(10, -1);
+
+	mpDeleteTask(tid);
+	close(sds[0]);
+	close(sds[1]);
+
+	printf("%-9s %s\r\n", "status", bOk ? "ok" : "failed");
+	return bOk;
+}
+
+int main(int argc, char** argv)
+{
+	BOOL bOk = TRUE;
+
+	Sim_Init();
+
+	bOk &= Test_StatusFanOut();
+
+	printf("%s\r\n", bOk ? "PASSED" : "FAILED");
+	return bOk ? 0 : 1;
+}
@@ -0,0 +1,957 @@
+//mpSim.c
+//
+// Simulated implementation of the MotoPlus API for the host build.
+// Tasks and semaphores are mapped on pthreads, sockets on the BSD socket
+// API and the robot is modeled as a set of control groups whose command
+// position integrates the pulse increments of the incremental motion API.
+// A dedicated thread generates the interpolation clock; on each tick the
+// feedback position follows the command position of the previous tick.
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "MotoROS.h"
+#include "mpSim.h"
+
+#define SIM_MAX_TASKS			64
+#define SIM_MIN_STACK_SIZE		(1024 * 1024)
+#define SIM_TICK_MS				1		// Length of a system tick (see mpGetRtc)
+#define SIM_IO_SIZE				1001000
+#define SIM_JOB_TIMER_MS		50		// TIMER instruction of the INIT_ROS job
+
+// Specific I/O monitored by Ros_Controller_StatusInit
+#define SIM_IO_ALARM_MAJOR		50010
+#define SIM_IO_ALARM_MINOR		50011
+#define SIM_IO_ALARM_SYSTEM		50012
+#define SIM_IO_ALARM_USER		50013
+#define SIM_IO_ERROR			50014
+#define SIM_IO_PLAY				50054
+#define SIM_IO_OPERATING		50070
+#define SIM_IO_SERVO			50073
+#define SIM_IO_REMOTE			80011
+#define SIM_IO_ESTOP_EX			80025
+#define SIM_IO_ESTOP_PP			80026
+#define SIM_IO_ESTOP_CTRL		80027
+
+typedef struct
+{
+	BOOL bUsed;
+	BOOL bDone;
+	pthread_t thread;
+	void* stack;
+	size_t stackSize;
+	FUNCPTR entryPt;
+	int args[10];
+} SimTask;
+
+typedef struct
+{
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	BOOL bFull;
+} SimSem;
+
+typedef struct
+{
+	LONG cmdPos[MP_GRP_AXES_NUM];		// Command position (pulse)
+	LONG fbPos[MP_GRP_AXES_NUM];		// Feedback position (pulse)
+	LONG fbSpeed[MP_GRP_AXES_NUM];		// Feedback speed (pulse/sec)
+	LONG maxInc[MP_GRP_AXES_NUM];		// Maximum increment accepted per interpolation cycle
+} SimGroup;
+
+typedef void (*SimTaskEntry)(long, long, long, long, long, long, long, long, long, long);
+
+SimConfig simConfig =
+{
+	SIM_DEFAULT_GROUPS,
+	SIM_DEFAULT_AXES,
+	SIM_DEFAULT_IP_PERIOD,
+	1.0f,
+	SIM_DEFAULT_PULSE_PER_RAD,
+	SIM_DEFAULT_MAX_SPEED,
+	0
+};
+
+static pthread_mutex_t simTaskLock = PTHREAD_MUTEX_INITIALIZER;
+static SimTask simTasks[SIM_MAX_TASKS];
+static __thread int simSelfTid = 0;
+
+static pthread_mutex_t simLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t simClkCond;
+static unsigned long simClkCount = 0;
+static __thread unsigned long simClkLastAnnounced = 0;		// Per task: every IP_CLK task is woken by each tick
+static __thread struct timespec simClkAnnounceTime;
+static SimGroup simGroups[MAX_CONTROLLABLE_GROUPS];
+static USHORT simIo[SIM_IO_SIZE];
+static BOOL simJobRunning = FALSE;
+static int simJobTimer = 0;
+static BOOL simErrorActive = FALSE;
+static MP_ALARM_DATA simAlarms;
+static USHORT simAlarmNum = 0;
+static SimStats simStats;
+
+//-----------------------
+// Function Declarations
+//-----------------------
+void Sim_Init(void);
+void Sim_GetStats(SimStats* stats);
+void Sim_PrintStats(void);
+static void* Sim_TaskStart(void* arg);
+static void Sim_TaskDone(void* arg);
+static void Sim_ReclaimTask(SimTask* task);
+static void Sim_UnlockMutex(void* arg);
+static void Sim_InitCondition(pthread_cond_t* cond);
+static void Sim_Deadline(struct timespec* ts, long nsec);
+static double Sim_ElapsedUs(struct timespec* start, struct timespec* end);
+static void* Sim_ClockTask(void* arg);
+static void Sim_UpdateFeedback(void);
+static void Sim_StopJob(void);
+static void Sim_SetServo(BOOL bOn);
+
+//-----------------------
+// Function implementation
+//-----------------------
+
+//-------------------------------------------------------------------
+// Initialize the simulated controller and start the interpolation clock
+//-------------------------------------------------------------------
+void Sim_Init(void)
+{
+	int grpNo;
+	int axis;
+	pthread_t clkThread;
+	long probe;
+
+	// MotoPlus passes pointers as int task arguments: they must fit in 31 bits
+	probe = (long)&simConfig;
+	if(probe != (long)(int)probe)
+	{
+		printf("ERROR: the host build must be linked as a non position independent executable\r\n");
+		exit(1);
+	}
+
+	if(simConfig.numGroups < 1)
+		simConfig.numGroups = 1;
+	if(simConfig.numGroups > MAX_CONTROLLABLE_GROUPS)
+		simConfig.numGroups = MAX_CONTROLLABLE_GROUPS;
+	if(simConfig.numAxes < 1)
+		simConfig.numAxes = 1;
+	if(simConfig.numAxes > MP_GRP_AXES_NUM)
+		simConfig.numAxes = MP_GRP_AXES_NUM;
+	if(simConfig.interpolPeriod < 1)
+		simConfig.interpolPeriod = 1;
+	if(simConfig.clockScale <= 0.0f)
+		simConfig.clockScale = 1.0f;
+
+	memset(simGroups, 0x00, sizeof(simGroups));
+	for(grpNo = 0; grpNo < simConfig.numGroups; grpNo++)
+	{
+		for(axis = 0; axis < simConfig.numAxes; axis++)
+			simGroups[grpNo].maxInc[axis] = (LONG)(simConfig.maxSpeed * simConfig.pulsePerRad * simConfig.interpolPeriod / 1000.0f);
+	}
+
+	// Controller in remote play mode, no e-stop, servo off
+	memset(simIo, 0x00, sizeof(simIo));
+	simIo[SIM_IO_PLAY] = 1;
+	simIo[SIM_IO_REMOTE] = 1;
+	simIo[SIM_IO_ESTOP_EX] = 1;
+	simIo[SIM_IO_ESTOP_PP] = 1;
+	simIo[SIM_IO_ESTOP_CTRL] = 1;
+
+	memset(&simAlarms, 0x00, sizeof(simAlarms));
+	memset(&simStats, 0x00, sizeof(simStats));
+
+	Sim_InitCondition(&simClkCond);
+	pthread_create(&clkThread, NULL, Sim_ClockTask, NULL);
+	pthread_detach(clkThread);
+
+	printf("Simulated controller: %d group(s) of %d axes, interpolation period %d ms (x%.2f)\r\n",
+		simConfig.numGroups, simConfig.numAxes, simConfig.interpolPeriod, simConfig.clockScale);
+}
+
+//-------------------------------------------------------------------
+// Copy the statistics accumulated since startup
+//-------------------------------------------------------------------
+void Sim_GetStats(SimStats* stats)
+{
+	pthread_mutex_lock(&simLock);
+	memcpy(stats, &simStats, sizeof(SimStats));
+	pthread_mutex_unlock(&simLock);
+}
+
+void Sim_PrintStats(void)
+{
+	SimStats stats;
+
+	Sim_GetStats(&stats);
+	printf("Interpolation clock: %lu ticks, %lu missed\r\n", stats.clkTicks, stats.clkMissed);
+	printf("Incremental moves: %lu (%lu limited)\r\n", stats.incMoves, stats.incMovesLimited);
+	if(stats.incMoves > 0)
+		printf("IP_CLK task cycle time: avg %.1f us, max %.1f us\r\n", stats.cycleTimeTotal / stats.incMoves, stats.cycleTimeMax);
+}
+
+/**** Tasks ****/
+
+int mpCreateTask(int priority, int stackSize, FUNCPTR entryPt,
+				int arg1, int arg2, int arg3, int arg4, int arg5, int arg6, int arg7, int arg8, int arg9, int arg10)
+{
+	int i;
+	int tid;
+	SimTask* task;
+	pthread_attr_t attr;
+
+	pthread_mutex_lock(&simTaskLock);
+
+	tid = ERROR;
+	for(i = 0; i < SIM_MAX_TASKS; i++)
+	{
+		if(simTasks[i].bUsed && simTasks[i].bDone)
+			Sim_ReclaimTask(&simTasks[i]);
+		if(!simTasks[i].bUsed)
+		{
+			tid = i + 1;
+			break;
+		}
+	}
+
+	if(tid == ERROR)
+	{
+		pthread_mutex_unlock(&simTaskLock);
+		return ERROR;
+	}
+
+	task = &simTasks[tid - 1];
+	memset(task, 0x00, sizeof(SimTask));
+	task->entryPt = entryPt;
+	task->args[0] = arg1;
+	task->args[1] = arg2;
+	task->args[2] = arg3;
+	task->args[3] = arg4;
+	task->args[4] = arg5;
+	task->args[5] = arg6;
+	task->args[6] = arg7;
+	task->args[7] = arg8;
+	task->args[8] = arg9;
+	task->args[9] = arg10;
+
+	// Stacks are allocated in the low 2GB so the address of a local variable
+	// can be passed as an int argument to another task
+	task->stackSize = max(stackSize, SIM_MIN_STACK_SIZE);
+	task->stack = mmap(NULL, task->stackSize, PROT_READ | PROT_WRITE,
+						MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT | MAP_STACK, -1, 0);
+	if(task->stack == MAP_FAILED)
+	{
+		pthread_mutex_unlock(&simTaskLock);
+		return ERROR;
+	}
+
+	pthread_attr_init(&attr);
+	pthread_attr_setstack(&attr, task->stack, task->stackSize);
+	task->bUsed = TRUE;
+	if(pthread_create(&task->thread, &attr, Sim_TaskStart, task) != 0)
+	{
+		munmap(task->stack, task->stackSize);
+		task->bUsed = FALSE;
+		tid = ERROR;
+	}
+	pthread_attr_destroy(&attr);
+
+	pthread_mutex_unlock(&simTaskLock);
+	return tid;
+}
+
+static void* Sim_TaskStart(void* arg)
+{
+	SimTask* task = (SimTask*)arg;
+
+	simSelfTid = (task - simTasks) + 1;
+
+	pthread_cleanup_push(Sim_TaskDone, task);
+	((SimTaskEntry)task->entryPt)(task->args[0], task->args[1], task->args[2], task->args[3], task->args[4],
+								task->args[5], task->args[6], task->args[7], task->args[8], task->args[9]);
+	pthread_cleanup_pop(1);
+
+	return NULL;
+}
+
+static void Sim_TaskDone(void* arg)
+{
+	SimTask* task = (SimTask*)arg;
+
+	task->bDone = TRUE;
+}
+
+// Must be called with simTaskLock held
+static void Sim_ReclaimTask(SimTask* task)
+{
+	pthread_join(task->thread, NULL);
+	munmap(task->stack, task->stackSize);
+	task->bUsed = FALSE;
+	task->bDone = FALSE;
+}
+
+STATUS mpDeleteTask(int tid)
+{
+	if(tid == 0 || tid == simSelfTid)
+		pthread_exit(NULL);
+
+	if(tid < 1 || tid > SIM_MAX_TASKS || !simTasks[tid - 1].bUsed)
+		return ERROR;
+
+	pthread_cancel(simTasks[tid - 1].thread);
+	return OK;
+}
+
+STATUS mpTaskDelay(int ticks)
+{
+	struct timespec ts;
+
+	if(ticks <= 0)
+	{
+		sched_yield();
+		return OK;
+	}
+
+	ts.tv_sec = (ticks * SIM_TICK_MS) / 1000;
+	ts.tv_nsec = ((ticks * SIM_TICK_MS) % 1000) * 1000000L;
+	while(nanosleep(&ts, &ts) != 0 && errno == EINTR)
+		;
+	return OK;
+}
+
+int mpGetRtc(void)
+{
+	return SIM_TICK_MS;
+}
+
+ULONG tickGet(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ULONG)(ts.tv_sec * (1000 / SIM_TICK_MS) + ts.tv_nsec / (SIM_TICK_MS * 1000000L));
+}
+
+/**** Semaphores ****/
+
+SEM_ID mpSemBCreate(int options, int initialState)
+{
+	SimSem* sem;
+
+	sem = (SimSem*)malloc(sizeof(SimSem));
+	if(sem == NULL)
+		return NULL;
+
+	pthread_mutex_init(&sem->lock, NULL);
+	Sim_InitCondition(&sem->cond);
+	sem->bFull = (initialState == SEM_FULL);
+	return (SEM_ID)sem;
+}
+
+STATUS mpSemTake(SEM_ID semId, int timeout)
+{
+	SimSem* sem = (SimSem*)semId;
+	struct timespec deadline;
+	STATUS status = OK;
+
+	if(sem == NULL)
+		return ERROR;
+
+	if(timeout > 0)
+		Sim_Deadline(&deadline, (long)timeout * SIM_TICK_MS * 1000000L);
+
+	pthread_mutex_lock(&sem->lock);
+	pthread_cleanup_push(Sim_UnlockMutex, &sem->lock);
+	while(!sem->bFull && status == OK)
+	{
+		if(timeout == NO_WAIT)
+			status = ERROR;
+		else if(timeout == WAIT_FOREVER)
+			pthread_cond_wait(&sem->cond, &sem->lock);
+		else if(pthread_cond_timedwait(&sem->cond, &sem->lock, &deadline) == ETIMEDOUT)
+			status = ERROR;
+	}
+	if(status == OK)
+		sem->bFull = FALSE;
+	pthread_cleanup_pop(1);
+
+	return status;
+}
+
+STATUS mpSemGive(SEM_ID semId)
+{
+	SimSem* sem = (SimSem*)semId;
+
+	if(sem == NULL)
+		return ERROR;
+
+	pthread_mutex_lock(&sem->lock);
+	sem->bFull = TRUE;
+	pthread_cond_signal(&sem->cond);
+	pthread_mutex_unlock(&sem->lock);
+	return OK;
+}
+
+static void Sim_UnlockMutex(void* arg)
+{
+	pthread_mutex_unlock((pthread_mutex_t*)arg);
+}
+
+static void Sim_InitCondition(pthread_cond_t* cond)
+{
+	pthread_condattr_t attr;
+
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(cond, &attr);
+	pthread_condattr_destroy(&attr);
+}
+
+static void Sim_Deadline(struct timespec* ts, long nsec)
+{
+	clock_gettime(CLOCK_MONOTONIC, ts);
+	ts->tv_sec += nsec / 1000000000L;
+	ts->tv_nsec += nsec % 1000000000L;
+	if(ts->tv_nsec >= 1000000000L)
+	{
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000L;
+	}
+}
+
+static double Sim_ElapsedUs(struct timespec* start, struct timespec* end)
+{
+	return (end->tv_sec - start->tv_sec) * 1.0E6 + (end->tv_nsec - start->tv_nsec) / 1.0E3;
+}
+
+/**** Memory ****/
+
+void* mpMalloc(size_t nBytes)
+{
+	return malloc(nBytes);
+}
+
+void mpFree(void* ptr)
+{
+	free(ptr);
+}
+
+/**** Sockets ****/
+
+int mpSocket(int domain, int type, int protocol)
+{
+	return socket(domain, type, protocol);
+}
+
+int mpBind(int s, struct sockaddr* name, int namelen)
+{
+	int reuse = 1;
+
+	// Allow the simulator to be restarted while connections are in TIME_WAIT
+	mpSimSetsockopt(s, SOL_SOCKET, SO_REUSEADDR, (char*)&reuse, sizeof(reuse));
+	return bind(s, name, namelen);
+}
+
+int mpListen(int s, int backlog)
+{
+	return listen(s, backlog);
+}
+
+int mpAccept(int s, struct sockaddr* addr, int* addrlen)
+{
+	socklen_t len = (addrlen != NULL) ? *addrlen : 0;
+	int ret;
+
+	ret = accept(s, addr, (addrlen != NULL) ? &len : NULL);
+	if(addrlen != NULL)
+		*addrlen = len;
+	return ret;
+}
+
+int mpSelect(int width, struct fd_set* readFds, struct fd_set* writeFds, struct fd_set* exceptFds, struct timeval* timeout)
+{
+	return select(width, readFds ? &readFds->set : NULL, writeFds ? &writeFds->set : NULL,
+				exceptFds ? &exceptFds->set : NULL, timeout);
+}
+
+int mpRecv(int s, char* buf, int bufLen, int flags)
+{
+	return recv(s, buf, bufLen, flags);
+}
+
+int mpSend(int s, char* buf, int bufLen, int flags)
+{
+	return send(s, buf, bufLen, flags | MSG_NOSIGNAL);
+}
+
+int mpSendTo(int s, char* buf, int bufLen, int flags, struct sockaddr* to, int tolen)
+{
+	return sendto(s, buf, bufLen, flags | MSG_NOSIGNAL, to, tolen);
+}
+
+int mpSetsockopt(int s, int level, int optname, char* optval, int optlen)
+{
+	return mpSimSetsockopt(s, level, optname, optval, optlen);
+}
+
+#undef setsockopt
+STATUS mpSimSetsockopt(int s, int level, int optname, char* optval, int optlen)
+{
+	return setsockopt(s, level, optname, optval, optlen);
+}
+
+STATUS mpClose(int s)
+{
+	return close(s);
+}
+
+USHORT mpHtons(USHORT hostshort)
+{
+	return htons(hostshort);
+}
+
+int mpNICData(USHORT if_no, ULONG* ip_addr, ULONG* subnet_mask, UCHAR* mac_addr, ULONG* default_gw)
+{
+	*ip_addr = htonl(INADDR_LOOPBACK);
+	*subnet_mask = htonl(0xFF000000);
+	*default_gw = 0;
+	memset(mac_addr, 0x00, 6);
+	return OK;
+}
+
+/**** Interpolation clock and robot model ****/
+
+//-------------------------------------------------------------------
+// Generate the interpolation clock
+//-------------------------------------------------------------------
+static void* Sim_ClockTask(void* arg)
+{
+	struct timespec next;
+	long periodNs;
+
+	periodNs = (long)(simConfig.interpolPeriod * 1000000L / simConfig.clockScale);
+	clock_gettime(CLOCK_MONOTONIC, &next);
+
+	FOREVER
+	{
+		next.tv_nsec += periodNs;
+		while(next.tv_nsec >= 1000000000L)
+		{
+			next.tv_sec++;
+			next.tv_nsec -= 1000000000L;
+		}
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+		pthread_mutex_lock(&simLock);
+		Sim_UpdateFeedback();
+
+		// INIT_ROS job: TIMER, then signal that it is waiting on the ROS motion
+		if(simJobRunning && simJobTimer > 0)
+		{
+			simJobTimer--;
+			if(simJobTimer == 0)
+				simIo[IO_FEEDBACK_WAITING_MP_INCMOVE] = 1;
+		}
+
+		simClkCount++;
+		simStats.clkTicks++;
+		pthread_cond_broadcast(&simClkCond);
+		pthread_mutex_unlock(&simLock);
+	}
+
+	return NULL;
+}
+
+// Must be called with simLock held
+static void Sim_UpdateFeedback(void)
+{
+	int grpNo;
+	int axis;
+	int regAddr;
+	double speed;
+	UINT32 regValue;
+
+	for(grpNo = 0; grpNo < simConfig.numGroups; grpNo++)
+	{
+		SimGroup* grp = &simGroups[grpNo];
+
+		for(axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+		{
+			grp->fbSpeed[axis] = (grp->cmdPos[axis] - grp->fbPos[axis]) * 1000 / simConfig.interpolPeriod;
+			grp->fbPos[axis] = grp->cmdPos[axis];
+
+			// Speed feedback registers are in 0.0001 deg/sec
+			speed = grp->fbSpeed[axis] / simConfig.pulsePerRad / RAD_PER_DEGREE * 1.0E4;
+			regValue = (UINT32)(INT32)speed;
+			regAddr = SIM_SPEED_REGISTER_BASE + (grpNo * 16) + (axis * 2);
+			simIo[regAddr] = (USHORT)(regValue & 0xFFFF);
+			simIo[regAddr + 1] = (USHORT)(regValue >> 16);
+		}
+	}
+}
+
+int mpClkAnnounce(int clkType)
+{
+	pthread_mutex_lock(&simLock);
+	pthread_cleanup_push(Sim_UnlockMutex, &simLock);
+	while(simClkCount == simClkLastAnnounced)
+		pthread_cond_wait(&simClkCond, &simLock);
+	if(simClkLastAnnounced != 0)
+		simStats.clkMissed += simClkCount - simClkLastAnnounced - 1;
+	simClkLastAnnounced = simClkCount;
+	clock_gettime(CLOCK_MONOTONIC, &simClkAnnounceTime);
+	pthread_cleanup_pop(1);
+
+	return OK;
+}
+
+int mpCtrlGrpId2GrpNo(MP_GRP_ID_TYPE grp_id)
+{
+	if((grp_id >= MP_R1_GID) && (grp_id < MP_R1_GID + simConfig.numGroups))
+		return grp_id - MP_R1_GID;
+	return -1;
+}
+
+LONG mpGetPulsePos(MP_CTRL_GRP_SEND_DATA* sData, MP_PULSE_POS_RSP_DATA* rData)
+{
+	memset(rData, 0x00, sizeof(MP_PULSE_POS_RSP_DATA));
+	if(sData->sCtrlGrp >= simConfig.numGroups)
+		return ERROR;
+
+	pthread_mutex_lock(&simLock);
+	memcpy(rData->lPos, simGroups[sData->sCtrlGrp].cmdPos, sizeof(LONG) * MAX_PULSE_AXES);
+	pthread_mutex_unlock(&simLock);
+	return OK;
+}
+
+LONG mpGetFBPulsePos(MP_CTRL_GRP_SEND_DATA* sData, MP_FB_PULSE_POS_RSP_DATA* rData)
+{
+	memset(rData, 0x00, sizeof(MP_FB_PULSE_POS_RSP_DATA));
+	if(sData->sCtrlGrp >= simConfig.numGroups)
+		return ERROR;
+
+	pthread_mutex_lock(&simLock);
+	memcpy(rData->lPos, simGroups[sData->sCtrlGrp].fbPos, sizeof(LONG) * MAX_PULSE_AXES);
+	pthread_mutex_unlock(&simLock);
+	return OK;
+}
+
+LONG mpGetServoSpeed(MP_CTRL_GRP_SEND_DATA* sData, MP_SERVO_SPEED_RSP_DATA* rData)
+{
+	memset(rData, 0x00, sizeof(MP_SERVO_SPEED_RSP_DATA));
+	if(sData->sCtrlGrp >= simConfig.numGroups)
+		return ERROR;
+
+	pthread_mutex_lock(&simLock);
+	memcpy(rData->lSpeed, simGroups[sData->sCtrlGrp].fbSpeed, sizeof(LONG) * MAX_PULSE_AXES);
+	pthread_mutex_unlock(&simLock);
+	return OK;
+}
+
+LONG mpSvsGetVelTrqFb(MP_GRP_AXES_T dst_vel, MP_TRQ_CTL_VAL* dst_trq)
+{
+	int grpNo;
+	int axis;
+
+	pthread_mutex_lock(&simLock);
+	for(grpNo = 0; grpNo < simConfig.numGroups; grpNo++)
+	{
+		for(axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+			dst_vel[grpNo][axis] = simGroups[grpNo].fbSpeed[axis] * 10; //0.1 pulse/sec
+	}
+	pthread_mutex_unlock(&simLock);
+
+	// The simulated robot has no load
+	if(dst_trq != NULL)
+		memset(dst_trq->data, 0x00, sizeof(MP_TRQCTL_DATA));
+
+	return OK;
+}
+
+int mpExRcsIncrementMove(MP_EXPOS_DATA* src_p)
+{
+	int grpNo;
+	int axis;
+	LONG inc;
+	LONG limit;
+	BOOL bLimited;
+	struct timespec now;
+	double cycleTime;
+
+	pthread_mutex_lock(&simLock);
+
+	if(!simIo[SIM_IO_SERVO] || !simJobRunning)
+	{
+		pthread_mutex_unlock(&simLock);
+		return E_EXRCS_IMOV_UNREADY;
+	}
+
+	if((src_p->ctrl_grp == 0) || (src_p->ctrl_grp >> simConfig.numGroups) != 0)
+	{
+		pthread_mutex_unlock(&simLock);
+		return E_EXRCS_CTRL_GRP;
+	}
+
+	bLimited = FALSE;
+	for(grpNo = 0; grpNo < simConfig.numGroups; grpNo++)
+	{
+		if((src_p->ctrl_grp & (0x01 << grpNo)) == 0)
+			continue;
+
+		for(axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+		{
+			inc = src_p->grp_pos_info[grpNo].pos[axis];
+			if(simConfig.fsuLimitPercent > 0)
+			{
+				// Pulses over the limit are not processed
+				limit = simGroups[grpNo].maxInc[axis] * simConfig.fsuLimitPercent / 100;
+				if(labs(inc) > limit)
+				{
+					inc = (inc > 0) ? limit : -limit;
+					bLimited = TRUE;
+				}
+			}
+			simGroups[grpNo].cmdPos[axis] += inc;
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	cycleTime = Sim_ElapsedUs(&simClkAnnounceTime, &now);
+	simStats.incMoves++;
+	if(bLimited)
+		simStats.incMovesLimited++;
+	simStats.cycleTimeTotal += cycleTime;
+	if(cycleTime > simStats.cycleTimeMax)
+		simStats.cycleTimeMax = cycleTime;
+
+	pthread_mutex_unlock(&simLock);
+	return OK;
+}
+
+int mpMeiIncrementMove(int sl_id, MP_POS_DATA* src_p)
+{
+	return mpExRcsIncrementMove(src_p);
+}
+
+/**** I/O ****/
+
+LONG mpReadIO(MP_IO_INFO* sData, USHORT* rData, LONG num)
+{
+	int i;
+	LONG ret = OK;
+
+	pthread_mutex_lock(&simLock);
+	for(i = 0; i < num; i++)
+	{
+		if(sData[i].ulAddr < SIM_IO_SIZE)
+			rData[i] = simIo[sData[i].ulAddr];
+		else
+		{
+			rData[i] = 0;
+			ret = ERROR;
+		}
+	}
+	pthread_mutex_unlock(&simLock);
+
+	return ret;
+}
+
+LONG mpWriteIO(MP_IO_DATA* sData, LONG num)
+{
+	int i;
+	LONG ret = OK;
+
+	pthread_mutex_lock(&simLock);
+	for(i = 0; i < num; i++)
+	{
+		if(sData[i].ulAddr >= SIM_IO_SIZE)
+		{
+			ret = ERROR;
+			continue;
+		}
+
+		simIo[sData[i].ulAddr] = (USHORT)sData[i].ulValue;
+
+		// INIT_ROS job: WAIT OT#(890)=ON, then end the job
+		if((sData[i].ulAddr == IO_FEEDBACK_MP_INCMOVE_DONE) && (sData[i].ulValue != 0) && simJobRunning)
+		{
+			simIo[IO_FEEDBACK_MP_INCMOVE_DONE] = 0;
+			Sim_StopJob();
+		}
+	}
+	pthread_mutex_unlock(&simLock);
+
+	return ret;
+}
+
+/**** System commands ****/
+
+// Must be called with simLock held
+static void Sim_StopJob(void)
+{
+	simJobRunning = FALSE;
+	simJobTimer = 0;
+	simIo[SIM_IO_OPERATING] = 0;
+}
+
+// Must be called with simLock held
+static void Sim_SetServo(BOOL bOn)
+{
+	simIo[SIM_IO_SERVO] = bOn ? 1 : 0;
+	if(!bOn)
+		Sim_StopJob();
+}
+
+LONG mpSetServoPower(MP_SERVO_POWER_SEND_DATA* sData, MP_STD_RSP_DATA* rData)
+{
+	memset(rData, 0x00, sizeof(MP_STD_RSP_DATA));
+
+	pthread_mutex_lock(&simLock);
+	if(sData->sServoPower && (simAlarmNum > 0 || simErrorActive))
+		rData->err_no = 0x2060;
+	else
+		Sim_SetServo(sData->sServoPower != 0);
+	pthread_mutex_unlock(&simLock);
+
+	return OK;
+}
+
+LONG mpStartJob(MP_START_JOB_SEND_DATA* sData, MP_STD_RSP_DATA* rData)
+{
+	memset(rData, 0x00, sizeof(MP_STD_RSP_DATA));
+
+	pthread_mutex_lock(&simLock);
+	if(simJobRunning)
+		rData->err_no = 0x2010;
+	else if(simAlarmNum > 0 || simErrorActive)
+		rData->err_no = 0x2060;
+	else if(!simIo[SIM_IO_SERVO])
+		rData->err_no = 0x2070;
+	else if(!simIo[SIM_IO_PLAY])
+		rData->err_no = 0x2080;
+	else if(strncmp(sData->cJobName, MOTION_INIT_ROS_JOB, MAX_JOB_NAME_LEN) != 0)
+		rData->err_no = 0x4040;
+	else
+	{
+		// DOUT OT#(890) OFF, DOUT OT#(889) OFF, TIMER T=0.05
+		simIo[IO_FEEDBACK_MP_INCMOVE_DONE] = 0;
+		simIo[IO_FEEDBACK_WAITING_MP_INCMOVE] = 0;
+		simIo[SIM_IO_OPERATING] = 1;
+		simJobRunning = TRUE;
+		simJobTimer = max(SIM_JOB_TIMER_MS / simConfig.interpolPeriod, 1);
+	}
+	pthread_mutex_unlock(&simLock);
+
+	return OK;
+}
+
+LONG mpSetToolNo(MP_SET_TOOL_NO_SEND_DATA* sData, MP_STD_RSP_DATA* rData)
+{
+	memset(rData, 0x00, sizeof(MP_STD_RSP_DATA));
+	return OK;
+}
+
+LONG mpGetAlarmStatus(MP_ALARM_STATUS_RSP_DATA* rData)
+{
+	pthread_mutex_lock(&simLock);
+	rData->sIsAlarm = ((simAlarmNum > 0) ? MASK_ISALARM_ACTIVEALARM : 0) | (simErrorActive ? MASK_ISALARM_ACTIVEERROR : 0);
+	pthread_mutex_unlock(&simLock);
+	return OK;
+}
+
+LONG mpGetAlarmCode(MP_ALARM_CODE_RSP_DATA* rData)
+{
+	memset(rData, 0x00, sizeof(MP_ALARM_CODE_RSP_DATA));
+
+	pthread_mutex_lock(&simLock);
+	rData->usAlarmNum = simAlarmNum;
+	memcpy(&rData->AlarmData, &simAlarms, sizeof(MP_ALARM_DATA));
+	pthread_mutex_unlock(&simLock);
+	return OK;
+}
+
+LONG mpResetAlarm(MP_STD_RSP_DATA* rData)
+{
+	memset(rData, 0x00, sizeof(MP_STD_RSP_DATA));
+
+	pthread_mutex_lock(&simLock);
+	simAlarmNum = 0;
+	memset(&simAlarms, 0x00, sizeof(simAlarms));
+	simIo[SIM_IO_ALARM_MAJOR] = 0;
+	simIo[SIM_IO_ALARM_MINOR] = 0;
+	simIo[SIM_IO_ALARM_SYSTEM] = 0;
+	simIo[SIM_IO_ALARM_USER] = 0;
+	pthread_mutex_unlock(&simLock);
+	return OK;
+}
+
+LONG mpCancelError(MP_STD_RSP_DATA* rData)
+{
+	memset(rData, 0x00, sizeof(MP_STD_RSP_DATA));
+
+	pthread_mutex_lock(&simLock);
+	simErrorActive = FALSE;
+	simIo[SIM_IO_ERROR] = 0;
+	pthread_mutex_unlock(&simLock);
+	return OK;
+}
+
+int mpSetAlarm(short alm_code, char* alm_msg, UCHAR sub_code)
+{
+	printf("ALARM %d[%d]: %s\r\n", alm_code, sub_code, alm_msg);
+
+	// Alarms turn the servo off and stop the job
+	pthread_mutex_lock(&simLock);
+	if(simAlarmNum < MAX_ALARM_COUNT)
+	{
+		simAlarms.usAlarmNo[simAlarmNum] = alm_code;
+		simAlarms.usAlarmData[simAlarmNum] = sub_code;
+		simAlarmNum++;
+	}
+	simIo[SIM_IO_ALARM_USER] = 1;
+	Sim_SetServo(FALSE);
+	pthread_mutex_unlock(&simLock);
+
+	return OK;
+}
+
+LONG mpApplicationInfoNotify(MP_APPINFO_SEND_DATA* sData, MP_STD_RSP_DATA* rData)
+{
+	memset(rData, 0x00, sizeof(MP_STD_RSP_DATA));
+	printf("%s %s (%s)\r\n", sData->AppName, sData->Version, sData->Comment);
+	return OK;
+}
@@ -0,0 +1,73 @@
+//mpSim.h
+//
+// Configuration and statistics of the simulated robot controller used by
+// the host build of MotoROS.
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#ifndef MPSIM_H
+#define MPSIM_H
+
+#define SIM_DEFAULT_GROUPS			1
+#define SIM_DEFAULT_AXES			6
+#define SIM_DEFAULT_IP_PERIOD		4		// ms
+#define SIM_DEFAULT_PULSE_PER_RAD	100000.0f
+#define SIM_DEFAULT_MAX_SPEED		3.14f	// rad/s
+
+#define SIM_SPEED_REGISTER_BASE		1000900	// M-registers holding the feedback speed (2 per axis, 16 per group)
+
+typedef struct
+{
+	int numGroups;				// Number of robot control groups (R1..R4)
+	int numAxes;				// Number of axes of each group
+	int interpolPeriod;			// Interpolation period in milliseconds
+	float clockScale;			// Interpolation clock rate relative to real time (>1 runs faster than real time)
+	float pulsePerRad;			// Pulse to radian conversion factor of every axis
+	float maxSpeed;				// Maximum joint speed in radian/sec
+	int fsuLimitPercent;		// When non-zero, the commanded increment is limited to this percentage of maxSpeed (simulates FSU speed limit)
+} SimConfig;
+
+typedef struct
+{
+	unsigned long clkTicks;			// Interpolation clock ticks generated
+	unsigned long clkMissed;		// Ticks that elapsed while an IP_CLK task was still busy (summed over those tasks)
+	unsigned long incMoves;			// Calls to the incremental motion API
+	unsigned long incMovesLimited;	// Calls where at least one increment was reduced by the simulated FSU limit
+	double cycleTimeTotal;			// Sum of the time between the clock announcement and the incremental motion call (us)
+	double cycleTimeMax;			// Maximum time between the clock announcement and the incremental motion call (us)
+} SimStats;
+
+extern SimConfig simConfig;
+
+extern void Sim_Init(void);
+extern void Sim_GetStats(SimStats* stats);
+extern void Sim_PrintStats(void);
+
+#endif
@@ -0,0 +1,90 @@
+//mpSimMain.c
+//
+// Entry point of the host build: configures the simulated controller,
+// starts MotoROS through mpUsrRoot and runs until interrupted.
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include "MotoROS.h"
+#include "mpSim.h"
+
+static void usage(const char* name)
+{
+	printf("Usage: %s [-g groups] [-a axes] [-p period_ms] [-s clock_scale] [-f fsu_limit_percent]\r\n", name);
+}
+
+int main(int argc, char** argv)
+{
+	int opt;
+	int sig;
+	sigset_t sigs;
+
+	while((opt = getopt(argc, argv, "g:a:p:s:f:h")) != -1)
+	{
+		switch(opt)
+		{
+			case 'g': simConfig.numGroups = atoi(optarg); break;
+			case 'a': simConfig.numAxes = atoi(optarg); break;
+			case 'p': simConfig.interpolPeriod = atoi(optarg); break;
+			case 's': simConfig.clockScale = atof(optarg); break;
+			case 'f': simConfig.fsuLimitPercent = atoi(optarg); break;
+			default:
+				usage(argv[0]);
+				return (opt == 'h') ? 0 : 1;
+		}
+	}
+
+	// Unbuffered output, like the controller console
+	setvbuf(stdout, NULL, _IONBF, 0);
+	signal(SIGPIPE, SIG_IGN);
+
+	// Block the termination signals in every task, they are handled below
+	sigemptyset(&sigs);
+	sigaddset(&sigs, SIGINT);
+	sigaddset(&sigs, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &sigs, NULL);
+
+	Sim_Init();
+
+	if(mpCreateTask(MP_PRI_TIME_NORMAL, MP_STACK_SIZE, (FUNCPTR)mpUsrRoot, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0) == ERROR)
+	{
+		printf("Failed to start mpUsrRoot\r\n");
+		return 1;
+	}
+
+	sigwait(&sigs, &sig);
+
+	Sim_PrintStats();
+	return 0;
+}
@@ -0,0 +1,179 @@
+//mpSimParameters.c
+//
+// Parameter Extraction library of the simulated controller.
+// Every group is a robot of simConfig.numAxes rotational axes sharing the
+// same pulse conversion factor and maximum speed.
+//
+/*
+* Software License Agreement (BSD License) 
+*
+* Copyright (c) 2026, the motoman_driver contributors
+* All rights reserved.
+*
+* Redistribution and use in binary form, with or without modification,
+* is permitted provided that the following conditions are met:
+*
+*       * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in the
+*       documentation and/or other materials provided with the distribution.
+*       * Neither the name of the copyright holder, nor the names 
+*       of its contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*/ 
+
+#include "MotoROS.h"
+#include "mpSim.h"
+
+//-----------------------
+// Function implementation
+//-----------------------
+
+int GP_getNumberOfGroups()
+{
+	return simConfig.numGroups;
+}
+
+int GP_getNumberOfAxes(int ctrlGrp)
+{
+	if((ctrlGrp < 0) || (ctrlGrp >= simConfig.numGroups))
+		return -1;
+	return simConfig.numAxes;
+}
+
+STATUS GP_getPulseToRad(int ctrlGrp, PULSE_TO_RAD *PulseToRad)
+{
+	int i;
+
+	memset(PulseToRad, 0x00, sizeof(PULSE_TO_RAD));
+	for(i = 0; i < simConfig.numAxes; i++)
+		PulseToRad->PtoR[i] = simConfig.pulsePerRad;
+	return OK;
+}
+
+STATUS GP_getPulseToMeter(int ctrlGrp, PULSE_TO_METER* PulseToMeter)
+{
+	memset(PulseToMeter, 0x00, sizeof(PULSE_TO_METER));
+	return OK;
+}
+
+STATUS GP_getFBPulseCorrection(int ctrlGrp, FB_PULSE_CORRECTION_DATA *correctionData)
+{
+	memset(correctionData, 0x00, sizeof(FB_PULSE_CORRECTION_DATA));
+	return OK;
+}
+
+STATUS GP_getQtyOfAllowedTasks(TASK_QTY_INFO *taskInfo)
+{
+	taskInfo->qtyOfOutFiles = 15;
+	taskInfo->qtyOfHighPriorityTasks = 2;
+	taskInfo->qtyOfNormalPriorityTasks = 16;
+	return OK;
+}
+
+STATUS GP_getInterpolationPeriod(UINT16* periodInMilliseconds)
+{
+	*periodInMilliseconds = simConfig.interpolPeriod;
+	return OK;
+}
+
+STATUS GP_getMaxIncPerIpCycle(int ctrlGrp, int interpolationPeriodInMilliseconds, MAX_INCREMENT_INFO *mip)
+{
+	int i;
+
+	memset(mip, 0x00, sizeof(MAX_INCREMENT_INFO));
+	for(i = 0; i < simConfig.numAxes; i++)
+		mip->maxIncrement[i] = (UINT32)(simConfig.maxSpeed * simConfig.pulsePerRad * interpolationPeriodInMilliseconds / 1000.0f);
+	return OK;
+}
+
+float GP_getGovForIncMotion(int ctrlGrp)
+{
+	return 1.0f;
+}
+
+STATUS GP_getJointPulseLimits(int ctrlGrp, JOINT_PULSE_LIMITS* jointPulseLimits)
+{
+	int i;
+
+	memset(jointPulseLimits, 0x00, sizeof(JOINT_PULSE_LIMITS));
+	for(i = 0; i < simConfig.numAxes; i++)
+	{
+		jointPulseLimits->maxLimit[i] = (INT32)(M_PI * simConfig.pulsePerRad);
+		jointPulseLimits->minLimit[i] = -jointPulseLimits->maxLimit[i];
+	}
+	return OK;
+}
+
+STATUS GP_getJointAngularVelocityLimits(int ctrlGrp, JOINT_ANGULAR_VELOCITY_LIMITS* jointVelocityLimits)
+{
+	int i;
+
+	memset(jointVelocityLimits, 0x00, sizeof(JOINT_ANGULAR_VELOCITY_LIMITS));
+	for(i = 0; i < simConfig.numAxes; i++)
+		jointVelocityLimits->maxLimit[i] = (INT32)(simConfig.maxSpeed / RAD_PER_DEGREE);
+	return OK;
+}
+
+STATUS GP_getAxisMotionType(int ctrlGrp, AXIS_MOTION_TYPE* axisType)
+{
+	int i;
+
+	for(i = 0; i < MAX_PULSE_AXES; i++)
+		axisType->type[i] = (i < simConfig.numAxes) ? AXIS_ROTATION : AXIS_INVALID;
+	return OK;
+}
+
+STATUS GP_isBaxisSlave(int ctrlGrp, BOOL* bBaxisIsSlave)
+{
+	*bBaxisIsSlave = FALSE;
+	return OK;
+}
+
+STATUS GP_getFeedbackSpeedMRegisterAddresses(int ctrlGrp, BOOL bActivateIfNotEnabled, BOOL bForceRebootAfterActivation, JOINT_FEEDBACK_SPEED_ADDRESSES* registerAddresses)
+{
+	int i;
+
+	registerAddresses->bFeedbackSpeedEnabled = TRUE;
+	for(i = 0; i < MAX_PULSE_AXES; i++)
+	{
+		registerAddresses->cioAddressForAxis[i][0] = SIM_SPEED_REGISTER_BASE + (ctrlGrp * 16) + (i * 2);
+		registerAddresses->cioAddressForAxis[i][1] = SIM_SPEED_REGISTER_BASE + (ctrlGrp * 16) + (i * 2) + 1;
+	}
+	return OK;
+}
+
+STATUS GP_isSdaRobot(BOOL* bIsSda)
+{
+	*bIsSda = FALSE;
+	return OK;
+}
+
+STATUS GP_isSharedBaseAxis(BOOL* bIsSharedBaseAxis)
+{
+	*bIsSharedBaseAxis = FALSE;
+	return OK;
+}
+
+STATUS GP_getDhParameters(int ctrlGrp, DH_PARAMETERS* dh)
+{
+	memset(dh, 0x00, sizeof(DH_PARAMETERS));
+	return OK;
+}
+
+STATUS GP_isPflEnabled(BOOL* bIsPflEnabled)
+{
+	*bIsPflEnabled = FALSE;
+	return OK;
+}
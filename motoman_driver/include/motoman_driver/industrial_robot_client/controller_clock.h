@@ -0,0 +1,127 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_CONTROLLER_CLOCK_H
+#define MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_CONTROLLER_CLOCK_H
+
+#include "ros/time.h"
+
+namespace industrial_robot_client
+{
+namespace controller_clock
+{
+
+/**
+ * \brief Period the controller time of the state samples wraps around at (sec).
+ * Matches STATE_TIME_WRAP in MotoROS.
+ */
+const double CONTROLLER_TIME_WRAP = 1024.0;
+
+/**
+ * \brief Maps the controller time of state samples to ROS time.
+ *
+ * The offset between both clocks is the lowest (ROS receive time - controller
+ * time) seen: the sample that got through the fastest.  It drifts up by at most
+ * MAX_DRIFT, so that it follows the drift between the clocks.
+ *
+ * As the controller takes its samples on its interpolation clock, the shortest
+ * interval between samples is the sample period: longer ones are samples
+ * that were dropped.
+ *
+ * THIS CLASS IS NOT THREAD-SAFE
+ *
+ */
+class ControllerClock
+{
+public:
+  explicit ControllerClock(double wrap = CONTROLLER_TIME_WRAP);
+
+  /**
+   * \brief Map the controller time of a sample to ROS time
+   *
+   * Messages of the same sample (e.g. for each group) have the same
+   * controller time, and are given the same ROS time.
+   *
+   * \param controller_time time the sample was taken, on the controller clock (sec)
+   * \param receive_time ROS time the sample was received
+   * \return ROS time the sample was taken
+   */
+  ros::Time toRosTime(double controller_time, const ros::Time &receive_time);
+
+  /**
+   * \brief Forget the offset between the clocks, e.g. on reconnection
+   */
+  void reset();
+
+  /**
+   * \brief Sequence # of the last sample: the number of sample periods since the first one
+   */
+  unsigned int sequence() const
+  {
+    return sequence_;
+  }
+
+  /**
+   * \brief Number of samples dropped since the last reset
+   */
+  unsigned int dropped() const
+  {
+    return dropped_;
+  }
+
+  /**
+   * \brief Number of samples dropped right before the last one
+   */
+  unsigned int lastDropped() const
+  {
+    return last_dropped_;
+  }
+
+private:
+  static const double MAX_DRIFT;  // between the clocks (sec/sec)
+  static const double MAX_GAP;    // between samples, past which the clocks are synchronized again (sec)
+
+  double wrap_;
+  bool synced_;
+  double epoch_;      // controller time of the last wrap around (sec)
+  double last_time_;  // unwrapped controller time of the last sample (sec)
+  double offset_;     // ROS time - controller time (sec)
+  double period_;     // between samples (sec), 0 until known
+  unsigned int sequence_;
+  unsigned int dropped_;
+  unsigned int last_dropped_;
+};
+
+}  // namespace controller_clock
+}  // namespace industrial_robot_client
+
+#endif  // MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_CONTROLLER_CLOCK_H
@@ -0,0 +1,254 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_FRAME_RECORDER_H
+#define MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_FRAME_RECORDER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include "simple_message/simple_message.h"
+#include "simple_message/socket/tcp_client.h"
+
+namespace industrial_robot_client
+{
+namespace frame_recorder
+{
+
+using industrial::simple_message::SimpleMessage;
+using industrial::tcp_client::TcpClient;
+
+/**
+ * \brief Recording file layout.
+ *
+ * A recording starts with a 16 byte file header:
+ *
+ *   member:             type                                      size
+ *   magic               (char[8], "SMSGREC\0")                    8  bytes
+ *   version             (uint32, host byte order)                 4  bytes
+ *   reserved            (uint32)                                  4  bytes
+ *
+ * followed by one record per frame, each padded to a multiple of 8 bytes:
+ *
+ *   size                (uint32, host byte order)                 4  bytes
+ *   direction           (uint16, FrameDirection)                  2  bytes
+ *   connection          (uint16, connection of the recording)     2  bytes
+ *   stamp               (uint64, monotonic clock, ns)             8  bytes
+ *   frame               (the frame as sent on the wire:           size bytes
+ *                        length prefix, header and data)
+ *
+ * The file is preallocated and zero filled; a record with a size of 0 ends
+ * the recording.
+ */
+namespace FrameDirections
+{
+enum FrameDirection
+{
+  RECEIVED = 1,  // from the controller
+  SENT     = 2   // to the controller
+};
+}  // namespace FrameDirections
+typedef FrameDirections::FrameDirection FrameDirection;
+
+struct RecordHeader
+{
+  uint32_t size;
+  uint16_t direction;
+  uint16_t connection;
+  uint64_t stamp;
+};
+
+static const char RECORDING_MAGIC[8] = {'S', 'M', 'S', 'G', 'R', 'E', 'C', '\0'};
+static const uint32_t RECORDING_VERSION = 2;
+static const size_t RECORDING_HEADER_SIZE = 16;
+
+/**
+ * \brief Current time of the clock recordings are stamped with (ns)
+ */
+uint64_t monotonicStamp();
+
+/**
+ * \brief Appends raw simple-message frames to a memory-mapped recording.
+ *
+ * The file is sized when it is opened; frames that do not fit are dropped
+ * (and counted).  Recording a frame takes no lock and makes no system call,
+ * so a recorder may be shared by several threads.
+ */
+class FrameRecorder
+{
+public:
+  FrameRecorder();
+  ~FrameRecorder();
+
+  /**
+   * \brief Create (or truncate) a recording
+   *
+   * \param path recording file
+   * \param max_size file size (bytes)
+   * \return true on success, false otherwise
+   */
+  bool open(const std::string &path, size_t max_size);
+
+  /**
+   * \brief Finish the recording: unmap it and trim the unused part of the file
+   */
+  void close();
+
+  bool isOpen() const
+  {
+    return this->data_ != NULL;
+  }
+
+  /**
+   * \brief Number a connection recorded to this recording.  The connections
+   * are numbered from 0 in the order they are added; open() restarts the
+   * numbering.
+   *
+   * \return connection number
+   */
+  unsigned int addConnection()
+  {
+    return this->connections_++;
+  }
+
+  /**
+   * \brief Append a frame to the recording
+   *
+   * \param direction direction the frame travelled
+   * \param connection connection the frame travelled on (see addConnection())
+   * \param msg frame
+   */
+  void record(FrameDirection direction, unsigned int connection, SimpleMessage &msg);
+
+  /**
+   * \brief Number of frames that did not fit in the recording
+   */
+  unsigned int dropped() const
+  {
+    return this->dropped_;
+  }
+
+private:
+  int fd_;
+  char* data_;
+  size_t size_;
+  std::atomic<size_t> end_;  // next free byte
+  std::atomic<unsigned int> dropped_;
+  std::atomic<unsigned int> connections_;
+};
+
+/**
+ * \brief Reads the frames of a recording, in recording order.
+ */
+class FrameReader
+{
+public:
+  FrameReader();
+  ~FrameReader();
+
+  /**
+   * \brief Open a recording
+   *
+   * \param path recording file
+   * \return true on success, false otherwise (not a recording)
+   */
+  bool open(const std::string &path);
+
+  void close();
+
+  /**
+   * \brief Read the next frame
+   *
+   * \param[out] header record header of the frame
+   * \param[out] frame frame bytes, as sent on the wire (valid until close())
+   * \return false at the end of the recording
+   */
+  bool next(RecordHeader* header, const char** frame);
+
+  /**
+   * \brief Restart reading at the first frame
+   */
+  void rewind()
+  {
+    this->pos_ = RECORDING_HEADER_SIZE;
+  }
+
+private:
+  int fd_;
+  const char* data_;
+  size_t size_;
+  size_t pos_;
+};
+
+/**
+ * \brief TCP client connection that records every frame it sends and
+ * receives, when recording is enabled.
+ */
+class RecordingTcpClient : public TcpClient
+{
+public:
+  RecordingTcpClient() : recorder_(&own_recorder_), connection_(0) {}
+
+  /**
+   * \brief Start recording if the ROS param "~record_file" is set.  The
+   * recording is sized by the ROS param "~record_size_mb" (default 256).
+   *
+   * \return false if the recording could not be created, true otherwise
+   */
+  bool initRecording();
+
+  /**
+   * \brief Record to the recording of another connection instead (e.g. of a
+   * pool of connections to the same server).  Its frames are interleaved with
+   * those of the other connection, and tagged with the next connection number.
+   *
+   * \param other connection which initRecording() started the recording
+   */
+  void shareRecording(RecordingTcpClient &other)
+  {
+    this->recorder_ = other.recorder_;
+    this->connection_ = this->recorder_->addConnection();
+  }
+
+  virtual bool sendMsg(SimpleMessage &message);
+  virtual bool receiveMsg(SimpleMessage &message);
+
+protected:
+  FrameRecorder own_recorder_;
+  FrameRecorder* recorder_;
+  unsigned int connection_;  // number of this connection in the recording
+};
+
+}  // namespace frame_recorder
+}  // namespace industrial_robot_client
+
+#endif  // MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_FRAME_RECORDER_H
@@ -37,6 +37,7 @@
 #include <vector>
 #include <map>
 #include <string>
+#include "motoman_driver/industrial_robot_client/controller_clock.h"
 #include "motoman_driver/industrial_robot_client/joint_relay_handler.h"
 #include "motoman_driver/industrial_robot_client/joint_feedback_relay_handler.h"
 #include "motoman_driver/simple_message/messages/joint_feedback_ex_message.h"
@@ -50,6 +51,8 @@ namespace joint_feedback_ex_relay_handler
 
 using industrial::joint_feedback_ex_message::JointFeedbackExMessage;
 using industrial::joint_feedback_message::JointFeedbackMessage;
+using industrial_robot_client::controller_clock::ControllerClock;
+using industrial_robot_client::joint_map::JointMap;
 using industrial::simple_message::SimpleMessage;
 using industrial::smpl_msg_connection::SmplMsgConnection;
 using industrial_robot_client::joint_relay_handler::JointRelayHandler;
@@ -98,6 +101,17 @@ protected:
   ros::Publisher dynamic_pub_joint_control_state_;
   ros::Publisher pub_joint_sensor_state_;
 
+  /**
+   * \brief Maps the controller time of the feedback to ROS time
+   */
+  ControllerClock clock_;
+
+  /**
+   * \brief ROS time the last converted joint state was sampled: from its
+   * controller time if it has one, the time it is received otherwise
+   */
+  ros::Time sample_stamp(const DynamicJointsGroup& joint_state);
+
   /**
    * \brief Convert joint message into intermediate message-type
    *
@@ -108,15 +122,39 @@ protected:
 
   virtual bool convert_message(JointFeedbackMessage& msg_in, DynamicJointsGroup* joint_state, int robot_id);
 
-  // override JointRelayHandler::create_messages, to check robot_id w/o error msg
+  // override JointRelayHandler::create_messages, to check robot_id w/o error msg.
+  // The messages of each group are published here: control_state and sensor_state are left untouched.
   bool create_messages(SimpleMessage& msg_in,
                        control_msgs::FollowJointTrajectoryFeedback* control_state,
                        sensor_msgs::JointState* sensor_state);
 
-  // override JointRelayHandler::create_messages, to check robot_id w/o error msg
-  bool create_messages(JointFeedbackMessage& msg_in,
-                       control_msgs::FollowJointTrajectoryFeedback* control_state,
-                       sensor_msgs::JointState* sensor_state, int robot_id);
+  /**
+   * \brief Convert and publish the joint feedback of a group
+   *
+   * \param msg_in joint feedback of the group
+   * \param efforts joint efforts of the group, NULL if it has none
+   * \param robot_id group # of the feedback
+   * \param[out] dyn_joint_state joint state of the group, for the dynamic feedback
+   */
+  bool create_messages(JointFeedbackMessage& msg_in, const industrial::joint_data::JointData* efforts,
+                       int robot_id, motoman_msgs::DynamicJointState* dyn_joint_state);
+
+  /**
+   * \brief Feedback of a group, kept from message to message so that relaying
+   * feedback does not allocate memory once the first messages are published
+   */
+  struct GroupFeedback
+  {
+    int num_joints;  // including blank (unpublished) joints
+    DynamicJointsGroup all_joint_state;
+    DynamicJointsGroup xform_joint_state;
+    control_msgs::FollowJointTrajectoryFeedbackPtr control_state;
+    sensor_msgs::JointStatePtr sensor_state;
+  };
+  std::map<int, GroupFeedback> group_feedback_;
+
+  JointFeedbackExMessage feedback_msg_;
+  motoman_msgs::DynamicJointTrajectoryFeedbackPtr dynamic_control_state_;
 
 private:
   static bool JointDataToVector(const industrial::joint_data::JointData &joints,
@@ -36,6 +36,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include "motoman_driver/industrial_robot_client/controller_clock.h"
 #include "motoman_driver/industrial_robot_client/joint_relay_handler.h"
 #include "simple_message/messages/joint_feedback_message.h"
 #include "motoman_msgs/DynamicJointsGroup.h"
@@ -46,6 +47,8 @@ namespace joint_feedback_relay_handler
 {
 
 using industrial::joint_feedback_message::JointFeedbackMessage;
+using industrial_robot_client::controller_clock::ControllerClock;
+using industrial_robot_client::joint_map::JointMap;
 using industrial::simple_message::SimpleMessage;
 using industrial::smpl_msg_connection::SmplMsgConnection;
 using industrial_robot_client::joint_relay_handler::JointRelayHandler;
@@ -88,6 +91,17 @@ protected:
   int robot_id_;
   bool version_0_;
 
+  /**
+   * \brief Maps the controller time of the feedback to ROS time
+   */
+  ControllerClock clock_;
+
+  /**
+   * \brief ROS time a joint state was sampled: from its controller time if it
+   * has one (TIME in valid_fields), the time it is received otherwise
+   */
+  ros::Time sample_stamp(const DynamicJointsGroup& joint_state);
+
 
   /**
    * \brief Convert joint message into intermediate message-type
@@ -121,9 +135,6 @@ protected:
     return true;
   }
 
-  virtual bool select(const DynamicJointsGroup& all_joint_state, const std::vector<std::string>& all_joint_names,
-                      DynamicJointsGroup* pub_joint_state, std::vector<std::string>* pub_joint_names);
-
 private:
   static bool JointDataToVector(const industrial::joint_data::JointData &joints,
                                 std::vector<double> &vec, int len);
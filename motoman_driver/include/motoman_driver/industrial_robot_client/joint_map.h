@@ -0,0 +1,130 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_JOINT_MAP_H
+#define MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_JOINT_MAP_H
+
+#include <string>
+#include <vector>
+
+namespace industrial_robot_client
+{
+namespace joint_map
+{
+
+/**
+ * \brief Maps a list of joint names onto another one, by index.
+ *
+ * Joint names are matched once, when the map is initialized.  The values of
+ * every point or message with the same joint names are then copied by index,
+ * without comparing names again.
+ *
+ * THIS CLASS IS NOT THREAD-SAFE (but a const map can be shared between threads)
+ *
+ */
+class JointMap
+{
+public:
+  /**
+   * \brief Index of the joints that have no source joint
+   */
+  static const int NONE = -1;
+
+  /**
+   * \brief Map each joint of to_names to the joint of the same name in from_names.
+   * Blank names of to_names are placeholders, mapped to NONE.
+   *
+   * \param from_names joint names of the source values
+   * \param to_names joint names of the mapped values
+   * \return false if a (non-blank) joint of to_names is missing from from_names (see missing())
+   */
+  bool init(const std::vector<std::string> &from_names, const std::vector<std::string> &to_names);
+
+  /**
+   * \brief Map the non-blank joints of names, in order, for publishing.
+   *
+   * \param names joint names of the source values, blank for placeholders
+   */
+  void initPublished(const std::vector<std::string> &names);
+
+  /**
+   * \brief Number of mapped joints
+   */
+  size_t size() const
+  {
+    return index_.size();
+  }
+
+  /**
+   * \brief Index of the source of a mapped joint, NONE if it has none
+   */
+  int index(size_t joint) const
+  {
+    return index_[joint];
+  }
+
+  /**
+   * \brief Names of the mapped joints
+   */
+  const std::vector<std::string>& names() const
+  {
+    return names_;
+  }
+
+  /**
+   * \brief The first joint that init() did not find (blank if none)
+   */
+  const std::string& missing() const
+  {
+    return missing_;
+  }
+
+  /**
+   * \brief Copy the values of the mapped joints (none if src is empty)
+   *
+   * \param src values of the source joints
+   * \param fill value of the joints that have no source joint
+   * \param[out] dst values of the mapped joints
+   * \return false if src is too short
+   */
+  bool apply(const std::vector<double> &src, double fill, std::vector<double>* dst) const;
+
+private:
+  std::vector<int> index_;
+  std::vector<std::string> names_;
+  std::string missing_;
+};
+
+}  // namespace joint_map
+}  // namespace industrial_robot_client
+
+#endif  // MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_JOINT_MAP_H
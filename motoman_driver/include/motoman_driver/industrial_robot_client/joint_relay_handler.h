@@ -42,6 +42,7 @@
 #include "simple_message/message_handler.h"
 #include "simple_message/messages/joint_message.h"
 #include "trajectory_msgs/JointTrajectoryPoint.h"
+#include "motoman_driver/industrial_robot_client/joint_map.h"
 #include "motoman_driver/industrial_robot_client/robot_group.h"
 #include "motoman_msgs/DynamicJointsGroup.h"
 
@@ -54,6 +55,7 @@ using industrial::joint_message::JointMessage;
 using industrial::simple_message::SimpleMessage;
 using trajectory_msgs::JointTrajectoryPoint;
 using motoman_msgs::DynamicJointsGroup;
+using industrial_robot_client::joint_map::JointMap;
 /**
  * \brief Message handler that relays joint positions (converts simple message
  * types to ROS message types and publishes them)
@@ -113,6 +115,13 @@ protected:
   std::map<int, ros::Publisher> pub_controls_;
   std::map<int, ros::Publisher> pub_states_;
 
+  /**
+   * \brief Joints published from all_joint_names_ and from each group,
+   * mapped once when the handler is initialized
+   */
+  JointMap pub_joints_;
+  std::map<int, JointMap> group_pub_joints_;
+
   /**
    * \brief Class initializer
    *
@@ -229,6 +238,21 @@ protected:
   virtual bool select(const DynamicJointsGroup& all_joint_state, const std::vector<std::string>& all_joint_names,
                       DynamicJointsGroup* pub_joint_state, std::vector<std::string>* pub_joint_names);
 
+  /**
+   * \brief Select specific joints for publishing, with the published joints already mapped
+   *
+   * \param[in] all_joint_state joint state, in count/order matching robot connection
+   * \param[in] pub_joints published joints of all_joint_state (see JointMap::initPublished())
+   * \param[out] pub_joint_state joint state selected for publishing, in the order of pub_joints.names()
+   *
+   * \return true on success, false otherwise
+   */
+  bool select(const JointTrajectoryPoint& all_joint_state, const JointMap& pub_joints,
+              JointTrajectoryPoint* pub_joint_state);
+
+  bool select(const DynamicJointsGroup& all_joint_state, const JointMap& pub_joints,
+              DynamicJointsGroup* pub_joint_state);
+
   /**
    * \brief Callback executed upon receiving a joint message
    *
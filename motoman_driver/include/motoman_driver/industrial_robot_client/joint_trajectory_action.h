@@ -149,6 +149,22 @@ private:
   void controllerStateCB(const control_msgs::FollowJointTrajectoryFeedbackConstPtr &msg);
 
   void controllerStateCB(const control_msgs::FollowJointTrajectoryFeedbackConstPtr &msg, int robot_id);
+
+  /**
+   * \brief Controller status callback.  The controller sends its status as soon as it
+   * changes: a stopped motion completes the active goals now, rather than on the next feedback.
+   *
+   * \param msg robot status message
+   */
+  void robotStatusCB(const industrial_msgs::RobotStatusConstPtr &msg);
+
+  /**
+   * \brief Succeed the active goal of a group if it ended inside its goal constraints
+   * and motion stopped
+   *
+   * \param robot_id group of the goal
+   */
+  void checkGoalCompletion(int robot_id);
   using JointTrajectoryActionV0::motionReplyCB;
   void motionReplyCB(const motoman_msgs::MotionReplyResultConstPtr &msg, int robot_id);
   using JointTrajectoryActionV0::abortGoal;
@@ -47,6 +47,8 @@
 #include "simple_message/socket/tcp_client.h"
 #include "simple_message/messages/joint_traj_pt_message.h"
 #include "trajectory_msgs/JointTrajectory.h"
+#include "motoman_driver/industrial_robot_client/frame_recorder.h"
+#include "motoman_driver/industrial_robot_client/joint_map.h"
 #include "motoman_driver/industrial_robot_client/robot_group.h"
 
 namespace industrial_robot_client
@@ -56,8 +58,10 @@ namespace joint_trajectory_interface
 
 using industrial::smpl_msg_connection::SmplMsgConnection;
 using industrial::tcp_client::TcpClient;
+using industrial_robot_client::frame_recorder::RecordingTcpClient;
 using industrial::joint_traj_pt_message::JointTrajPtMessage;
 using industrial::simple_message::SimpleMessage;
+using industrial_robot_client::joint_map::JointMap;
 namespace StandardSocketPorts = industrial::simple_socket::StandardSocketPorts;
 
 /**
@@ -158,6 +162,20 @@ protected:
   virtual bool trajectory_to_msgs(const motoman_msgs::DynamicJointTrajectoryConstPtr& traj,
                                   std::vector<SimpleMessage>* msgs);
 
+  /**
+   * \brief Convert a range of trajectory points into SimpleMessages, without validating them.
+   *   Each point is converted on its own, so ranges may be converted concurrently.
+   *
+   * \param[in] traj ROS DynamicJointTrajectory message
+   * \param[in] first index of the first point to convert
+   * \param[in] last index past the last point to convert
+   * \param[out] msgs SimpleMessages for points [first, last)
+   *
+   * \return true on success, false otherwise
+   */
+  bool points_to_msgs(const motoman_msgs::DynamicJointTrajectory& traj, size_t first, size_t last,
+                      std::vector<SimpleMessage>* msgs);
+
   /**
    * \brief Convert ROS trajectory message into stream of SimpleMessages for sending to robot.
    *   Also includes various joint transforms that can be overridden for robot-specific behavior.
@@ -220,6 +238,34 @@ protected:
                       const trajectory_msgs::JointTrajectoryPoint& ros_pt,
                       const std::vector<std::string>& rbt_joint_names, trajectory_msgs::JointTrajectoryPoint* rbt_pt);
 
+  /**
+   * \brief Select specific joints for sending to the robot, with the joint names already matched.
+   * The same map serves every point of a trajectory.
+   *
+   * \param[in] rbt_joints map from the joints of the ROS command to the joints expected by robot connection
+   * \param[in] ros_pt target pos/vel from ROS command
+   * \param[out] rbt_pt target pos/vel, matching the joints of rbt_joints
+   *
+   * \return true on success, false otherwise
+   */
+  bool select(const JointMap& rbt_joints, const motoman_msgs::DynamicJointsGroup& ros_pt,
+              motoman_msgs::DynamicJointsGroup* rbt_pt);
+
+  bool select(const JointMap& rbt_joints, const trajectory_msgs::JointTrajectoryPoint& ros_pt,
+              trajectory_msgs::JointTrajectoryPoint* rbt_pt);
+
+  /**
+   * \brief Match the joints of a ROS command to the joints expected by robot connection
+   *
+   * \param[in] ros_joint_names joint names from ROS command
+   * \param[in] rbt_joint_names joint names, in order/count expected by robot connection
+   * \param[out] rbt_joints map from ros_joint_names to rbt_joint_names
+   *
+   * \return false if an expected joint is missing from the ROS command
+   */
+  static bool map_joints(const std::vector<std::string>& ros_joint_names,
+                         const std::vector<std::string>& rbt_joint_names, JointMap* rbt_joints);
+
   /**
    * \brief Create SimpleMessage for sending to the robot
    *
@@ -324,6 +370,28 @@ protected:
    */
   virtual bool is_valid(const motoman_msgs::DynamicJointTrajectory &traj);
 
+  /**
+   * \brief Validate that a range of trajectory points meets minimum requirements.
+   *   Must not depend on points outside the range, as ranges may be validated concurrently.
+   *
+   * \param traj incoming trajectory
+   * \param first index of the first point to validate
+   * \param last index past the last point to validate
+   * \return true if the points are valid, false otherwise
+   */
+  virtual bool is_valid(const motoman_msgs::DynamicJointTrajectory &traj, size_t first, size_t last);
+
+  /**
+   * \brief Validate that a trajectory can start from the robot's current state
+   *
+   * \param traj incoming trajectory
+   * \return true if the trajectory can start, false otherwise
+   */
+  virtual bool is_valid_start(const motoman_msgs::DynamicJointTrajectory &traj)
+  {
+    return true;
+  }
+
   /**
    * \brief Validate that trajectory command meets minimum requirements
    *
@@ -332,6 +400,17 @@ protected:
    */
   virtual bool is_valid(const trajectory_msgs::JointTrajectory &traj);
 
+  /**
+   * \brief Validate that a trajectory can start from the robot's current state
+   *
+   * \param traj incoming trajectory
+   * \return true if the trajectory can start, false otherwise
+   */
+  virtual bool is_valid_start(const trajectory_msgs::JointTrajectory &traj)
+  {
+    return true;
+  }
+
   /*
    * \brief Callback for JointState topic
    *
@@ -350,7 +429,7 @@ protected:
    */
   void sendMotionReplyResult(ros::Publisher& pub, int res);
 
-  TcpClient default_tcp_connection_;
+  RecordingTcpClient default_tcp_connection_;
 
   ros::NodeHandle node_;
   SmplMsgConnection* connection_;
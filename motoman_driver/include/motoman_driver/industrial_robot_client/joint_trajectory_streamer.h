@@ -32,8 +32,11 @@
 #ifndef MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_JOINT_TRAJECTORY_STREAMER_H
 #define MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_JOINT_TRAJECTORY_STREAMER_H
 
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/thread/thread.hpp>
 #include "motoman_driver/industrial_robot_client/joint_trajectory_interface.h"
+#include "motoman_driver/industrial_robot_client/latency_histogram.h"
 #include <map>
 #include <vector>
 #include <string>
@@ -46,6 +49,8 @@ namespace joint_trajectory_streamer
 using industrial_robot_client::joint_trajectory_interface::JointTrajectoryInterface;
 using industrial::simple_message::SimpleMessage;
 using industrial::smpl_msg_connection::SmplMsgConnection;
+using industrial_robot_client::latency_histogram::LatencyHistogram;
+using industrial_robot_client::joint_map::JointMap;
 
 namespace TransferStates
 {
@@ -77,7 +82,10 @@ public:
    *
    * \param min_buffer_size minimum number of points as required by robot implementation
    */
-  explicit JointTrajectoryStreamer(int min_buffer_size = 1) : min_buffer_size_(min_buffer_size) {}
+  explicit JointTrajectoryStreamer(int min_buffer_size = 1) : min_buffer_size_(min_buffer_size),
+    first_point_pending_(false), splice_lead_time_(0.1), splice_blend_time_(0.2), splice_max_deviation_(0.02),
+    conversion_chunk_size_(0), conversion_threads_(1),
+    next_chunk_(0), next_collected_chunk_(0), conversion_failed_(false), conversion_cancelled_(false) {}
 
   /**
    * \brief Class initializer
@@ -116,6 +124,12 @@ public:
 
   virtual void jointTrajectoryCB(const motoman_msgs::DynamicJointTrajectoryConstPtr &msg);
 
+  /**
+   * \brief Callback of the DynamicJointTrajectory topics (robot_groups setups):
+   * streams, splices or stops like jointTrajectoryCB().
+   */
+  virtual void jointTrajectoryExCB(const motoman_msgs::DynamicJointTrajectoryConstPtr &msg);
+
   virtual bool trajectory_to_msgs(const trajectory_msgs::JointTrajectoryConstPtr& traj,
                                   std::vector<SimpleMessage>* msgs);
 
@@ -129,13 +143,141 @@ public:
 protected:
   void trajectoryStop();
 
+  /**
+   * \brief Splice a new trajectory onto the one currently streaming.
+   *
+   * The motion queued on the robot past the splice time is dropped, the new
+   * trajectory is time-aligned against the motion currently executing and its
+   * points past the splice time replace the points not yet sent.  Where the new
+   * trajectory deviates from the kept motion at the splice time, the deviation
+   * is blended out over splice_blend_time_; beyond splice_max_deviation_ the
+   * trajectories are not spliced.
+   *
+   * \param traj new trajectory
+   * \return true on success, false if the trajectories could not be spliced
+   */
+  bool splice(const trajectory_msgs::JointTrajectoryConstPtr &traj);
+
+  bool splice(const motoman_msgs::DynamicJointTrajectoryConstPtr &traj);
+
+  /**
+   * \brief Drop the motion queued on the robot past the splice time.
+   *
+   * Robot implementations that cannot truncate their motion queue return false,
+   * in which case the current motion is stopped instead of spliced.
+   *
+   * \param lead_time motion to keep queued ahead of the motion currently executing (sec)
+   * \param[out] splice_time trajectory time at which the kept motion ends (sec)
+   * \param[out] exec_time trajectory time currently executing (sec)
+   * \param[out] end_state joint positions and velocities at the end of the kept motion,
+   *   by group number, in the joint order of the messages sent
+   * \return true on success, false otherwise
+   */
+  virtual bool truncate(double lead_time, double* splice_time, double* exec_time,
+                        std::map<int, trajectory_msgs::JointTrajectoryPoint>* end_state)
+  {
+    return false;
+  }
+
+  /**
+   * \brief Wake the streaming thread, e.g. after a new trajectory was loaded
+   * or a stop was requested.
+   */
+  void notifyStreamingThread();
+
+  /**
+   * \brief Block the streaming thread until it is notified or the timeout expires.
+   *
+   * \param lock lock on mutex_, held by the caller.  Released while waiting.
+   * \param timeout maximum time to wait
+   */
+  void waitForEvent(boost::unique_lock<boost::mutex> &lock, const ros::Duration &timeout);
+
+  /**
+   * \brief Record the time between loading the current trajectory and sending
+   * its first point, once per trajectory.
+   */
+  void recordFirstPointLatency();
+
+  /**
+   * \brief Validate a long trajectory and convert its first chunk of points,
+   * leaving the remaining chunks converting on background threads.
+   *
+   * Chunks are validated concurrently, and all of them before anything is
+   * streamed.  Converted chunks are appended to current_traj_ in order by
+   * collectConvertedPoints().
+   *
+   * \param traj trajectory of more than conversion_chunk_size_ points
+   * \param[out] msgs messages of the first chunk, for send_to_robot()
+   * \return false if the trajectory is invalid or its first chunk could not be converted
+   */
+  bool startConversion(const motoman_msgs::DynamicJointTrajectoryConstPtr &traj, std::vector<SimpleMessage>* msgs);
+
+  /**
+   * \brief Append the chunks converted since the last call to current_traj_.
+   * Called by the streaming thread, with mutex_ held.
+   *
+   * \param[out] converting true if more points will follow
+   * \return false if a chunk failed to convert
+   */
+  bool collectConvertedPoints(bool* converting);
+
+  /**
+   * \brief Stop the background conversion (if any) and drop its unsent points.
+   */
+  void cancelConversion();
+
+  /**
+   * \brief Background worker: convert chunks until none are left.
+   */
+  void convertChunks();
+
+  /**
+   * \brief Validate every stride-th chunk, starting at first_chunk.
+   */
+  void validateChunks(const motoman_msgs::DynamicJointTrajectory &traj, size_t first_chunk, size_t stride,
+                      char* valid);
+
   boost::thread* streaming_thread_;
   boost::mutex mutex_;
+  boost::condition_variable streaming_cond_;
   int current_point_;
   std::vector<SimpleMessage> current_traj_;
   TransferState state_;
   ros::Time streaming_start_;
   int min_buffer_size_;
+  bool first_point_pending_;
+  LatencyHistogram first_point_latency_;
+  double splice_lead_time_;
+
+  /**
+   * \brief Time over which a spliced trajectory is blended into the kept motion
+   * (ROS param "splice_blend_time", sec), and the largest deviation that is
+   * blended (ROS param "splice_max_deviation", rad; for velocities, rad over
+   * the blend time).  A blend time of 0 splices trajectories as they are,
+   * within the maximum deviation (rad/s for velocities).
+   */
+  double splice_blend_time_;
+  double splice_max_deviation_;
+
+  /**
+   * \brief Number of points per chunk when converting long DynamicJointTrajectory
+   * messages on conversion_threads_ background threads.  0 converts every
+   * trajectory entirely before streaming it, as required when the messages of
+   * consecutive points depend on each other (e.g. calc_duration()).
+   */
+  int conversion_chunk_size_;
+  int conversion_threads_;
+
+  std::vector<boost::shared_ptr<boost::thread> > conversion_workers_;
+  boost::mutex conversion_mutex_;  // guards the conversion state below
+  motoman_msgs::DynamicJointTrajectoryConstPtr conversion_traj_;
+  std::vector<std::vector<SimpleMessage> > converted_chunks_;
+  std::vector<bool> chunk_converted_;
+  size_t next_chunk_;  // next chunk to be converted
+  size_t next_collected_chunk_;  // next chunk to be appended to current_traj_
+  bool conversion_failed_;
+  bool conversion_cancelled_;
 };
 
 }  // namespace joint_trajectory_streamer
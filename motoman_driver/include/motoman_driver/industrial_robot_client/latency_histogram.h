@@ -0,0 +1,102 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_LATENCY_HISTOGRAM_H
+#define MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_LATENCY_HISTOGRAM_H
+
+#include <string>
+#include <vector>
+#include "ros/duration.h"
+
+namespace industrial_robot_client
+{
+namespace latency_histogram
+{
+
+/**
+ * \brief Fixed-bucket histogram of latency samples.
+ *
+ * Buckets are bounded by 0.1, 0.2, 0.5, 1, 2, 5, ... ms; the last bucket
+ * collects everything above the largest bound.
+ *
+ * THIS CLASS IS NOT THREAD-SAFE
+ *
+ */
+class LatencyHistogram
+{
+public:
+  LatencyHistogram();
+
+  /**
+   * \brief Add a sample to the histogram
+   *
+   * \param latency sample to add
+   */
+  void record(const ros::Duration &latency);
+
+  /**
+   * \brief Discard all samples
+   */
+  void reset();
+
+  /**
+   * \brief Number of samples recorded since the last reset
+   */
+  unsigned int count() const
+  {
+    return count_;
+  }
+
+  /**
+   * \brief Largest sample recorded since the last reset (sec)
+   */
+  double max() const
+  {
+    return max_;
+  }
+
+  /**
+   * \brief Human readable summary, e.g. for logging
+   */
+  std::string toString() const;
+
+private:
+  std::vector<double> bounds_;  // upper bound of each bucket (sec)
+  std::vector<unsigned int> buckets_;
+  unsigned int count_;
+  double sum_;
+  double max_;
+};
+
+}  // namespace latency_histogram
+}  // namespace industrial_robot_client
+
+#endif  // MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_LATENCY_HISTOGRAM_H
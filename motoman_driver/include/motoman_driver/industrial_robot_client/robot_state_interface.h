@@ -32,17 +32,27 @@
 #ifndef MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_ROBOT_STATE_INTERFACE_H
 #define MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_ROBOT_STATE_INTERFACE_H
 
+#include <atomic>
 #include <vector>
 #include <string>
 #include <map>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include "ros/time.h"
 #include "simple_message/smpl_msg_connection.h"
 #include "simple_message/message_manager.h"
 #include "simple_message/message_handler.h"
+#include "simple_message/ping_handler.h"
 #include "simple_message/socket/tcp_client.h"
+#include "motoman_driver/industrial_robot_client/frame_recorder.h"
 #include "motoman_driver/industrial_robot_client/joint_relay_handler.h"
 #include "motoman_driver/industrial_robot_client/robot_group.h"
 #include "motoman_driver/industrial_robot_client/joint_feedback_relay_handler.h"
 #include "motoman_driver/industrial_robot_client/joint_feedback_ex_relay_handler.h"
+#include "motoman_driver/industrial_robot_client/latency_histogram.h"
+#include "motoman_driver/industrial_robot_client/spsc_ring.h"
 #include "industrial_robot_client/robot_status_relay_handler.h"
 
 namespace industrial_robot_client
@@ -53,11 +63,16 @@ namespace robot_state_interface
 using industrial::smpl_msg_connection::SmplMsgConnection;
 using industrial::message_manager::MessageManager;
 using industrial::message_handler::MessageHandler;
+using industrial::ping_handler::PingHandler;
+using industrial::simple_message::SimpleMessage;
 using industrial::tcp_client::TcpClient;
+using industrial_robot_client::frame_recorder::RecordingTcpClient;
 using industrial_robot_client::joint_relay_handler::JointRelayHandler;
 using industrial_robot_client::joint_feedback_relay_handler::JointFeedbackRelayHandler;
 using industrial_robot_client::joint_feedback_ex_relay_handler::JointFeedbackExRelayHandler;
 using industrial_robot_client::robot_status_relay_handler::RobotStatusRelayHandler;
+using industrial_robot_client::latency_histogram::LatencyHistogram;
+using industrial_robot_client::spsc_ring::SpscRing;
 namespace StandardSocketPorts = industrial::simple_socket::StandardSocketPorts;
 
 /**
@@ -123,6 +138,17 @@ public:
 
   /**
    * \brief Begin processing messages and publishing topics.
+   *
+   * Frames are received on the calling thread and published by
+   * "~publish_threads" (ROS param, default 1) publish threads, each draining
+   * a ring of "~receive_queue_size" (ROS param, default 64) frames.  All
+   * messages of one type are published by the same thread, in the order they
+   * were received.  A frame that finds its ring full is dropped.  Messages
+   * without a handler are answered on the calling thread, as the message
+   * manager does: pings are replied to, other service requests fail.
+   *
+   * With "~publish_threads" set to 0, messages are received and published on
+   * the calling thread by the message manager.
    */
   void run();
 
@@ -164,15 +190,17 @@ public:
    */
   void add_handler(MessageHandler* handler, bool allow_replace = true)
   {
-    this->manager_.add(handler, allow_replace);
+    if (this->manager_.add(handler, allow_replace))
+      this->handlers_[handler->getMsgType()] = handler;
   }
 
 protected:
-  TcpClient default_tcp_connection_;
+  RecordingTcpClient default_tcp_connection_;
   JointRelayHandler default_joint_handler_;
   JointFeedbackRelayHandler default_joint_feedback_handler_;
   JointFeedbackExRelayHandler default_joint_feedback_ex_handler_;
   RobotStatusRelayHandler default_robot_status_handler_;
+  PingHandler ping_handler_;  // the message manager's own is not reachable from run()
 
   SmplMsgConnection* connection_;
   MessageManager manager_;
@@ -181,6 +209,65 @@ protected:
   std::map<int, RobotGroup> robot_groups_;
 
   bool version_0_;
+
+  /**
+   * \brief Frame received from the robot, waiting to be published
+   */
+  struct StateFrame
+  {
+    SimpleMessage msg;
+    MessageHandler* handler;
+    ros::WallTime received;
+  };
+
+  /**
+   * \brief Publish thread and the ring of frames it publishes
+   */
+  struct PublishStage
+  {
+    explicit PublishStage(size_t queue_size) : ring(queue_size), max_depth(0), dropped(0) {}
+
+    SpscRing<StateFrame> ring;
+    boost::mutex mutex;  // only parks the publish thread while the ring is empty
+    boost::condition_variable cond;
+    boost::thread thread;
+
+    std::atomic<size_t> max_depth;  // deepest ring since the last stats report
+    std::atomic<unsigned int> dropped;  // frames dropped on a full ring
+
+    // owned by the publish thread
+    LatencyHistogram queue_latency;  // receive to dequeue
+    LatencyHistogram publish_latency;  // handler callback
+  };
+
+  /**
+   * \brief Handlers added to the message manager, by message type
+   */
+  std::map<int, MessageHandler*> handlers_;
+
+  std::vector<boost::shared_ptr<PublishStage> > stages_;
+  std::map<int, PublishStage*> routes_;  // publish stage of each message type
+  std::atomic<bool> publishing_;
+
+  /**
+   * \brief Receive frames and queue them for publishing, until ROS shuts down
+   */
+  void receiveFrames();
+
+  /**
+   * \brief Answer a message no handler was added for, as the message manager does
+   *
+   * \param msg message received
+   */
+  void handleUnrouted(SimpleMessage &msg);
+
+  /**
+   * \brief Publish the frames queued on a stage, until publishing_ is cleared
+   *
+   * \param stage publish stage served by the calling thread
+   * \param idx stage number, for logging
+   */
+  void publishFrames(PublishStage* stage, size_t idx);
 };  // class RobotStateInterface
 
 }  // namespace robot_state_interface
@@ -0,0 +1,140 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_SPSC_RING_H
+#define MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace industrial_robot_client
+{
+namespace spsc_ring
+{
+
+/**
+ * \brief Fixed-capacity, lock-free ring buffer for exactly one producer
+ * thread and one consumer thread.
+ *
+ * Elements are filled and drained in place: the producer claims the next
+ * free slot, fills it and commits it; the consumer reads the oldest slot and
+ * releases it.  No element is copied and nothing is allocated after
+ * construction.
+ *
+ * claim()/commit() MUST ONLY BE CALLED FROM THE PRODUCER THREAD,
+ * front()/release() ONLY FROM THE CONSUMER THREAD.
+ */
+template<typename T>
+class SpscRing
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param capacity maximum number of elements held by the ring
+   */
+  explicit SpscRing(size_t capacity) : slots_(capacity + 1), head_(0), tail_(0) {}
+
+  /**
+   * \brief Returns the next free slot, to be filled and then commit()ed
+   *
+   * \return free slot, NULL if the ring is full
+   */
+  T* claim()
+  {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (next(tail) == head_.load(std::memory_order_acquire))
+      return NULL;
+    return &slots_[tail];
+  }
+
+  /**
+   * \brief Hands the slot returned by claim() to the consumer
+   */
+  void commit()
+  {
+    tail_.store(next(tail_.load(std::memory_order_relaxed)), std::memory_order_release);
+  }
+
+  /**
+   * \brief Returns the oldest element, to be release()d once consumed
+   *
+   * \return oldest element, NULL if the ring is empty
+   */
+  T* front()
+  {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire))
+      return NULL;
+    return &slots_[head];
+  }
+
+  /**
+   * \brief Returns the slot returned by front() to the producer
+   */
+  void release()
+  {
+    head_.store(next(head_.load(std::memory_order_relaxed)), std::memory_order_release);
+  }
+
+  /**
+   * \brief Number of elements waiting in the ring (a snapshot, if called
+   * while the other thread is active)
+   */
+  size_t size() const
+  {
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    return (tail + slots_.size() - head) % slots_.size();
+  }
+
+  size_t capacity() const
+  {
+    return slots_.size() - 1;
+  }
+
+private:
+  size_t next(size_t idx) const
+  {
+    return (idx + 1) % slots_.size();
+  }
+
+  std::vector<T> slots_;  // one slot is kept free to tell full from empty
+  std::atomic<size_t> head_;  // next slot to consume
+  std::atomic<size_t> tail_;  // next slot to fill
+};
+
+}  // namespace spsc_ring
+}  // namespace industrial_robot_client
+
+#endif  // MOTOMAN_DRIVER_INDUSTRIAL_ROBOT_CLIENT_SPSC_RING_H
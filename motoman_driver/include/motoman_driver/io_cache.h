@@ -0,0 +1,200 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MOTOMAN_DRIVER_IO_CACHE_H
+#define MOTOMAN_DRIVER_IO_CACHE_H
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <boost/thread/mutex.hpp>
+#include "ros/ros.h"
+#include "motoman_driver/simple_message/motoman_read_io_multi.h"
+
+namespace motoman
+{
+namespace io_cache
+{
+
+using motoman::simple_message::io_ctrl::IoMultiSize;
+
+/**
+ * \brief Shadow copy of the IO elements read from and written to the
+ * controller, to answer repeated reads without a round trip.
+ *
+ * A value read or written is fresh for max_age.  The values of the elements
+ * subscribed to are refreshed by the subscription instead: each of its
+ * messages (changes or keepalives) confirms them, and they are fresh for
+ * max_age from the last one (at most until the subscription times out).
+ *
+ * A group IO and its 8 IO points are the same IO: writing (or a change of)
+ * one invalidates the other.  A read that was sent before a write or an
+ * invalidation of its element does not refill it (see the tickets), so a
+ * read reply that is overtaken by a write on another connection is not
+ * cached.
+ *
+ * Elements are counted as hits when a read is answered by the cache, as
+ * misses when it is sent to the controller.
+ *
+ * THIS CLASS IS THREAD-SAFE
+ */
+class IoCache
+{
+public:
+  IoCache() : max_age_(0.0) {}
+
+  /**
+   * \param max_age How long values read or written are answered from the cache (s), 0 to disable it
+   */
+  void init(double max_age);
+
+  bool isEnabled() const
+  {
+    return !this->max_age_.isZero();
+  }
+
+  /**
+   * \brief Answers a read from the cache if all its elements are fresh.
+   *
+   * \param values [out] values of the elements, if all are fresh
+   * \param tickets [out] tickets to fill() the elements with, if not all are fresh
+   * \return true if all the elements are fresh
+   */
+  bool read(const std::vector<industrial::shared_types::shared_int> &addresses,
+            const std::vector<IoMultiSize> &sizes,
+            std::vector<industrial::shared_types::shared_int> &values,
+            std::vector<unsigned int> &tickets);
+  bool read(industrial::shared_types::shared_int address, IoMultiSize size,
+            industrial::shared_types::shared_int &value, unsigned int &ticket);
+
+  /**
+   * \brief Stores the values read from the controller after read() missed.
+   * Elements written or invalidated since are not filled.
+   *
+   * \param result_codes result code of each element (IoMultiReplyResultCodes): only those read are stored
+   * \param tickets tickets returned by read()
+   */
+  void fill(const std::vector<industrial::shared_types::shared_int> &addresses,
+            const std::vector<IoMultiSize> &sizes,
+            const std::vector<industrial::shared_types::shared_int> &values,
+            const std::vector<industrial::shared_types::shared_int> &result_codes,
+            const std::vector<unsigned int> &tickets);
+  void fill(industrial::shared_types::shared_int address, IoMultiSize size,
+            industrial::shared_types::shared_int value, unsigned int ticket);
+
+  /**
+   * \brief Stores the values written to the controller.  Elements which
+   * write failed are invalidated.
+   *
+   * \param result_codes result code of each element (IoMultiReplyResultCodes)
+   */
+  void write(const std::vector<industrial::shared_types::shared_int> &addresses,
+             const std::vector<IoMultiSize> &sizes,
+             const std::vector<industrial::shared_types::shared_int> &values,
+             const std::vector<industrial::shared_types::shared_int> &result_codes);
+  void write(industrial::shared_types::shared_int address, IoMultiSize size,
+             industrial::shared_types::shared_int value, bool written);
+
+  /**
+   * \brief Replaces the elements refreshed by a subscription, with their
+   * values when subscribed.
+   *
+   * \param result_codes result code of each element: only those read are subscribed to
+   */
+  void subscribe(const std::vector<industrial::shared_types::shared_int> &addresses,
+                 const std::vector<IoMultiSize> &sizes,
+                 const std::vector<industrial::shared_types::shared_int> &values,
+                 const std::vector<industrial::shared_types::shared_int> &result_codes);
+
+  /**
+   * \brief Stores the changes of a subscription message, which confirms the
+   * values of the other elements subscribed to (none for a keepalive)
+   */
+  void change(const std::vector<industrial::shared_types::shared_int> &addresses,
+              const std::vector<IoMultiSize> &sizes,
+              const std::vector<industrial::shared_types::shared_int> &values);
+
+  /**
+   * \brief The subscription was lost: the elements subscribed to age from its last message
+   */
+  void unsubscribe();
+
+  /**
+   * \brief Hit and miss counts of each element read
+   */
+  void getStats(std::vector<industrial::shared_types::shared_int> &addresses,
+                std::vector<IoMultiSize> &sizes,
+                std::vector<unsigned int> &hits,
+                std::vector<unsigned int> &misses);
+
+protected:
+  /**
+   * \brief Element: size and address (M registers by their full address)
+   */
+  typedef std::pair<IoMultiSize, industrial::shared_types::shared_int> Key;
+
+  struct Entry
+  {
+    Entry() : value(0), valid(false), subscribed(false), generation(0), hits(0), misses(0) {}
+
+    industrial::shared_types::shared_int value;
+    ros::WallTime stamp;  // when value was read or written
+    bool valid;
+    bool subscribed;
+    unsigned int generation;  // incremented when written or invalidated
+    unsigned int hits;
+    unsigned int misses;
+  };
+
+  ros::WallDuration max_age_;
+
+  boost::mutex mutex_;
+  std::map<Key, Entry> entries_;
+
+  /**
+   * \brief When the last message of the subscription was received
+   */
+  ros::WallTime subscription_stamp_;
+
+  static Key makeKey(industrial::shared_types::shared_int address, IoMultiSize size);
+  bool isFresh(const Entry &entry, const ros::WallTime &now) const;
+  void store(const Key &key, industrial::shared_types::shared_int value, const ros::WallTime &now);
+
+  /**
+   * \brief Invalidates the elements that are the same IO as key
+   */
+  void invalidateOverlapping(const Key &key);
+};
+
+}  // namespace io_cache
+}  // namespace motoman
+
+#endif  // MOTOMAN_DRIVER_IO_CACHE_H
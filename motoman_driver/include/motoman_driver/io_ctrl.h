@@ -35,6 +35,7 @@
 #define MOTOMAN_DRIVER_IO_CTRL_H
 
 #include <string>
+#include <vector>
 #include "simple_message/smpl_msg_connection.h"
 #include "motoman_driver/simple_message/motoman_read_mregister.h"
 #include "motoman_driver/simple_message/motoman_read_mregister_reply.h"
@@ -42,12 +43,18 @@
 #include "motoman_driver/simple_message/motoman_read_single_io_reply.h"
 #include "motoman_driver/simple_message/motoman_read_group_io.h"
 #include "motoman_driver/simple_message/motoman_read_group_io_reply.h"
+#include "motoman_driver/simple_message/motoman_read_io_multi.h"
+#include "motoman_driver/simple_message/motoman_read_io_multi_reply.h"
 #include "motoman_driver/simple_message/motoman_write_mregister.h"
 #include "motoman_driver/simple_message/motoman_write_mregister_reply.h"
 #include "motoman_driver/simple_message/motoman_write_single_io.h"
 #include "motoman_driver/simple_message/motoman_write_single_io_reply.h"
 #include "motoman_driver/simple_message/motoman_write_group_io.h"
 #include "motoman_driver/simple_message/motoman_write_group_io_reply.h"
+#include "motoman_driver/simple_message/motoman_write_io_multi.h"
+#include "motoman_driver/simple_message/motoman_write_io_multi_reply.h"
+#include "motoman_driver/simple_message/motoman_io_subscribe.h"
+#include "motoman_driver/simple_message/motoman_io_changed.h"
 
 namespace motoman
 {
@@ -60,6 +67,49 @@ using motoman::simple_message::io_ctrl_reply::ReadGroupIOReply;
 using motoman::simple_message::io_ctrl_reply::WriteMRegisterReply;
 using motoman::simple_message::io_ctrl_reply::WriteSingleIOReply;
 using motoman::simple_message::io_ctrl_reply::WriteGroupIOReply;
+using motoman::simple_message::io_ctrl::ReadIOMulti;
+using motoman::simple_message::io_ctrl::WriteIOMulti;
+using motoman::simple_message::io_ctrl::IoMultiSize;
+using motoman::simple_message::io_ctrl_reply::ReadIOMultiReply;
+using motoman::simple_message::io_ctrl_reply::WriteIOMultiReply;
+using motoman::simple_message::io_ctrl::IoSubscribe;
+using motoman::simple_message::io_ctrl_reply::IoChanged;
+
+/**
+ * \brief Message received on a connection subscribed to IO elements
+ */
+struct IoUpdate
+{
+  enum Type
+  {
+    SUBSCRIBED,  // reply to subscribe(): values of all the elements subscribed to
+    CHANGED,     // elements that changed (none for a keepalive)
+    REJECTED     // the controller does not support subscriptions
+  };
+
+  Type type;
+
+  /**
+   * \brief Time of the sample (ms, controller clock), CHANGED only
+   */
+  industrial::shared_types::shared_int time;
+
+  /**
+   * \brief Elements that changed, CHANGED only
+   */
+  std::vector<industrial::shared_types::shared_int> addresses;
+  std::vector<IoMultiSize> sizes;
+
+  /**
+   * \brief Values of the elements, in the order of the subscription for SUBSCRIBED
+   */
+  std::vector<industrial::shared_types::shared_int> values;
+
+  /**
+   * \brief Result code of each element subscribed to (IoMultiReplyResultCodes), SUBSCRIBED only
+   */
+  std::vector<industrial::shared_types::shared_int> result_codes;
+};
 
 /**
  * \brief Wrapper class around Motoman-specific io control commands
@@ -71,7 +121,7 @@ public:
   /**
    * \brief Default constructor
    */
-  MotomanIoCtrl() {}
+  MotomanIoCtrl() : connection_(NULL), multi_supported_(true) {}
 
   bool init(SmplMsgConnection* connection);
 
@@ -148,9 +198,85 @@ public:
   bool writeGroupIO(industrial::shared_types::shared_int address,
     industrial::shared_types::shared_int value, std::string& err_msg);
 
+  /**
+   * \brief Reads several IO points, group IOs and M registers on the controller.
+   *
+   * The elements are read with one READ_IO_MULTI message per
+   * ReadIOMulti::MAX_ELEMENTS elements.  Controllers that do not support
+   * these messages are read one element at a time.
+   *
+   * Note: the value of an element that could not be read is undefined.
+   *
+   * \param addresses The addresses (indices) of the elements
+   * \param sizes The size of each element (IoMultiSizes)
+   * \param values [out] Will contain the value of each element
+   * \param result_codes [out] Will contain the result code of each element (IoMultiReplyResultCodes)
+   * \param err_msg [out] A descriptive error message for the first element that failed
+   * \return True IFF all elements were read successfully
+   */
+  bool readIOMulti(const std::vector<industrial::shared_types::shared_int> &addresses,
+    const std::vector<IoMultiSize> &sizes,
+    std::vector<industrial::shared_types::shared_int> &values,
+    std::vector<industrial::shared_types::shared_int> &result_codes, std::string& err_msg);
+
+  /**
+   * \brief Writes to several IO points, group IOs and M registers on the controller.
+   *
+   * The elements are written with one WRITE_IO_MULTI message per
+   * WriteIOMulti::MAX_ELEMENTS elements.  Controllers that do not support
+   * these messages are written one element at a time.  Elements that cannot
+   * be written do not prevent the others from being written.
+   *
+   * \param addresses The addresses (indices) of the elements
+   * \param sizes The size of each element (IoMultiSizes)
+   * \param values The value to set each element to
+   * \param result_codes [out] Will contain the result code of each element (IoMultiReplyResultCodes)
+   * \param err_msg [out] A descriptive error message for the first element that failed
+   * \return True IFF all elements were written successfully
+   */
+  bool writeIOMulti(const std::vector<industrial::shared_types::shared_int> &addresses,
+    const std::vector<IoMultiSize> &sizes,
+    const std::vector<industrial::shared_types::shared_int> &values,
+    std::vector<industrial::shared_types::shared_int> &result_codes, std::string& err_msg);
+
+  /**
+   * \brief Subscribes to IO points, group IOs and M registers on the controller.
+   *
+   * The controller replies with the current values of the elements, then
+   * sends the elements that changed, sampled every period.  The subscription
+   * replaces the previous one of the connection; no elements ends it.
+   *
+   * Only the request is sent: the reply and the changes are received with
+   * receiveUpdate(), by a thread dedicated to a connection of its own, as
+   * the controller sends the changes at any time.
+   *
+   * \param addresses The addresses (indices) of the elements (at most IoSubscribe::MAX_ELEMENTS)
+   * \param sizes The size of each element (IoMultiSizes)
+   * \param period_ms Time between samples (ms), rounded up to the interpolation period
+   * \param err_msg [out] A descriptive error message in case of failure
+   * \return True IFF the request was sent
+   */
+  bool subscribe(const std::vector<industrial::shared_types::shared_int> &addresses,
+    const std::vector<IoMultiSize> &sizes,
+    industrial::shared_types::shared_int period_ms, std::string& err_msg);
+
+  /**
+   * \brief Receives the next message of a subscription (blocking).
+   *
+   * \param update [out] The message received
+   * \param err_msg [out] A descriptive error message in case of failure
+   * \return True IFF a message was received
+   */
+  bool receiveUpdate(IoUpdate &update, std::string& err_msg);
+
 protected:
   SmplMsgConnection* connection_;
 
+  /**
+   * \brief Cleared when the controller rejects READ_IO_MULTI or WRITE_IO_MULTI
+   */
+  bool multi_supported_;
+
   bool sendAndReceive(industrial::shared_types::shared_int address,
     ReadMRegisterReply &reply);
   bool sendAndReceive(industrial::shared_types::shared_int address,
@@ -166,6 +292,27 @@ protected:
   bool sendAndReceive(industrial::shared_types::shared_int address,
     industrial::shared_types::shared_int value,
     WriteGroupIOReply &reply);
+
+  /**
+   * \brief Send a multi-element message
+   *
+   * \param reply [out] reply of the controller
+   * \param supported [out] false if the controller rejected the message type
+   * \return false if the message could not be exchanged
+   */
+  bool sendAndReceive(ReadIOMulti &cmd, ReadIOMultiReply &reply, bool &supported);
+  bool sendAndReceive(WriteIOMulti &cmd, WriteIOMultiReply &reply, bool &supported);
+
+  /**
+   * \brief Read or write a single element of a multi-element request with the
+   * single-element messages, for controllers without multi-element messages.
+   *
+   * \return false if the message could not be exchanged
+   */
+  bool readElement(industrial::shared_types::shared_int address, IoMultiSize size,
+    industrial::shared_types::shared_int &value, industrial::shared_types::shared_int &result_code);
+  bool writeElement(industrial::shared_types::shared_int address, IoMultiSize size,
+    industrial::shared_types::shared_int value, industrial::shared_types::shared_int &result_code);
 };
 
 }  // namespace io_ctrl
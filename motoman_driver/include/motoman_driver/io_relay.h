@@ -35,13 +35,24 @@
 
 #include "simple_message/socket/tcp_client.h"
 #include "motoman_driver/io_ctrl.h"
+#include "motoman_driver/io_cache.h"
+#include "motoman_driver/industrial_robot_client/frame_recorder.h"
 #include "motoman_msgs/ReadMRegister.h"
 #include "motoman_msgs/ReadSingleIO.h"
 #include "motoman_msgs/ReadGroupIO.h"
+#include "motoman_msgs/ReadIOMulti.h"
 #include "motoman_msgs/WriteMRegister.h"
 #include "motoman_msgs/WriteSingleIO.h"
 #include "motoman_msgs/WriteGroupIO.h"
+#include "motoman_msgs/WriteIOMulti.h"
+#include "motoman_msgs/SubscribeIO.h"
+#include "motoman_msgs/IOChanges.h"
+#include "motoman_msgs/IOCacheStats.h"
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
+#include <deque>
+#include <vector>
 
 namespace motoman
 {
@@ -49,6 +60,7 @@ namespace io_relay
 {
 
 using industrial::tcp_client::TcpClient;
+using industrial_robot_client::frame_recorder::RecordingTcpClient;
 
 /**
  * \brief Message handler that sends I/O service requests to the robot controller and receives the responses.
@@ -56,6 +68,9 @@ using industrial::tcp_client::TcpClient;
 class MotomanIORelay
 {
 public:
+  MotomanIORelay() : stream_connected_(false), stream_rejected_(false), stream_period_(0),
+    stream_version_(0), stream_reply_version_(0) {}
+
   /**
    * \brief Class initializer
    *
@@ -64,8 +79,29 @@ public:
    */
   bool init(int default_port);
 
+  /**
+   * \brief I/O connections the controller accepts (MAX_IO_CONNECTIONS in MotoPlus).
+   * The pool gets at most all but one, kept for the subscription.
+   */
+  static const int MAX_IO_CONNECTIONS = 4;
+
+  /**
+   * \brief Number of requests sent to the controller in parallel
+   */
+  size_t getConnectionCount() const
+  {
+    return this->connections_.size();
+  }
+
 protected:
-  io_ctrl::MotomanIoCtrl io_ctrl_;
+  /**
+   * \brief Connection to the controller, used by one request at a time
+   */
+  struct IoConnection
+  {
+    RecordingTcpClient tcp;
+    io_ctrl::MotomanIoCtrl io;
+  };
 
   ros::ServiceServer srv_read_mregister;    // handle for read_mregister service
   ros::ServiceServer srv_read_single_io;    // handle for read_single_io service
@@ -73,10 +109,95 @@ protected:
   ros::ServiceServer srv_write_mregister;   // handle for write_mregister service
   ros::ServiceServer srv_write_single_io;   // handle for write_single_io service
   ros::ServiceServer srv_write_group_io;    // handle for write_group_io service
+  ros::ServiceServer srv_read_io_multi;     // handle for read_io_multi service
+  ros::ServiceServer srv_write_io_multi;    // handle for write_io_multi service
+  ros::ServiceServer srv_subscribe_io;      // handle for subscribe_io service
+  ros::ServiceServer srv_io_cache_stats;    // handle for io_cache_stats service
+  ros::Publisher pub_io_changes_;           // changes of the elements subscribed to
 
   ros::NodeHandle node_;
+
+  /**
+   * \brief Pool of connections (ROS param "~io_connections"), so that a slow
+   * request does not delay the others
+   */
+  std::vector<boost::shared_ptr<IoConnection> > connections_;
+
+  /**
+   * \brief Connections not in use, guarded by mutex_
+   */
+  std::vector<io_ctrl::MotomanIoCtrl*> idle_;
   boost::mutex mutex_;
-  TcpClient default_tcp_connection_;
+  boost::condition_variable connection_idle_;
+
+  /**
+   * \brief Takes an idle connection, waiting for one if all are in use
+   */
+  io_ctrl::MotomanIoCtrl* acquireConnection();
+
+  /**
+   * \brief Returns a connection taken by acquireConnection()
+   */
+  void releaseConnection(io_ctrl::MotomanIoCtrl* connection);
+
+  /**
+   * \brief Answers repeated reads (ROS param "~io_cache_max_age", disabled by default)
+   */
+  io_cache::IoCache cache_;
+
+  /**
+   * \brief Connection dedicated to the subscription, received by stream_thread_.
+   * Opened on the first subscription, as it takes an I/O connection of the
+   * controller, and closed if the controller rejects subscriptions.  Recorded
+   * along with the other connections.
+   */
+  boost::scoped_ptr<RecordingTcpClient> stream_tcp_connection_;
+  io_ctrl::MotomanIoCtrl io_stream_;
+  boost::thread stream_thread_;
+
+  /**
+   * \brief Guards the members below, shared by stream_thread_ and subscribeIoCB()
+   */
+  boost::mutex stream_mutex_;
+  boost::condition_variable stream_replied_;
+  bool stream_connected_;
+  bool stream_rejected_;
+
+  /**
+   * \brief Elements subscribed to.  Only ever appended to, so that the values
+   * of a reply are those of the first elements.
+   */
+  std::vector<industrial::shared_types::shared_int> stream_addresses_;
+  std::vector<io_ctrl::IoMultiSize> stream_sizes_;
+  industrial::shared_types::shared_int stream_period_;
+
+  /**
+   * \brief Incremented when elements are added: version of stream_addresses_
+   */
+  unsigned int stream_version_;
+
+  /**
+   * \brief Versions sent to the controller and not replied to yet, in order
+   */
+  std::deque<unsigned int> stream_pending_;
+
+  /**
+   * \brief Last reply of the controller, and version of the elements it is for
+   */
+  unsigned int stream_reply_version_;
+  std::vector<industrial::shared_types::shared_int> stream_values_;
+  std::vector<industrial::shared_types::shared_int> stream_result_codes_;
+
+  /**
+   * \brief Sends the elements subscribed to, stream_mutex_ held
+   */
+  bool sendSubscription(std::string &err_msg);
+
+  /**
+   * \brief Body of stream_thread_: (re)connects, (re)subscribes and
+   * publishes the changes
+   */
+  void streamIo();
 
   bool readMRegisterCB(motoman_msgs::ReadMRegister::Request &req,
                             motoman_msgs::ReadMRegister::Response &res);
@@ -90,6 +211,14 @@ protected:
                             motoman_msgs::WriteSingleIO::Response &res);
   bool writeGroupIoCB(motoman_msgs::WriteGroupIO::Request &req,
                             motoman_msgs::WriteGroupIO::Response &res);
+  bool readIoMultiCB(motoman_msgs::ReadIOMulti::Request &req,
+                            motoman_msgs::ReadIOMulti::Response &res);
+  bool writeIoMultiCB(motoman_msgs::WriteIOMulti::Request &req,
+                            motoman_msgs::WriteIOMulti::Response &res);
+  bool subscribeIoCB(motoman_msgs::SubscribeIO::Request &req,
+                            motoman_msgs::SubscribeIO::Response &res);
+  bool ioCacheStatsCB(motoman_msgs::IOCacheStats::Request &req,
+                            motoman_msgs::IOCacheStats::Response &res);
 };
 
 }  // namespace io_relay
@@ -79,7 +79,8 @@ public:
    * \param robot_id robot group # on this controller (for multi-group systems)
    */
   explicit MotomanJointTrajectoryStreamer(int robot_id = -1) : JointTrajectoryStreamer(1),
-    robot_id_(robot_id) {}
+    robot_id_(robot_id), max_window_(1), window_(1), inc_queue_size_(0), point_queue_size_(0),
+    queue_size_applied_(true), target_buffer_time_(0.0), batch_size_(1) {}
 
   ~MotomanJointTrajectoryStreamer();
 
@@ -144,13 +145,90 @@ protected:
 
   std::map<int, MotomanMotionCtrl> motion_ctrl_map_;
 
+  /**
+   * \brief Maximum number of trajectory messages sent to the controller before
+   * waiting for their replies (ROS param "streaming_window").  A value of 1
+   * streams one message per round trip.
+   */
+  int max_window_;
+
+  /**
+   * \brief Current number of trajectory messages in flight.  Halved when the
+   * controller replies BUSY, grown by one while its incremental queue has headroom.
+   */
+  int window_;
+
+  /**
+   * \brief Depth of the controller's incremental queue (ROS param
+   * "controller_queue_size") and trajectory point queue (ROS param
+   * "controller_point_queue_size"), applied before streaming.  0 keeps
+   * the controller's depth.
+   */
+  int inc_queue_size_;
+  int point_queue_size_;
+  bool queue_size_applied_;
+
+  /**
+   * \brief Motion to keep buffered on the controller (ROS param
+   * "target_buffer_time", sec).  Streaming pauses while more is buffered.
+   * 0 streams as fast as the controller accepts points.
+   */
+  double target_buffer_time_;
+
+  /**
+   * \brief Maximum number of consecutive trajectory points sent in a single
+   * JOINT_TRAJ_PT_FULL_BATCH message (ROS param "streaming_batch_size").
+   * A value of 1 sends one point per message.
+   */
+  int batch_size_;
+
   void trajectoryStop();
+  bool truncate(double lead_time, double* splice_time, double* exec_time,
+                std::map<int, trajectory_msgs::JointTrajectoryPoint>* end_state);
   bool is_valid(const trajectory_msgs::JointTrajectory &traj);
-  bool is_valid(const motoman_msgs::DynamicJointTrajectory &traj);
+  bool is_valid_start(const trajectory_msgs::JointTrajectory &traj);
+  bool is_valid(const motoman_msgs::DynamicJointTrajectory &traj, size_t first, size_t last);
+  bool is_valid_start(const motoman_msgs::DynamicJointTrajectory &traj);
+
+  /**
+   * \brief Send the next window of trajectory points and process their replies.
+   *
+   * \param[out] busy set when the controller rejected a point as BUSY
+   * \param[out] buffered_time motion buffered on the controller (sec), -1 if unknown
+   * \return false if the trajectory was aborted, true otherwise
+   */
+  bool streamWindow(bool* busy, double* buffered_time);
+
+  /**
+   * \brief Pack consecutive trajectory points into a single batch message.
+   *
+   * \param first index of the first point to pack
+   * \param last index past the last point that may be packed
+   * \param[out] msg batch message
+   * \param[out] num_points number of points packed
+   * \return false if fewer than two points could be packed (msg is not set)
+   */
+  bool createBatch(int first, int last, SimpleMessage* msg, int* num_points);
+
+  /**
+   * \brief Read the motion control parameters shared by both init() overloads.
+   */
+  void initParams();
 
   static bool VectorToJointData(const std::vector<double> &vec,
                                 industrial::joint_data::JointData &joints);
 
+  /**
+   * \brief Serialize a joint vector the way JointData is: all joints, 0 past the end of vec.
+   *
+   * \param vec joint values
+   * \param padding number of zeros vec is deemed to be followed by (for validation)
+   * \param data buffer the joints are appended to
+   * \return false if vec and its padding exceed the joints of a JointData
+   */
+  static bool LoadJointVector(const std::vector<double> &vec, size_t padding,
+                              industrial::byte_array::ByteArray* data);
+
   /**
    * \brief Service used to disable the robot controller.  When disabled,
    * all incoming goals are ignored.
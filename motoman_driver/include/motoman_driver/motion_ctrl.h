@@ -37,11 +37,13 @@
 #include "motoman_driver/simple_message/motoman_motion_reply.h"
 #include "motoman_driver/simple_message/motoman_select_tool.h"
 #include <string>
+#include <vector>
 namespace motoman
 {
 namespace motion_ctrl
 {
 using industrial::smpl_msg_connection::SmplMsgConnection;
+using motoman::simple_message::motion_ctrl::MotionCtrl;
 using motoman::simple_message::motion_reply::MotionReply;
 typedef motoman::simple_message::motion_ctrl::MotionControlCmd MotionControlCmd;
 typedef motoman::simple_message::misc::SelectTool SelectToolReq;
@@ -65,6 +67,38 @@ public:
   bool setTrajMode(bool enable);
   bool stopTrajectory();
 
+  /**
+   * \brief Drop the motion queued on the controller more than lead_time past
+   * the motion currently executing, so a new trajectory can be spliced in.
+   *
+   * \param lead_time motion to keep queued (sec)
+   * \param[out] splice_time trajectory time at which the kept motion ends (sec)
+   * \param[out] exec_time trajectory time currently executing (sec)
+   * \return True IFF the queued motion was truncated
+   */
+  bool truncateTrajectory(double lead_time, double* splice_time, double* exec_time);
+
+  /**
+   * \brief Get the joint state at the end of the motion queued on the
+   * controller, which a spliced trajectory must continue from.
+   *
+   * \param[out] positions joint positions (rad), in the order of the trajectory points sent
+   * \param[out] velocities joint velocities (rad/s)
+   * \return True IFF the state was read
+   */
+  bool getQueueEndState(std::vector<double>* positions, std::vector<double>* velocities);
+
+  /**
+   * \brief Change the depth of the motion queues of all groups on the
+   * controller.  The queues can only be changed while no motion is queued.
+   *
+   * \param inc_queue_size interpolation increments queued per group (0 keeps the current depth)
+   * \param point_queue_size trajectory points queued ahead of the increments (0 keeps the current depth)
+   * \param[out] inc_queue_time motion the increment queue holds once changed (sec)
+   * \return True IFF the queues were changed
+   */
+  bool setQueueSize(int inc_queue_size, int point_queue_size, double* inc_queue_time);
+
   /**
    * \brief Change the active tool file on the controller.
    *
@@ -82,7 +116,11 @@ protected:
   SmplMsgConnection* connection_;
   int robot_id_;
 
-  bool sendAndReceive(MotionControlCmd command, MotionReply &reply);
+  bool sendAndReceive(MotionControlCmd command, MotionReply &reply,
+                      industrial::shared_types::shared_real data = 0);
+
+  // overload for sending commands with more than one data value
+  bool sendAndReceive(MotionCtrl &ctrl_data, MotionReply &reply);
 
   // special overload for sending and receiving Select Tool requests
   bool sendAndReceive(SelectToolReq& request, MotionReply &reply);
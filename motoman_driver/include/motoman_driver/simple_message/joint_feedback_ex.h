@@ -102,11 +102,35 @@ public:
     this->joint_feedback_messages_ = joint_feedback_messages;
   }
 
-  std::vector<industrial::joint_feedback_message::JointFeedbackMessage> getJointMessages()
+  std::vector<industrial::joint_feedback_message::JointFeedbackMessage>& getJointMessages()
   {
     return joint_feedback_messages_;
   }
 
+  /**
+   * \brief Gets the joint efforts of a group, sent in place of its accelerations
+   *        (see motoman::simple_message::MotomanValidFieldTypes::EFFORT)
+   *
+   * \param index index of the group in getJointMessages()
+   * \param[out] efforts joint efforts
+   * \return true if the group has joint efforts
+   */
+  bool getEfforts(size_t index, industrial::joint_data::JointData *efforts);
+
+  /**
+   * \brief Unloads the JointFeedback at the end of a buffer, taking out the
+   *        joint efforts it may carry in place of its accelerations
+   *
+   * \param buffer buffer to unload from
+   * \param[out] feedback joint feedback, without the efforts
+   * \param[out] efforts joint efforts, if has_efforts
+   * \param[out] has_efforts true if the feedback carried joint efforts
+   * \return true on success, false otherwise (buffer too short)
+   */
+  static bool unloadFeedback(industrial::byte_array::ByteArray *buffer,
+                             industrial::joint_feedback::JointFeedback *feedback,
+                             industrial::joint_data::JointData *efforts, bool *has_efforts);
+
   /**
    * \brief Gets groups_number
    *        Gets the number of groups currently running on the controller
@@ -156,6 +180,12 @@ private:
 
   std::vector<industrial::joint_feedback_message::JointFeedbackMessage> joint_feedback_messages_;
 
+  /**
+   * \brief Joint efforts of each of joint_feedback_messages_, if has_efforts_
+   */
+  std::vector<industrial::joint_data::JointData> efforts_;
+  std::vector<bool> has_efforts_;
+
   industrial::joint_data::JointData positions_;
 
   static const industrial::shared_types::shared_int MAX_NUM_GROUPS = 4;
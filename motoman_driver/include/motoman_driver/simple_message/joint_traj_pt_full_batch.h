@@ -0,0 +1,186 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MOTOMAN_DRIVER_SIMPLE_MESSAGE_JOINT_TRAJ_PT_FULL_BATCH_H
+#define MOTOMAN_DRIVER_SIMPLE_MESSAGE_JOINT_TRAJ_PT_FULL_BATCH_H
+
+#ifndef FLATHEADERS
+#include "simple_message/byte_array.h"
+#include "simple_message/simple_message.h"
+#include "simple_message/simple_serialize.h"
+#include "simple_message/shared_types.h"
+#else
+#include "byte_array.h"        // NOLINT(build/include)
+#include "simple_message.h"    // NOLINT(build/include)
+#include "simple_serialize.h"  // NOLINT(build/include)
+#include "shared_types.h"      // NOLINT(build/include)
+#endif
+
+namespace industrial
+{
+namespace joint_traj_pt_full_batch
+{
+
+/**
+ * \brief Class encapsulating a batch of consecutive joint trajectory points,
+ * sent to the controller in a single message with a single reply.
+ *
+ * The points are taken from JOINT_TRAJ_PT_FULL or JOINT_TRAJ_PT_FULL_EX
+ * messages.  Their group data is copied as-is, so a batch is laid out like
+ * a JOINT_TRAJ_PT_FULL_EX message with several points.
+ *
+ * The message data-packet byte representation is as follows (ordered lowest index
+ * to highest). The standard sizes are given, but can change based on type sizes:
+ *
+ *   member:             type                                      size
+ *   num_points          (industrial::shared_types::shared_int)    4  bytes
+ *   num_groups          (industrial::shared_types::shared_int)    4  bytes
+ *   sequence            (industrial::shared_types::shared_int)    4  bytes
+ *   data                JointTrajPtData[num_points * num_groups]  (group data of each point, point after point)
+ *
+ * The sequence is the one of the first point, the following points are
+ * numbered consecutively.
+ *
+ * THIS CLASS IS NOT THREAD-SAFE
+ *
+ */
+class JointTrajPtFullBatch : public industrial::simple_serialize::SimpleSerialize
+{
+public:
+  /**
+   * \brief Default constructor
+   *
+   * This method creates an empty batch.
+   *
+   */
+  JointTrajPtFullBatch(void);
+  /**
+   * \brief Destructor
+   *
+   */
+  ~JointTrajPtFullBatch(void);
+
+  /**
+   * \brief Initializes an empty batch
+   *
+   */
+  void init();
+
+  /**
+   * \brief Appends a trajectory point to the batch
+   *
+   * \param msg JOINT_TRAJ_PT_FULL or JOINT_TRAJ_PT_FULL_EX message of the point
+   *
+   * \return false if the point does not directly follow the batch, has a
+   * different number of groups or does not fit in the batch (the batch is
+   * left unchanged)
+   */
+  bool addPoint(industrial::simple_message::SimpleMessage &msg);
+
+  /**
+   * \brief Returns the number of points in the batch
+   */
+  industrial::shared_types::shared_int getNumPoints()
+  {
+    return this->num_points_;
+  }
+
+  /**
+   * \brief Returns the number of groups of each point
+   */
+  industrial::shared_types::shared_int getNumGroups()
+  {
+    return this->num_groups_;
+  }
+
+  /**
+   * \brief Returns the sequence number of the first point
+   */
+  industrial::shared_types::shared_int getSequence()
+  {
+    return this->sequence_;
+  }
+
+  /**
+   * \brief Returns the maximum number of group data (points x groups) in a batch
+   */
+  industrial::shared_types::shared_int getMaxData()
+  {
+    return MAX_BATCH_DATA;
+  }
+
+  /**
+   * \brief Copies the passed in value
+   *
+   * \param src (value to copy)
+   */
+  void copyFrom(JointTrajPtFullBatch &src);
+
+  /**
+   * \brief == operator implementation
+   *
+   * \return true if equal
+   */
+  bool operator==(JointTrajPtFullBatch &rhs);
+
+  // Overrides - SimpleSerialize
+  bool load(industrial::byte_array::ByteArray *buffer);
+  bool unload(industrial::byte_array::ByteArray *buffer);
+  unsigned int byteLength()
+  {
+    return 3 * sizeof(industrial::shared_types::shared_int) + this->data_.getBufferSize();
+  }
+
+private:
+  /**
+   * \brief number of points in the batch
+   */
+  industrial::shared_types::shared_int num_points_;
+  /**
+   * \brief number of groups of each point
+   */
+  industrial::shared_types::shared_int num_groups_;
+  /**
+   * \brief sequence number of the first point
+   */
+  industrial::shared_types::shared_int sequence_;
+  /**
+   * \brief serialized group data of the points
+   */
+  industrial::byte_array::ByteArray data_;
+
+  static const industrial::shared_types::shared_int MAX_NUM_GROUPS = 4;
+  static const industrial::shared_types::shared_int MAX_BATCH_DATA = 16;  // ROS_MAX_BATCH_DATA in MotoPlus
+};
+}  // namespace joint_traj_pt_full_batch
+}  // namespace industrial
+
+#endif  // MOTOMAN_DRIVER_SIMPLE_MESSAGE_JOINT_TRAJ_PT_FULL_BATCH_H
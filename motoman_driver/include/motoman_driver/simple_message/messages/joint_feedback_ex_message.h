@@ -115,11 +115,16 @@ public:
     return this->data_.getGroupsNumber();
   }
 
-  std::vector<industrial::joint_feedback_message::JointFeedbackMessage> getJointMessages()
+  std::vector<industrial::joint_feedback_message::JointFeedbackMessage>& getJointMessages()
   {
     return this->data_.getJointMessages();
   }
 
+  bool getEfforts(size_t index, industrial::joint_data::JointData *efforts)
+  {
+    return this->data_.getEfforts(index, efforts);
+  }
+
 private:
   industrial::joint_feedback_ex::JointFeedbackEx data_;
 };
@@ -59,8 +59,11 @@ enum MotionControlCmd
 {
   UNDEFINED          = 0,
   CHECK_MOTION_READY = 200101,  // check if controller is ready to receive ROS motion cmds
-  CHECK_QUEUE_CNT    = 200102,  // get number of motion increments in queue
+  CHECK_QUEUE_CNT    = 200102,  // get number of motion increments in queue, and motion buffered (sec) in data[]
+  SET_QUEUE_SIZE     = 200103,  // set depth of the increment (data[0]) and trajectory point (data[1]) queues
+  GET_QUEUE_END_STATE = 200104,  // get joint positions (data[0] 0) or velocities (1) at the end of the queued motion
   STOP_MOTION        = 200111,  // stop robot motion immediately
+  TRUNCATE_TRAJ      = 200115,  // drop queued motion more than data[0] sec past the executing increment
   START_TRAJ_MODE    = 200121,  // prepare controller to receive ROS motion cmds
   STOP_TRAJ_MODE     = 200122,  // return motion control to INFORM
 };
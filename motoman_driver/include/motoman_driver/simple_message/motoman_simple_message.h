@@ -69,9 +69,30 @@ enum MotomanMsgType
   ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_EX = 2016,  // This is similar to the "Dynamic Joint Point" in REP I0001
   ROS_MSG_MOTO_JOINT_FEEDBACK_EX = 2017,      // Similar to Dynamic Joint State on the REP I0001
   MOTOMAN_SELECT_TOOL = 2018,
+  ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH = 2021,  // Several consecutive JOINT_TRAJ_PT_FULL_EX points, one reply
+  MOTOMAN_READ_IO_MULTI = 2022,        // Several IO elements of any size, one reply
+  MOTOMAN_READ_IO_MULTI_REPLY = 2023,
+  MOTOMAN_WRITE_IO_MULTI = 2024,
+  MOTOMAN_WRITE_IO_MULTI_REPLY = 2025,
+  MOTOMAN_IO_SUBSCRIBE = 2026,         // Watch IO elements: reply as READ_IO_MULTI_REPLY, then IO_CHANGED
+  MOTOMAN_IO_SUBSCRIBE_REPLY = 2027,
+  MOTOMAN_IO_CHANGED = 2028,           // IO elements watched that changed (topic)
 };
 }  // namespace MotomanMsgTypes
 typedef MotomanMsgTypes::MotomanMsgType MotomanMsgType;
+
+/**
+ * \brief Enumeration of motoman-specific valid fields of joint feedback, in
+ *        addition to industrial::joint_feedback::ValidFieldTypes
+ */
+namespace MotomanValidFieldTypes
+{
+enum MotomanValidFieldType
+{
+  EFFORT = 0x10  // the accelerations are joint efforts (never sent with ACCELERATION)
+};
+}  // namespace MotomanValidFieldTypes
+typedef MotomanValidFieldTypes::MotomanValidFieldType MotomanValidFieldType;
 }  // namespace simple_message
 }  // namespace motoman
 
@@ -0,0 +1,195 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MOTOMAN_DRIVER_SIMPLE_MESSAGE_MOTOMAN_WRITE_IO_MULTI_H
+#define MOTOMAN_DRIVER_SIMPLE_MESSAGE_MOTOMAN_WRITE_IO_MULTI_H
+
+#ifdef ROS
+#include "simple_message/simple_serialize.h"
+#include "simple_message/shared_types.h"
+#include "simple_message/log_wrapper.h"
+#include "motoman_driver/simple_message/motoman_read_io_multi.h"
+#endif
+
+#ifdef MOTOPLUS
+#include "simple_serialize.h"       // NOLINT(build/include)
+#include "shared_types.h"           // NOLINT(build/include)
+#include "log_wrapper.h"            // NOLINT(build/include)
+#include "motoman_read_io_multi.h"  // NOLINT(build/include)
+#endif
+
+namespace motoman
+{
+namespace simple_message
+{
+namespace io_ctrl
+{
+
+/**
+ * \brief Class encapsulated write io multi data. Motoman specific interface
+ * to write several IO elements on the controller with a single message.
+ *
+ * The byte representation of a write io multi command is as follows
+ * (in order lowest index to highest). The standard sizes are given,
+ * but can change based on type sizes:
+ *
+ *   member:             type                                      size
+ *   num_elements        (industrial::shared_types::shared_int)    4  bytes
+ *   elements[num_elements]:
+ *     address           (industrial::shared_types::shared_int)    4  bytes
+ *     size              (industrial::shared_types::shared_int)    4  bytes
+ *     value             (industrial::shared_types::shared_int)    4  bytes
+ *
+ * Only the elements in use are sent.
+ *
+ *
+ * THIS CLASS IS NOT THREAD-SAFE
+ *
+ */
+
+class WriteIOMulti : public industrial::simple_serialize::SimpleSerialize
+{
+public:
+  /**
+   * \brief Maximum number of elements in a message (ROS_MAX_IO_MULTI in MotoPlus)
+   */
+  static const industrial::shared_types::shared_int MAX_ELEMENTS = 64;
+
+  /**
+   * \brief Default constructor
+   *
+   * This method creates empty data.
+   *
+   */
+  WriteIOMulti(void);
+  /**
+   * \brief Destructor
+   *
+   */
+  ~WriteIOMulti(void);
+
+  /**
+   * \brief Initializes an empty write io multi
+   *
+   */
+  void init();
+
+  /**
+   * \brief Appends an element to write
+   *
+   * \param address The address of the element
+   * \param size The size of the element
+   * \param value The value to write
+   * \return false if the message is full
+   */
+  bool addElement(industrial::shared_types::shared_int address, IoMultiSize size,
+                  industrial::shared_types::shared_int value);
+
+  /**
+   * \brief Returns the number of elements
+   */
+  industrial::shared_types::shared_int getNumElements() const
+  {
+    return this->num_elements_;
+  }
+
+  /**
+   * \brief Returns the address of an element
+   */
+  industrial::shared_types::shared_int getAddress(size_t idx) const
+  {
+    return this->address_[idx];
+  }
+
+  /**
+   * \brief Returns the size of an element
+   */
+  industrial::shared_types::shared_int getSize(size_t idx) const
+  {
+    return this->size_[idx];
+  }
+
+  /**
+   * \brief Returns the value of an element
+   */
+  industrial::shared_types::shared_int getValue(size_t idx) const
+  {
+    return this->value_[idx];
+  }
+
+  /**
+   * \brief Copies the passed in value
+   *
+   * \param src (value to copy)
+   */
+  void copyFrom(WriteIOMulti &src);
+
+  /**
+   * \brief == operator implementation
+   *
+   * \return true if equal
+   */
+  bool operator==(WriteIOMulti &rhs);
+
+  // Overrides - SimpleSerialize
+  bool load(industrial::byte_array::ByteArray *buffer);
+  bool unload(industrial::byte_array::ByteArray *buffer);
+  unsigned int byteLength()
+  {
+    return (1 + 3 * this->num_elements_) * sizeof(industrial::shared_types::shared_int);
+  }
+
+private:
+  /**
+   * \brief Number of elements in use
+   */
+  industrial::shared_types::shared_int num_elements_;
+
+  /**
+   * \brief The addresses of the elements
+   */
+  industrial::shared_types::shared_int address_[MAX_ELEMENTS];
+
+  /**
+   * \brief The sizes of the elements
+   */
+  industrial::shared_types::shared_int size_[MAX_ELEMENTS];
+
+  /**
+   * \brief The values to write
+   */
+  industrial::shared_types::shared_int value_[MAX_ELEMENTS];
+};
+}  // namespace io_ctrl
+}  // namespace simple_message
+}  // namespace motoman
+
+#endif  // MOTOMAN_DRIVER_SIMPLE_MESSAGE_MOTOMAN_WRITE_IO_MULTI_H
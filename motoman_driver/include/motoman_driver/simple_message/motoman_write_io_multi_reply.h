@@ -0,0 +1,207 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MOTOMAN_DRIVER_SIMPLE_MESSAGE_MOTOMAN_WRITE_IO_MULTI_REPLY_H
+#define MOTOMAN_DRIVER_SIMPLE_MESSAGE_MOTOMAN_WRITE_IO_MULTI_REPLY_H
+
+#include <string>
+#ifdef ROS
+#include "simple_message/simple_serialize.h"
+#include "simple_message/shared_types.h"
+#include "simple_message/log_wrapper.h"
+#include "motoman_driver/simple_message/motoman_read_io_multi_reply.h"
+#endif
+
+#ifdef MOTOPLUS
+#include "simple_serialize.h"             // NOLINT(build/include)
+#include "shared_types.h"                 // NOLINT(build/include)
+#include "log_wrapper.h"                  // NOLINT(build/include)
+#include "motoman_read_io_multi_reply.h"  // NOLINT(build/include)
+#endif
+
+namespace motoman
+{
+namespace simple_message
+{
+namespace io_ctrl_reply
+{
+
+/**
+ * \brief Class encapsulated write io multi reply data.  These messages are sent
+ * by the controller in response to WriteIOMulti messages.
+ *
+ * The byte representation of a write io multi reply is as follows
+ * (in order lowest index to highest). The standard sizes are given,
+ * but can change based on type sizes:
+ *
+ *   member:             type                                      size
+ *   num_elements        (industrial::shared_types::shared_int)    4  bytes
+ *   result_code         (industrial::shared_types::shared_int)    4  bytes
+ *   result_codes        (industrial::shared_types::shared_int)    4  bytes * num_elements
+ *
+ * The result codes (IoMultiReplyResultCodes) are in the order of the
+ * WriteIOMulti message.  result_code is SUCCESS if all elements were
+ * written, else the code of the first element that failed.  Elements that
+ * failed do not prevent the others from being written.
+ *
+ *
+ * THIS CLASS IS NOT THREAD-SAFE
+ *
+ */
+
+class WriteIOMultiReply : public industrial::simple_serialize::SimpleSerialize
+{
+public:
+  /**
+   * \brief Maximum number of elements in a message (ROS_MAX_IO_MULTI in MotoPlus)
+   */
+  static const industrial::shared_types::shared_int MAX_ELEMENTS = 64;
+
+  /**
+   * \brief Default constructor
+   *
+   * This method creates empty data.
+   *
+   */
+  WriteIOMultiReply(void);
+  /**
+   * \brief Destructor
+   *
+   */
+  ~WriteIOMultiReply(void);
+
+  /**
+   * \brief Initializes an empty write io multi reply
+   *
+   */
+  void init();
+
+  /**
+   * \brief Appends the result of an element
+   *
+   * \param result_code The result code of the element
+   * \return false if the reply is full
+   */
+  bool addElement(industrial::shared_types::shared_int result_code);
+
+  /**
+   * \brief Returns the number of elements
+   */
+  industrial::shared_types::shared_int getNumElements() const
+  {
+    return this->num_elements_;
+  }
+
+  /**
+   * \brief Returns the result code of an element
+   */
+  industrial::shared_types::shared_int getElementResultCode(size_t idx) const
+  {
+    return this->element_result_code_[idx];
+  }
+
+  /**
+   * \brief Sets the result code of the reply
+   *
+   * \param result code
+   */
+  void setResultCode(industrial::shared_types::shared_int result_code)
+  {
+    this->result_code_ = result_code;
+  }
+
+  /**
+   * \brief Returns the result code of the reply
+   *
+   * \return result_code number
+   */
+  industrial::shared_types::shared_int getResultCode() const
+  {
+    return this->result_code_;
+  }
+
+  /*
+   * \brief Returns a string interpretation of a result code
+   * \param code result code
+   * \return string message associated with result code
+   */
+  static std::string getResultString(industrial::shared_types::shared_int code)
+  {
+    return ReadIOMultiReply::getResultString(code);
+  }
+  std::string getResultString() const
+  {
+    return getResultString(this->result_code_);
+  }
+
+  /**
+   * \brief Copies the passed in value
+   *
+   * \param src (value to copy)
+   */
+  void copyFrom(WriteIOMultiReply &src);
+
+  /**
+   * \brief == operator implementation
+   *
+   * \return true if equal
+   */
+  bool operator==(WriteIOMultiReply &rhs);
+
+  // Overrides - SimpleSerialize
+  bool load(industrial::byte_array::ByteArray *buffer);
+  bool unload(industrial::byte_array::ByteArray *buffer);
+  unsigned int byteLength()
+  {
+    return (2 + this->num_elements_) * sizeof(industrial::shared_types::shared_int);
+  }
+
+private:
+  /**
+   * \brief Number of elements in use
+   */
+  industrial::shared_types::shared_int num_elements_;
+
+  /**
+   * \brief The result code of the reply
+   */
+  industrial::shared_types::shared_int result_code_;
+
+  /**
+   * \brief The result codes of the elements
+   */
+  industrial::shared_types::shared_int element_result_code_[MAX_ELEMENTS];
+};
+}  // namespace io_ctrl_reply
+}  // namespace simple_message
+}  // namespace motoman
+
+#endif  // MOTOMAN_DRIVER_SIMPLE_MESSAGE_MOTOMAN_WRITE_IO_MULTI_REPLY_H
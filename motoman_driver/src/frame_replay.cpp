@@ -0,0 +1,247 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// Plays a recording of a robot connection back to a client, acting as the
+// robot controller: frames received from the controller are sent with their
+// recorded timing (scaled by the replay speed), and each recorded request is
+// waited for before the frames that followed it are sent.  Point the state,
+// motion or I/O node at this host and the recorded port to replay into it.
+// A recording of several connections (the I/O relay pool) is replayed one
+// connection at a time.
+
+#include <arpa/inet.h>
+#include <byteswap.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include "motoman_driver/industrial_robot_client/frame_recorder.h"
+
+using industrial_robot_client::frame_recorder::FrameReader;
+using industrial_robot_client::frame_recorder::RecordHeader;
+using industrial_robot_client::frame_recorder::monotonicStamp;
+namespace FrameDirections = industrial_robot_client::frame_recorder::FrameDirections;
+
+namespace
+{
+
+const int MAX_FRAME_SIZE = 0x100000;
+
+bool receiveAll(int sock, char* buffer, size_t size)
+{
+  while (size > 0)
+  {
+    ssize_t n = recv(sock, buffer, size, 0);
+    if (n <= 0)
+      return false;
+    buffer += n;
+    size -= n;
+  }
+  return true;
+}
+
+// Receive and discard one frame from the client
+bool receiveFrame(int sock)
+{
+  static char buffer[MAX_FRAME_SIZE];
+  uint32_t size;
+
+  if (!receiveAll(sock, reinterpret_cast<char*>(&size), sizeof(size)))
+    return false;
+  if (size > MAX_FRAME_SIZE)  // length prefix in the other byte order
+    size = bswap_32(size);
+  return size <= MAX_FRAME_SIZE && receiveAll(sock, buffer, size);
+}
+
+void sleepUntil(uint64_t stamp)
+{
+  struct timespec ts;
+  ts.tv_sec = stamp / 1000000000ULL;
+  ts.tv_nsec = stamp % 1000000000ULL;
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {}
+}
+
+// Number of connections recorded
+unsigned int countConnections(FrameReader* reader)
+{
+  RecordHeader header;
+  const char* frame;
+  unsigned int connections = 0;
+
+  reader->rewind();
+  while (reader->next(&header, &frame))
+    connections = std::max(connections, header.connection + 1U);
+  return connections;
+}
+
+// Replay a connection of a recording to the client once.  Returns false if the client went away.
+bool replay(FrameReader* reader, unsigned int connection, int sock, double speed, unsigned int* frames)
+{
+  RecordHeader header;
+  const char* frame;
+  bool first = true;
+  uint64_t base_stamp = 0, base_time = 0;  // recorded and replay time at the last sync point
+
+  reader->rewind();
+  while (reader->next(&header, &frame))
+  {
+    if (header.connection != connection)
+      continue;
+
+    if (header.direction == FrameDirections::SENT)
+    {
+      if (!receiveFrame(sock))
+        return false;
+      base_stamp = header.stamp;
+      base_time = monotonicStamp();
+      first = false;
+      continue;
+    }
+
+    if (first)
+    {
+      base_stamp = header.stamp;
+      base_time = monotonicStamp();
+      first = false;
+    }
+    if (speed > 0)
+      sleepUntil(base_time + static_cast<uint64_t>((header.stamp - base_stamp) / speed));
+
+    if (send(sock, frame, header.size, MSG_NOSIGNAL) != static_cast<ssize_t>(header.size))
+      return false;
+    (*frames)++;
+  }
+  return true;
+}
+
+void usage(const char* name)
+{
+  fprintf(stderr, "Usage: %s [-p port] [-s speed] [-c connection] [-l] recording\n"
+                  "  -p port        TCP port to serve (default 50241)\n"
+                  "  -s speed       replay speed factor, 0 for as fast as possible (default 1)\n"
+                  "  -c connection  connection to replay, of a recording of several (default 0)\n"
+                  "  -l             replay in a loop\n", name);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  int port = 50241;
+  double speed = 1.0;
+  int connection = 0;
+  bool loop = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "p:s:c:l")) != -1)
+  {
+    switch (opt)
+    {
+    case 'p':
+      port = atoi(optarg);
+      break;
+    case 's':
+      speed = atof(optarg);
+      break;
+    case 'c':
+      connection = atoi(optarg);
+      break;
+    case 'l':
+      loop = true;
+      break;
+    default:
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (optind != argc - 1 || port <= 0 || speed < 0 || connection < 0)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  FrameReader reader;
+  if (!reader.open(argv[optind]))
+    return 1;
+
+  unsigned int connections = countConnections(&reader);
+  if (static_cast<unsigned int>(connection) >= connections)
+  {
+    fprintf(stderr, "The recording has no connection %d (%u recorded)\n", connection, connections);
+    return 1;
+  }
+  if (connections > 1)
+    printf("Replaying connection %d of the %u recorded\n", connection, connections);
+
+  int server = socket(AF_INET, SOCK_STREAM, 0);
+  int on = 1;
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  if (server < 0 || bind(server, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0 ||
+      listen(server, 1) != 0)
+  {
+    perror("Failed to listen");
+    return 1;
+  }
+
+  printf("Waiting for a connection on port %d\n", port);
+  int sock = accept(server, NULL, NULL);
+  if (sock < 0)
+  {
+    perror("Failed to accept a connection");
+    return 1;
+  }
+
+  unsigned int frames = 0;
+  uint64_t start = monotonicStamp();
+  bool connected;
+  do
+  {
+    connected = replay(&reader, connection, sock, speed, &frames);
+  }
+  while (connected && loop);
+
+  printf("Replayed %u frames in %.3f s%s\n", frames, (monotonicStamp() - start) * 1e-9,
+         connected ? "" : " (connection closed)");
+  close(sock);
+  close(server);
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "motoman_driver/industrial_robot_client/controller_clock.h"
+#include <algorithm>
+#include <cmath>
+
+namespace industrial_robot_client
+{
+namespace controller_clock
+{
+
+const double ControllerClock::MAX_DRIFT = 1e-4;
+const double ControllerClock::MAX_GAP = 1.0;
+
+ControllerClock::ControllerClock(double wrap) : wrap_(wrap)
+{
+  reset();
+}
+
+void ControllerClock::reset()
+{
+  synced_ = false;
+  epoch_ = 0.0;
+  last_time_ = 0.0;
+  offset_ = 0.0;
+  period_ = 0.0;
+  sequence_ = 0;
+  dropped_ = 0;
+  last_dropped_ = 0;
+}
+
+ros::Time ControllerClock::toRosTime(double controller_time, const ros::Time &receive_time)
+{
+  double time = epoch_ + controller_time;
+  last_dropped_ = 0;
+
+  if (synced_ && time < last_time_ - wrap_ / 2)
+  {
+    epoch_ += wrap_;
+    time += wrap_;
+  }
+
+  double dt = time - last_time_;
+  if (!synced_ || dt < 0 || dt > MAX_GAP)
+  {
+    // first sample, or the controller restarted its clock
+    epoch_ = 0.0;
+    time = controller_time;
+    offset_ = receive_time.toSec() - time;
+    period_ = 0.0;
+    synced_ = true;
+  }
+  else if (dt > 0)  // else: another message of the last sample
+  {
+    if (period_ == 0.0 || dt < period_)
+      period_ = dt;
+
+    unsigned int periods = std::max(static_cast<unsigned int>(std::floor(dt / period_ + 0.5)), 1u);
+    last_dropped_ = periods - 1;
+    dropped_ += last_dropped_;
+    sequence_ += periods;
+    offset_ += dt * MAX_DRIFT;
+  }
+
+  offset_ = std::min(offset_, receive_time.toSec() - time);
+  last_time_ = time;
+
+  return ros::Time(time + offset_);
+}
+
+}  // namespace controller_clock
+}  // namespace industrial_robot_client
@@ -0,0 +1,276 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "motoman_driver/industrial_robot_client/frame_recorder.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include "ros/ros.h"
+#include "simple_message/byte_array.h"
+
+using industrial::byte_array::ByteArray;
+using industrial::shared_types::shared_int;
+
+namespace industrial_robot_client
+{
+namespace frame_recorder
+{
+
+namespace
+{
+size_t recordLength(size_t frame_size)
+{
+  return (sizeof(RecordHeader) + frame_size + 7) & ~static_cast<size_t>(7);
+}
+}  // namespace
+
+uint64_t monotonicStamp()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+FrameRecorder::FrameRecorder() : fd_(-1), data_(NULL), size_(0), end_(0), dropped_(0), connections_(0)
+{
+}
+
+FrameRecorder::~FrameRecorder()
+{
+  close();
+}
+
+bool FrameRecorder::open(const std::string &path, size_t max_size)
+{
+  close();
+
+  if (max_size < RECORDING_HEADER_SIZE + recordLength(0))
+  {
+    ROS_ERROR("Recording size of %zu bytes is too small", max_size);
+    return false;
+  }
+
+  this->fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (this->fd_ < 0)
+  {
+    ROS_ERROR("Failed to create recording '%s': %s", path.c_str(), strerror(errno));
+    return false;
+  }
+
+  void* data = MAP_FAILED;
+  if (ftruncate(this->fd_, max_size) == 0)
+    data = mmap(NULL, max_size, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd_, 0);
+  if (data == MAP_FAILED)
+  {
+    ROS_ERROR("Failed to map recording '%s': %s", path.c_str(), strerror(errno));
+    ::close(this->fd_);
+    this->fd_ = -1;
+    return false;
+  }
+
+  this->data_ = static_cast<char*>(data);
+  this->size_ = max_size;
+  this->end_ = RECORDING_HEADER_SIZE;
+  this->dropped_ = 0;
+  this->connections_ = 0;
+
+  memcpy(this->data_, RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+  memcpy(this->data_ + sizeof(RECORDING_MAGIC), &RECORDING_VERSION, sizeof(RECORDING_VERSION));
+  return true;
+}
+
+void FrameRecorder::close()
+{
+  if (!isOpen())
+    return;
+
+  size_t end = std::min(this->end_.load(), this->size_);
+  munmap(this->data_, this->size_);
+  if (ftruncate(this->fd_, end) != 0)
+    ROS_WARN("Failed to trim recording: %s", strerror(errno));
+  ::close(this->fd_);
+
+  if (this->dropped_)
+    ROS_WARN("Recording full, %u frames were not recorded", this->dropped_.load());
+
+  this->fd_ = -1;
+  this->data_ = NULL;
+  this->size_ = 0;
+}
+
+void FrameRecorder::record(FrameDirection direction, unsigned int connection, SimpleMessage &msg)
+{
+  if (!isOpen())
+    return;
+
+  uint64_t stamp = monotonicStamp();
+
+  // serialize the frame the way SmplMsgConnection puts it on the wire
+  ByteArray body, prefix;
+  msg.toByteArray(body);
+  prefix.load(static_cast<shared_int>(body.getBufferSize()));
+  size_t frame_size = prefix.getBufferSize() + body.getBufferSize();
+
+  size_t len = recordLength(frame_size);
+  size_t pos = this->end_.fetch_add(len);
+  if (pos + len > this->size_)
+  {
+    this->dropped_++;
+    return;
+  }
+
+  RecordHeader* header = reinterpret_cast<RecordHeader*>(this->data_ + pos);
+  char* frame = this->data_ + pos + sizeof(RecordHeader);
+  header->direction = direction;
+  header->connection = connection;
+  header->stamp = stamp;
+  size_t prefix_size = prefix.getBufferSize();
+  prefix.unloadFront(frame, prefix_size);
+  body.unloadFront(frame + prefix_size, body.getBufferSize());
+
+  // a non-zero size marks the record complete
+  std::atomic_thread_fence(std::memory_order_release);
+  header->size = frame_size;
+}
+
+FrameReader::FrameReader() : fd_(-1), data_(NULL), size_(0), pos_(RECORDING_HEADER_SIZE)
+{
+}
+
+FrameReader::~FrameReader()
+{
+  close();
+}
+
+bool FrameReader::open(const std::string &path)
+{
+  close();
+
+  this->fd_ = ::open(path.c_str(), O_RDONLY);
+  if (this->fd_ < 0)
+  {
+    ROS_ERROR("Failed to open recording '%s': %s", path.c_str(), strerror(errno));
+    return false;
+  }
+
+  struct stat st;
+  void* data = MAP_FAILED;
+  if (fstat(this->fd_, &st) == 0 && static_cast<size_t>(st.st_size) >= RECORDING_HEADER_SIZE)
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, this->fd_, 0);
+
+  uint32_t version = 0;
+  if (data != MAP_FAILED)
+    memcpy(&version, static_cast<char*>(data) + sizeof(RECORDING_MAGIC), sizeof(version));
+  if (data == MAP_FAILED || memcmp(data, RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0 ||
+      version != RECORDING_VERSION)
+  {
+    ROS_ERROR("'%s' is not a simple message recording", path.c_str());
+    if (data != MAP_FAILED)
+      munmap(data, st.st_size);
+    ::close(this->fd_);
+    this->fd_ = -1;
+    return false;
+  }
+
+  this->data_ = static_cast<const char*>(data);
+  this->size_ = st.st_size;
+  rewind();
+  return true;
+}
+
+void FrameReader::close()
+{
+  if (this->data_ == NULL)
+    return;
+
+  munmap(const_cast<char*>(this->data_), this->size_);
+  ::close(this->fd_);
+  this->fd_ = -1;
+  this->data_ = NULL;
+  this->size_ = 0;
+}
+
+bool FrameReader::next(RecordHeader* header, const char** frame)
+{
+  if (this->data_ == NULL || this->pos_ + sizeof(RecordHeader) > this->size_)
+    return false;
+
+  memcpy(header, this->data_ + this->pos_, sizeof(RecordHeader));
+  if (header->size == 0 || this->pos_ + recordLength(header->size) > this->size_)
+    return false;
+
+  *frame = this->data_ + this->pos_ + sizeof(RecordHeader);
+  this->pos_ += recordLength(header->size);
+  return true;
+}
+
+bool RecordingTcpClient::initRecording()
+{
+  std::string path;
+  int size_mb;
+
+  if (!ros::param::get("~record_file", path) || path.empty())
+    return true;
+  ros::param::param<int>("~record_size_mb", size_mb, 256);
+
+  if (size_mb <= 0 || !this->recorder_->open(path, static_cast<size_t>(size_mb) << 20))
+    return false;
+  this->connection_ = this->recorder_->addConnection();
+
+  ROS_INFO("Recording robot connection to '%s'", path.c_str());
+  return true;
+}
+
+bool RecordingTcpClient::sendMsg(SimpleMessage &message)
+{
+  bool rtn = TcpClient::sendMsg(message);
+  if (rtn)
+    this->recorder_->record(FrameDirections::SENT, this->connection_, message);
+  return rtn;
+}
+
+bool RecordingTcpClient::receiveMsg(SimpleMessage &message)
+{
+  bool rtn = TcpClient::receiveMsg(message);
+  if (rtn)
+    this->recorder_->record(FrameDirections::RECEIVED, this->connection_, message);
+  return rtn;
+}
+
+}  // namespace frame_recorder
+}  // namespace industrial_robot_client
@@ -43,11 +43,28 @@ using industrial::joint_data::JointData;
 using industrial::shared_types::shared_real;
 namespace MotomanMsgTypes = motoman::simple_message::MotomanMsgTypes;
 namespace ValidFieldTypes = industrial::joint_feedback::ValidFieldTypes;
+namespace MotomanValidFieldTypes = motoman::simple_message::MotomanValidFieldTypes;
 
 namespace industrial_robot_client
 {
 namespace joint_feedback_ex_relay_handler
 {
+
+namespace
+{
+/**
+ * \brief Returns the message to fill, reusing the published one once no
+ * (intra-process) subscriber holds it anymore, so that its vectors keep their capacity
+ */
+template<typename M>
+M& reusable(boost::shared_ptr<M>* msg)
+{
+  if (!*msg || !msg->unique())
+    msg->reset(new M());
+  return **msg;
+}
+}  // namespace
+
 bool JointFeedbackExRelayHandler::init(SmplMsgConnection* connection,
                                        std::map<int, RobotGroup> &robot_groups)
 {
@@ -61,6 +78,12 @@ bool JointFeedbackExRelayHandler::init(SmplMsgConnection* connection,
 
   this->robot_groups_ = robot_groups;
   this->version_0_ = false;
+
+  // the published joints of each group are mapped by JointRelayHandler::init()
+  this->group_feedback_.clear();
+  for (std::map<int, RobotGroup>::iterator it = robot_groups.begin(); it != robot_groups.end(); ++it)
+    this->group_feedback_[it->first].num_joints = it->second.get_joint_names().size();
+
   bool rtn = JointRelayHandler::init(connection, static_cast<int>(MotomanMsgTypes::ROS_MSG_MOTO_JOINT_FEEDBACK_EX),
                                      robot_groups);
   // try to read groups_number parameter, if none specified
@@ -87,90 +110,142 @@ bool JointFeedbackExRelayHandler::create_messages(SimpleMessage& msg_in,
     sensor_msgs::JointState* sensor_state)
 {
   // inspect groups_number field first, to avoid "Failed to Convert" message
-  JointFeedbackExMessage tmp_msg;
-  tmp_msg.init(msg_in);
-  motoman_msgs::DynamicJointTrajectoryFeedback dynamic_control_state;
+  if (!this->feedback_msg_.init(msg_in))
+  {
+    LOG_ERROR("Failed to initialize joint feedback message");
+    return false;
+  }
+  std::vector<JointFeedbackMessage>& joint_msgs = this->feedback_msg_.getJointMessages();
+
+  motoman_msgs::DynamicJointTrajectoryFeedback& dynamic_control_state = reusable(&this->dynamic_control_state_);
+  dynamic_control_state.joint_feedbacks.resize(joint_msgs.size());
 
-  for (size_t i = 0; i < tmp_msg.getJointMessages().size(); i++)
+  JointData efforts;
+  for (size_t i = 0; i < joint_msgs.size(); i++)
   {
-    int group_number = tmp_msg.getJointMessages()[i].getRobotID();
+    int group_number = joint_msgs[i].getRobotID();
+    bool has_efforts = this->feedback_msg_.getEfforts(i, &efforts);
 
-    if (!create_messages(tmp_msg.getJointMessages()[i], control_state, sensor_state, group_number))
+    if (!create_messages(joint_msgs[i], has_efforts ? &efforts : NULL, group_number,
+                         &dynamic_control_state.joint_feedbacks[i]))
     {
       return false;
     }
-    motoman_msgs::DynamicJointState dyn_joint_state;
-    dyn_joint_state.num_joints = control_state->joint_names.size();
-    dyn_joint_state.group_number = group_number;
-    dyn_joint_state.valid_fields = this->valid_fields_from_message_;
-    dyn_joint_state.positions = control_state->actual.positions;
-    dyn_joint_state.velocities = control_state->actual.velocities;
-    dyn_joint_state.accelerations = control_state->actual.accelerations;
-    dynamic_control_state.joint_feedbacks.push_back(dyn_joint_state);
   }
-  dynamic_control_state.header.stamp = ros::Time::now();
-  dynamic_control_state.num_groups = tmp_msg.getGroupsNumber();
-  this->dynamic_pub_joint_control_state_.publish(dynamic_control_state);
+  if (!joint_msgs.empty())
+    dynamic_control_state.header.stamp =
+      this->group_feedback_[joint_msgs.back().getRobotID()].control_state->header.stamp;
+  dynamic_control_state.num_groups = this->feedback_msg_.getGroupsNumber();
+  this->dynamic_pub_joint_control_state_.publish(this->dynamic_control_state_);
 
   return true;
 }
 
-bool JointFeedbackExRelayHandler::create_messages(JointFeedbackMessage& msg_in,
-    control_msgs::FollowJointTrajectoryFeedback* control_state,
-    sensor_msgs::JointState* sensor_state, int robot_id)
+bool JointFeedbackExRelayHandler::create_messages(JointFeedbackMessage& msg_in, const JointData* efforts,
+    int robot_id, motoman_msgs::DynamicJointState* dyn_joint_state)
 {
-  DynamicJointsGroup all_joint_state;
+  std::map<int, GroupFeedback>::iterator it = this->group_feedback_.find(robot_id);
+  if (it == this->group_feedback_.end())
+  {
+    LOG_ERROR("Unexpected joint feedback of group %d", robot_id);
+    return false;
+  }
+  GroupFeedback& group = it->second;
+  const JointMap& pub_joints = this->group_pub_joints_[robot_id];
+
+  DynamicJointsGroup& all_joint_state = group.all_joint_state;
   if (!JointFeedbackExRelayHandler::convert_message(msg_in, &all_joint_state, robot_id))
   {
     LOG_ERROR("Failed to convert SimpleMessage");
     return false;
   }
+
+  // copy effort data
+  if (efforts)
+  {
+    this->valid_fields_from_message_ |= MotomanValidFieldTypes::EFFORT;
+    if (!JointDataToVector(*efforts, all_joint_state.effort, group.num_joints))
+    {
+      LOG_ERROR("Failed to parse effort data from JointFeedbackMessage");
+      return false;
+    }
+  }
+  else
+  {
+    all_joint_state.effort.clear();
+    this->valid_fields_from_message_ &= ~MotomanValidFieldTypes::EFFORT;
+  }
   // apply transform, if required
-  DynamicJointsGroup xform_joint_state;
+  DynamicJointsGroup& xform_joint_state = group.xform_joint_state;
   if (!transform(all_joint_state, &xform_joint_state))
   {
     LOG_ERROR("Failed to transform joint state");
     return false;
   }
+  ros::Time stamp = sample_stamp(all_joint_state);
 
-  // select specific joints for publishing
-  DynamicJointsGroup pub_joint_state;
-  std::vector<std::string> pub_joint_names;
-  if (!select(xform_joint_state, robot_groups_[robot_id].get_joint_names(), &pub_joint_state, &pub_joint_names))
+  // select specific joints for publishing, straight into the messages
+  control_msgs::FollowJointTrajectoryFeedback& control_state = reusable(&group.control_state);
+  control_state.header.stamp = stamp;
+  control_state.joint_names = pub_joints.names();
+  if (!pub_joints.apply(xform_joint_state.positions, 0.0, &control_state.actual.positions) ||
+      !pub_joints.apply(xform_joint_state.velocities, 0.0, &control_state.actual.velocities) ||
+      !pub_joints.apply(xform_joint_state.accelerations, 0.0, &control_state.actual.accelerations) ||
+      !pub_joints.apply(xform_joint_state.effort, 0.0, &control_state.actual.effort))
   {
     LOG_ERROR("Failed to select joints for publishing");
     return false;
   }
+  control_state.actual.time_from_start = xform_joint_state.time_from_start;
 
+  this->pub_joint_control_state_.publish(group.control_state);
 
-  // assign values to messages
-  *control_state = control_msgs::FollowJointTrajectoryFeedback();  // always start with a "clean" message
-  control_state->header.stamp = ros::Time::now();
-  control_state->joint_names = pub_joint_names;
-  control_state->actual.positions = pub_joint_state.positions;
-  control_state->actual.velocities = pub_joint_state.velocities;
-  control_state->actual.accelerations = pub_joint_state.accelerations;
-  control_state->actual.time_from_start = pub_joint_state.time_from_start;
-
-  this->pub_joint_control_state_.publish(*control_state);
+  sensor_msgs::JointState& sensor_state = reusable(&group.sensor_state);
+  sensor_state.header.stamp = stamp;
+  sensor_state.name = pub_joints.names();
+  sensor_state.position = control_state.actual.positions;
+  sensor_state.velocity = control_state.actual.velocities;
+  sensor_state.effort = control_state.actual.effort;
 
-  *sensor_state = sensor_msgs::JointState();  // always start with a "clean" message
-  sensor_state->header.stamp = ros::Time::now();
-  sensor_state->name = pub_joint_names;
-  sensor_state->position = pub_joint_state.positions;
-  sensor_state->velocity = pub_joint_state.velocities;
+  this->pub_joint_sensor_state_.publish(group.sensor_state);
 
-  this->pub_joint_sensor_state_.publish(*sensor_state);
+  dyn_joint_state->num_joints = pub_joints.size();
+  dyn_joint_state->group_number = robot_id;
+  dyn_joint_state->valid_fields = this->valid_fields_from_message_;
+  dyn_joint_state->positions = control_state.actual.positions;
+  dyn_joint_state->velocities = control_state.actual.velocities;
+  dyn_joint_state->accelerations = control_state.actual.accelerations;
+  dyn_joint_state->effort = control_state.actual.effort;
 
   return true;
 }
 
+ros::Time JointFeedbackExRelayHandler::sample_stamp(const DynamicJointsGroup& joint_state)
+{
+  ros::Time now = ros::Time::now();
+  if (!(this->valid_fields_from_message_ & ValidFieldTypes::TIME))
+    return now;
+
+  // all groups of a message share the controller time, and get the same stamp
+  ros::Time stamp = clock_.toRosTime(joint_state.time_from_start.toSec(), now);
+  if (clock_.lastDropped() > 0)
+    ROS_WARN_THROTTLE(10, "Dropped %u joint feedback samples (%u in total)",
+                      clock_.lastDropped(), clock_.dropped());
+  return stamp;
+}
+
 bool JointFeedbackExRelayHandler::convert_message(JointFeedbackMessage& msg_in, DynamicJointsGroup* joint_state,
                                                   int robot_id)
 {
   JointData values;
 
-  int num_jnts = robot_groups_[robot_id].get_joint_names().size();
+  std::map<int, GroupFeedback>::const_iterator group = this->group_feedback_.find(robot_id);
+  if (group == this->group_feedback_.end())
+  {
+    LOG_ERROR("Unexpected joint feedback of group %d", robot_id);
+    return false;
+  }
+  int num_jnts = group->second.num_joints;
 
   // copy position data
   bool position_field = msg_in.getPositions(values);
@@ -258,6 +333,5 @@ bool JointFeedbackExRelayHandler::JointDataToVector(const JointData &joints,
   return true;
 }
 
-
 }  // namespace joint_feedback_ex_relay_handler
 }  // namespace industrial_robot_client
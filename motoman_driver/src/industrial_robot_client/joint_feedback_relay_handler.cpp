@@ -30,15 +30,20 @@
 */
 
 #include "motoman_driver/industrial_robot_client/joint_feedback_relay_handler.h"
+#include "motoman_driver/simple_message/joint_feedback_ex.h"
 #include "simple_message/log_wrapper.h"
 #include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
 
+using industrial::byte_array::ByteArray;
 using industrial::joint_data::JointData;
+using industrial::joint_feedback::JointFeedback;
+using industrial::joint_feedback_ex::JointFeedbackEx;
 using industrial::shared_types::shared_real;
 namespace StandardMsgTypes = industrial::simple_message::StandardMsgTypes;
+namespace ValidFieldTypes = industrial::joint_feedback::ValidFieldTypes;
 
 namespace industrial_robot_client
 {
@@ -104,27 +109,32 @@ bool JointFeedbackRelayHandler::create_messages(SimpleMessage& msg_in,
   }
 
   // select specific joints for publishing
+  const JointMap& pub_joints = group_pub_joints_[robot_id];
   DynamicJointsGroup pub_joint_state;
-  std::vector<std::string> pub_joint_names;
-  if (!select(xform_joint_state, robot_groups_[robot_id].get_joint_names(), &pub_joint_state, &pub_joint_names))
+  const std::vector<std::string>& pub_joint_names = pub_joints.names();
+  if (!select(xform_joint_state, pub_joints, &pub_joint_state))
   {
     LOG_ERROR("Failed to select joints for publishing");
     return false;
   }
+  ros::Time stamp = sample_stamp(all_joint_state);
+
   // assign values to messages
   *control_state = control_msgs::FollowJointTrajectoryFeedback();  // always start with a "clean" message
-  control_state->header.stamp = ros::Time::now();
+  control_state->header.stamp = stamp;
   control_state->joint_names = pub_joint_names;
   control_state->actual.positions = pub_joint_state.positions;
   control_state->actual.velocities = pub_joint_state.velocities;
   control_state->actual.accelerations = pub_joint_state.accelerations;
+  control_state->actual.effort = pub_joint_state.effort;
   control_state->actual.time_from_start = pub_joint_state.time_from_start;
 
   *sensor_state = sensor_msgs::JointState();  // always start with a "clean" message
-  sensor_state->header.stamp = ros::Time::now();
+  sensor_state->header.stamp = stamp;
   sensor_state->name = pub_joint_names;
   sensor_state->position = pub_joint_state.positions;
   sensor_state->velocity = pub_joint_state.velocities;
+  sensor_state->effort = pub_joint_state.effort;
 
   this->pub_controls_[robot_id].publish(*control_state);
   this->pub_states_[robot_id].publish(*sensor_state);
@@ -132,16 +142,49 @@ bool JointFeedbackRelayHandler::create_messages(SimpleMessage& msg_in,
   return true;
 }
 
+ros::Time JointFeedbackRelayHandler::sample_stamp(const DynamicJointsGroup& joint_state)
+{
+  ros::Time now = ros::Time::now();
+  if (!(joint_state.valid_fields & ValidFieldTypes::TIME))
+    return now;
+
+  ros::Time stamp = clock_.toRosTime(joint_state.time_from_start.toSec(), now);
+  if (clock_.lastDropped() > 0)
+    ROS_WARN_THROTTLE(10, "Dropped %u joint feedback samples (%u in total)",
+                      clock_.lastDropped(), clock_.dropped());
+  return stamp;
+}
+
 bool JointFeedbackRelayHandler::convert_message(SimpleMessage& msg_in, DynamicJointsGroup* joint_state, int robot_id)
 {
-  JointFeedbackMessage joint_feedback_msg;
-  if (!joint_feedback_msg.init(msg_in))
+  ByteArray data = msg_in.getData();
+  JointFeedback joint_feedback;
+  JointData efforts;
+  bool has_efforts;
+  if (!JointFeedbackEx::unloadFeedback(&data, &joint_feedback, &efforts, &has_efforts))
   {
     LOG_ERROR("Failed to initialize joint feedback message");
     return false;
   }
 
-  return convert_message(joint_feedback_msg, joint_state, robot_id);
+  JointFeedbackMessage joint_feedback_msg;
+  joint_feedback_msg.init(joint_feedback);
+  if (!convert_message(joint_feedback_msg, joint_state, robot_id))
+    return false;
+
+  // copy effort data
+  if (has_efforts)
+  {
+    if (!JointDataToVector(efforts, joint_state->effort, robot_groups_[robot_id].get_joint_names().size()))
+    {
+      LOG_ERROR("Failed to parse effort data from JointFeedbackMessage");
+      return false;
+    }
+  }
+  else
+    joint_state->effort.clear();
+
+  return true;
 }
 
 bool JointFeedbackRelayHandler::convert_message(SimpleMessage& msg_in, JointTrajectoryPoint* joint_state)
@@ -218,9 +261,15 @@ bool JointFeedbackRelayHandler::convert_message(JointFeedbackMessage& msg_in, Dy
   // copy timestamp data
   shared_real value;
   if (msg_in.getTime(value))
+  {
     joint_state->time_from_start = ros::Duration(value);
+    joint_state->valid_fields |= ValidFieldTypes::TIME;
+  }
   else
+  {
     joint_state->time_from_start = ros::Duration(0);
+    joint_state->valid_fields &= ~ValidFieldTypes::TIME;
+  }
 
   return true;
 }
@@ -276,33 +325,6 @@ bool JointFeedbackRelayHandler::convert_message(JointFeedbackMessage& msg_in, Jo
   return true;
 }
 
-bool JointFeedbackRelayHandler::select(const DynamicJointsGroup& all_joint_state,
-                                       const std::vector<std::string>& all_joint_names,
-                                       DynamicJointsGroup* pub_joint_state, std::vector<std::string>* pub_joint_names)
-{
-  ROS_ASSERT(all_joint_state.positions.size() == all_joint_names.size());
-
-  *pub_joint_state = DynamicJointsGroup();  // start with a "clean" message
-  pub_joint_names->clear();
-
-  // skip over "blank" joint names
-  for (size_t i = 0; i < all_joint_names.size(); ++i)
-  {
-    if (all_joint_names[i].empty())
-      continue;
-    pub_joint_names->push_back(all_joint_names[i]);
-    if (!all_joint_state.positions.empty())
-      pub_joint_state->positions.push_back(all_joint_state.positions[i]);
-    if (!all_joint_state.velocities.empty())
-      pub_joint_state->velocities.push_back(all_joint_state.velocities[i]);
-    if (!all_joint_state.accelerations.empty())
-      pub_joint_state->accelerations.push_back(all_joint_state.accelerations[i]);
-  }
-  pub_joint_state->time_from_start = all_joint_state.time_from_start;
-
-  return true;
-}
-
 }  // namespace joint_feedback_relay_handler
 }  // namespace industrial_robot_client
 
@@ -0,0 +1,105 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "motoman_driver/industrial_robot_client/joint_map.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace industrial_robot_client
+{
+namespace joint_map
+{
+
+const int JointMap::NONE;
+
+bool JointMap::init(const std::vector<std::string> &from_names, const std::vector<std::string> &to_names)
+{
+  index_.assign(to_names.size(), NONE);
+  names_ = to_names;
+  missing_.clear();
+
+  // joint lists are short: a search is cheaper than building a name index
+  for (size_t i = 0; i < to_names.size(); ++i)
+  {
+    if (to_names[i].empty())
+      continue;
+
+    std::vector<std::string>::const_iterator it = std::find(from_names.begin(), from_names.end(), to_names[i]);
+    if (it != from_names.end())
+      index_[i] = static_cast<int>(it - from_names.begin());  // first of duplicate names
+    else if (missing_.empty())
+      missing_ = to_names[i];
+  }
+
+  return missing_.empty();
+}
+
+void JointMap::initPublished(const std::vector<std::string> &names)
+{
+  index_.clear();
+  names_.clear();
+  missing_.clear();
+
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    if (names[i].empty())
+      continue;
+    index_.push_back(static_cast<int>(i));
+    names_.push_back(names[i]);
+  }
+}
+
+bool JointMap::apply(const std::vector<double> &src, double fill, std::vector<double>* dst) const
+{
+  if (src.empty())
+  {
+    dst->clear();
+    return true;
+  }
+
+  dst->resize(index_.size());
+  for (size_t i = 0; i < index_.size(); ++i)
+  {
+    if (index_[i] == NONE)
+      (*dst)[i] = fill;
+    else if (static_cast<size_t>(index_[i]) < src.size())
+      (*dst)[i] = src[index_[i]];
+    else
+      return false;
+  }
+
+  return true;
+}
+
+}  // namespace joint_map
+}  // namespace industrial_robot_client
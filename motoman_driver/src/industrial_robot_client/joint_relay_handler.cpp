@@ -66,6 +66,7 @@ bool JointRelayHandler::init(SmplMsgConnection* connection, int msg_type, std::m
 
     this->pub_controls_[robot_id] = this->pub_joint_control_state_;
     this->pub_states_[robot_id] = this->pub_joint_sensor_state_;
+    this->group_pub_joints_[robot_id].initPublished(iterator->second.get_joint_names());
   }
 
 
@@ -83,6 +84,7 @@ bool JointRelayHandler::init(SmplMsgConnection* connection, int msg_type, std::v
 
   // save "complete" joint-name list, preserving any blank entries for later use
   this->all_joint_names_ = joint_names;
+  this->pub_joints_.initPublished(joint_names);
 
   return MessageHandler::init(msg_type, connection);
 }
@@ -115,7 +117,7 @@ bool JointRelayHandler::internalCB(SimpleMessage& msg_in)
   return rtn;
 }
 
-// TODO( ): Add support for other message fields (effort, desired pos)
+// TODO( ): Add support for other message fields (desired pos)
 bool JointRelayHandler::create_messages(SimpleMessage& msg_in,
                                         control_msgs::FollowJointTrajectoryFeedback* control_state,
                                         sensor_msgs::JointState* sensor_state)
@@ -137,8 +139,8 @@ bool JointRelayHandler::create_messages(SimpleMessage& msg_in,
 
   // select specific joints for publishing
   JointTrajectoryPoint pub_joint_state;
-  std::vector<std::string> pub_joint_names;
-  if (!select(xform_joint_state, all_joint_names_, &pub_joint_state, &pub_joint_names))
+  const std::vector<std::string>& pub_joint_names = pub_joints_.names();
+  if (!select(xform_joint_state, pub_joints_, &pub_joint_state))
   {
     LOG_ERROR("Failed to select joints for publishing");
     return false;
@@ -151,6 +153,7 @@ bool JointRelayHandler::create_messages(SimpleMessage& msg_in,
   control_state->actual.positions = pub_joint_state.positions;
   control_state->actual.velocities = pub_joint_state.velocities;
   control_state->actual.accelerations = pub_joint_state.accelerations;
+  control_state->actual.effort = pub_joint_state.effort;
   control_state->actual.time_from_start = pub_joint_state.time_from_start;
 
   *sensor_state = sensor_msgs::JointState();  // always start with a "clean" message
@@ -158,6 +161,7 @@ bool JointRelayHandler::create_messages(SimpleMessage& msg_in,
   sensor_state->name = pub_joint_names;
   sensor_state->position = pub_joint_state.positions;
   sensor_state->velocity = pub_joint_state.velocities;
+  sensor_state->effort = pub_joint_state.effort;
 
   this->pub_joint_control_state_.publish(*control_state);
   this->pub_joint_sensor_state_.publish(*sensor_state);
@@ -165,7 +169,7 @@ bool JointRelayHandler::create_messages(SimpleMessage& msg_in,
   return true;
 }
 
-// TODO( ): Add support for other message fields (effort, desired pos)
+// TODO( ): Add support for other message fields (desired pos)
 bool JointRelayHandler::create_messages(SimpleMessage& msg_in,
                                         control_msgs::FollowJointTrajectoryFeedback* control_state,
                                         sensor_msgs::JointState* sensor_state, int robot_id)
@@ -185,9 +189,10 @@ bool JointRelayHandler::create_messages(SimpleMessage& msg_in,
   }
 
   // select specific joints for publishing
+  const JointMap& pub_joints = group_pub_joints_[robot_id];
   DynamicJointsGroup pub_joint_state;
-  std::vector<std::string> pub_joint_names;
-  if (!select(xform_joint_state, robot_groups_[robot_id].get_joint_names(), &pub_joint_state, &pub_joint_names))
+  const std::vector<std::string>& pub_joint_names = pub_joints.names();
+  if (!select(xform_joint_state, pub_joints, &pub_joint_state))
   {
     LOG_ERROR("Failed to select joints for publishing");
     return false;
@@ -199,6 +204,7 @@ bool JointRelayHandler::create_messages(SimpleMessage& msg_in,
   control_state->actual.positions = pub_joint_state.positions;
   control_state->actual.velocities = pub_joint_state.velocities;
   control_state->actual.accelerations = pub_joint_state.accelerations;
+  control_state->actual.effort = pub_joint_state.effort;
   control_state->actual.time_from_start = pub_joint_state.time_from_start;
 
   *sensor_state = sensor_msgs::JointState();  // always start with a "clean" message
@@ -206,6 +212,7 @@ bool JointRelayHandler::create_messages(SimpleMessage& msg_in,
   sensor_state->name = pub_joint_names;
   sensor_state->position = pub_joint_state.positions;
   sensor_state->velocity = pub_joint_state.velocities;
+  sensor_state->effort = pub_joint_state.effort;
 
   this->pub_controls_[robot_id].publish(*control_state);
   this->pub_states_[robot_id].publish(*sensor_state);
@@ -293,26 +300,12 @@ bool JointRelayHandler::select(const JointTrajectoryPoint& all_joint_state,
 {
   ROS_ASSERT(all_joint_state.positions.size() == all_joint_names.size());
 
-  *pub_joint_state = JointTrajectoryPoint();  // start with a "clean" message
-  pub_joint_names->clear();
-
-  // skip over "blank" joint names
-  for (size_t i = 0; i < all_joint_names.size(); ++i)
-  {
-    if (all_joint_names[i].empty())
-      continue;
-
-    pub_joint_names->push_back(all_joint_names[i]);
-    if (!all_joint_state.positions.empty())
-      pub_joint_state->positions.push_back(all_joint_state.positions[i]);
-    if (!all_joint_state.velocities.empty())
-      pub_joint_state->velocities.push_back(all_joint_state.velocities[i]);
-    if (!all_joint_state.accelerations.empty())
-      pub_joint_state->accelerations.push_back(all_joint_state.accelerations[i]);
-  }
-  pub_joint_state->time_from_start = all_joint_state.time_from_start;
+  JointMap pub_joints;
+  pub_joints.initPublished(all_joint_names);
+  *pub_joint_names = pub_joints.names();
 
-  return true;
+  *pub_joint_state = JointTrajectoryPoint();  // start with a "clean" message
+  return select(all_joint_state, pub_joints, pub_joint_state);
 }
 
 bool JointRelayHandler::select(const DynamicJointsGroup& all_joint_state,
@@ -321,22 +314,37 @@ bool JointRelayHandler::select(const DynamicJointsGroup& all_joint_state,
 {
   ROS_ASSERT(all_joint_state.positions.size() == all_joint_names.size());
 
+  JointMap pub_joints;
+  pub_joints.initPublished(all_joint_names);
+  *pub_joint_names = pub_joints.names();
+
   *pub_joint_state = DynamicJointsGroup();  // start with a "clean" message
-  pub_joint_names->clear();
+  return select(all_joint_state, pub_joints, pub_joint_state);
+}
 
-  // skip over "blank" joint names
-  for (size_t i = 0; i < all_joint_names.size(); ++i)
-  {
-    if (all_joint_names[i].empty())
-      continue;
-    pub_joint_names->push_back(all_joint_names[i]);
-    if (!all_joint_state.positions.empty())
-      pub_joint_state->positions.push_back(all_joint_state.positions[i]);
-    if (!all_joint_state.velocities.empty())
-      pub_joint_state->velocities.push_back(all_joint_state.velocities[i]);
-    if (!all_joint_state.accelerations.empty())
-      pub_joint_state->accelerations.push_back(all_joint_state.accelerations[i]);
-  }
+bool JointRelayHandler::select(const JointTrajectoryPoint& all_joint_state, const JointMap& pub_joints,
+                               JointTrajectoryPoint* pub_joint_state)
+{
+  // blank joints are not published, so nothing is filled in
+  if (!pub_joints.apply(all_joint_state.positions, 0.0, &pub_joint_state->positions) ||
+      !pub_joints.apply(all_joint_state.velocities, 0.0, &pub_joint_state->velocities) ||
+      !pub_joints.apply(all_joint_state.accelerations, 0.0, &pub_joint_state->accelerations) ||
+      !pub_joints.apply(all_joint_state.effort, 0.0, &pub_joint_state->effort))
+    return false;
+  pub_joint_state->time_from_start = all_joint_state.time_from_start;
+
+  return true;
+}
+
+bool JointRelayHandler::select(const DynamicJointsGroup& all_joint_state, const JointMap& pub_joints,
+                               DynamicJointsGroup* pub_joint_state)
+{
+  // blank joints are not published, so nothing is filled in
+  if (!pub_joints.apply(all_joint_state.positions, 0.0, &pub_joint_state->positions) ||
+      !pub_joints.apply(all_joint_state.velocities, 0.0, &pub_joint_state->velocities) ||
+      !pub_joints.apply(all_joint_state.accelerations, 0.0, &pub_joint_state->accelerations) ||
+      !pub_joints.apply(all_joint_state.effort, 0.0, &pub_joint_state->effort))
+    return false;
   pub_joint_state->time_from_start = all_joint_state.time_from_start;
 
   return true;
@@ -32,6 +32,7 @@
  */
 
 #include <motoman_driver/industrial_robot_client/joint_trajectory_action.h>
+#include "motoman_driver/industrial_robot_client/joint_map.h"
 #include "motoman_driver/industrial_robot_client/motoman_utils.h"
 #include <industrial_robot_client/utils.h>
 #include <industrial_utils/param_utils.h>
@@ -40,6 +41,7 @@
 #include <string>
 #include <vector>
 
+using industrial_robot_client::joint_map::JointMap;
 using industrial_robot_client::motoman_utils::getJointGroups;
 
 namespace industrial_robot_client
@@ -47,6 +49,22 @@ namespace industrial_robot_client
 namespace joint_trajectory_action
 {
 
+namespace
+{
+/**
+ * \brief Copy the joints of a group from a trajectory point, zeros if the point has no such values
+ */
+bool copyJoints(const JointMap& joints, const std::vector<double>& src, std::vector<double>* dst)
+{
+  if (src.empty())
+  {
+    dst->assign(joints.size(), 0.0);
+    return true;
+  }
+  return joints.apply(src, 0.0, dst);
+}
+}  // namespace
+
 JointTrajectoryAction::JointTrajectoryAction() :
   JointTrajectoryActionV0(false)
 {
@@ -96,8 +114,7 @@ JointTrajectoryAction::JointTrajectoryAction() :
                                boost::bind(&JointTrajectoryAction::controllerStateCB,
                                            this, _1, group_number_int));
     sub_robot_status_ = node_.subscribe(
-                          "robot_status", 1, &JointTrajectoryAction::robotStatusCB,
-                          static_cast<JointTrajectoryActionV0*>(this));
+                          "robot_status", 1, &JointTrajectoryAction::robotStatusCB, this);
 
     pub_trajectories_[group_number_int] = pub_trajectory_command_;
     sub_trajectories_[group_number_int] = (sub_trajectory_state_);
@@ -198,108 +215,58 @@ void JointTrajectoryAction::goalCB(JointTractoryActionServer::GoalHandle gh)
 {
   gh.setAccepted();
 
-  int group_number;
+  const trajectory_msgs::JointTrajectory& traj = gh.getGoal()->trajectory;
 
 // TODO(thiagodefreitas): change for getting the id from the group instead of a sequential checking on the map
 
-  ros::Duration last_time_from_start(0.0);
+  // joint names are matched once per group, for all the points
+  std::vector<JointMap> group_joints(robot_groups_.size());
+  std::vector<bool> is_found(robot_groups_.size());
+  for (size_t rbt_idx = 0; rbt_idx < robot_groups_.size(); rbt_idx++)
+    is_found[rbt_idx] = group_joints[rbt_idx].init(traj.joint_names, robot_groups_[rbt_idx].get_joint_names());
 
   motoman_msgs::DynamicJointTrajectory dyn_traj;
+  dyn_traj.points.resize(traj.points.size());
 
-  for (size_t i = 0; i < gh.getGoal()->trajectory.points.size(); i++)
+  for (size_t i = 0; i < traj.points.size(); i++)
   {
-    motoman_msgs::DynamicJointPoint dpoint;
+    const trajectory_msgs::JointTrajectoryPoint& pt = traj.points[i];
+    motoman_msgs::DynamicJointPoint& dpoint = dyn_traj.points[i];
+    dpoint.groups.resize(robot_groups_.size());
 
     for (size_t rbt_idx = 0; rbt_idx < robot_groups_.size(); rbt_idx++)
     {
-      size_t ros_idx = std::find(
-                         gh.getGoal()->trajectory.joint_names.begin(),
-                         gh.getGoal()->trajectory.joint_names.end(),
-                         robot_groups_[rbt_idx].get_joint_names()[0])
-                       - gh.getGoal()->trajectory.joint_names.begin();
+      const JointMap& joints = group_joints[rbt_idx];
+      motoman_msgs::DynamicJointsGroup& dyn_group = dpoint.groups[rbt_idx];
+      int num_joints = joints.size();
 
-      bool is_found = ros_idx < gh.getGoal()->trajectory.joint_names.size();
-
-      group_number = rbt_idx;
-      motoman_msgs::DynamicJointsGroup dyn_group;
-
-      int num_joints = robot_groups_[group_number].get_joint_names().size();
-
-      if (is_found)
+      if (is_found[rbt_idx])
       {
-        if (gh.getGoal()->trajectory.points[i].positions.empty())
-        {
-          std::vector<double> positions(num_joints, 0.0);
-          dyn_group.positions = positions;
-        }
-        else
-          dyn_group.positions.insert(
-            dyn_group.positions.begin(),
-            gh.getGoal()->trajectory.points[i].positions.begin() + ros_idx,
-            gh.getGoal()->trajectory.points[i].positions.begin() + ros_idx
-            + robot_groups_[rbt_idx].get_joint_names().size());
-
-        if (gh.getGoal()->trajectory.points[i].velocities.empty())
-        {
-          std::vector<double> velocities(num_joints, 0.0);
-          dyn_group.velocities = velocities;
-        }
-        else
-          dyn_group.velocities.insert(
-            dyn_group.velocities.begin(),
-            gh.getGoal()->trajectory.points[i].velocities.begin()
-            + ros_idx, gh.getGoal()->trajectory.points[i].velocities.begin()
-            + ros_idx + robot_groups_[rbt_idx].get_joint_names().size());
-
-        if (gh.getGoal()->trajectory.points[i].accelerations.empty())
+        if (!copyJoints(joints, pt.positions, &dyn_group.positions) ||
+            !copyJoints(joints, pt.velocities, &dyn_group.velocities) ||
+            !copyJoints(joints, pt.accelerations, &dyn_group.accelerations) ||
+            !copyJoints(joints, pt.effort, &dyn_group.effort))
         {
-          std::vector<double> accelerations(num_joints, 0.0);
-          dyn_group.accelerations = accelerations;
+          ROS_ERROR("Trajectory point %lu has fewer values than joint names, aborting goal", i);
+          gh.setAborted();
+          return;
         }
-        else
-          dyn_group.accelerations.insert(
-            dyn_group.accelerations.begin(),
-            gh.getGoal()->trajectory.points[i].accelerations.begin()
-            + ros_idx, gh.getGoal()->trajectory.points[i].accelerations.begin()
-            + ros_idx + robot_groups_[rbt_idx].get_joint_names().size());
-        if (gh.getGoal()->trajectory.points[i].effort.empty())
-        {
-          std::vector<double> effort(num_joints, 0.0);
-          dyn_group.effort = effort;
-        }
-        else
-          dyn_group.effort.insert(
-            dyn_group.effort.begin(),
-            gh.getGoal()->trajectory.points[i].effort.begin()
-            + ros_idx, gh.getGoal()->trajectory.points[i].effort.begin()
-            + ros_idx + robot_groups_[rbt_idx].get_joint_names().size());
-        dyn_group.time_from_start = gh.getGoal()->trajectory.points[i].time_from_start;
-        dyn_group.group_number = group_number;
-        dyn_group.num_joints = dyn_group.positions.size();
       }
 
       // Generating message for groups that were not present in the trajectory message
       else
       {
-        std::vector<double> positions(num_joints, 0.0);
-        std::vector<double> velocities(num_joints, 0.0);
-        std::vector<double> accelerations(num_joints, 0.0);
-        std::vector<double> effort(num_joints, 0.0);
-
-        dyn_group.positions = positions;
-        dyn_group.velocities = velocities;
-        dyn_group.accelerations = accelerations;
-        dyn_group.effort = effort;
-
-        dyn_group.time_from_start = gh.getGoal()->trajectory.points[i].time_from_start;
-        dyn_group.group_number = group_number;
-        dyn_group.num_joints = num_joints;
+        dyn_group.positions.assign(num_joints, 0.0);
+        dyn_group.velocities.assign(num_joints, 0.0);
+        dyn_group.accelerations.assign(num_joints, 0.0);
+        dyn_group.effort.assign(num_joints, 0.0);
       }
 
-      dpoint.groups.push_back(dyn_group);
+      dyn_group.time_from_start = pt.time_from_start;
+      dyn_group.group_number = rbt_idx;
+      dyn_group.num_joints = num_joints;
     }
     dpoint.num_groups = dpoint.groups.size();
-    dyn_traj.points.push_back(dpoint);
   }
   dyn_traj.header = gh.getGoal()->trajectory.header;
   dyn_traj.header.stamp = ros::Time::now();
@@ -479,6 +446,32 @@ void JointTrajectoryAction::controllerStateCB(
     return;
   }
 
+  checkGoalCompletion(robot_id);
+}
+
+void JointTrajectoryAction::robotStatusCB(const industrial_msgs::RobotStatusConstPtr &msg)
+{
+  JointTrajectoryActionV0::robotStatusCB(msg);
+
+  if (msg->in_motion.val != industrial_msgs::TriState::FALSE)
+    return;
+
+  // motion stopped: check the goals against the last feedback received
+  for (std::map<int, bool>::iterator it = has_active_goal_map_.begin(); it != has_active_goal_map_.end(); ++it)
+  {
+    int robot_id = it->first;
+    if (!it->second || !last_trajectory_state_map_[robot_id] || current_traj_map_[robot_id].points.empty())
+      continue;
+    if (!industrial_utils::isSimilar(robot_groups_[robot_id].get_joint_names(),
+                                     last_trajectory_state_map_[robot_id]->joint_names))
+      continue;
+
+    checkGoalCompletion(robot_id);
+  }
+}
+
+void JointTrajectoryAction::checkGoalCompletion(int robot_id)
+{
   // Checking for goal constraints
   // Checks that we have ended inside the goal constraints and has motion stopped
 
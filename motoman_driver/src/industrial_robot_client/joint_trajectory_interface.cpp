@@ -83,6 +83,9 @@ bool JointTrajectoryInterface::init(std::string default_ip, int default_port, bo
   default_tcp_connection_.init(ip_addr, port);
   free(ip_addr);
 
+  if (!default_tcp_connection_.initRecording())
+    return false;
+
   return init(&default_tcp_connection_);
 }
 
@@ -297,46 +300,64 @@ bool JointTrajectoryInterface::trajectory_to_msgs(
 {
   msgs->clear();
 
-  std::vector<double>::iterator it;
+  // check for valid trajectory
+  if ((traj->points[0].num_groups == 1) && !is_valid(*traj))
+    return false;
 
-  if (traj->points[0].num_groups == 1)
+  return points_to_msgs(*traj, 0, traj->points.size(), msgs);
+}
+
+bool JointTrajectoryInterface::points_to_msgs(
+  const motoman_msgs::DynamicJointTrajectory& traj, size_t first, size_t last,
+  std::vector<SimpleMessage>* msgs)
+{
+  msgs->clear();
+
+  if (traj.points[0].num_groups == 1)
   {
-    // check for valid trajectory
-    if (!is_valid(*traj))
-    {
-      return false;
-    }
+    // joint names are matched once per group, for all the points
+    std::map<int, JointMap> rbt_joints;
+    ros_dynamicPoint rbt_pt, xform_pt;
 
-    for (size_t i = 0; i < traj->points.size(); ++i)
+    msgs->resize(last - first);
+    for (size_t i = first; i < last; ++i)
     {
-      SimpleMessage msg;
-      ros_dynamicPoint rbt_pt, xform_pt;
+      const ros_dynamicPoint &pt = traj.points[i].groups[0];
 
+      std::map<int, JointMap>::iterator joints = rbt_joints.find(pt.group_number);
+      if (joints == rbt_joints.end())
+      {
+        // find (rather than operator[]) leaves robot_groups_ untouched for concurrent conversions
+        std::map<int, RobotGroup>::iterator group = robot_groups_.find(pt.group_number);
+        if (group == robot_groups_.end())
+          ROS_ERROR_RETURN(false, "Unknown robot group (%d) for trajectory pt %lu", pt.group_number, i);
+
+        joints = rbt_joints.insert(std::make_pair(pt.group_number, JointMap())).first;
+        if (!map_joints(traj.joint_names, group->second.get_joint_names(), &joints->second))
+          return false;
+      }
 
-      if (!select(traj->joint_names, traj->points[i].groups[0],
-                  robot_groups_[traj->points[i].groups[0].group_number].get_joint_names(),
-                  &rbt_pt))
+      if (!select(joints->second, pt, &rbt_pt))
         return false;
 
       // transform point data (e.g. for joint-coupling)
       if (!transform(rbt_pt, &xform_pt))
         return false;
 
-      // convert trajectory point to ROS message
-      if (!create_message(i, xform_pt, &msg))
+      // convert trajectory point to ROS message, in place
+      if (!create_message(i, xform_pt, &(*msgs)[i - first]))
         return false;
-
-      msgs->push_back(msg);
     }
   }
   // TODO(thiagodefreitas) : get MAX_NUM_GROUPS for the FS100 controller
-  else if (traj->points[0].num_groups <= 4)
+  else if (traj.points[0].num_groups <= 4)
   {
-    for (size_t i = 0; i < traj->points.size(); ++i)
+    msgs->resize(last - first);
+    for (size_t i = first; i < last; ++i)
     {
-      SimpleMessage msg;
-      create_message_ex(i, traj->points[i], &msg);
-      msgs->push_back(msg);
+      // convert trajectory point to ROS message, in place
+      if (!create_message_ex(i, traj.points[i], &(*msgs)[i - first]))
+        return false;
     }
   }
   return true;
@@ -349,17 +370,21 @@ bool JointTrajectoryInterface::trajectory_to_msgs(
   msgs->clear();
 
   // check for valid trajectory
-  if (!is_valid(*traj))
+  if (!is_valid(*traj) || !is_valid_start(*traj))
     return false;
 
+  // joint names are matched once, for all the points
+  JointMap rbt_joints;
+  if (!map_joints(traj->joint_names, this->all_joint_names_, &rbt_joints))
+    return false;
+
+  msgs->resize(traj->points.size());
   for (size_t i = 0; i < traj->points.size(); ++i)
   {
-    SimpleMessage msg;
     ros_JointTrajPt rbt_pt, xform_pt;
 
     // select / reorder joints for sending to robot
-    if (!select(traj->joint_names, traj->points[i],
-                this->all_joint_names_, &rbt_pt))
+    if (!select(rbt_joints, traj->points[i], &rbt_pt))
       return false;
 
     // Check if the first trajectory point should be replaced with the current joint position.
@@ -391,108 +416,79 @@ bool JointTrajectoryInterface::trajectory_to_msgs(
     if (!transform(rbt_pt, &xform_pt))
       return false;
 
-    // convert trajectory point to ROS message
-    if (!create_message(i, xform_pt, &msg))
+    // convert trajectory point to ROS message, in place
+    if (!create_message(i, xform_pt, &(*msgs)[i]))
       return false;
-
-    msgs->push_back(msg);
   }
 
   return true;
 }
 
-bool JointTrajectoryInterface::select(
+bool JointTrajectoryInterface::map_joints(
   const std::vector<std::string>& ros_joint_names,
-  const ros_dynamicPoint& ros_pt,
-  const std::vector<std::string>& rbt_joint_names, ros_dynamicPoint* rbt_pt)
+  const std::vector<std::string>& rbt_joint_names, JointMap* rbt_joints)
 {
-  ROS_ASSERT(ros_joint_names.size() == ros_pt.positions.size());
-  // initialize rbt_pt
-  *rbt_pt = ros_pt;
-  rbt_pt->positions.clear();
-  rbt_pt->velocities.clear();
-  rbt_pt->accelerations.clear();
-
-  for (size_t rbt_idx = 0; rbt_idx < rbt_joint_names.size(); ++rbt_idx)
+  // error-chk: required robot joint not found in ROS joint-list
+  if (!rbt_joints->init(ros_joint_names, rbt_joint_names))
   {
-    bool is_empty = rbt_joint_names[rbt_idx].empty();
-
-    // find matching ROS element
-    size_t ros_idx = std::find(ros_joint_names.begin(),
-                               ros_joint_names.end(),
-                               rbt_joint_names[rbt_idx]) - ros_joint_names.begin();
-    bool is_found = ros_idx < ros_joint_names.size();
-
-
-    // error-chk: required robot joint not found in ROS joint-list
-    if (!is_empty && !is_found)
-    {
-      ROS_ERROR("Expected joint (%s) not found in JointTrajectory.Aborting command.",
-                rbt_joint_names[rbt_idx].c_str());
-      return false;
-    }
-
-    if (is_empty)
-    {
-      if (!ros_pt.positions.empty()) rbt_pt->positions.push_back(default_joint_pos_);
-      if (!ros_pt.velocities.empty()) rbt_pt->velocities.push_back(-1);
-      if (!ros_pt.accelerations.empty()) rbt_pt->accelerations.push_back(-1);
-    }
-    else
-    {
-      if (!ros_pt.positions.empty())
-        rbt_pt->positions.push_back(ros_pt.positions[ros_idx]);
-      if (!ros_pt.velocities.empty())
-        rbt_pt->velocities.push_back(ros_pt.velocities[ros_idx]);
-      if (!ros_pt.accelerations.empty())
-        rbt_pt->accelerations.push_back(ros_pt.accelerations[ros_idx]);
-    }
+    ROS_ERROR("Expected joint (%s) not found in JointTrajectory.  Aborting command.",
+              rbt_joints->missing().c_str());
+    return false;
   }
   return true;
 }
 
+bool JointTrajectoryInterface::select(
+  const std::vector<std::string>& ros_joint_names,
+  const ros_dynamicPoint& ros_pt,
+  const std::vector<std::string>& rbt_joint_names, ros_dynamicPoint* rbt_pt)
+{
+  JointMap rbt_joints;
+  return map_joints(ros_joint_names, rbt_joint_names, &rbt_joints) && select(rbt_joints, ros_pt, rbt_pt);
+}
 
 bool JointTrajectoryInterface::select(
   const std::vector<std::string>& ros_joint_names,
   const ros_JointTrajPt& ros_pt, const std::vector<std::string>& rbt_joint_names,
   ros_JointTrajPt* rbt_pt)
 {
-  ROS_ASSERT(ros_joint_names.size() == ros_pt.positions.size());
-  // initialize rbt_pt
-  *rbt_pt = ros_pt;
-  rbt_pt->positions.clear();
-  rbt_pt->velocities.clear();
-  rbt_pt->accelerations.clear();
+  JointMap rbt_joints;
+  return map_joints(ros_joint_names, rbt_joint_names, &rbt_joints) && select(rbt_joints, ros_pt, rbt_pt);
+}
 
-  for (size_t rbt_idx = 0; rbt_idx < rbt_joint_names.size(); ++rbt_idx)
+bool JointTrajectoryInterface::select(const JointMap& rbt_joints, const ros_dynamicPoint& ros_pt,
+                                      ros_dynamicPoint* rbt_pt)
+{
+  // copy the fields that are not selected, then the selected ones by index
+  rbt_pt->group_number = ros_pt.group_number;
+  rbt_pt->num_joints = ros_pt.num_joints;
+  rbt_pt->valid_fields = ros_pt.valid_fields;
+  rbt_pt->effort = ros_pt.effort;
+  rbt_pt->time_from_start = ros_pt.time_from_start;
+
+  if (!rbt_joints.apply(ros_pt.positions, default_joint_pos_, &rbt_pt->positions) ||
+      !rbt_joints.apply(ros_pt.velocities, -1, &rbt_pt->velocities) ||
+      !rbt_joints.apply(ros_pt.accelerations, -1, &rbt_pt->accelerations))
   {
-    bool is_empty = rbt_joint_names[rbt_idx].empty();
-
-    // find matching ROS element
-    size_t ros_idx = std::find(ros_joint_names.begin(), ros_joint_names.end(),
-                               rbt_joint_names[rbt_idx]) - ros_joint_names.begin();
-    bool is_found = ros_idx < ros_joint_names.size();
+    ROS_ERROR("Trajectory point has fewer values than joint names.  Aborting command.");
+    return false;
+  }
+  return true;
+}
 
-    // error-chk: required robot joint not found in ROS joint-list
-    if (!is_empty && !is_found)
-    {
-      ROS_ERROR("Expected joint (%s) not found in JointTrajectory.  Aborting command.",
-                rbt_joint_names[rbt_idx].c_str());
-      return false;
-    }
+bool JointTrajectoryInterface::select(const JointMap& rbt_joints, const ros_JointTrajPt& ros_pt,
+                                      ros_JointTrajPt* rbt_pt)
+{
+  // copy the fields that are not selected, then the selected ones by index
+  rbt_pt->effort = ros_pt.effort;
+  rbt_pt->time_from_start = ros_pt.time_from_start;
 
-    if (is_empty)
-    {
-      if (!ros_pt.positions.empty()) rbt_pt->positions.push_back(default_joint_pos_);
-      if (!ros_pt.velocities.empty()) rbt_pt->velocities.push_back(-1);
-      if (!ros_pt.accelerations.empty()) rbt_pt->accelerations.push_back(-1);
-    }
-    else
-    {
-      if (!ros_pt.positions.empty()) rbt_pt->positions.push_back(ros_pt.positions[ros_idx]);
-      if (!ros_pt.velocities.empty()) rbt_pt->velocities.push_back(ros_pt.velocities[ros_idx]);
-      if (!ros_pt.accelerations.empty()) rbt_pt->accelerations.push_back(ros_pt.accelerations[ros_idx]);
-    }
+  if (!rbt_joints.apply(ros_pt.positions, default_joint_pos_, &rbt_pt->positions) ||
+      !rbt_joints.apply(ros_pt.velocities, -1, &rbt_pt->velocities) ||
+      !rbt_joints.apply(ros_pt.accelerations, -1, &rbt_pt->accelerations))
+  {
+    ROS_ERROR("Trajectory point has fewer values than joint names.  Aborting command.");
+    return false;
   }
   return true;
 }
@@ -741,7 +737,12 @@ bool JointTrajectoryInterface::is_valid(const trajectory_msgs::JointTrajectory &
 
 bool JointTrajectoryInterface::is_valid(const motoman_msgs::DynamicJointTrajectory &traj)
 {
-  for (size_t i = 0; i < traj.points.size(); ++i)
+  return is_valid(traj, 0, traj.points.size()) && is_valid_start(traj);
+}
+
+bool JointTrajectoryInterface::is_valid(const motoman_msgs::DynamicJointTrajectory &traj, size_t first, size_t last)
+{
+  for (size_t i = first; i < last; ++i)
   {
     for (int gr = 0; gr < traj.points[i].num_groups; gr++)
     {
@@ -31,6 +31,9 @@
 
 #include "motoman_driver/industrial_robot_client/joint_trajectory_streamer.h"
 #include "motoman_driver/simple_message/motoman_motion_reply.h"
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <vector>
 #include <string>
@@ -39,6 +42,124 @@ namespace CommTypes = industrial::simple_message::CommTypes;
 namespace ReplyTypes = industrial::simple_message::ReplyTypes;
 using motoman::simple_message::motion_reply::MotionReplyResult;
 
+namespace
+{
+
+/**
+ * \brief Position and velocity at time t of the cubic the robot interpolates
+ * between two trajectory points.
+ */
+template <typename Point>
+void interpolate(const Point &pt0, const Point &pt1, double t, std::vector<double>* pos, std::vector<double>* vel)
+{
+  double t0 = pt0.time_from_start.toSec();
+  double h = pt1.time_from_start.toSec() - t0;
+  double s = (h > 0.0) ? (t - t0) / h : 1.0;
+  double h00 = 2 * s * s * s - 3 * s * s + 1, h10 = s * s * s - 2 * s * s + s;
+  double h01 = 1 - h00, h11 = s * s * s - s * s;
+  double d00 = 6 * s * s - 6 * s, d10 = 3 * s * s - 4 * s + 1, d11 = 3 * s * s - 2 * s;
+
+  pos->resize(pt1.positions.size());
+  vel->resize(pt1.positions.size());
+  for (size_t j = 0; j < pt1.positions.size(); ++j)
+  {
+    double p0 = (j < pt0.positions.size()) ? pt0.positions[j] : pt1.positions[j];
+    double v0 = (j < pt0.velocities.size()) ? pt0.velocities[j] : 0.0;
+    double v1 = (j < pt1.velocities.size()) ? pt1.velocities[j] : 0.0;
+
+    if (h > 0.0)
+    {
+      (*pos)[j] = h00 * p0 + h10 * h * v0 + h01 * pt1.positions[j] + h11 * h * v1;
+      (*vel)[j] = (d00 * p0 - d00 * pt1.positions[j]) / h + d10 * v0 + d11 * v1;
+    }
+    else
+    {
+      (*pos)[j] = pt1.positions[j];
+      (*vel)[j] = v1;
+    }
+  }
+}
+
+/**
+ * \brief Make the points of one group continue the motion kept on the robot.
+ *
+ * The new trajectory is evaluated at the splice time and its deviation from the
+ * kept end state is blended out over blend_time, by adding to the points in that
+ * window a cubic that cancels the deviation in position and velocity.
+ *
+ * \param points points of the new trajectory, in trajectory time of the robot
+ * \param[out] first index of the first point past the splice time
+ * \return false if the trajectory doesn't cover the splice time or deviates too much
+ */
+template <typename Point>
+bool blendSplice(const std::vector<Point*> &points, double splice_time,
+                 const trajectory_msgs::JointTrajectoryPoint &end_state,
+                 double blend_time, double max_deviation, size_t* first)
+{
+  size_t k = 0;
+  while ((k < points.size()) && (points[k]->time_from_start.toSec() <= splice_time))
+    ++k;
+
+  if (k == 0)
+  {
+    ROS_ERROR("New trajectory starts after the splice time (%.3f s)", splice_time);
+    return false;
+  }
+  if (k == points.size())
+  {
+    ROS_ERROR("New trajectory ends before the splice time (%.3f s)", splice_time);
+    return false;
+  }
+
+  std::vector<double> pos, vel;
+  interpolate(*points[k - 1], *points[k], splice_time, &pos, &vel);
+
+  size_t num_joints = std::min(pos.size(), std::min(end_state.positions.size(), end_state.velocities.size()));
+  std::vector<double> dp(num_joints), dv(num_joints);
+  double max_dp = 0.0, max_dv = 0.0;
+  for (size_t j = 0; j < num_joints; ++j)
+  {
+    dp[j] = end_state.positions[j] - pos[j];
+    dv[j] = end_state.velocities[j] - vel[j];
+    max_dp = std::max(max_dp, std::fabs(dp[j]));
+    max_dv = std::max(max_dv, std::fabs(dv[j]));
+  }
+
+  // a velocity deviation moves the blended points by up to max_dv * blend_time
+  double max_dv_time = (blend_time > 0.0) ? blend_time : 1.0;
+  if ((max_dp > max_deviation) || (max_dv * max_dv_time > max_deviation))
+  {
+    ROS_ERROR("New trajectory deviates from the motion kept on the robot by %.4f rad, %.4f rad/s at the splice time",
+              max_dp, max_dv);
+    return false;
+  }
+
+  *first = k;
+  if (blend_time <= 0.0)
+    return true;
+
+  ROS_DEBUG("Blending a deviation of %.4f rad, %.4f rad/s over %.3f s", max_dp, max_dv, blend_time);
+  for (size_t i = k; i < points.size(); ++i)
+  {
+    double u = (points[i]->time_from_start.toSec() - splice_time) / blend_time;
+    if (u >= 1.0)
+      break;
+
+    double h00 = 2 * u * u * u - 3 * u * u + 1, h10 = u * u * u - 2 * u * u + u;
+    double d00 = 6 * u * u - 6 * u, d10 = 3 * u * u - 4 * u + 1;
+    for (size_t j = 0; (j < num_joints) && (j < points[i]->positions.size()); ++j)
+    {
+      points[i]->positions[j] += h00 * dp[j] + h10 * blend_time * dv[j];
+      if (j < points[i]->velocities.size())
+        points[i]->velocities[j] += d00 * dp[j] / blend_time + d10 * dv[j];
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
 namespace industrial_robot_client
 {
 namespace joint_trajectory_streamer
@@ -53,6 +174,10 @@ bool JointTrajectoryStreamer::init(SmplMsgConnection* connection, const std::map
 
   rtn &= JointTrajectoryInterface::init(connection, robot_groups, velocity_limits);
 
+  node_.param("splice_lead_time", splice_lead_time_, 0.1);
+  node_.param("splice_blend_time", splice_blend_time_, 0.2);
+  node_.param("splice_max_deviation", splice_max_deviation_, 0.02);
+
   this->mutex_.lock();
   this->current_point_ = 0;
   this->state_ = TransferStates::IDLE;
@@ -73,6 +198,10 @@ bool JointTrajectoryStreamer::init(SmplMsgConnection* connection, const std::vec
 
   rtn &= JointTrajectoryInterface::init(connection, joint_names, velocity_limits);
 
+  node_.param("splice_lead_time", splice_lead_time_, 0.1);
+  node_.param("splice_blend_time", splice_blend_time_, 0.2);
+  node_.param("splice_max_deviation", splice_max_deviation_, 0.02);
+
   this->mutex_.lock();
   this->current_point_ = 0;
   this->state_ = TransferStates::IDLE;
@@ -86,13 +215,22 @@ bool JointTrajectoryStreamer::init(SmplMsgConnection* connection, const std::vec
 
 JointTrajectoryStreamer::~JointTrajectoryStreamer()
 {
+  cancelConversion();
   delete this->streaming_thread_;
 }
 
+void JointTrajectoryStreamer::jointTrajectoryExCB(const motoman_msgs::DynamicJointTrajectoryConstPtr &msg)
+{
+  jointTrajectoryCB(msg);
+}
+
 void JointTrajectoryStreamer::jointTrajectoryCB(const motoman_msgs::DynamicJointTrajectoryConstPtr &msg)
 {
   ROS_INFO("Receiving joint trajectory message");
 
+  // the points still converting belong to the trajectory being replaced
+  cancelConversion();
+
   // read current state value (should be atomic)
   int state = this->state_;
 
@@ -101,8 +239,13 @@ void JointTrajectoryStreamer::jointTrajectoryCB(const motoman_msgs::DynamicJoint
   {
     if (msg->points.empty())
       ROS_INFO("Empty trajectory received, canceling current trajectory");
+    else if (splice(msg))
+      return;
     else
-      ROS_ERROR("Trajectory splicing not yet implemented, stopping current motion.");
+    {
+      ROS_ERROR("Unable to splice trajectory, stopping current motion.");
+      sendMotionReplyResult(pub_motion_reply_, MotionReplyResult::NOT_READY);
+    }
 
     this->mutex_.lock();
     trajectoryStop();
@@ -116,19 +259,29 @@ void JointTrajectoryStreamer::jointTrajectoryCB(const motoman_msgs::DynamicJoint
     return;
   }
 
-  // calc new trajectory
+  // calc new trajectory, or only its first chunk if the trajectory is long
   std::vector<SimpleMessage> new_traj_msgs;
-  if (!trajectory_to_msgs(msg, &new_traj_msgs))
+  if ((conversion_chunk_size_ > 0) && (msg->points.size() > static_cast<size_t>(conversion_chunk_size_)) &&
+      (msg->points.size() >= static_cast<size_t>(min_buffer_size_)))
+  {
+    if (!startConversion(msg, &new_traj_msgs))
+      return;
+  }
+  else if (!trajectory_to_msgs(msg, &new_traj_msgs))
     return;
 
   // send command messages to robot
-  send_to_robot(new_traj_msgs);
+  if (!send_to_robot(new_traj_msgs))
+    cancelConversion();
 }
 
 void JointTrajectoryStreamer::jointTrajectoryCB(const trajectory_msgs::JointTrajectoryConstPtr &msg)
 {
   ROS_INFO("Receiving joint trajectory message");
 
+  // the points still converting belong to the trajectory being replaced
+  cancelConversion();
+
   // read current state value (should be atomic)
   int state = this->state_;
 
@@ -137,8 +290,11 @@ void JointTrajectoryStreamer::jointTrajectoryCB(const trajectory_msgs::JointTraj
   {
     if (msg->points.empty())
       ROS_INFO("Empty trajectory received, canceling current trajectory");
-    else{
-      ROS_ERROR("Trajectory splicing not yet implemented, stopping current motion.");
+    else if (splice(msg))
+      return;
+    else
+    {
+      ROS_ERROR("Unable to splice trajectory, stopping current motion.");
       sendMotionReplyResult(pub_motion_reply_, MotionReplyResult::NOT_READY);
     }
 
@@ -187,8 +343,180 @@ bool JointTrajectoryStreamer::send_to_robot(const std::vector<SimpleMessage>& me
     this->current_point_ = 0;
     this->state_ = TransferStates::STREAMING;
     this->streaming_start_ = ros::Time::now();
+    this->first_point_pending_ = true;
   }
   this->mutex_.unlock();
+  notifyStreamingThread();
+
+  return true;
+}
+
+bool JointTrajectoryStreamer::splice(const trajectory_msgs::JointTrajectoryConstPtr &traj)
+{
+  ros::Time arrival = ros::Time::now();
+  std::vector<SimpleMessage> new_traj_msgs;
+  std::map<int, trajectory_msgs::JointTrajectoryPoint> end_state;
+  double splice_time, exec_time;
+  size_t first;
+
+  if (!is_valid(*traj))
+    return false;
+
+  // the new trajectory as it is sent to the robot
+  JointMap rbt_joints;
+  if (!map_joints(traj->joint_names, this->all_joint_names_, &rbt_joints))
+    return false;
+
+  std::vector<trajectory_msgs::JointTrajectoryPoint> xform_pts(traj->points.size());
+  std::vector<trajectory_msgs::JointTrajectoryPoint*> points(traj->points.size());
+  for (size_t i = 0; i < traj->points.size(); ++i)
+  {
+    trajectory_msgs::JointTrajectoryPoint rbt_pt;
+
+    if (!select(rbt_joints, traj->points[i], &rbt_pt) || !transform(rbt_pt, &xform_pts[i]))
+      return false;
+    points[i] = &xform_pts[i];
+  }
+
+  // waits for the points in flight, so nothing is sent while splicing
+  boost::lock_guard<boost::mutex> lock(this->mutex_);
+
+  if (TransferStates::STREAMING != this->state_)
+    return false;
+
+  if (!truncate(splice_lead_time_, &splice_time, &exec_time, &end_state))
+    return false;
+
+  if (end_state.size() != 1)
+  {
+    ROS_ERROR("Can't splice a JointTrajectory onto the motion of %d groups", static_cast<int>(end_state.size()));
+    return false;
+  }
+
+  // trajectory time of the new trajectory's start, relative to the motion executing now
+  ros::Time traj_start = traj->header.stamp.isZero() ? arrival : traj->header.stamp;
+  double time_offset = exec_time + (traj_start - ros::Time::now()).toSec();
+
+  for (size_t i = 0; i < xform_pts.size(); ++i)
+    xform_pts[i].time_from_start = ros::Duration(time_offset + traj->points[i].time_from_start.toSec());
+
+  if (!blendSplice(points, splice_time, end_state.begin()->second, splice_blend_time_, splice_max_deviation_, &first))
+    return false;
+
+  // every point sent so far was accepted by the robot, so sequence numbers continue from there
+  new_traj_msgs.resize(xform_pts.size() - first);
+  for (size_t i = first; i < xform_pts.size(); ++i)
+  {
+    if (!create_message(this->current_point_ + static_cast<int>(i - first), xform_pts[i], &new_traj_msgs[i - first]))
+      return false;
+  }
+
+  ROS_INFO("Spliced %d points at t=%.3f s (executing t=%.3f s)",
+           static_cast<int>(new_traj_msgs.size()), splice_time, exec_time);
+  this->current_traj_.resize(this->current_point_);
+  this->current_traj_.insert(this->current_traj_.end(), new_traj_msgs.begin(), new_traj_msgs.end());
+  notifyStreamingThread();
+
+  return true;
+}
+
+bool JointTrajectoryStreamer::splice(const motoman_msgs::DynamicJointTrajectoryConstPtr &traj)
+{
+  ros::Time arrival = ros::Time::now();
+  std::vector<SimpleMessage> new_traj_msgs;
+  std::map<int, trajectory_msgs::JointTrajectoryPoint> end_state;
+  double splice_time, exec_time;
+  size_t first = 0;
+
+  if (!is_valid(*traj, 0, traj->points.size()))
+    return false;
+
+  // the new trajectory as it is sent to the robot (see points_to_msgs())
+  motoman_msgs::DynamicJointTrajectory rbt_traj = *traj;
+  int num_groups = traj->points[0].num_groups;
+  if (num_groups == 1)
+  {
+    std::map<int, JointMap> rbt_joints;
+
+    for (size_t i = 0; i < traj->points.size(); ++i)
+    {
+      const motoman_msgs::DynamicJointsGroup &pt = traj->points[i].groups[0];
+      motoman_msgs::DynamicJointsGroup rbt_pt;
+
+      std::map<int, JointMap>::iterator joints = rbt_joints.find(pt.group_number);
+      if (joints == rbt_joints.end())
+      {
+        std::map<int, RobotGroup>::iterator group = robot_groups_.find(pt.group_number);
+        if (group == robot_groups_.end())
+        {
+          ROS_ERROR("Unknown robot group (%d) for trajectory pt %lu", pt.group_number, i);
+          return false;
+        }
+
+        joints = rbt_joints.insert(std::make_pair(pt.group_number, JointMap())).first;
+        if (!map_joints(traj->joint_names, group->second.get_joint_names(), &joints->second))
+          return false;
+      }
+
+      if (!select(joints->second, pt, &rbt_pt) || !transform(rbt_pt, &rbt_traj.points[i].groups[0]))
+        return false;
+    }
+  }
+
+  // waits for the points in flight, so nothing is sent while splicing
+  boost::lock_guard<boost::mutex> lock(this->mutex_);
+
+  if (TransferStates::STREAMING != this->state_)
+    return false;
+
+  if (!truncate(splice_lead_time_, &splice_time, &exec_time, &end_state))
+    return false;
+
+  // trajectory time of the new trajectory's start, relative to the motion executing now
+  ros::Time traj_start = traj->header.stamp.isZero() ? arrival : traj->header.stamp;
+  double time_offset = exec_time + (traj_start - ros::Time::now()).toSec();
+
+  // every group continues from its own kept motion
+  for (int gr = 0; gr < num_groups; ++gr)
+  {
+    std::vector<motoman_msgs::DynamicJointsGroup*> points(rbt_traj.points.size());
+    int group_number = rbt_traj.points[0].groups[gr].group_number;
+    size_t group_first;
+
+    for (size_t i = 0; i < rbt_traj.points.size(); ++i)
+    {
+      points[i] = &rbt_traj.points[i].groups[gr];
+      points[i]->time_from_start = ros::Duration(time_offset + traj->points[i].groups[gr].time_from_start.toSec());
+    }
+
+    if (end_state.find(group_number) == end_state.end())
+    {
+      ROS_ERROR("No motion kept on the robot for group %d", group_number);
+      return false;
+    }
+
+    if (!blendSplice(points, splice_time, end_state[group_number], splice_blend_time_, splice_max_deviation_,
+                     &group_first))
+      return false;
+    first = std::max(first, group_first);
+  }
+
+  // every point sent so far was accepted by the robot, so sequence numbers continue from there
+  new_traj_msgs.resize(rbt_traj.points.size() - first);
+  for (size_t i = first; i < rbt_traj.points.size(); ++i)
+  {
+    int seq = this->current_point_ + static_cast<int>(i - first);
+
+    if (num_groups == 1 ? !create_message(seq, rbt_traj.points[i].groups[0], &new_traj_msgs[i - first])
+                        : !create_message_ex(seq, rbt_traj.points[i], &new_traj_msgs[i - first]))
+      return false;
+  }
+
+  ROS_INFO("Spliced %d points at t=%.3f s (executing t=%.3f s)",
+           static_cast<int>(new_traj_msgs.size()), splice_time, exec_time);
+  this->current_traj_.resize(this->current_point_);
+  this->current_traj_.insert(this->current_traj_.end(), new_traj_msgs.begin(), new_traj_msgs.end());
+  notifyStreamingThread();
 
   return true;
 }
@@ -233,18 +561,24 @@ bool JointTrajectoryStreamer::trajectory_to_msgs(const motoman_msgs::DynamicJoin
 void JointTrajectoryStreamer::streamingThread()
 {
   int connectRetryCount = 1;
+  bool converting = false;
+  boost::unique_lock<boost::mutex> lock(this->mutex_, boost::defer_lock);
 
   ROS_INFO("Starting joint trajectory streamer thread");
   while (ros::ok())
   {
-    ros::Duration(0.005).sleep();
-
     // automatically re-establish connection, if required
     if (connectRetryCount-- > 0)
     {
       ROS_INFO("Connecting to robot motion server");
       this->connection_->makeConnect();
-      ros::Duration(0.250).sleep();  // wait for connection
+
+      if (!this->connection_->isConnected())
+      {
+        lock.lock();
+        waitForEvent(lock, ros::Duration(0.250));  // wait for connection
+        lock.unlock();
+      }
 
       if (this->connection_->isConnected())
         connectRetryCount = 0;
@@ -256,20 +590,34 @@ void JointTrajectoryStreamer::streamingThread()
       continue;
     }
 
-    this->mutex_.lock();
+    lock.lock();
 
     SimpleMessage msg, tmpMsg, reply;
 
     switch (this->state_)
     {
     case TransferStates::IDLE:
-      ros::Duration(0.250).sleep();  //  slower loop while waiting for new trajectory
+      waitForEvent(lock, ros::Duration(0.250));  // woken early by a new trajectory
       break;
 
     case TransferStates::STREAMING:
+      if (!collectConvertedPoints(&converting))
+      {
+        ROS_ERROR("Failed to convert trajectory points, stopping current motion");
+        trajectoryStop();
+        break;
+      }
+
       if (this->current_point_ >= static_cast<int>(this->current_traj_.size()))
       {
+        if (converting)
+        {
+          waitForEvent(lock, ros::Duration(0.010));  // woken early by the next converted chunk
+          break;
+        }
+
         ROS_INFO("Trajectory streaming complete, setting state to IDLE");
+        ROS_DEBUG_STREAM("Time to first point: " << this->first_point_latency_.toString());
         this->state_ = TransferStates::IDLE;
         break;
       }
@@ -290,6 +638,7 @@ void JointTrajectoryStreamer::streamingThread()
       {
         ROS_INFO("Point[%d of %d] sent to controller",
                  this->current_point_, static_cast<int>(this->current_traj_.size()));
+        recordFirstPointLatency();
         this->current_point_++;
       }
       else
@@ -302,18 +651,164 @@ void JointTrajectoryStreamer::streamingThread()
       break;
     }
 
-    this->mutex_.unlock();
+    lock.unlock();
   }
 
+  ROS_INFO_STREAM("Time to first point: " << this->first_point_latency_.toString());
   ROS_WARN("Exiting trajectory streamer thread");
 }
 
+// Long trajectories are converted in chunks of conversion_chunk_size_ points: the
+// first chunk is converted here, so streaming starts as soon as it is ready, while
+// background threads convert the others.  Validation is chunked as well, but
+// completes for the whole trajectory before any motion starts.
+bool JointTrajectoryStreamer::startConversion(const motoman_msgs::DynamicJointTrajectoryConstPtr &traj,
+                                              std::vector<SimpleMessage>* msgs)
+{
+  size_t chunk_size = conversion_chunk_size_;
+  size_t num_chunks = (traj->points.size() + chunk_size - 1) / chunk_size;
+  size_t num_threads = std::min(static_cast<size_t>(std::max(conversion_threads_, 1)), num_chunks);
+
+  // check for valid trajectory
+  if (traj->points[0].num_groups == 1)
+  {
+    boost::thread_group validators;
+    std::vector<char> valid(num_threads, true);
+
+    for (size_t i = 1; i < num_threads; ++i)
+      validators.create_thread(boost::bind(&JointTrajectoryStreamer::validateChunks, this,
+                                           boost::cref(*traj), i, num_threads, &valid[i]));
+    validateChunks(*traj, 0, num_threads, &valid[0]);
+    validators.join_all();
+
+    if ((std::find(valid.begin(), valid.end(), false) != valid.end()) || !is_valid_start(*traj))
+      return false;
+  }
+
+  {
+    boost::lock_guard<boost::mutex> lock(this->conversion_mutex_);
+    conversion_traj_ = traj;
+    converted_chunks_.resize(num_chunks);
+    chunk_converted_.assign(num_chunks, false);
+    next_chunk_ = 1;  // the first chunk is converted below
+    next_collected_chunk_ = 1;
+  }
+
+  for (size_t i = 0; i < num_threads; ++i)
+    conversion_workers_.push_back(
+      boost::make_shared<boost::thread>(boost::bind(&JointTrajectoryStreamer::convertChunks, this)));
+
+  ROS_DEBUG("Converting %d trajectory points in %d chunks on %d threads", static_cast<int>(traj->points.size()),
+            static_cast<int>(num_chunks), static_cast<int>(num_threads));
+
+  if (!points_to_msgs(*traj, 0, chunk_size, msgs))
+  {
+    cancelConversion();
+    return false;
+  }
+  return true;
+}
+
+void JointTrajectoryStreamer::validateChunks(const motoman_msgs::DynamicJointTrajectory &traj, size_t first_chunk,
+                                             size_t stride, char* valid)
+{
+  size_t chunk_size = conversion_chunk_size_;
+
+  for (size_t first = first_chunk * chunk_size; *valid && (first < traj.points.size()); first += stride * chunk_size)
+    *valid = is_valid(traj, first, std::min(first + chunk_size, traj.points.size()));
+}
+
+void JointTrajectoryStreamer::convertChunks()
+{
+  boost::unique_lock<boost::mutex> lock(this->conversion_mutex_);
+
+  while (!conversion_cancelled_ && !conversion_failed_ && (next_chunk_ < converted_chunks_.size()))
+  {
+    motoman_msgs::DynamicJointTrajectoryConstPtr traj = conversion_traj_;
+    size_t chunk = next_chunk_++;
+    size_t first = chunk * conversion_chunk_size_;
+    size_t last = std::min(first + conversion_chunk_size_, traj->points.size());
+    std::vector<SimpleMessage> msgs;
+
+    lock.unlock();
+    bool converted = points_to_msgs(*traj, first, last, &msgs);
+    lock.lock();
+
+    if (converted)
+    {
+      converted_chunks_[chunk].swap(msgs);
+      chunk_converted_[chunk] = true;
+    }
+    else
+      conversion_failed_ = true;
+    notifyStreamingThread();
+  }
+}
+
+bool JointTrajectoryStreamer::collectConvertedPoints(bool* converting)
+{
+  boost::lock_guard<boost::mutex> lock(this->conversion_mutex_);
+
+  while ((next_collected_chunk_ < chunk_converted_.size()) && chunk_converted_[next_collected_chunk_])
+  {
+    std::vector<SimpleMessage> msgs;
+    msgs.swap(converted_chunks_[next_collected_chunk_++]);
+    this->current_traj_.insert(this->current_traj_.end(), msgs.begin(), msgs.end());
+  }
+
+  *converting = !conversion_failed_ && (next_collected_chunk_ < chunk_converted_.size());
+  return !conversion_failed_;
+}
+
+void JointTrajectoryStreamer::cancelConversion()
+{
+  {
+    boost::lock_guard<boost::mutex> lock(this->conversion_mutex_);
+    conversion_cancelled_ = true;
+  }
+
+  for (size_t i = 0; i < conversion_workers_.size(); ++i)
+    conversion_workers_[i]->join();
+  conversion_workers_.clear();
+
+  boost::lock_guard<boost::mutex> lock(this->conversion_mutex_);
+  conversion_traj_.reset();
+  converted_chunks_.clear();
+  chunk_converted_.clear();
+  next_chunk_ = 0;
+  next_collected_chunk_ = 0;
+  conversion_failed_ = false;
+  conversion_cancelled_ = false;
+}
+
 void JointTrajectoryStreamer::trajectoryStop()
 {
   JointTrajectoryInterface::trajectoryStop();
 
   ROS_DEBUG("Stop command sent, entering idle mode");
   this->state_ = TransferStates::IDLE;
+  notifyStreamingThread();
+}
+
+void JointTrajectoryStreamer::notifyStreamingThread()
+{
+  this->streaming_cond_.notify_all();
+}
+
+void JointTrajectoryStreamer::waitForEvent(boost::unique_lock<boost::mutex> &lock, const ros::Duration &timeout)
+{
+  this->streaming_cond_.timed_wait(lock, boost::posix_time::microseconds(timeout.toNSec() / 1000));
+}
+
+void JointTrajectoryStreamer::recordFirstPointLatency()
+{
+  if (!this->first_point_pending_)
+    return;
+
+  ros::Duration latency = ros::Time::now() - this->streaming_start_;
+  this->first_point_latency_.record(latency);
+  this->first_point_pending_ = false;
+  ROS_DEBUG("First trajectory point sent %.3f ms after loading the trajectory", latency.toSec() * 1e3);
 }
 
 }  // namespace joint_trajectory_streamer
@@ -0,0 +1,94 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/industrial_robot_client/latency_histogram.h"
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+namespace industrial_robot_client
+{
+namespace latency_histogram
+{
+
+LatencyHistogram::LatencyHistogram()
+{
+  const double bounds[] = {0.0001, 0.0002, 0.0005, 0.001, 0.002, 0.005,
+                           0.01, 0.02, 0.05, 0.1, 0.2, 0.5};
+
+  bounds_.assign(bounds, bounds + sizeof(bounds) / sizeof(bounds[0]));
+  buckets_.resize(bounds_.size() + 1);
+  reset();
+}
+
+void LatencyHistogram::record(const ros::Duration &latency)
+{
+  double sec = latency.toSec();
+  size_t idx = std::upper_bound(bounds_.begin(), bounds_.end(), sec) - bounds_.begin();
+
+  buckets_[idx]++;
+  count_++;
+  sum_ += sec;
+  max_ = std::max(max_, sec);
+}
+
+void LatencyHistogram::reset()
+{
+  std::fill(buckets_.begin(), buckets_.end(), 0);
+  count_ = 0;
+  sum_ = 0.0;
+  max_ = 0.0;
+}
+
+std::string LatencyHistogram::toString() const
+{
+  std::ostringstream ss;
+
+  ss << "n=" << count_;
+  if (count_ == 0)
+    return ss.str();
+
+  ss << ", mean=" << (sum_ / count_) * 1e3 << "ms, max=" << max_ * 1e3 << "ms |";
+  for (size_t i = 0; i < buckets_.size(); ++i)
+  {
+    if (buckets_[i] == 0)
+      continue;
+
+    if (i < bounds_.size())
+      ss << " <" << bounds_[i] * 1e3 << "ms:" << buckets_[i];
+    else
+      ss << " >=" << bounds_.back() * 1e3 << "ms:" << buckets_[i];
+  }
+  return ss.str();
+}
+
+}  // namespace latency_histogram
+}  // namespace industrial_robot_client
@@ -32,20 +32,38 @@
 #include "motoman_driver/industrial_robot_client/robot_state_interface.h"
 #include "motoman_driver/industrial_robot_client/motoman_utils.h"
 #include "industrial_utils/param_utils.h"
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
 
 using industrial::smpl_msg_connection::SmplMsgConnection;
+namespace CommTypes = industrial::simple_message::CommTypes;
+namespace ReplyTypes = industrial::simple_message::ReplyTypes;
+namespace StandardMsgTypes = industrial::simple_message::StandardMsgTypes;
 using industrial_utils::param::getJointNames;
 using industrial_robot_client::motoman_utils::getJointGroups;
 
+namespace
+{
+// period of the publish pipeline statistics (sec)
+const double STATS_PERIOD = 10.0;
+
+// wait before retrying a failed connection (sec)
+const double RECONNECT_DELAY = 0.5;
+
+ros::Duration toDuration(const ros::WallDuration &d)
+{
+  return ros::Duration(d.sec, d.nsec);
+}
+}  // namespace
+
 namespace industrial_robot_client
 {
 namespace robot_state_interface
 {
 
-RobotStateInterface::RobotStateInterface()
+RobotStateInterface::RobotStateInterface() : publishing_(false)
 {
   this->connection_ = NULL;
   this->add_handler(&default_joint_handler_);
@@ -79,6 +97,9 @@ bool RobotStateInterface::init(std::string default_ip, int default_port, bool ve
   default_tcp_connection_.init(ip_addr, port);
   free(ip_addr);
 
+  if (!default_tcp_connection_.initRecording())
+    return false;
+
   return init(&default_tcp_connection_);
 }
 
@@ -116,6 +137,9 @@ bool RobotStateInterface::init(SmplMsgConnection* connection, std::map<int, Robo
     ROS_ERROR("Failed to initialize message manager");
     return false;
   }
+  this->handlers_.clear();
+  if (!ping_handler_.init(connection_))
+    return false;
 
   // initialize default handlers
   if (!default_joint_handler_.init(connection_, robot_groups_))
@@ -161,6 +185,9 @@ bool RobotStateInterface::init(SmplMsgConnection* connection, std::vector<std::s
   // initialize message-manager
   if (!manager_.init(connection_))
     return false;
+  this->handlers_.clear();
+  if (!ping_handler_.init(connection_))
+    return false;
 
   // initialize default handlers
   if (!default_joint_handler_.init(connection_, joint_names_))
@@ -180,7 +207,158 @@ bool RobotStateInterface::init(SmplMsgConnection* connection, std::vector<std::s
 
 void RobotStateInterface::run()
 {
-  manager_.spin();
+  int publish_threads, queue_size;
+
+  ros::param::param<int>("~publish_threads", publish_threads, 1);
+  ros::param::param<int>("~receive_queue_size", queue_size, 64);
+
+  if (publish_threads <= 0)
+  {
+    manager_.spin();
+    return;
+  }
+
+  queue_size = std::max(queue_size, 1);
+  ROS_INFO("Publishing robot state on %d thread(s), queueing up to %d frames each", publish_threads, queue_size);
+
+  // spread the message types over the publish threads
+  this->stages_.clear();
+  this->routes_.clear();
+  for (int i = 0; i < publish_threads; ++i)
+    this->stages_.push_back(boost::shared_ptr<PublishStage>(new PublishStage(queue_size)));
+
+  size_t next_stage = 0;
+  for (std::map<int, MessageHandler*>::const_iterator it = handlers_.begin(); it != handlers_.end(); ++it)
+  {
+    this->routes_[it->first] = this->stages_[next_stage].get();
+    next_stage = (next_stage + 1) % this->stages_.size();
+  }
+
+  this->publishing_ = true;
+  for (size_t i = 0; i < this->stages_.size(); ++i)
+    this->stages_[i]->thread = boost::thread(&RobotStateInterface::publishFrames, this, this->stages_[i].get(), i);
+
+  receiveFrames();
+
+  this->publishing_ = false;
+  for (size_t i = 0; i < this->stages_.size(); ++i)
+  {
+    PublishStage* stage = this->stages_[i].get();
+    {
+      boost::lock_guard<boost::mutex> lock(stage->mutex);
+    }
+    stage->cond.notify_one();
+    stage->thread.join();
+  }
+}
+
+void RobotStateInterface::receiveFrames()
+{
+  StateFrame scratch;
+  unsigned int dropped = 0;
+
+  while (ros::ok())
+  {
+    if (!connection_->isConnected() && !connection_->makeConnect())
+    {
+      ros::WallDuration(RECONNECT_DELAY).sleep();
+      continue;
+    }
+
+    // with a single publish stage, receive straight into its ring
+    StateFrame* frame = (this->stages_.size() == 1) ? this->stages_[0]->ring.claim() : NULL;
+    if (!frame)
+      frame = &scratch;
+
+    if (!connection_->receiveMsg(frame->msg))
+      continue;
+    frame->received = ros::WallTime::now();
+
+    int msg_type = frame->msg.getMessageType();
+    std::map<int, PublishStage*>::const_iterator route = this->routes_.find(msg_type);
+    if (route == this->routes_.end())
+    {
+      handleUnrouted(frame->msg);
+      continue;
+    }
+    PublishStage* stage = route->second;
+
+    if (frame == &scratch)
+    {
+      frame = stage->ring.claim();
+      if (!frame)
+      {
+        stage->dropped++;
+        ROS_WARN_THROTTLE(STATS_PERIOD, "Robot state publishing falls behind, %u frames dropped", ++dropped);
+        continue;
+      }
+      *frame = scratch;
+    }
+    frame->handler = this->handlers_[msg_type];
+    stage->ring.commit();
+
+    size_t depth = stage->ring.size();
+    if (depth > stage->max_depth)
+      stage->max_depth = depth;
+
+    {
+      boost::lock_guard<boost::mutex> lock(stage->mutex);
+    }
+    stage->cond.notify_one();
+  }
+}
+
+void RobotStateInterface::handleUnrouted(SimpleMessage &msg)
+{
+  if (msg.getMessageType() == StandardMsgTypes::PING)
+  {
+    ping_handler_.callback(msg);
+    return;
+  }
+
+  if (msg.getCommType() == CommTypes::SERVICE_REQUEST)
+  {
+    SimpleMessage reply;
+    reply.init(msg.getMessageType(), CommTypes::SERVICE_REPLY, ReplyTypes::FAILURE);
+    connection_->sendMsg(reply);
+  }
+  ROS_WARN_THROTTLE(STATS_PERIOD, "Unhandled robot state message type: %d", msg.getMessageType());
+}
+
+void RobotStateInterface::publishFrames(PublishStage* stage, size_t idx)
+{
+  ros::WallTime next_stats = ros::WallTime::now() + ros::WallDuration(STATS_PERIOD);
+
+  while (this->publishing_)
+  {
+    StateFrame* frame = stage->ring.front();
+    if (!frame)
+    {
+      boost::unique_lock<boost::mutex> lock(stage->mutex);
+      if (this->publishing_ && !stage->ring.front())
+        stage->cond.timed_wait(lock, boost::posix_time::milliseconds(100));
+      continue;
+    }
+
+    ros::WallTime dequeued = ros::WallTime::now();
+    stage->queue_latency.record(toDuration(dequeued - frame->received));
+    frame->handler->callback(frame->msg);
+    ros::WallTime published = ros::WallTime::now();
+    stage->publish_latency.record(toDuration(published - dequeued));
+    stage->ring.release();
+
+    if (published >= next_stats)
+    {
+      ROS_DEBUG_STREAM("Robot state publish thread " << idx << ": depth " << stage->ring.size()
+                       << "/" << stage->ring.capacity() << " (max " << stage->max_depth.exchange(0)
+                       << "), " << stage->dropped.load() << " dropped, queue latency: "
+                       << stage->queue_latency.toString() << ", publish latency: "
+                       << stage->publish_latency.toString());
+      stage->queue_latency.reset();
+      stage->publish_latency.reset();
+      next_stats = published + ros::WallDuration(STATS_PERIOD);
+    }
+  }
 }
 
 }  // namespace robot_state_interface
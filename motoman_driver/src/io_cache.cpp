@@ -0,0 +1,299 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/io_cache.h"
+#include "motoman_driver/simple_message/motoman_read_io_multi_reply.h"
+#include <algorithm>
+#include <vector>
+
+namespace IoMultiReplyResultCodes = motoman::simple_message::io_ctrl_reply::IoMultiReplyResultCodes;
+namespace IoMultiSizes = motoman::simple_message::io_ctrl::IoMultiSizes;
+
+using industrial::shared_types::shared_int;
+
+namespace motoman
+{
+namespace io_cache
+{
+
+// MotoROS sends a keepalive every second (IO_SUBSCRIPTION_KEEPALIVE_PERIOD):
+// without any message for longer, the subscription is considered lost
+static const ros::WallDuration SUBSCRIPTION_TIMEOUT(2.5);
+
+void IoCache::init(double max_age)
+{
+  boost::mutex::scoped_lock lock(this->mutex_);
+
+  this->max_age_ = ros::WallDuration(max_age > 0.0 ? max_age : 0.0);
+  this->entries_.clear();
+}
+
+IoCache::Key IoCache::makeKey(shared_int address, IoMultiSize size)
+{
+  // as the controller does
+  if (size == IoMultiSizes::MREGISTER && address < 1000000)
+    address += 1000000;
+  return Key(size, address);
+}
+
+bool IoCache::isFresh(const Entry &entry, const ros::WallTime &now) const
+{
+  if (!entry.valid)
+    return false;
+  // each message of the subscription confirms its values, which then age as read ones
+  if (entry.subscribed && now - this->subscription_stamp_ <= std::min(this->max_age_, SUBSCRIPTION_TIMEOUT))
+    return true;
+  return now - entry.stamp <= this->max_age_;
+}
+
+void IoCache::store(const Key &key, shared_int value, const ros::WallTime &now)
+{
+  Entry &entry = this->entries_[key];
+
+  entry.value = value;
+  entry.stamp = now;
+  entry.valid = true;
+  entry.generation++;
+}
+
+void IoCache::invalidateOverlapping(const Key &key)
+{
+  std::vector<Key> overlapping;
+
+  // an IO point is a bit of its group IO (address: group address * 10 + bit)
+  if (key.first == IoMultiSizes::BIT && key.second % 10 < 8)
+    overlapping.push_back(Key(IoMultiSizes::GROUP, key.second / 10));
+  else if (key.first == IoMultiSizes::GROUP)
+  {
+    for (shared_int bit = 0; bit < 8; ++bit)
+      overlapping.push_back(Key(IoMultiSizes::BIT, key.second * 10 + bit));
+  }
+
+  for (size_t i = 0; i < overlapping.size(); ++i)
+  {
+    std::map<Key, Entry>::iterator it = this->entries_.find(overlapping[i]);
+    if (it != this->entries_.end())
+    {
+      it->second.valid = false;
+      it->second.generation++;
+    }
+  }
+}
+
+bool IoCache::read(const std::vector<shared_int> &addresses, const std::vector<IoMultiSize> &sizes,
+                   std::vector<shared_int> &values, std::vector<unsigned int> &tickets)
+{
+  if (!isEnabled())
+    return false;
+
+  boost::mutex::scoped_lock lock(this->mutex_);
+  ros::WallTime now = ros::WallTime::now();
+  std::vector<Entry*> entries(addresses.size());
+  bool all_fresh = true;
+
+  values.resize(addresses.size());
+  tickets.resize(addresses.size());
+  for (size_t i = 0; i < addresses.size(); ++i)
+  {
+    entries[i] = &this->entries_[makeKey(addresses[i], sizes[i])];
+    tickets[i] = entries[i]->generation;
+    values[i] = entries[i]->value;
+    all_fresh = all_fresh && isFresh(*entries[i], now);
+  }
+
+  // the elements that were fresh are read from the controller all the same
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    if (all_fresh)
+      entries[i]->hits++;
+    else
+      entries[i]->misses++;
+  }
+  return all_fresh;
+}
+
+bool IoCache::read(shared_int address, IoMultiSize size, shared_int &value, unsigned int &ticket)
+{
+  std::vector<shared_int> values;
+  std::vector<unsigned int> tickets;
+
+  bool fresh = read(std::vector<shared_int>(1, address), std::vector<IoMultiSize>(1, size), values, tickets);
+  if (!tickets.empty())
+  {
+    value = values[0];
+    ticket = tickets[0];
+  }
+  return fresh;
+}
+
+void IoCache::fill(const std::vector<shared_int> &addresses, const std::vector<IoMultiSize> &sizes,
+                   const std::vector<shared_int> &values, const std::vector<shared_int> &result_codes,
+                   const std::vector<unsigned int> &tickets)
+{
+  if (!isEnabled())
+    return;
+
+  boost::mutex::scoped_lock lock(this->mutex_);
+  ros::WallTime now = ros::WallTime::now();
+
+  for (size_t i = 0; i < addresses.size() && i < values.size() && i < tickets.size(); ++i)
+  {
+    if (result_codes[i] != IoMultiReplyResultCodes::SUCCESS)
+      continue;
+
+    Entry &entry = this->entries_[makeKey(addresses[i], sizes[i])];
+    if (entry.generation != tickets[i])
+      continue;  // written or changed since the read was sent
+    entry.value = values[i];
+    entry.stamp = now;
+    entry.valid = true;
+  }
+}
+
+void IoCache::fill(shared_int address, IoMultiSize size, shared_int value, unsigned int ticket)
+{
+  fill(std::vector<shared_int>(1, address), std::vector<IoMultiSize>(1, size), std::vector<shared_int>(1, value),
+       std::vector<shared_int>(1, IoMultiReplyResultCodes::SUCCESS), std::vector<unsigned int>(1, ticket));
+}
+
+void IoCache::write(const std::vector<shared_int> &addresses, const std::vector<IoMultiSize> &sizes,
+                    const std::vector<shared_int> &values, const std::vector<shared_int> &result_codes)
+{
+  if (!isEnabled())
+    return;
+
+  boost::mutex::scoped_lock lock(this->mutex_);
+  ros::WallTime now = ros::WallTime::now();
+
+  for (size_t i = 0; i < addresses.size() && i < result_codes.size(); ++i)
+  {
+    Key key = makeKey(addresses[i], sizes[i]);
+
+    invalidateOverlapping(key);
+    if (result_codes[i] == IoMultiReplyResultCodes::SUCCESS)
+      store(key, values[i], now);
+    else
+    {
+      Entry &entry = this->entries_[key];
+      entry.valid = false;
+      entry.generation++;
+    }
+  }
+}
+
+void IoCache::write(shared_int address, IoMultiSize size, shared_int value, bool written)
+{
+  shared_int result_code = written ? IoMultiReplyResultCodes::SUCCESS : IoMultiReplyResultCodes::WRITE_API_ERROR;
+
+  write(std::vector<shared_int>(1, address), std::vector<IoMultiSize>(1, size), std::vector<shared_int>(1, value),
+        std::vector<shared_int>(1, result_code));
+}
+
+void IoCache::subscribe(const std::vector<shared_int> &addresses, const std::vector<IoMultiSize> &sizes,
+                        const std::vector<shared_int> &values, const std::vector<shared_int> &result_codes)
+{
+  if (!isEnabled())
+    return;
+
+  boost::mutex::scoped_lock lock(this->mutex_);
+  ros::WallTime now = ros::WallTime::now();
+
+  for (std::map<Key, Entry>::iterator it = this->entries_.begin(); it != this->entries_.end(); ++it)
+    it->second.subscribed = false;
+
+  for (size_t i = 0; i < addresses.size() && i < values.size(); ++i)
+  {
+    if (result_codes[i] != IoMultiReplyResultCodes::SUCCESS)
+      continue;
+
+    Key key = makeKey(addresses[i], sizes[i]);
+    store(key, values[i], now);
+    this->entries_[key].subscribed = true;
+  }
+  this->subscription_stamp_ = now;
+}
+
+void IoCache::change(const std::vector<shared_int> &addresses, const std::vector<IoMultiSize> &sizes,
+                     const std::vector<shared_int> &values)
+{
+  if (!isEnabled())
+    return;
+
+  boost::mutex::scoped_lock lock(this->mutex_);
+  ros::WallTime now = ros::WallTime::now();
+
+  // a group IO and its IO points may change together: invalidate before storing
+  for (size_t i = 0; i < addresses.size(); ++i)
+    invalidateOverlapping(makeKey(addresses[i], sizes[i]));
+  for (size_t i = 0; i < addresses.size() && i < values.size(); ++i)
+    store(makeKey(addresses[i], sizes[i]), values[i], now);
+  this->subscription_stamp_ = now;
+}
+
+void IoCache::unsubscribe()
+{
+  boost::mutex::scoped_lock lock(this->mutex_);
+
+  for (std::map<Key, Entry>::iterator it = this->entries_.begin(); it != this->entries_.end(); ++it)
+  {
+    Entry &entry = it->second;
+    if (!entry.subscribed)
+      continue;
+
+    // confirmed by the last message
+    entry.subscribed = false;
+    if (entry.stamp < this->subscription_stamp_)
+      entry.stamp = this->subscription_stamp_;
+  }
+}
+
+void IoCache::getStats(std::vector<shared_int> &addresses, std::vector<IoMultiSize> &sizes,
+                       std::vector<unsigned int> &hits, std::vector<unsigned int> &misses)
+{
+  boost::mutex::scoped_lock lock(this->mutex_);
+
+  addresses.clear();
+  sizes.clear();
+  hits.clear();
+  misses.clear();
+  for (std::map<Key, Entry>::const_iterator it = this->entries_.begin(); it != this->entries_.end(); ++it)
+  {
+    if (it->second.hits == 0 && it->second.misses == 0)
+      continue;
+    addresses.push_back(it->first.second);
+    sizes.push_back(it->first.first);
+    hits.push_back(it->second.hits);
+    misses.push_back(it->second.misses);
+  }
+}
+
+}  // namespace io_cache
+}  // namespace motoman
@@ -44,9 +44,18 @@
 #include "motoman_driver/simple_message/messages/motoman_write_single_io_reply_message.h"
 #include "motoman_driver/simple_message/messages/motoman_write_group_io_message.h"
 #include "motoman_driver/simple_message/messages/motoman_write_group_io_reply_message.h"
+#include "motoman_driver/simple_message/messages/motoman_read_io_multi_message.h"
+#include "motoman_driver/simple_message/messages/motoman_read_io_multi_reply_message.h"
+#include "motoman_driver/simple_message/messages/motoman_write_io_multi_message.h"
+#include "motoman_driver/simple_message/messages/motoman_write_io_multi_reply_message.h"
+#include "motoman_driver/simple_message/messages/motoman_io_subscribe_message.h"
+#include "motoman_driver/simple_message/messages/motoman_io_changed_message.h"
 #include "ros/ros.h"
 #include "simple_message/simple_message.h"
+#include <algorithm>
+#include <sstream>
 #include <string>
+#include <vector>
 
 
 namespace ReadMRegisterReplyResultCodes = motoman::simple_message::io_ctrl_reply::ReadMRegisterReplyResultCodes;
@@ -55,6 +64,9 @@ namespace ReadGroupIOReplyResultCodes = motoman::simple_message::io_ctrl_reply::
 namespace WriteMRegisterReplyResultCodes = motoman::simple_message::io_ctrl_reply::WriteMRegisterReplyResultCodes;
 namespace WriteSingleIOReplyResultCodes = motoman::simple_message::io_ctrl_reply::WriteSingleIOReplyResultCodes;
 namespace WriteGroupIOReplyResultCodes = motoman::simple_message::io_ctrl_reply::WriteGroupIOReplyResultCodes;
+namespace IoMultiReplyResultCodes = motoman::simple_message::io_ctrl_reply::IoMultiReplyResultCodes;
+namespace IoMultiSizes = motoman::simple_message::io_ctrl::IoMultiSizes;
+namespace MotomanMsgTypes = motoman::simple_message::MotomanMsgTypes;
 
 using motoman::simple_message::io_ctrl::ReadMRegister;
 using motoman::simple_message::io_ctrl_message::ReadMRegisterMessage;
@@ -74,6 +86,12 @@ using motoman::simple_message::io_ctrl_reply_message::WriteSingleIOReplyMessage;
 using motoman::simple_message::io_ctrl::WriteGroupIO;
 using motoman::simple_message::io_ctrl_message::WriteGroupIOMessage;
 using motoman::simple_message::io_ctrl_reply_message::WriteGroupIOReplyMessage;
+using motoman::simple_message::io_ctrl_message::ReadIOMultiMessage;
+using motoman::simple_message::io_ctrl_reply_message::ReadIOMultiReplyMessage;
+using motoman::simple_message::io_ctrl_message::WriteIOMultiMessage;
+using motoman::simple_message::io_ctrl_reply_message::WriteIOMultiReplyMessage;
+using motoman::simple_message::io_ctrl_message::IoSubscribeMessage;
+using motoman::simple_message::io_ctrl_reply_message::IoChangedMessage;
 using industrial::simple_message::SimpleMessage;
 using industrial::shared_types::shared_int;
 
@@ -83,9 +101,31 @@ namespace motoman
 namespace io_ctrl
 {
 
+namespace
+{
+// Describes the first element that failed, returns true if none did
+bool allSucceeded(const std::vector<shared_int> &addresses, const std::vector<shared_int> &result_codes,
+                  std::string &err_msg)
+{
+  for (size_t i = 0; i < result_codes.size(); ++i)
+  {
+    if (result_codes[i] != IoMultiReplyResultCodes::SUCCESS)
+    {
+      std::stringstream message;
+      message << "element " << i << " (address: " << addresses[i] << "): "
+              << ReadIOMultiReply::getResultString(result_codes[i]);
+      err_msg = message.str();
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
 bool MotomanIoCtrl::init(SmplMsgConnection* connection)
 {
   connection_ = connection;
+  multi_supported_ = true;
   return true;
 }
 
@@ -347,6 +387,366 @@ bool MotomanIoCtrl::sendAndReceive(shared_int address, shared_int value, WriteGr
   return true;
 }
 
+bool MotomanIoCtrl::readIOMulti(const std::vector<shared_int> &addresses, const std::vector<IoMultiSize> &sizes,
+                                std::vector<shared_int> &values, std::vector<shared_int> &result_codes,
+                                std::string &err_msg)
+{
+  if (addresses.size() != sizes.size())
+  {
+    ROS_ERROR("READ_IO_MULTI: %zu addresses but %zu sizes", addresses.size(), sizes.size());
+    return false;
+  }
+
+  values.assign(addresses.size(), 0);
+  result_codes.assign(addresses.size(), IoMultiReplyResultCodes::SUCCESS);
+
+  for (size_t first = 0; first < addresses.size(); first += ReadIOMulti::MAX_ELEMENTS)
+  {
+    size_t last = std::min(addresses.size(), first + ReadIOMulti::MAX_ELEMENTS);
+
+    if (this->multi_supported_)
+    {
+      ReadIOMulti cmd;
+      ReadIOMultiReply reply;
+
+      for (size_t i = first; i < last; ++i)
+        cmd.addElement(addresses[i], sizes[i]);
+
+      if (!sendAndReceive(cmd, reply, this->multi_supported_))
+      {
+        ROS_ERROR("Failed to send READ_IO_MULTI command");
+        return false;
+      }
+
+      if (this->multi_supported_)
+      {
+        if (reply.getNumElements() != static_cast<shared_int>(last - first))
+        {
+          ROS_ERROR("READ_IO_MULTI reply has %d elements, %zu were requested", reply.getNumElements(), last - first);
+          return false;
+        }
+        for (size_t i = first; i < last; ++i)
+        {
+          values[i] = reply.getValue(i - first);
+          result_codes[i] = reply.getElementResultCode(i - first);
+        }
+        continue;
+      }
+      ROS_WARN("Controller does not support multi-element I/O messages, accessing I/O one element at a time");
+    }
+
+    for (size_t i = first; i < last; ++i)
+    {
+      if (!readElement(addresses[i], sizes[i], values[i], result_codes[i]))
+      {
+        ROS_ERROR("Failed to send read command for element %zu", i);
+        return false;
+      }
+    }
+  }
+
+  return allSucceeded(addresses, result_codes, err_msg);
+}
+
+bool MotomanIoCtrl::writeIOMulti(const std::vector<shared_int> &addresses, const std::vector<IoMultiSize> &sizes,
+                                 const std::vector<shared_int> &values, std::vector<shared_int> &result_codes,
+                                 std::string &err_msg)
+{
+  if (addresses.size() != sizes.size() || addresses.size() != values.size())
+  {
+    ROS_ERROR("WRITE_IO_MULTI: %zu addresses but %zu sizes and %zu values",
+              addresses.size(), sizes.size(), values.size());
+    return false;
+  }
+
+  result_codes.assign(addresses.size(), IoMultiReplyResultCodes::SUCCESS);
+
+  for (size_t first = 0; first < addresses.size(); first += WriteIOMulti::MAX_ELEMENTS)
+  {
+    size_t last = std::min(addresses.size(), first + WriteIOMulti::MAX_ELEMENTS);
+
+    if (this->multi_supported_)
+    {
+      WriteIOMulti cmd;
+      WriteIOMultiReply reply;
+
+      for (size_t i = first; i < last; ++i)
+        cmd.addElement(addresses[i], sizes[i], values[i]);
+
+      if (!sendAndReceive(cmd, reply, this->multi_supported_))
+      {
+        ROS_ERROR("Failed to send WRITE_IO_MULTI command");
+        return false;
+      }
+
+      if (this->multi_supported_)
+      {
+        if (reply.getNumElements() != static_cast<shared_int>(last - first))
+        {
+          ROS_ERROR("WRITE_IO_MULTI reply has %d elements, %zu were requested", reply.getNumElements(), last - first);
+          return false;
+        }
+        for (size_t i = first; i < last; ++i)
+          result_codes[i] = reply.getElementResultCode(i - first);
+        continue;
+      }
+      ROS_WARN("Controller does not support multi-element I/O messages, accessing I/O one element at a time");
+    }
+
+    for (size_t i = first; i < last; ++i)
+    {
+      if (!writeElement(addresses[i], sizes[i], values[i], result_codes[i]))
+      {
+        ROS_ERROR("Failed to send write command for element %zu", i);
+        return false;
+      }
+    }
+  }
+
+  return allSucceeded(addresses, result_codes, err_msg);
+}
+
+bool MotomanIoCtrl::subscribe(const std::vector<shared_int> &addresses, const std::vector<IoMultiSize> &sizes,
+                              shared_int period_ms, std::string &err_msg)
+{
+  if (addresses.size() != sizes.size())
+  {
+    ROS_ERROR("IO_SUBSCRIBE: %zu addresses but %zu sizes", addresses.size(), sizes.size());
+    return false;
+  }
+  if (addresses.size() > static_cast<size_t>(IoSubscribe::MAX_ELEMENTS))
+  {
+    std::stringstream message;
+    message << "at most " << IoSubscribe::MAX_ELEMENTS << " elements can be subscribed to, "
+            << addresses.size() << " were requested";
+    err_msg = message.str();
+    return false;
+  }
+
+  SimpleMessage req;
+  IoSubscribe cmd;
+  IoSubscribeMessage io_subscribe_msg;
+
+  for (size_t i = 0; i < addresses.size(); ++i)
+    cmd.addElement(addresses[i], sizes[i]);
+  cmd.setPeriod(period_ms);
+  io_subscribe_msg.init(cmd);
+  io_subscribe_msg.toRequest(req);
+
+  if (!this->connection_->sendMsg(req))
+  {
+    err_msg = "Failed to send IoSubscribe message";
+    return false;
+  }
+  return true;
+}
+
+bool MotomanIoCtrl::receiveUpdate(IoUpdate &update, std::string &err_msg)
+{
+  SimpleMessage res;
+
+  if (!this->connection_->receiveMsg(res))
+  {
+    err_msg = "Failed to receive IO subscription message";
+    return false;
+  }
+
+  switch (res.getMessageType())
+  {
+  case MotomanMsgTypes::MOTOMAN_IO_CHANGED:
+  {
+    IoChangedMessage io_changed_msg;
+
+    if (!io_changed_msg.init(res))
+    {
+      err_msg = "Failed to unload IoChanged message";
+      return false;
+    }
+    update.type = IoUpdate::CHANGED;
+    update.time = io_changed_msg.data_.getTime();
+    update.addresses.resize(io_changed_msg.data_.getNumElements());
+    update.sizes.resize(update.addresses.size());
+    update.values.resize(update.addresses.size());
+    update.result_codes.clear();
+    for (size_t i = 0; i < update.addresses.size(); ++i)
+    {
+      update.addresses[i] = io_changed_msg.data_.getAddress(i);
+      update.sizes[i] = static_cast<IoMultiSize>(io_changed_msg.data_.getSize(i));
+      update.values[i] = io_changed_msg.data_.getValue(i);
+    }
+    return true;
+  }
+
+  case MotomanMsgTypes::MOTOMAN_IO_SUBSCRIBE_REPLY:
+  {
+    // same layout as a READ_IO_MULTI reply
+    ReadIOMultiReplyMessage io_subscribe_reply;
+
+    if (!io_subscribe_reply.init(res))
+    {
+      err_msg = "Failed to unload IoSubscribe reply message";
+      return false;
+    }
+    update.type = IoUpdate::SUBSCRIBED;
+    update.time = 0;
+    update.addresses.clear();
+    update.sizes.clear();
+    update.values.resize(io_subscribe_reply.reply_.getNumElements());
+    update.result_codes.resize(update.values.size());
+    for (size_t i = 0; i < update.values.size(); ++i)
+    {
+      update.values[i] = io_subscribe_reply.reply_.getValue(i);
+      update.result_codes[i] = io_subscribe_reply.reply_.getElementResultCode(i);
+    }
+    return true;
+  }
+
+  default:
+    // MotoROS versions without subscriptions reject them with a MOTION_REPLY
+    update.type = IoUpdate::REJECTED;
+    update.time = 0;
+    update.addresses.clear();
+    update.sizes.clear();
+    update.values.clear();
+    update.result_codes.clear();
+    return true;
+  }
+}
+
+bool MotomanIoCtrl::sendAndReceive(ReadIOMulti &cmd, ReadIOMultiReply &reply, bool &supported)
+{
+  SimpleMessage req, res;
+  ReadIOMultiMessage read_io_multi_msg;
+  ReadIOMultiReplyMessage read_io_multi_reply;
+
+  read_io_multi_msg.init(cmd);
+  read_io_multi_msg.toRequest(req);
+
+  if (!this->connection_->sendAndReceiveMsg(req, res))
+  {
+    ROS_ERROR("Failed to send ReadIOMulti message");
+    return false;
+  }
+
+  // MotoROS versions without multi-element messages reject them with a MOTION_REPLY
+  supported = (res.getMessageType() == MotomanMsgTypes::MOTOMAN_READ_IO_MULTI_REPLY);
+  if (!supported)
+    return true;
+
+  if (!read_io_multi_reply.init(res))
+  {
+    ROS_ERROR("Failed to unload ReadIOMultiReply message");
+    return false;
+  }
+  reply.copyFrom(read_io_multi_reply.reply_);
+
+  return true;
+}
+
+bool MotomanIoCtrl::sendAndReceive(WriteIOMulti &cmd, WriteIOMultiReply &reply, bool &supported)
+{
+  SimpleMessage req, res;
+  WriteIOMultiMessage write_io_multi_msg;
+  WriteIOMultiReplyMessage write_io_multi_reply;
+
+  write_io_multi_msg.init(cmd);
+  write_io_multi_msg.toRequest(req);
+
+  if (!this->connection_->sendAndReceiveMsg(req, res))
+  {
+    ROS_ERROR("Failed to send WriteIOMulti message");
+    return false;
+  }
+
+  // MotoROS versions without multi-element messages reject them with a MOTION_REPLY
+  supported = (res.getMessageType() == MotomanMsgTypes::MOTOMAN_WRITE_IO_MULTI_REPLY);
+  if (!supported)
+    return true;
+
+  if (!write_io_multi_reply.init(res))
+  {
+    ROS_ERROR("Failed to unload WriteIOMultiReply message");
+    return false;
+  }
+  reply.copyFrom(write_io_multi_reply.reply_);
+
+  return true;
+}
+
+bool MotomanIoCtrl::readElement(shared_int address, IoMultiSize size, shared_int &value, shared_int &result_code)
+{
+  switch (size)
+  {
+  case IoMultiSizes::BIT:
+  {
+    ReadSingleIOReply reply;
+    if (!sendAndReceive(address, reply))
+      return false;
+    value = reply.getValue();
+    result_code = reply.getResultCode();
+    return true;
+  }
+  case IoMultiSizes::GROUP:
+  {
+    ReadGroupIOReply reply;
+    if (!sendAndReceive(address, reply))
+      return false;
+    value = reply.getValue();
+    result_code = reply.getResultCode();
+    return true;
+  }
+  case IoMultiSizes::MREGISTER:
+  {
+    ReadMRegisterReply reply;
+    if (!sendAndReceive(address, reply))
+      return false;
+    value = reply.getValue();
+    result_code = reply.getResultCode();
+    return true;
+  }
+  default:
+    // as the controller does
+    value = 0;
+    result_code = IoMultiReplyResultCodes::READ_ADDRESS_INVALID;
+    return true;
+  }
+}
+
+bool MotomanIoCtrl::writeElement(shared_int address, IoMultiSize size, shared_int value, shared_int &result_code)
+{
+  switch (size)
+  {
+  case IoMultiSizes::BIT:
+  {
+    WriteSingleIOReply reply;
+    if (!sendAndReceive(address, value, reply))
+      return false;
+    result_code = reply.getResultCode();
+    return true;
+  }
+  case IoMultiSizes::GROUP:
+  {
+    WriteGroupIOReply reply;
+    if (!sendAndReceive(address, value, reply))
+      return false;
+    result_code = reply.getResultCode();
+    return true;
+  }
+  case IoMultiSizes::MREGISTER:
+  {
+    WriteMRegisterReply reply;
+    if (!sendAndReceive(address, value, reply))
+      return false;
+    result_code = reply.getResultCode();
+    return true;
+  }
+  default:
+    // as the controller does
+    result_code = IoMultiReplyResultCodes::WRITE_ADDRESS_INVALID;
+    return true;
+  }
+}
+
 }  // namespace io_ctrl
 
 }  // namespace motoman
@@ -35,8 +35,10 @@
 #include <string>
 #include <cstdint>
 #include <limits>
+#include <algorithm>
 #include <ros/ros.h>
 #include <sstream>
+#include <vector>
 
 namespace motoman
 {
@@ -44,6 +46,13 @@ namespace io_relay
 {
 
 using industrial::shared_types::shared_int;
+using motoman::simple_message::io_ctrl::IoMultiSize;
+using motoman::simple_message::io_ctrl::IoSubscribe;
+namespace IoMultiReplyResultCodes = motoman::simple_message::io_ctrl_reply::IoMultiReplyResultCodes;
+namespace IoMultiSizes = motoman::simple_message::io_ctrl::IoMultiSizes;
+
+// how long subscribe_io waits for the controller to reply
+static const int SUBSCRIBE_TIMEOUT = 5;  // seconds
 
 bool MotomanIORelay::init(int default_port)
 {
@@ -73,22 +82,73 @@ bool MotomanIORelay::init(int default_port)
     return false;
   }
 
+  int connections;
+  ros::param::param<int>("~io_connections", connections, 1);
+  if (connections < 1 || connections > MAX_IO_CONNECTIONS - 1)
+  {
+    // the controller closes its oldest connection to accept one more
+    ROS_FATAL_STREAM_NAMED("io.init", "Invalid value for io_connections (" << connections << "), "
+      "must be between 1 and " << MAX_IO_CONNECTIONS - 1 << ".");
+    return false;
+  }
+
+  double cache_max_age;
+  ros::param::param<double>("~io_cache_max_age", cache_max_age, 0.0);
+  this->cache_.init(cache_max_age);
+  if (this->cache_.isEnabled())
+    ROS_INFO_STREAM_NAMED("io.init", "Answering repeated reads from values up to " << cache_max_age << " s old");
+
   char* ip_addr = strdup(ip.c_str());  // connection.init() requires "char*", not "const char*"
-  if (!default_tcp_connection_.init(ip_addr, port))
+  stream_tcp_connection_.reset(new RecordingTcpClient());
+  if (!stream_tcp_connection_->init(ip_addr, port))
   {
     ROS_FATAL_NAMED("io.init", "Failed to initialize TcpClient");
     return false;
   }
-  free(ip_addr);
 
-  ROS_DEBUG_STREAM_NAMED("io.init", "I/O relay attempting to connect to: tcp://" << ip << ":" << port);
-  if (!default_tcp_connection_.makeConnect())
+  ROS_DEBUG_STREAM_NAMED("io.init", "I/O relay attempting to connect to: tcp://" << ip << ":" << port
+    << " (" << connections << " connection(s))");
+  for (int i = 0; i < connections; ++i)
   {
-    ROS_FATAL_NAMED("io.init", "Failed to connect");
-    return false;
+    boost::shared_ptr<IoConnection> connection(new IoConnection());
+
+    if (!connection->tcp.init(ip_addr, port))
+    {
+      ROS_FATAL_NAMED("io.init", "Failed to initialize TcpClient");
+      return false;
+    }
+
+    // all the connections are recorded together
+    if (this->connections_.empty())
+    {
+      if (!connection->tcp.initRecording())
+      {
+        ROS_FATAL_NAMED("io.init", "Failed to start recording");
+        return false;
+      }
+    }
+    else
+      connection->tcp.shareRecording(this->connections_.front()->tcp);
+
+    if (!connection->tcp.makeConnect())
+    {
+      ROS_FATAL_NAMED("io.init", "Failed to connect");
+      return false;
+    }
+
+    if (!connection->io.init(&connection->tcp))
+    {
+      ROS_FATAL_NAMED("io.init", "Failed to initialize MotomanIoCtrl");
+      return false;
+    }
+
+    this->connections_.push_back(connection);
+    this->idle_.push_back(&connection->io);
   }
+  free(ip_addr);
+  stream_tcp_connection_->shareRecording(this->connections_.front()->tcp);
 
-  if (!io_ctrl_.init(&default_tcp_connection_))
+  if (!io_stream_.init(stream_tcp_connection_.get()))
   {
     ROS_FATAL_NAMED("io.init", "Failed to initialize MotomanIoCtrl");
     return false;
@@ -106,10 +166,39 @@ bool MotomanIORelay::init(int default_port)
       &MotomanIORelay::writeSingleIoCB, this);
   this->srv_write_group_io = this->node_.advertiseService("write_group_io",
       &MotomanIORelay::writeGroupIoCB, this);
+  this->srv_read_io_multi = this->node_.advertiseService("read_io_multi",
+      &MotomanIORelay::readIoMultiCB, this);
+  this->srv_write_io_multi = this->node_.advertiseService("write_io_multi",
+      &MotomanIORelay::writeIoMultiCB, this);
+  this->srv_subscribe_io = this->node_.advertiseService("subscribe_io",
+      &MotomanIORelay::subscribeIoCB, this);
+  this->srv_io_cache_stats = this->node_.advertiseService("io_cache_stats",
+      &MotomanIORelay::ioCacheStatsCB, this);
+  this->pub_io_changes_ = this->node_.advertise<motoman_msgs::IOChanges>("io_changes", 100);
 
   return true;
 }
 
+io_ctrl::MotomanIoCtrl* MotomanIORelay::acquireConnection()
+{
+  boost::mutex::scoped_lock lock(this->mutex_);
+
+  while (this->idle_.empty())
+    this->connection_idle_.wait(lock);
+
+  io_ctrl::MotomanIoCtrl* connection = this->idle_.back();
+  this->idle_.pop_back();
+  return connection;
+}
+
+void MotomanIORelay::releaseConnection(io_ctrl::MotomanIoCtrl* connection)
+{
+  boost::mutex::scoped_lock lock(this->mutex_);
+
+  this->idle_.push_back(connection);
+  this->connection_idle_.notify_one();
+}
+
 // Service to read an M register
 bool MotomanIORelay::readMRegisterCB(
   motoman_msgs::ReadMRegister::Request &req,
@@ -117,11 +206,19 @@ bool MotomanIORelay::readMRegisterCB(
 {
   shared_int io_val = -1;
   std::string err_msg;
+  unsigned int ticket;
 
-  // send message and release mutex as soon as possible
-  this->mutex_.lock();
-  bool result = io_ctrl_.readMRegister(req.address, io_val, err_msg);
-  this->mutex_.unlock();
+  if (this->cache_.read(req.address, IoMultiSizes::MREGISTER, io_val, ticket))
+  {
+    res.value = io_val;
+    res.success = true;
+    return true;
+  }
+
+  // send message on an idle connection and release it as soon as possible
+  io_ctrl::MotomanIoCtrl* connection = acquireConnection();
+  bool result = connection->readMRegister(req.address, io_val, err_msg);
+  releaseConnection(connection);
 
   if (!result)
   {
@@ -138,6 +235,7 @@ bool MotomanIORelay::readMRegisterCB(
   }
 
   ROS_DEBUG_STREAM_NAMED("io.read", "Address " << req.address << ", value: " << io_val);
+  this->cache_.fill(req.address, IoMultiSizes::MREGISTER, io_val, ticket);
 
   // no failure, so no need for an additional message
   res.value = io_val;
@@ -152,11 +250,19 @@ bool MotomanIORelay::readSingleIoCB(
 {
   shared_int io_val = -1;
   std::string err_msg;
+  unsigned int ticket;
 
-  // send message and release mutex as soon as possible
-  this->mutex_.lock();
-  bool result = io_ctrl_.readSingleIO(req.address, io_val, err_msg);
-  this->mutex_.unlock();
+  if (this->cache_.read(req.address, IoMultiSizes::BIT, io_val, ticket))
+  {
+    res.value = io_val;
+    res.success = true;
+    return true;
+  }
+
+  // send message on an idle connection and release it as soon as possible
+  io_ctrl::MotomanIoCtrl* connection = acquireConnection();
+  bool result = connection->readSingleIO(req.address, io_val, err_msg);
+  releaseConnection(connection);
 
   if (!result)
   {
@@ -173,6 +279,7 @@ bool MotomanIORelay::readSingleIoCB(
   }
 
   ROS_DEBUG_STREAM_NAMED("io.read", "Address " << req.address << ", value: " << io_val);
+  this->cache_.fill(req.address, IoMultiSizes::BIT, io_val, ticket);
 
   // no failure, so no need for an additional message
   res.value = io_val;
@@ -187,11 +294,19 @@ bool MotomanIORelay::readGroupIoCB(
 {
   shared_int io_val = -1;
   std::string err_msg;
+  unsigned int ticket;
+
+  if (this->cache_.read(req.address, IoMultiSizes::GROUP, io_val, ticket))
+  {
+    res.value = io_val;
+    res.success = true;
+    return true;
+  }
 
-  // send message and release mutex as soon as possible
-  this->mutex_.lock();
-  bool result = io_ctrl_.readGroupIO(req.address, io_val, err_msg);
-  this->mutex_.unlock();
+  // send message on an idle connection and release it as soon as possible
+  io_ctrl::MotomanIoCtrl* connection = acquireConnection();
+  bool result = connection->readGroupIO(req.address, io_val, err_msg);
+  releaseConnection(connection);
 
   if (!result)
   {
@@ -208,6 +323,7 @@ bool MotomanIORelay::readGroupIoCB(
   }
 
   ROS_DEBUG_STREAM_NAMED("io.read", "Address " << req.address << ", value: " << io_val);
+  this->cache_.fill(req.address, IoMultiSizes::GROUP, io_val, ticket);
 
   // no failure, so no need for an additional message
   res.value = io_val;
@@ -222,10 +338,11 @@ bool MotomanIORelay::writeMRegisterCB(
 {
   std::string err_msg;
 
-  // send message and release mutex as soon as possible
-  this->mutex_.lock();
-  bool result = io_ctrl_.writeMRegister(req.address, req.value, err_msg);
-  this->mutex_.unlock();
+  // send message on an idle connection and release it as soon as possible
+  io_ctrl::MotomanIoCtrl* connection = acquireConnection();
+  bool result = connection->writeMRegister(req.address, req.value, err_msg);
+  releaseConnection(connection);
+  this->cache_.write(req.address, IoMultiSizes::MREGISTER, req.value, result);
 
   if (!result)
   {
@@ -255,10 +372,11 @@ bool MotomanIORelay::writeSingleIoCB(
 {
   std::string err_msg;
 
-  // send message and release mutex as soon as possible
-  this->mutex_.lock();
-  bool result = io_ctrl_.writeSingleIO(req.address, req.value, err_msg);
-  this->mutex_.unlock();
+  // send message on an idle connection and release it as soon as possible
+  io_ctrl::MotomanIoCtrl* connection = acquireConnection();
+  bool result = connection->writeSingleIO(req.address, req.value, err_msg);
+  releaseConnection(connection);
+  this->cache_.write(req.address, IoMultiSizes::BIT, req.value, result);
 
   if (!result)
   {
@@ -288,10 +406,11 @@ bool MotomanIORelay::writeGroupIoCB(
 {
   std::string err_msg;
 
-  // send message and release mutex as soon as possible
-  this->mutex_.lock();
-  bool result = io_ctrl_.writeGroupIO(req.address, req.value, err_msg);
-  this->mutex_.unlock();
+  // send message on an idle connection and release it as soon as possible
+  io_ctrl::MotomanIoCtrl* connection = acquireConnection();
+  bool result = connection->writeGroupIO(req.address, req.value, err_msg);
+  releaseConnection(connection);
+  this->cache_.write(req.address, IoMultiSizes::GROUP, req.value, result);
 
   if (!result)
   {
@@ -314,6 +433,364 @@ bool MotomanIORelay::writeGroupIoCB(
   return true;
 }
 
+// Service to read several IO elements at once
+bool MotomanIORelay::readIoMultiCB(
+  motoman_msgs::ReadIOMulti::Request &req,
+  motoman_msgs::ReadIOMulti::Response &res)
+{
+  std::vector<shared_int> addresses(req.addresses.begin(), req.addresses.end());
+  std::vector<IoMultiSize> sizes;
+  std::vector<shared_int> io_vals;
+  std::vector<shared_int> result_codes;
+  std::string err_msg;
+
+  if (req.sizes.size() != req.addresses.size())
+  {
+    res.success = false;
+    res.message = "Read failed: the number of sizes does not match the number of addresses";
+    ROS_ERROR_STREAM_NAMED("io.read", res.message);
+    return true;
+  }
+  for (size_t i = 0; i < req.sizes.size(); ++i)
+    sizes.push_back(static_cast<IoMultiSize>(req.sizes[i]));
+
+  // the request is sent whole if any element is not fresh: the round trip is what costs
+  std::vector<unsigned int> tickets;
+  if (this->cache_.read(addresses, sizes, io_vals, tickets))
+  {
+    res.values.assign(io_vals.begin(), io_vals.end());
+    res.result_codes.assign(io_vals.size(), IoMultiReplyResultCodes::SUCCESS);
+    res.success = true;
+    return true;
+  }
+
+  // send message on an idle connection and release it as soon as possible
+  io_ctrl::MotomanIoCtrl* connection = acquireConnection();
+  bool result = connection->readIOMulti(addresses, sizes, io_vals, result_codes, err_msg);
+  releaseConnection(connection);
+  this->cache_.fill(addresses, sizes, io_vals, result_codes, tickets);
+
+  res.values.assign(io_vals.begin(), io_vals.end());
+  res.result_codes.assign(result_codes.begin(), result_codes.end());
+
+  if (!result)
+  {
+    res.success = false;
+
+    // provide caller with failure indication
+    std::stringstream message;
+    message << "Multi read failed: " << err_msg;
+    res.message = message.str();
+    ROS_ERROR_STREAM_NAMED("io.read", res.message);
+
+    return true;
+  }
+
+  ROS_DEBUG_STREAM_NAMED("io.read", "Read " << addresses.size() << " elements");
+
+  // no failure, so no need for an additional message
+  res.success = true;
+  return true;
+}
+
+// Service to write several IO elements at once
+bool MotomanIORelay::writeIoMultiCB(
+  motoman_msgs::WriteIOMulti::Request &req,
+  motoman_msgs::WriteIOMulti::Response &res)
+{
+  std::vector<shared_int> addresses(req.addresses.begin(), req.addresses.end());
+  std::vector<IoMultiSize> sizes;
+  std::vector<shared_int> io_vals(req.values.begin(), req.values.end());
+  std::vector<shared_int> result_codes;
+  std::string err_msg;
+
+  if (req.sizes.size() != req.addresses.size() || req.values.size() != req.addresses.size())
+  {
+    res.success = false;
+    res.message = "Write failed: the number of sizes or values does not match the number of addresses";
+    ROS_ERROR_STREAM_NAMED("io.write", res.message);
+    return true;
+  }
+  for (size_t i = 0; i < req.sizes.size(); ++i)
+    sizes.push_back(static_cast<IoMultiSize>(req.sizes[i]));
+
+  // send message on an idle connection and release it as soon as possible
+  io_ctrl::MotomanIoCtrl* connection = acquireConnection();
+  bool result = connection->writeIOMulti(addresses, sizes, io_vals, result_codes, err_msg);
+  releaseConnection(connection);
+  this->cache_.write(addresses, sizes, io_vals, result_codes);
+
+  res.result_codes.assign(result_codes.begin(), result_codes.end());
+
+  if (!result)
+  {
+    res.success = false;
+
+    // provide caller with failure indication
+    std::stringstream message;
+    message << "Multi write failed: " << err_msg;
+    res.message = message.str();
+    ROS_ERROR_STREAM_NAMED("io.write", res.message);
+
+    return true;
+  }
+
+  ROS_DEBUG_STREAM_NAMED("io.write", "Wrote " << addresses.size() << " elements");
+
+  // no failure, so no need for an additional message
+  res.success = true;
+  return true;
+}
+
+// Service to watch several IO elements, which changes are published by streamIo()
+bool MotomanIORelay::subscribeIoCB(
+  motoman_msgs::SubscribeIO::Request &req,
+  motoman_msgs::SubscribeIO::Response &res)
+{
+  if (req.sizes.size() != req.addresses.size())
+  {
+    res.success = false;
+    res.message = "Subscribe failed: the number of sizes does not match the number of addresses";
+    ROS_ERROR_STREAM_NAMED("io.subscribe", res.message);
+    return true;
+  }
+
+  boost::mutex::scoped_lock lock(this->stream_mutex_);
+
+  if (this->stream_rejected_)
+  {
+    res.success = false;
+    res.message = "Subscribe failed: the controller does not support I/O subscriptions";
+    ROS_ERROR_STREAM_NAMED("io.subscribe", res.message);
+    return true;
+  }
+
+  // add the elements not watched yet, at the end
+  std::vector<shared_int> addresses = this->stream_addresses_;
+  std::vector<IoMultiSize> sizes = this->stream_sizes_;
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < req.addresses.size(); ++i)
+  {
+    shared_int address = static_cast<shared_int>(req.addresses[i]);
+    IoMultiSize size = static_cast<IoMultiSize>(req.sizes[i]);
+    size_t j = 0;
+    while (j < addresses.size() && (addresses[j] != address || sizes[j] != size))
+      ++j;
+    if (j == addresses.size())
+    {
+      addresses.push_back(address);
+      sizes.push_back(size);
+    }
+    indices.push_back(j);
+  }
+
+  if (addresses.size() > static_cast<size_t>(IoSubscribe::MAX_ELEMENTS))
+  {
+    std::stringstream message;
+    message << "Subscribe failed: at most " << IoSubscribe::MAX_ELEMENTS << " elements can be watched, "
+            << addresses.size() << " would be";
+    res.success = false;
+    res.message = message.str();
+    ROS_ERROR_STREAM_NAMED("io.subscribe", res.message);
+    return true;
+  }
+
+  shared_int period = static_cast<shared_int>(req.period);
+  if (!this->stream_addresses_.empty())
+    period = std::min(period, this->stream_period_);
+  if (addresses.size() != this->stream_addresses_.size() || period != this->stream_period_)
+  {
+    this->stream_addresses_.swap(addresses);
+    this->stream_sizes_.swap(sizes);
+    this->stream_period_ = period;
+    this->stream_version_++;
+
+    // otherwise the stream thread subscribes once connected
+    std::string err_msg;
+    if (this->stream_connected_ && !sendSubscription(err_msg))
+      ROS_WARN_STREAM_NAMED("io.subscribe", err_msg);
+    if (this->stream_thread_.get_id() == boost::thread::id())
+      this->stream_thread_ = boost::thread(&MotomanIORelay::streamIo, this);
+  }
+
+  // wait for a reply covering the elements requested
+  boost::system_time deadline = boost::get_system_time() + boost::posix_time::seconds(SUBSCRIBE_TIMEOUT);
+  while (!this->stream_rejected_ && this->stream_reply_version_ < this->stream_version_)
+  {
+    if (!this->stream_replied_.timed_wait(lock, deadline))
+    {
+      res.success = false;
+      res.message = "Subscribe failed: the controller did not reply";
+      ROS_ERROR_STREAM_NAMED("io.subscribe", res.message);
+      return true;
+    }
+  }
+  if (this->stream_rejected_)
+  {
+    res.success = false;
+    res.message = "Subscribe failed: the controller does not support I/O subscriptions";
+    ROS_ERROR_STREAM_NAMED("io.subscribe", res.message);
+    return true;
+  }
+
+  res.success = true;
+  for (size_t i = 0; i < indices.size(); ++i)
+  {
+    shared_int value = this->stream_values_[indices[i]];
+    shared_int result_code = this->stream_result_codes_[indices[i]];
+    res.values.push_back(value);
+    res.result_codes.push_back(result_code);
+
+    if (result_code != IoMultiReplyResultCodes::SUCCESS && res.success)
+    {
+      std::stringstream message;
+      message << "Subscribe failed: element " << i << " (address: " << req.addresses[i] << "): "
+              << io_ctrl::ReadIOMultiReply::getResultString(result_code);
+      res.success = false;
+      res.message = message.str();
+      ROS_ERROR_STREAM_NAMED("io.subscribe", res.message);
+    }
+  }
+
+  ROS_DEBUG_STREAM_NAMED("io.subscribe", "Watching " << this->stream_addresses_.size()
+    << " elements every " << this->stream_period_ << " ms");
+  return true;
+}
+
+bool MotomanIORelay::sendSubscription(std::string &err_msg)
+{
+  if (!io_stream_.subscribe(this->stream_addresses_, this->stream_sizes_, this->stream_period_, err_msg))
+    return false;
+  this->stream_pending_.push_back(this->stream_version_);
+  return true;
+}
+
+void MotomanIORelay::streamIo()
+{
+  io_ctrl::IoUpdate update;
+  std::string err_msg;
+
+  while (ros::ok())
+  {
+    if (!stream_tcp_connection_->isConnected())
+    {
+      boost::mutex::scoped_lock lock(this->stream_mutex_);
+
+      // subscriptions sent on the previous connection are not replied to
+      this->stream_connected_ = false;
+      this->cache_.unsubscribe();
+      this->stream_pending_.clear();
+      lock.unlock();
+      if (!stream_tcp_connection_->makeConnect())
+      {
+        ros::Duration(1.0).sleep();
+        continue;
+      }
+      lock.lock();
+      this->stream_connected_ = true;
+      if (!sendSubscription(err_msg))
+        ROS_WARN_STREAM_NAMED("io.subscribe", err_msg);
+      continue;
+    }
+
+    if (!io_stream_.receiveUpdate(update, err_msg))
+    {
+      ROS_WARN_STREAM_NAMED("io.subscribe", err_msg);
+      continue;
+    }
+
+    motoman_msgs::IOChanges changes;
+    changes.header.stamp = ros::Time::now();
+    changes.controller_time = update.time;
+
+    switch (update.type)
+    {
+    case io_ctrl::IoUpdate::CHANGED:
+      this->cache_.change(update.addresses, update.sizes, update.values);
+      if (update.addresses.empty())
+        continue;  // keepalive
+      changes.addresses.assign(update.addresses.begin(), update.addresses.end());
+      changes.sizes.assign(update.sizes.begin(), update.sizes.end());
+      changes.values.assign(update.values.begin(), update.values.end());
+      break;
+
+    case io_ctrl::IoUpdate::SUBSCRIBED:
+    {
+      boost::mutex::scoped_lock lock(this->stream_mutex_);
+      if (this->stream_pending_.empty())
+        continue;
+      unsigned int version = this->stream_pending_.front();
+      this->stream_pending_.pop_front();
+
+      // the elements of a reply are the first ones of stream_addresses_
+      if (update.values.size() > this->stream_addresses_.size())
+      {
+        ROS_ERROR_NAMED("io.subscribe", "Subscription reply has %zu elements, %zu were subscribed to",
+                        update.values.size(), this->stream_addresses_.size());
+        continue;
+      }
+      this->stream_reply_version_ = version;
+      this->stream_values_ = update.values;
+      this->stream_result_codes_ = update.result_codes;
+      this->stream_values_.resize(this->stream_addresses_.size(), 0);
+      this->stream_result_codes_.resize(this->stream_addresses_.size(), IoMultiReplyResultCodes::READ_API_ERROR);
+      this->stream_replied_.notify_all();
+      this->cache_.subscribe(std::vector<shared_int>(this->stream_addresses_.begin(),
+                                                     this->stream_addresses_.begin() + update.values.size()),
+                             std::vector<IoMultiSize>(this->stream_sizes_.begin(),
+                                                      this->stream_sizes_.begin() + update.values.size()),
+                             update.values, update.result_codes);
+
+      // publish the values the changes start from
+      for (size_t i = 0; i < update.values.size(); ++i)
+      {
+        if (update.result_codes[i] != IoMultiReplyResultCodes::SUCCESS)
+          continue;
+        changes.addresses.push_back(this->stream_addresses_[i]);
+        changes.sizes.push_back(this->stream_sizes_[i]);
+        changes.values.push_back(update.values[i]);
+      }
+      break;
+    }
+
+    case io_ctrl::IoUpdate::REJECTED:
+    {
+      boost::mutex::scoped_lock lock(this->stream_mutex_);
+      ROS_ERROR_NAMED("io.subscribe", "The controller does not support I/O subscriptions");
+      this->stream_rejected_ = true;
+      this->stream_replied_.notify_all();
+      this->cache_.unsubscribe();
+
+      // give the controller its I/O connection back (older versions only have one)
+      this->stream_connected_ = false;
+      this->stream_tcp_connection_.reset();
+      return;
+    }
+    }
+
+    this->pub_io_changes_.publish(changes);
+  }
+}
+
+// Service to report how often reads of each element were answered by the cache
+bool MotomanIORelay::ioCacheStatsCB(
+  motoman_msgs::IOCacheStats::Request &req,
+  motoman_msgs::IOCacheStats::Response &res)
+{
+  std::vector<shared_int> addresses;
+  std::vector<IoMultiSize> sizes;
+  std::vector<unsigned int> hits;
+  std::vector<unsigned int> misses;
+
+  this->cache_.getStats(addresses, sizes, hits, misses);
+  res.addresses.assign(addresses.begin(), addresses.end());
+  res.sizes.assign(sizes.begin(), sizes.end());
+  res.hits.assign(hits.begin(), hits.end());
+  res.misses.assign(misses.begin(), misses.end());
+  res.enabled = this->cache_.isEnabled();
+  return true;
+}
+
 }  // namespace io_relay
 }  // namespace motoman
 
@@ -44,7 +44,10 @@ int main(int argc, char** argv)
 
   io_relay.init(default_io_port);
 
-  ros::spin();
+  // serve as many requests at once as there are connections, plus a
+  // subscribe_io request waiting for the controller to reply
+  ros::MultiThreadedSpinner spinner(io_relay.getConnectionCount() + 1);
+  spinner.spin();
 
   return 0;
 }
@@ -30,11 +30,14 @@
  */
 
 #include "motoman_driver/joint_trajectory_streamer.h"
+#include "motoman_driver/simple_message/messages/motoman_motion_ctrl_message.h"
 #include "motoman_driver/simple_message/messages/motoman_motion_reply_message.h"
 #include "simple_message/messages/joint_traj_pt_full_message.h"
-#include "motoman_driver/simple_message/messages/joint_traj_pt_full_ex_message.h"
+#include "motoman_driver/simple_message/motoman_simple_message.h"
+#include "motoman_driver/simple_message/messages/joint_traj_pt_full_batch_message.h"
 #include "industrial_robot_client/utils.h"
 #include "industrial_utils/param_utils.h"
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <string>
@@ -44,13 +47,21 @@ namespace ReplyTypes = industrial::simple_message::ReplyTypes;
 using industrial::joint_data::JointData;
 using industrial::joint_traj_pt_full::JointTrajPtFull;
 using industrial::joint_traj_pt_full_message::JointTrajPtFullMessage;
-using industrial::joint_traj_pt_full_ex::JointTrajPtFullEx;
-using industrial::joint_traj_pt_full_ex_message::JointTrajPtFullExMessage;
+using industrial::joint_traj_pt_full_batch::JointTrajPtFullBatch;
+using industrial::joint_traj_pt_full_batch_message::JointTrajPtFullBatchMessage;
+using industrial::byte_array::ByteArray;
 using industrial::shared_types::shared_int;
+using industrial::shared_types::shared_real;
+namespace ValidFieldTypes = industrial::joint_traj_pt_full::ValidFieldTypes;
 
+using motoman::simple_message::motion_ctrl::MotionCtrl;
+using motoman::simple_message::motion_ctrl_message::MotionCtrlMessage;
 using motoman::simple_message::motion_reply_message::MotionReplyMessage;
+namespace MotionControlCmds = motoman::simple_message::motion_ctrl::MotionControlCmds;
 namespace TransferStates = industrial_robot_client::joint_trajectory_streamer::TransferStates;
 namespace MotionReplyResults = motoman::simple_message::motion_reply::MotionReplyResults;
+namespace InvalidSubcodes = motoman::simple_message::motion_reply::MotionReplySubcodes::Invalid;
+namespace MotomanMsgTypes = motoman::simple_message::MotomanMsgTypes;
 
 namespace motoman
 {
@@ -62,6 +73,9 @@ namespace
   const double pos_stale_time_ = 1.0;  // max time since last "current position" update, for validation (sec)
   const double start_pos_tol_  = 1e-4;  // max difference btwn start & current position, for validation (rad)
   const double start_pos_close_  = 0.02;  // max difference btwn start & current position, for validation (rad).
+  const double busy_retry_delay_ = 0.005;  // delay before resending points rejected as BUSY (sec)
+  const int legacy_inc_queue_size_ = 200;  // size of the incremental queue of MotoROS versions that don't report it
+  const double max_buffer_wait_ = 0.1;  // longest pause while the controller buffers more than its target (sec)
 }
 
 #define ROS_ERROR_RETURN(rtn, ...) do {ROS_ERROR(__VA_ARGS__); return(rtn);} while (0)  // NOLINT(whitespace/braces)
@@ -88,6 +102,8 @@ bool MotomanJointTrajectoryStreamer::init(SmplMsgConnection* connection, const s
     motion_ctrl_map_[robot_id] = motion_ctrl;
   }
 
+  initParams();
+
   disabler_ = node_.advertiseService("robot_disable", &MotomanJointTrajectoryStreamer::disableRobotCB, this);
 
   enabler_ = node_.advertiseService("robot_enable", &MotomanJointTrajectoryStreamer::enableRobotCB, this);
@@ -113,6 +129,8 @@ bool MotomanJointTrajectoryStreamer::init(SmplMsgConnection* connection, const s
 
   rtn &= motion_ctrl_.init(connection, robot_id_);
 
+  initParams();
+
   disabler_ = node_.advertiseService("robot_disable", &MotomanJointTrajectoryStreamer::disableRobotCB, this);
 
   enabler_ = node_.advertiseService("robot_enable", &MotomanJointTrajectoryStreamer::enableRobotCB, this);
@@ -122,8 +140,32 @@ bool MotomanJointTrajectoryStreamer::init(SmplMsgConnection* connection, const s
   return rtn;
 }
 
+void MotomanJointTrajectoryStreamer::initParams()
+{
+  node_.param("streaming_window", max_window_, 1);
+  max_window_ = std::max(max_window_, 1);
+  window_ = 1;
+
+  node_.param("controller_queue_size", inc_queue_size_, 0);
+  node_.param("controller_point_queue_size", point_queue_size_, 0);
+  queue_size_applied_ = (inc_queue_size_ <= 0) && (point_queue_size_ <= 0);
+  node_.param("target_buffer_time", target_buffer_time_, 0.0);
+
+  node_.param("streaming_batch_size", batch_size_, 1);
+  batch_size_ = std::max(batch_size_, 1);
+
+  // FS100 messages don't depend on the previous point, so long trajectories can be converted in parallel.
+  // Off unless configured: a trajectory is then converted entirely before it is streamed.
+  node_.param("conversion_chunk_size", conversion_chunk_size_, 0);
+  node_.param("conversion_threads", conversion_threads_, static_cast<int>(boost::thread::hardware_concurrency()));
+  conversion_threads_ = std::max(conversion_threads_, 1);
+}
+
 MotomanJointTrajectoryStreamer::~MotomanJointTrajectoryStreamer()
 {
+  // the conversion threads call this class' create_message overrides
+  cancelConversion();
+
   // SmplMsgConnection is not thread safe, so lock first
   // NOTE: motion_ctrl_ uses the SmplMsgConnection here
   const std::lock_guard<std::mutex> lock{smpl_msg_conx_mutex_};
@@ -266,87 +308,47 @@ bool MotomanJointTrajectoryStreamer::create_message(int seq, const trajectory_ms
   return jtpf_msg.toRequest(*msg);  // assume "request" COMM_TYPE for now
 }
 
+// The JOINT_TRAJ_PT_FULL_EX layout (see JointTrajPtFullEx) is encoded straight into the
+// message data, already as a request: going through JointTrajPtFullEx copies its groups
+// several times per point, which dominates the conversion of long multi-group trajectories.
 bool MotomanJointTrajectoryStreamer::create_message_ex(int seq, const motoman_msgs::DynamicJointPoint& point,
                                                        SimpleMessage* msg)
 {
-  JointTrajPtFullEx msg_data_ex;
-  JointTrajPtFullExMessage jtpf_msg_ex;
-  std::vector<industrial::joint_traj_pt_full::JointTrajPtFull> msg_data_vector;
+  static const size_t max_joints = JointData().getMaxNumJoints();
+  ByteArray data;
 
-  JointData values;
-
-  int num_groups = point.num_groups;
+  data.load(static_cast<shared_int>(point.num_groups));
+  data.load(static_cast<shared_int>(seq));
 
-  for (int i = 0; i < num_groups; i++)
+  for (int i = 0; i < point.num_groups; i++)
   {
-    JointTrajPtFull msg_data;
-
-    motoman_msgs::DynamicJointsGroup pt;
-
-    motoman_msgs::DynamicJointPoint dpoint;
-
-    pt = point.groups[i];
-
-    if (pt.positions.size() < 10)
-    {
-      int size_to_complete = 10 - pt.positions.size();
-
-      std::vector<double> positions(size_to_complete, 0.0);
-      std::vector<double> velocities(size_to_complete, 0.0);
-      std::vector<double> accelerations(size_to_complete, 0.0);
-
-      pt.positions.insert(pt.positions.end(), positions.begin(), positions.end());
-      pt.velocities.insert(pt.velocities.end(), velocities.begin(), velocities.end());
-      pt.accelerations.insert(pt.accelerations.end(), accelerations.begin(), accelerations.end());
-    }
-
-    // copy position data
-    if (!pt.positions.empty())
-    {
-      if (VectorToJointData(pt.positions, values))
-        msg_data.setPositions(values);
-      else
-        ROS_ERROR_RETURN(false, "Failed to copy position data to JointTrajPtFullMessage");
-    }
-    else
-      msg_data.clearPositions();
-    // copy velocity data
-    if (!pt.velocities.empty())
-    {
-      if (VectorToJointData(pt.velocities, values))
-        msg_data.setVelocities(values);
-      else
-        ROS_ERROR_RETURN(false, "Failed to copy velocity data to JointTrajPtFullMessage");
-    }
-    else
-      msg_data.clearVelocities();
-
-    // copy acceleration data
-    if (!pt.accelerations.empty())
-    {
-      if (VectorToJointData(pt.accelerations, values))
-        msg_data.setAccelerations(values);
-      else
-        ROS_ERROR_RETURN(false, "Failed to copy acceleration data to JointTrajPtFullMessage");
-    }
-    else
-      msg_data.clearAccelerations();
-
-    // copy scalar data
-    msg_data.setRobotID(pt.group_number);
-    msg_data.setSequence(seq);
-    msg_data.setTime(pt.time_from_start.toSec());
-
-    // convert to message
-    msg_data_vector.push_back(msg_data);
+    const motoman_msgs::DynamicJointsGroup &pt = point.groups[i];
+
+    // groups with fewer joints are padded with zeros
+    size_t padding = (pt.positions.size() < max_joints) ? max_joints - pt.positions.size() : 0;
+
+    shared_int valid_fields = ValidFieldTypes::TIME;
+    if (pt.positions.size() + padding > 0)
+      valid_fields |= ValidFieldTypes::POSITION;
+    if (pt.velocities.size() + padding > 0)
+      valid_fields |= ValidFieldTypes::VELOCITY;
+    if (pt.accelerations.size() + padding > 0)
+      valid_fields |= ValidFieldTypes::ACCELERATION;
+
+    data.load(static_cast<shared_int>(pt.group_number));
+    data.load(valid_fields);
+    data.load(static_cast<shared_real>(pt.time_from_start.toSec()));
+
+    if (!LoadJointVector(pt.positions, padding, &data))
+      ROS_ERROR_RETURN(false, "Failed to copy position data to JointTrajPtFullExMessage");
+    if (!LoadJointVector(pt.velocities, padding, &data))
+      ROS_ERROR_RETURN(false, "Failed to copy velocity data to JointTrajPtFullExMessage");
+    if (!LoadJointVector(pt.accelerations, padding, &data))
+      ROS_ERROR_RETURN(false, "Failed to copy acceleration data to JointTrajPtFullExMessage");
   }
 
-  msg_data_ex.setMultiJointTrajPtData(msg_data_vector);
-  msg_data_ex.setNumGroups(num_groups);
-  msg_data_ex.setSequence(seq);
-  jtpf_msg_ex.init(msg_data_ex);
-
-  return jtpf_msg_ex.toRequest(*msg);  // assume "request" COMM_TYPE for now
+  return msg->init(MotomanMsgTypes::ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_EX, CommTypes::SERVICE_REQUEST,
+                   ReplyTypes::INVALID, data);
 }
 
 bool MotomanJointTrajectoryStreamer::create_message(int seq, const motoman_msgs::DynamicJointsGroup& pt,
@@ -400,6 +402,20 @@ bool MotomanJointTrajectoryStreamer::create_message(int seq, const motoman_msgs:
   return jtpf_msg.toRequest(*msg);  // assume "request" COMM_TYPE for now
 }
 
+bool MotomanJointTrajectoryStreamer::LoadJointVector(const std::vector<double> &vec, size_t padding,
+                                                     ByteArray* data)
+{
+  static const size_t max_joints = JointData().getMaxNumJoints();
+
+  if (vec.size() + padding > max_joints)
+    ROS_ERROR_RETURN(false, "Failed to copy to JointData.  Len (%d) out of range (0 to %d)",
+                     static_cast<int>(vec.size() + padding), static_cast<int>(max_joints));
+
+  for (size_t i = 0; i < max_joints; ++i)
+    data->load(static_cast<shared_real>(i < vec.size() ? vec[i] : 0.0));
+  return true;
+}
+
 bool MotomanJointTrajectoryStreamer::VectorToJointData(const std::vector<double> &vec,
     JointData &joints)
 {
@@ -424,6 +440,16 @@ bool MotomanJointTrajectoryStreamer::send_to_robot(const std::vector<SimpleMessa
     // NOTE: motion_ctrl_ uses the SmplMsgConnection here
     const std::lock_guard<std::mutex> lock{smpl_msg_conx_mutex_};
     motion_ctrl_result = motion_ctrl_.controllerReady();
+
+    // the queues can only be resized while the controller has no motion queued
+    if (motion_ctrl_result && !queue_size_applied_)
+    {
+      double inc_queue_time;
+      queue_size_applied_ = motion_ctrl_.setQueueSize(std::max(inc_queue_size_, 0), std::max(point_queue_size_, 0),
+                                                      &inc_queue_time);
+      if (!queue_size_applied_)
+        ROS_WARN("Controller queue size not changed, will retry with the next trajectory");
+    }
   }
 
   if (!motion_ctrl_result)
@@ -433,34 +459,42 @@ bool MotomanJointTrajectoryStreamer::send_to_robot(const std::vector<SimpleMessa
   return JointTrajectoryStreamer::send_to_robot(messages);
 }
 
-// override streamingThread, to provide check/retry of MotionReply.result=BUSY
+// override streamingThread, to provide windowed streaming and check/retry of MotionReply.result=BUSY
 void MotomanJointTrajectoryStreamer::streamingThread()
 {
   int connectRetryCount = 1;
   bool is_connected = false;
-  bool is_msg_sent = false;
+  bool is_busy = false;
+  bool converting = false;
+  double buffered_time = -1.0;
+  boost::unique_lock<boost::mutex> lock(this->mutex_, boost::defer_lock);
 
   ROS_INFO("Starting Motoman joint trajectory streamer thread");
   while (ros::ok())
   {
-    ros::Duration(0.005).sleep();
-
     // automatically re-establish connection, if required
     if (connectRetryCount-- > 0)
     {
       ROS_INFO("Connecting to robot motion server");
       {
         // SmplMsgConnection is not thread safe, so lock first
-        const std::lock_guard<std::mutex> lock{smpl_msg_conx_mutex_};
+        const std::lock_guard<std::mutex> conx_lock{smpl_msg_conx_mutex_};
         this->connection_->makeConnect();
+        is_connected = this->connection_->isConnected();
+
+        // the controller may have restarted with its default queue size
+        queue_size_applied_ = (inc_queue_size_ <= 0) && (point_queue_size_ <= 0);
       }
-      ros::Duration(0.250).sleep();  // wait for connection
 
-      is_connected = false;
+      if (!is_connected)
       {
+        lock.lock();
+        waitForEvent(lock, ros::Duration(0.250));  // wait for connection
+        lock.unlock();
+
         // SmplMsgConnection is not thread safe, so lock first
         // TODO(gavanderhoorn): not sure this needs to be protected by a mutex
-        const std::lock_guard<std::mutex> lock{smpl_msg_conx_mutex_};
+        const std::lock_guard<std::mutex> conx_lock{smpl_msg_conx_mutex_};
         is_connected = this->connection_->isConnected();
       }
 
@@ -477,20 +511,35 @@ void MotomanJointTrajectoryStreamer::streamingThread()
     }
 
     // this does not lock smpl_msg_conx_mutex_, but the mutex from JointTrajectoryStreamer
-    this->mutex_.lock();
+    lock.lock();
 
-    SimpleMessage msg, tmpMsg, reply;
+    is_busy = false;
 
     switch (this->state_)
     {
     case TransferStates::IDLE:
-      ros::Duration(0.250).sleep();  //  slower loop while waiting for new trajectory
+      waitForEvent(lock, ros::Duration(0.250));  // woken early by a new trajectory
       break;
 
     case TransferStates::STREAMING:
+      if (!collectConvertedPoints(&converting))
+      {
+        ROS_ERROR("Failed to convert trajectory points, stopping current motion");
+        trajectoryStop();
+        sendMotionReplyResult(pub_motion_reply_, MotionReplyResults::INVALID);
+        break;
+      }
+
       if (this->current_point_ >= static_cast<int>(this->current_traj_.size()))
       {
+        if (converting)
+        {
+          waitForEvent(lock, ros::Duration(0.010));  // woken early by the next converted chunk
+          break;
+        }
+
         ROS_INFO("Trajectory streaming complete, setting state to IDLE");
+        ROS_DEBUG_STREAM("Time to first point: " << this->first_point_latency_.toString());
         this->state_ = TransferStates::IDLE;
         sendMotionReplyResult(pub_motion_reply_, MotionReplyResults::SUCCESS);
         break;
@@ -500,7 +549,7 @@ void MotomanJointTrajectoryStreamer::streamingThread()
       {
         // SmplMsgConnection is not thread safe, so lock first
         // TODO(gavanderhoorn): not sure this needs to be protected by a mutex
-        const std::lock_guard<std::mutex> lock{smpl_msg_conx_mutex_};
+        const std::lock_guard<std::mutex> conx_lock{smpl_msg_conx_mutex_};
         is_connected = this->connection_->isConnected();
       }
 
@@ -511,50 +560,12 @@ void MotomanJointTrajectoryStreamer::streamingThread()
         break;
       }
 
-      tmpMsg = this->current_traj_[this->current_point_];
-      msg.init(tmpMsg.getMessageType(), CommTypes::SERVICE_REQUEST,
-               ReplyTypes::INVALID, tmpMsg.getData());  // set commType=REQUEST
-
-      is_msg_sent = false;
-      {
-        // SmplMsgConnection is not thread safe, so lock first
-        const std::lock_guard<std::mutex> lock{smpl_msg_conx_mutex_};
-        is_msg_sent = this->connection_->sendAndReceiveMsg(msg, reply, false);
-      }
-
-      if (!is_msg_sent)
-      {
-        ROS_WARN("Failed sent joint point, will try again");
-      }
-      else
-      {
-        MotionReplyMessage reply_status;
-        if (!reply_status.init(reply))
-        {
-          ROS_ERROR("Aborting trajectory: Unable to parse JointTrajectoryPoint reply");
-          this->state_ = TransferStates::IDLE;
-          break;
-        }
-
-        if (reply_status.reply_.getResult() == MotionReplyResults::SUCCESS)
-        {
-          ROS_DEBUG("Point[%d of %d] sent to controller",
-                    this->current_point_, static_cast<int>(this->current_traj_.size()));
-          this->current_point_++;
-        }
-        else if (reply_status.reply_.getResult() == MotionReplyResults::BUSY)
-          break;  // silently retry sending this point
-        else
-        {
-          ROS_ERROR_STREAM("Aborting Trajectory.  Failed to send point"
-                           << " (#" << this->current_point_ << "): "
-                           << MotomanMotionCtrl::getErrorString(reply_status.reply_));
-          this->state_ = TransferStates::IDLE;
-          // TODO Determine if the reply should be published into pub_motion_replies_ or pub_motion_reply_.
-          sendMotionReplyResult(pub_motion_reply_, reply_status.reply_.getResult());
-          break;
-        }
-      }
+      if (!streamWindow(&is_busy, &buffered_time))
+        this->state_ = TransferStates::IDLE;
+      else if (is_busy)
+        waitForEvent(lock, ros::Duration(busy_retry_delay_));  // give the controller time to process its points
+      else if ((target_buffer_time_ > 0) && (buffered_time > target_buffer_time_))
+        waitForEvent(lock, ros::Duration(std::min(buffered_time - target_buffer_time_, max_buffer_wait_)));
       break;
     default:
       ROS_ERROR("Joint trajectory streamer: unknown state");
@@ -564,15 +575,240 @@ void MotomanJointTrajectoryStreamer::streamingThread()
       break;
     }
     // this does not unlock smpl_msg_conx_mutex_, but the mutex from JointTrajectoryStreamer
-    this->mutex_.unlock();
+    lock.unlock();
   }
+  ROS_INFO_STREAM("Time to first point: " << this->first_point_latency_.toString());
   ROS_WARN("Exiting trajectory streamer thread");
 }
 
+// Points are sent back-to-back, without waiting for the reply of the previous one.
+// MotoROS accepts points strictly in sequence: once a point is rejected as BUSY,
+// every following point in the window is rejected as well and is simply resent.
+// A queue query piggy-backed on the window reports the motion buffered on the
+// controller, which sizes the next window and paces streaming to the target buffer.
+// With streaming_batch_size > 1, consecutive points share a message and its reply.
+bool MotomanJointTrajectoryStreamer::streamWindow(bool* busy, double* buffered_time)
+{
+  SimpleMessage msg, reply;
+  MotionReplyMessage reply_status;
+  int window_end = std::min(this->current_point_ + this->window_ * this->batch_size_,
+                            static_cast<int>(this->current_traj_.size()));
+  int num_sent = 0;  // points sent
+  std::vector<int> batch_points;  // points carried by each message sent
+  size_t num_replies = 0;
+  bool query_queue = false;
+  int queue_cnt = -1;
+  double inc_queue_time = 0.0;
+  double inc_queue_capacity = 0.0;
+
+  *buffered_time = -1.0;
+
+  // SmplMsgConnection is not thread safe, so lock first
+  const std::lock_guard<std::mutex> lock{smpl_msg_conx_mutex_};
+
+  for (int i = this->current_point_; i < window_end; i += batch_points.back())
+  {
+    int num_points = 1;
+    bool sent;
+    if (createBatch(i, window_end, &msg, &num_points))
+      sent = this->connection_->sendMsg(msg);
+    else
+      sent = this->connection_->sendMsg(this->current_traj_[i]);  // created as a request by create_message()
+
+    if (!sent)
+      break;
+    if (i == 0)
+      recordFirstPointLatency();
+    num_sent += num_points;
+    batch_points.push_back(num_points);
+  }
+
+  if (num_sent == 0)
+  {
+    ROS_WARN("Failed sent joint point, will try again");
+    return true;
+  }
+
+  // piggy-back a queue query on a full window, to decide whether it may grow
+  // (on every window when streaming to a target buffer)
+  if (((num_sent == window_end - this->current_point_) && (this->window_ < this->max_window_))
+      || (target_buffer_time_ > 0))
+  {
+    MotionCtrl data;
+    MotionCtrlMessage ctrl_msg;
+
+    data.init(robot_id_ < 0 ? 0 : robot_id_, 0, MotionControlCmds::CHECK_QUEUE_CNT, 0);
+    ctrl_msg.init(data);
+    ctrl_msg.toRequest(msg);
+    query_queue = this->connection_->sendMsg(msg);
+  }
+
+  // replies arrive in the order the requests were sent
+  int expected = this->current_point_;
+  int pending = static_cast<int>(batch_points.size()) + (query_queue ? 1 : 0);
+  while (pending > 0)
+  {
+    if (!this->connection_->receiveMsg(reply))
+    {
+      ROS_WARN("Failed to receive joint point reply, will try again");
+      this->window_ = 1;
+      return true;
+    }
+
+    if (!reply_status.init(reply))
+    {
+      ROS_ERROR("Aborting trajectory: Unable to parse JointTrajectoryPoint reply");
+      return false;
+    }
+
+    if (reply_status.reply_.getCommand() == MotionControlCmds::CHECK_QUEUE_CNT)
+    {
+      if (reply_status.reply_.getResult() == MotionReplyResults::TRUE)
+      {
+        queue_cnt = reply_status.reply_.getSubcode();
+        inc_queue_time = reply_status.reply_.getData(1);
+        inc_queue_capacity = reply_status.reply_.getData(2);
+        if (inc_queue_capacity > 0)  // older MotoROS versions only report the count
+          *buffered_time = reply_status.reply_.getData(0);
+      }
+      pending--;
+      continue;
+    }
+
+    // MotoROS versions without batches reject them without a sequence number
+    if (reply_status.reply_.getCommand() == MotomanMsgTypes::ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH &&
+        reply_status.reply_.getResult() == MotionReplyResults::INVALID &&
+        reply_status.reply_.getSubcode() == InvalidSubcodes::MSGTYPE)
+    {
+      ROS_WARN("Controller does not support batched trajectory points, sending points one by one");
+      this->batch_size_ = 1;
+      *busy = true;  // resend the rest of the window
+      this->window_ = 1;
+      return true;
+    }
+
+    // a late reply to a point that was already resent after a lost reply
+    if (reply_status.reply_.getSequence() < expected)
+      continue;
+    pending--;
+
+    if (reply_status.reply_.getSequence() != expected)
+    {
+      ROS_ERROR("Aborting Trajectory.  Reply for point #%d received while expecting #%d",
+                reply_status.reply_.getSequence(), expected);
+      sendMotionReplyResult(pub_motion_reply_, MotionReplyResults::FAILURE);
+      return false;
+    }
+    int num_points = batch_points[num_replies++];
+    expected += num_points;
+
+    // a batch reply covers all its points, data[0] tells how many were accepted
+    if (!*busy && reply_status.reply_.getCommand() == MotomanMsgTypes::ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH &&
+        reply_status.reply_.getResult() != MotionReplyResults::SUCCESS)
+      this->current_point_ += static_cast<int>(reply_status.reply_.getData(0));
+
+    if (*busy || reply_status.reply_.getResult() == MotionReplyResults::BUSY)
+    {
+      *busy = true;  // silently retry sending this point and the rest of the window
+    }
+    else if (reply_status.reply_.getResult() == MotionReplyResults::SUCCESS)
+    {
+      ROS_DEBUG("Point[%d of %d] sent to controller",
+                this->current_point_, static_cast<int>(this->current_traj_.size()));
+      this->current_point_ += num_points;
+    }
+    else
+    {
+      ROS_ERROR_STREAM("Aborting Trajectory.  Failed to send point"
+                       << " (#" << this->current_point_ << "): "
+                       << MotomanMotionCtrl::getErrorString(reply_status.reply_));
+      // TODO Determine if the reply should be published into pub_motion_replies_ or pub_motion_reply_.
+      sendMotionReplyResult(pub_motion_reply_, reply_status.reply_.getResult());
+      return false;
+    }
+  }
+
+  if (*busy)
+  {
+    this->window_ = std::max(this->window_ / 2, 1);
+  }
+  else if (queue_cnt >= 0 && this->window_ < this->max_window_)
+  {
+    // grow while the controller has headroom
+    bool has_room;
+    if (target_buffer_time_ > 0 && *buffered_time >= 0)
+      has_room = (*buffered_time < target_buffer_time_);
+    else if (inc_queue_capacity > 0)
+      has_room = (inc_queue_time < inc_queue_capacity / 2);
+    else
+      has_room = (queue_cnt < legacy_inc_queue_size_ / 2);
+
+    if (has_room)
+      this->window_++;
+  }
+
+  return true;
+}
+
+// Packs the points [first, last) into one batch message, up to streaming_batch_size points.
+// Returns false when fewer than two points could be batched: they are sent on their own.
+bool MotomanJointTrajectoryStreamer::createBatch(int first, int last, SimpleMessage* msg, int* num_points)
+{
+  JointTrajPtFullBatch batch;
+  JointTrajPtFullBatchMessage batch_msg;
+
+  if (this->batch_size_ < 2)
+    return false;
+
+  last = std::min(last, first + this->batch_size_);
+  for (int i = first; i < last; ++i)
+  {
+    if (!batch.addPoint(this->current_traj_[i]))
+      break;
+  }
+  if (batch.getNumPoints() < 2)
+    return false;
+
+  batch_msg.init(batch);
+  if (!batch_msg.toRequest(*msg))
+    return false;
+
+  *num_points = batch.getNumPoints();
+  return true;
+}
+
+// override truncate to drop the motion queued on the controller past the splice time
+bool MotomanJointTrajectoryStreamer::truncate(double lead_time, double* splice_time, double* exec_time,
+                                              std::map<int, trajectory_msgs::JointTrajectoryPoint>* end_state)
+{
+  // SmplMsgConnection is not thread safe, so lock first
+  // NOTE: motion_ctrl_ uses the SmplMsgConnection here
+  const std::lock_guard<std::mutex> lock{smpl_msg_conx_mutex_};
+  if (!motion_ctrl_.truncateTrajectory(lead_time, splice_time, exec_time))
+    return false;
+
+  // the state each group's next point is interpolated from
+  end_state->clear();
+  if (motion_ctrl_map_.empty())
+  {
+    trajectory_msgs::JointTrajectoryPoint &state = (*end_state)[robot_id_];
+    return motion_ctrl_.getQueueEndState(&state.positions, &state.velocities);
+  }
+
+  for (std::map<int, MotomanMotionCtrl>::iterator it = motion_ctrl_map_.begin(); it != motion_ctrl_map_.end(); ++it)
+  {
+    trajectory_msgs::JointTrajectoryPoint &state = (*end_state)[it->first];
+    if (!it->second.getQueueEndState(&state.positions, &state.velocities))
+      return false;
+  }
+  return true;
+}
+
 // override trajectoryStop to send MotionCtrl message
 void MotomanJointTrajectoryStreamer::trajectoryStop()
 {
   this->state_ = TransferStates::IDLE;  // stop sending trajectory points
+  notifyStreamingThread();
   // SmplMsgConnection is not thread safe, so lock first
   // NOTE: motion_ctrl_ uses the SmplMsgConnection here
   const std::lock_guard<std::mutex> lock{smpl_msg_conx_mutex_};
@@ -593,7 +829,11 @@ bool MotomanJointTrajectoryStreamer::is_valid(const trajectory_msgs::JointTrajec
     if (pt.velocities.empty())
       ROS_ERROR_RETURN(false, "Validation failed: Missing velocity data for trajectory pt %lu", i);
   }
+  return true;
+}
 
+bool MotomanJointTrajectoryStreamer::is_valid_start(const trajectory_msgs::JointTrajectory &traj)
+{
   if ((cur_joint_pos_.header.stamp - ros::Time::now()).toSec() > pos_stale_time_)
     ROS_ERROR_RETURN(false, "Validation failed: Can't get current robot position.");
 
@@ -621,33 +861,46 @@ bool MotomanJointTrajectoryStreamer::is_valid(const trajectory_msgs::JointTrajec
   return true;
 }
 
-bool MotomanJointTrajectoryStreamer::is_valid(const motoman_msgs::DynamicJointTrajectory &traj)
+bool MotomanJointTrajectoryStreamer::is_valid(const motoman_msgs::DynamicJointTrajectory &traj,
+                                              size_t first, size_t last)
 {
-  if (!JointTrajectoryInterface::is_valid(traj))
+  if (!JointTrajectoryInterface::is_valid(traj, first, last))
     return false;
-  ros::Time time_stamp;
-  int group_number;
-  for (size_t i = 0; i < traj.points.size(); ++i)
+
+  for (size_t i = first; i < last; ++i)
   {
     for (int gr = 0; gr < traj.points[i].num_groups; gr++)
     {
-      const motoman_msgs::DynamicJointsGroup &pt = traj.points[i].groups[gr];
-      time_stamp = cur_joint_pos_map_[pt.group_number].header.stamp;
-      // TODO( ): adjust for more joints
-      group_number = pt.group_number;
       // FS100 requires valid velocity data
-      if (pt.velocities.empty())
+      if (traj.points[i].groups[gr].velocities.empty())
         ROS_ERROR_RETURN(false, "Validation failed: Missing velocity data for trajectory pt %lu", i);
+    }
+  }
+  return true;
+}
+
+bool MotomanJointTrajectoryStreamer::is_valid_start(const motoman_msgs::DynamicJointTrajectory &traj)
+{
+  ros::Time time_stamp;
 
-      // FS100 requires trajectory start at current position
-      namespace IRC_utils = industrial_robot_client::utils;
+  if (traj.points.empty())
+    return true;
 
-      if (!IRC_utils::isWithinRange(cur_joint_pos_map_[group_number].name, cur_joint_pos_map_[group_number].position,
-                                    traj.joint_names, traj.points[0].groups[gr].positions,
-                                    start_pos_tol_))
-      {
-        ROS_ERROR_RETURN(false, "Validation failed: Trajectory doesn't start at current position.");
-      }
+  for (int gr = 0; gr < traj.points[0].num_groups; gr++)
+  {
+    const motoman_msgs::DynamicJointsGroup &pt = traj.points[0].groups[gr];
+    const sensor_msgs::JointState &cur_joint_pos = cur_joint_pos_map_[pt.group_number];
+    // TODO( ): adjust for more joints
+    time_stamp = cur_joint_pos.header.stamp;
+
+    // FS100 requires trajectory start at current position
+    namespace IRC_utils = industrial_robot_client::utils;
+
+    if (!IRC_utils::isWithinRange(cur_joint_pos.name, cur_joint_pos.position,
+                                  traj.joint_names, pt.positions,
+                                  start_pos_tol_))
+    {
+      ROS_ERROR_RETURN(false, "Validation failed: Trajectory doesn't start at current position.");
     }
   }
 
@@ -36,10 +36,10 @@
 #include "ros/ros.h"
 #include "simple_message/simple_message.h"
 #include <string>
+#include <vector>
 
 namespace MotionControlCmds = motoman::simple_message::motion_ctrl::MotionControlCmds;
 namespace MotionReplyResults = motoman::simple_message::motion_reply::MotionReplyResults;
-using motoman::simple_message::motion_ctrl::MotionCtrl;
 using motoman::simple_message::motion_ctrl_message::MotionCtrlMessage;
 using motoman::simple_message::motion_reply_message::MotionReplyMessage;
 using motoman::simple_message::misc::SelectToolMessage;
@@ -111,6 +111,90 @@ bool MotomanMotionCtrl::stopTrajectory()
   return true;
 }
 
+bool MotomanMotionCtrl::truncateTrajectory(double lead_time, double* splice_time, double* exec_time)
+{
+  MotionReply reply;
+  const int max_busy_retries = 250;  // controller finishes interpolating its current point first
+
+  for (int i = 0; i < max_busy_retries; ++i)
+  {
+    if (!sendAndReceive(MotionControlCmds::TRUNCATE_TRAJ, reply, lead_time))
+    {
+      ROS_ERROR("Failed to send TRUNCATE_TRAJ command");
+      return false;
+    }
+
+    if (reply.getResult() != MotionReplyResults::BUSY)
+      break;
+    ros::Duration(0.002).sleep();
+  }
+
+  if (reply.getResult() != MotionReplyResults::SUCCESS)
+  {
+    ROS_ERROR_STREAM("Failed to truncate trajectory: " << getErrorString(reply));
+    return false;
+  }
+
+  *splice_time = reply.getData(0);
+  *exec_time = reply.getData(1);
+  return true;
+}
+
+bool MotomanMotionCtrl::getQueueEndState(std::vector<double>* positions, std::vector<double>* velocities)
+{
+  const size_t num_joints = 10;  // data of a motion reply
+  std::vector<double>* state[] = {positions, velocities};
+
+  for (int i = 0; i < 2; ++i)
+  {
+    MotionReply reply;
+
+    if (!sendAndReceive(MotionControlCmds::GET_QUEUE_END_STATE, reply, i))
+    {
+      ROS_ERROR("Failed to send GET_QUEUE_END_STATE command");
+      return false;
+    }
+
+    if (reply.getResult() != MotionReplyResults::SUCCESS)
+    {
+      ROS_ERROR_STREAM("Failed to get queue end state: " << getErrorString(reply));
+      return false;
+    }
+
+    state[i]->resize(num_joints);
+    for (size_t j = 0; j < num_joints; ++j)
+      (*state[i])[j] = reply.getData(j);
+  }
+
+  return true;
+}
+
+bool MotomanMotionCtrl::setQueueSize(int inc_queue_size, int point_queue_size, double* inc_queue_time)
+{
+  MotionCtrl ctrl_data;
+  MotionReply reply;
+
+  ctrl_data.init(robot_id_, 0, MotionControlCmds::SET_QUEUE_SIZE, inc_queue_size);
+  ctrl_data.setData(1, point_queue_size);
+
+  if (!sendAndReceive(ctrl_data, reply))
+  {
+    ROS_ERROR("Failed to send SET_QUEUE_SIZE command");
+    return false;
+  }
+
+  if (reply.getResult() != MotionReplyResults::SUCCESS)
+  {
+    ROS_ERROR_STREAM("Failed to set queue size: " << getErrorString(reply));
+    return false;
+  }
+
+  ROS_INFO("Controller queues: %d increments (%.3f s), %d trajectory points",
+           static_cast<int>(reply.getData(0)), reply.getData(2), static_cast<int>(reply.getData(1)));
+  *inc_queue_time = reply.getData(2);
+  return true;
+}
+
 bool MotomanMotionCtrl::selectToolFile(industrial::shared_types::shared_int group_number,
   industrial::shared_types::shared_int tool_number, std::string& err_msg)
 {
@@ -142,15 +226,22 @@ bool MotomanMotionCtrl::selectToolFile(industrial::shared_types::shared_int grou
   return true;
 }
 
-bool MotomanMotionCtrl::sendAndReceive(MotionControlCmd command, MotionReply &reply)
+bool MotomanMotionCtrl::sendAndReceive(MotionControlCmd command, MotionReply &reply,
+                                       industrial::shared_types::shared_real data)
+{
+  MotionCtrl ctrl_data;
+
+  ctrl_data.init(robot_id_, 0, command, data);
+  return sendAndReceive(ctrl_data, reply);
+}
+
+bool MotomanMotionCtrl::sendAndReceive(MotionCtrl &ctrl_data, MotionReply &reply)
 {
   SimpleMessage req, res;
-  MotionCtrl data;
   MotionCtrlMessage ctrl_msg;
   MotionReplyMessage ctrl_reply;
 
-  data.init(robot_id_, 0, command, 0);
-  ctrl_msg.init(data);
+  ctrl_msg.init(ctrl_data);
   ctrl_msg.toRequest(req);
 
   if (!this->connection_->sendAndReceiveMsg(req, res))
@@ -35,16 +35,20 @@
 
 #ifndef FLATHEADERS
 #include "motoman_driver/simple_message/joint_feedback_ex.h"
+#include "motoman_driver/simple_message/motoman_simple_message.h"
 #include "simple_message/shared_types.h"
 #include "simple_message/log_wrapper.h"
 #else
 #include "joint_feedback_ex.h"  // NOLINT(build/include)
+#include "motoman_simple_message.h"  // NOLINT(build/include)
 #include "shared_types.h"       // NOLINT(build/include)
 #include "log_wrapper.h"        // NOLINT(build/include)
 #endif
 
+using industrial::joint_data::JointData;
 using industrial::joint_feedback_message::JointFeedbackMessage;
 using industrial::joint_feedback::JointFeedback;
+namespace MotomanValidFieldTypes = motoman::simple_message::MotomanValidFieldTypes;
 
 namespace industrial
 {
@@ -69,12 +73,55 @@ void JointFeedbackEx::init(industrial::shared_types::shared_int groups_number,
 {
   this->setGroupsNumber(groups_number);
   this->joint_feedback_messages_ = joints_feedback_points;
+  this->efforts_.assign(joints_feedback_points.size(), JointData());
+  this->has_efforts_.assign(joints_feedback_points.size(), false);
 }
 
 void JointFeedbackEx::copyFrom(JointFeedbackEx &src)
 {
   this->setGroupsNumber(src.getGroupsNumber());
   this->joint_feedback_messages_ = src.joint_feedback_messages_;
+  this->efforts_ = src.efforts_;
+  this->has_efforts_ = src.has_efforts_;
+}
+
+bool JointFeedbackEx::getEfforts(size_t index, JointData *efforts)
+{
+  if (index >= this->has_efforts_.size() || !this->has_efforts_[index])
+    return false;
+
+  efforts->copyFrom(this->efforts_[index]);
+  return true;
+}
+
+bool JointFeedbackEx::unloadFeedback(industrial::byte_array::ByteArray *buffer, JointFeedback *feedback,
+                                     JointData *efforts, bool *has_efforts)
+{
+  industrial::shared_types::shared_int robot_id;
+  industrial::shared_types::shared_int valid_fields;
+  industrial::shared_types::shared_real time;
+  JointData positions;
+  JointData velocities;
+  JointData accelerations;
+
+  // same layout as JointFeedback, unloaded from the back
+  if (!buffer->unload(accelerations) || !buffer->unload(velocities) || !buffer->unload(positions)
+      || !buffer->unload(time) || !buffer->unload(valid_fields) || !buffer->unload(robot_id))
+  {
+    LOG_ERROR("Failed to unload joint feedback");
+    return false;
+  }
+
+  *has_efforts = (valid_fields & MotomanValidFieldTypes::EFFORT);
+  if (*has_efforts)
+  {
+    efforts->copyFrom(accelerations);
+    accelerations.init();
+    valid_fields &= ~MotomanValidFieldTypes::EFFORT;
+  }
+
+  feedback->init(robot_id, valid_fields, time, positions, velocities, accelerations);
+  return true;
 }
 
 bool JointFeedbackEx::operator==(JointFeedbackEx &rhs)
@@ -126,12 +173,17 @@ bool JointFeedbackEx::unload(industrial::byte_array::ByteArray *buffer)
   // Because of that we have to deserialise all submsgs and check validity
   // of each individually (ie: we cannot skip submsgs 3 & 4 if there are only
   // two motion groups, as the data for grp1 could be in submsg 3 fi).
+  this->joint_feedback_messages_.clear();
+  this->efforts_.clear();
+  this->has_efforts_.clear();
   for (std::size_t i = 0; i < MAX_NUM_GROUPS; ++i)
   {
     JointFeedbackMessage tmp_msg;
     JointFeedback j_feedback;
+    JointData efforts;
+    bool has_efforts;
 
-    if (!buffer->unload(j_feedback))
+    if (!unloadFeedback(buffer, &j_feedback, &efforts, &has_efforts))
     {
       LOG_ERROR("Failed to unload joint feedback groups_number");
       return false;
@@ -149,6 +201,8 @@ bool JointFeedbackEx::unload(industrial::byte_array::ByteArray *buffer)
     {
       tmp_msg.init(j_feedback);
       this->joint_feedback_messages_.push_back(tmp_msg);
+      this->efforts_.push_back(efforts);
+      this->has_efforts_.push_back(has_efforts);
     }
   }
 
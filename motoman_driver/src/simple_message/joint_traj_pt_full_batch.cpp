@@ -0,0 +1,251 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+
+#ifndef FLATHEADERS
+#include "motoman_driver/simple_message/joint_traj_pt_full_batch.h"
+#include "motoman_driver/simple_message/motoman_simple_message.h"
+#include "simple_message/joint_traj_pt_full.h"
+#include "simple_message/shared_types.h"
+#include "simple_message/log_wrapper.h"
+#else
+#include "joint_traj_pt_full_batch.h"  // NOLINT(build/include)
+#include "motoman_simple_message.h"    // NOLINT(build/include)
+#include "joint_traj_pt_full.h"        // NOLINT(build/include)
+#include "shared_types.h"              // NOLINT(build/include)
+#include "log_wrapper.h"               // NOLINT(build/include)
+#endif
+
+using industrial::byte_array::ByteArray;
+using industrial::joint_traj_pt_full::JointTrajPtFull;
+using industrial::shared_types::shared_int;
+using industrial::simple_message::SimpleMessage;
+namespace StandardMsgTypes = industrial::simple_message::StandardMsgTypes;
+namespace MotomanMsgTypes = motoman::simple_message::MotomanMsgTypes;
+
+namespace industrial
+{
+namespace joint_traj_pt_full_batch
+{
+
+namespace
+{
+// size of the data of one group: a JointTrajPtFull without its sequence
+unsigned int groupDataLength()
+{
+  JointTrajPtFull sample;
+  return sample.byteLength() - sizeof(shared_int);
+}
+}  // namespace
+
+JointTrajPtFullBatch::JointTrajPtFullBatch(void)
+{
+  this->init();
+}
+JointTrajPtFullBatch::~JointTrajPtFullBatch(void)
+{
+}
+
+void JointTrajPtFullBatch::init()
+{
+  this->num_points_ = 0;
+  this->num_groups_ = 0;
+  this->sequence_ = 0;
+  this->data_.init();
+}
+
+bool JointTrajPtFullBatch::addPoint(SimpleMessage &msg)
+{
+  ByteArray point = msg.getData();
+  ByteArray group_data;
+  shared_int num_groups;
+  shared_int sequence;
+
+  switch (msg.getMessageType())
+  {
+  case StandardMsgTypes::JOINT_TRAJ_PT_FULL:
+  {
+    // the sequence sits between the robot_id and the rest of the group data
+    shared_int robot_id;
+    if (!point.unloadFront(robot_id) || !point.unloadFront(sequence))
+    {
+      LOG_ERROR("Failed to unload joint traj. pt. header");
+      return false;
+    }
+    num_groups = 1;
+    group_data.load(robot_id);
+    break;
+  }
+  case MotomanMsgTypes::ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_EX:
+    if (!point.unloadFront(num_groups) || !point.unloadFront(sequence))
+    {
+      LOG_ERROR("Failed to unload joint traj. pt. header");
+      return false;
+    }
+    break;
+  default:
+    LOG_ERROR("Message type %d can't be batched", msg.getMessageType());
+    return false;
+  }
+
+  if (num_groups <= 0 || num_groups > MAX_NUM_GROUPS ||
+      group_data.getBufferSize() + point.getBufferSize() != num_groups * groupDataLength())
+  {
+    LOG_ERROR("Invalid joint traj. pt. for a batch (%d groups)", num_groups);
+    return false;
+  }
+
+  // only consecutive points of the same groups, up to the capacity of the controller
+  if (this->num_points_ > 0 &&
+      (num_groups != this->num_groups_ || sequence != this->sequence_ + this->num_points_))
+    return false;
+  if ((this->num_points_ + 1) * num_groups > MAX_BATCH_DATA)
+    return false;
+
+  if (!group_data.load(point))
+  {
+    LOG_ERROR("Failed to copy joint traj. pt. data");
+    return false;
+  }
+  if (!this->data_.load(group_data))
+  {
+    LOG_ERROR("Failed to load joint traj. pt. data into the batch");
+    return false;
+  }
+
+  if (this->num_points_ == 0)
+  {
+    this->num_groups_ = num_groups;
+    this->sequence_ = sequence;
+  }
+  this->num_points_++;
+  return true;
+}
+
+void JointTrajPtFullBatch::copyFrom(JointTrajPtFullBatch &src)
+{
+  this->num_points_ = src.num_points_;
+  this->num_groups_ = src.num_groups_;
+  this->sequence_ = src.sequence_;
+  this->data_.copyFrom(src.data_);
+}
+
+bool JointTrajPtFullBatch::operator==(JointTrajPtFullBatch &rhs)
+{
+  if (this->num_points_ != rhs.num_points_ || this->num_groups_ != rhs.num_groups_ ||
+      this->sequence_ != rhs.sequence_ || this->data_.getBufferSize() != rhs.data_.getBufferSize())
+    return false;
+
+  // compare copies: unloading empties them
+  ByteArray lhs_data, rhs_data;
+  lhs_data.copyFrom(this->data_);
+  rhs_data.copyFrom(rhs.data_);
+  std::vector<char> lhs_bytes(lhs_data.getBufferSize()), rhs_bytes(rhs_data.getBufferSize());
+  if (!lhs_bytes.empty() &&
+      (!lhs_data.unloadFront(&lhs_bytes[0], lhs_bytes.size()) ||
+       !rhs_data.unloadFront(&rhs_bytes[0], rhs_bytes.size())))
+    return false;
+  return lhs_bytes == rhs_bytes;
+}
+
+bool JointTrajPtFullBatch::load(industrial::byte_array::ByteArray *buffer)
+{
+  LOG_COMM("Executing joint traj. pt. batch load");
+
+  if (!buffer->load(this->num_points_))
+  {
+    LOG_ERROR("Failed to load joint traj. pt. batch num_points");
+    return false;
+  }
+
+  if (!buffer->load(this->num_groups_))
+  {
+    LOG_ERROR("Failed to load joint traj. pt. batch num_groups");
+    return false;
+  }
+
+  if (!buffer->load(this->sequence_))
+  {
+    LOG_ERROR("Failed to load joint traj. pt. batch sequence number");
+    return false;
+  }
+
+  if (!buffer->load(this->data_))
+  {
+    LOG_ERROR("Failed to load joint traj. pt. batch data");
+    return false;
+  }
+
+  LOG_COMM("Joint traj. pt. batch successfully loaded");
+  return true;
+}
+
+// The length of a batch is only known from its header: it is unloaded from
+// the front of the buffer, which must start with the batch.
+bool JointTrajPtFullBatch::unload(industrial::byte_array::ByteArray *buffer)
+{
+  LOG_COMM("Executing joint traj. pt. batch unload");
+
+  this->init();
+
+  if (!buffer->unloadFront(this->num_points_) || !buffer->unloadFront(this->num_groups_) ||
+      !buffer->unloadFront(this->sequence_))
+  {
+    LOG_ERROR("Failed to unload joint traj. pt. batch header");
+    return false;
+  }
+
+  if (this->num_points_ < 0 || this->num_groups_ < 0 ||
+      this->num_points_ * this->num_groups_ > MAX_BATCH_DATA)
+  {
+    LOG_ERROR("Invalid joint traj. pt. batch size (%d points of %d groups)", this->num_points_, this->num_groups_);
+    return false;
+  }
+
+  unsigned int data_length = this->num_points_ * this->num_groups_ * groupDataLength();
+  if (data_length > 0)
+  {
+    std::vector<char> data(data_length);
+    if (!buffer->unloadFront(&data[0], data_length))
+    {
+      LOG_ERROR("Failed to unload joint traj. pt. batch data");
+      return false;
+    }
+    this->data_.init(&data[0], data_length);
+  }
+
+  LOG_COMM("Joint traj. pt. batch successfully unloaded");
+  return true;
+}
+
+}  // namespace joint_traj_pt_full_batch
+}  // namespace industrial
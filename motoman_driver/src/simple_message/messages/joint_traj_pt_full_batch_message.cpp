@@ -0,0 +1,124 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FLATHEADERS
+#include "motoman_driver/simple_message/messages/joint_traj_pt_full_batch_message.h"
+#include "simple_message/byte_array.h"
+#include "simple_message/log_wrapper.h"
+#include "motoman_driver/simple_message/motoman_simple_message.h"
+#else
+#include "joint_traj_pt_full_batch_message.h"  // NOLINT(build/include)
+#include "byte_array.h"                        // NOLINT(build/include)
+#include "log_wrapper.h"                       // NOLINT(build/include)
+#include "motoman_simple_message.h"            // NOLINT(build/include)
+#endif
+
+using industrial::byte_array::ByteArray;
+namespace MotomanMsgTypes = motoman::simple_message::MotomanMsgTypes;
+
+namespace industrial
+{
+namespace joint_traj_pt_full_batch_message
+{
+
+JointTrajPtFullBatchMessage::JointTrajPtFullBatchMessage(void)
+{
+  this->init();
+}
+
+JointTrajPtFullBatchMessage::~JointTrajPtFullBatchMessage(void)
+{
+}
+
+bool JointTrajPtFullBatchMessage::init(industrial::simple_message::SimpleMessage & msg)
+{
+  bool rtn = false;
+  ByteArray data = msg.getData();
+  this->init();
+
+  if (data.unload(this->batch_))
+  {
+    rtn = true;
+  }
+  else
+  {
+    LOG_ERROR("Failed to unload joint traj pt batch data");
+  }
+  return rtn;
+}
+
+void JointTrajPtFullBatchMessage::init(industrial::joint_traj_pt_full_batch::JointTrajPtFullBatch & batch)
+{
+  this->init();
+  this->batch_.copyFrom(batch);
+}
+
+void JointTrajPtFullBatchMessage::init()
+{
+  this->setMessageType(MotomanMsgTypes::ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_BATCH);
+  this->batch_.init();
+}
+
+bool JointTrajPtFullBatchMessage::load(ByteArray *buffer)
+{
+  bool rtn = false;
+  LOG_COMM("Executing joint traj. pt. batch message load");
+  if (buffer->load(this->batch_))
+  {
+    rtn = true;
+  }
+  else
+  {
+    rtn = false;
+    LOG_ERROR("Failed to load joint traj. pt. batch data");
+  }
+  return rtn;
+}
+
+bool JointTrajPtFullBatchMessage::unload(ByteArray *buffer)
+{
+  bool rtn = false;
+  LOG_COMM("Executing joint traj pt batch message unload");
+
+  if (buffer->unload(this->batch_))
+  {
+    rtn = true;
+  }
+  else
+  {
+    rtn = false;
+    LOG_ERROR("Failed to unload joint traj pt batch data");
+  }
+  return rtn;
+}
+
+}  // namespace joint_traj_pt_full_batch_message
+}  // namespace industrial
@@ -0,0 +1,170 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef ROS
+#include "motoman_driver/simple_message/motoman_io_changed.h"
+#include "simple_message/shared_types.h"
+#include "simple_message/log_wrapper.h"
+#endif
+
+#ifdef MOTOPLUS
+#include "motoman_io_changed.h"      // NOLINT(build/include)
+#include "shared_types.h"            // NOLINT(build/include)
+#include "log_wrapper.h"             // NOLINT(build/include)
+#endif
+
+using industrial::shared_types::shared_int;
+using motoman::simple_message::io_ctrl::IoMultiSize;
+
+namespace motoman
+{
+namespace simple_message
+{
+namespace io_ctrl_reply
+{
+
+const shared_int IoChanged::MAX_ELEMENTS;
+
+IoChanged::IoChanged(void)
+{
+  this->init();
+}
+IoChanged::~IoChanged(void)
+{
+}
+
+void IoChanged::init()
+{
+  this->num_elements_ = 0;
+  this->time_ = 0;
+}
+
+bool IoChanged::addElement(shared_int address, IoMultiSize size, shared_int value)
+{
+  if (this->num_elements_ >= MAX_ELEMENTS)
+    return false;
+
+  this->address_[this->num_elements_] = address;
+  this->size_[this->num_elements_] = size;
+  this->value_[this->num_elements_] = value;
+  this->num_elements_++;
+  return true;
+}
+
+void IoChanged::copyFrom(IoChanged &src)
+{
+  this->num_elements_ = src.num_elements_;
+  this->time_ = src.time_;
+  for (shared_int i = 0; i < src.num_elements_; ++i)
+  {
+    this->address_[i] = src.address_[i];
+    this->size_[i] = src.size_[i];
+    this->value_[i] = src.value_[i];
+  }
+}
+
+bool IoChanged::operator==(IoChanged &rhs)
+{
+  if (this->num_elements_ != rhs.num_elements_ || this->time_ != rhs.time_)
+    return false;
+
+  for (shared_int i = 0; i < this->num_elements_; ++i)
+  {
+    if (this->address_[i] != rhs.address_[i] || this->size_[i] != rhs.size_[i] ||
+        this->value_[i] != rhs.value_[i])
+      return false;
+  }
+  return true;
+}
+
+bool IoChanged::load(industrial::byte_array::ByteArray *buffer)
+{
+  LOG_COMM("Executing IoChanged load");
+
+  if (!buffer->load(this->time_) || !buffer->load(this->num_elements_))
+  {
+    LOG_ERROR("Failed to load IoChanged header");
+    return false;
+  }
+
+  for (shared_int i = 0; i < this->num_elements_; ++i)
+  {
+    if (!buffer->load(this->address_[i]) || !buffer->load(this->size_[i]) ||
+        !buffer->load(this->value_[i]))
+    {
+      LOG_ERROR("Failed to load IoChanged element %d", i);
+      return false;
+    }
+  }
+
+  LOG_COMM("IoChanged data successfully loaded");
+  return true;
+}
+
+// The length of the data is only known from its header: it is unloaded from
+// the front of the buffer, which must start with the data.
+bool IoChanged::unload(industrial::byte_array::ByteArray *buffer)
+{
+  LOG_COMM("Executing IoChanged unload");
+
+  this->init();
+
+  shared_int num_elements;
+  if (!buffer->unloadFront(this->time_) || !buffer->unloadFront(num_elements))
+  {
+    LOG_ERROR("Failed to unload IoChanged header");
+    return false;
+  }
+
+  if (num_elements < 0 || num_elements > MAX_ELEMENTS)
+  {
+    LOG_ERROR("Invalid IoChanged size (%d elements)", num_elements);
+    return false;
+  }
+
+  for (shared_int i = 0; i < num_elements; ++i)
+  {
+    if (!buffer->unloadFront(this->address_[i]) || !buffer->unloadFront(this->size_[i]) ||
+        !buffer->unloadFront(this->value_[i]))
+    {
+      LOG_ERROR("Failed to unload IoChanged element %d", i);
+      return false;
+    }
+  }
+  this->num_elements_ = num_elements;
+
+  LOG_COMM("IoChanged data successfully unloaded");
+  return true;
+}
+
+}  // namespace io_ctrl_reply
+}  // namespace simple_message
+}  // namespace motoman
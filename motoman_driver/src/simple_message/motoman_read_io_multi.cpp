@@ -0,0 +1,162 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef ROS
+#include "motoman_driver/simple_message/motoman_read_io_multi.h"
+#include "simple_message/shared_types.h"
+#include "simple_message/log_wrapper.h"
+#endif
+
+#ifdef MOTOPLUS
+#include "motoman_read_io_multi.h"  // NOLINT(build/include)
+#include "shared_types.h"           // NOLINT(build/include)
+#include "log_wrapper.h"            // NOLINT(build/include)
+#endif
+
+using industrial::shared_types::shared_int;
+
+namespace motoman
+{
+namespace simple_message
+{
+namespace io_ctrl
+{
+
+const shared_int ReadIOMulti::MAX_ELEMENTS;
+
+ReadIOMulti::ReadIOMulti(void)
+{
+  this->init();
+}
+ReadIOMulti::~ReadIOMulti(void)
+{
+}
+
+void ReadIOMulti::init()
+{
+  this->num_elements_ = 0;
+}
+
+bool ReadIOMulti::addElement(shared_int address, IoMultiSize size)
+{
+  if (this->num_elements_ >= MAX_ELEMENTS)
+    return false;
+
+  this->address_[this->num_elements_] = address;
+  this->size_[this->num_elements_] = size;
+  this->num_elements_++;
+  return true;
+}
+
+void ReadIOMulti::copyFrom(ReadIOMulti &src)
+{
+  this->num_elements_ = src.num_elements_;
+  for (shared_int i = 0; i < src.num_elements_; ++i)
+  {
+    this->address_[i] = src.address_[i];
+    this->size_[i] = src.size_[i];
+  }
+}
+
+bool ReadIOMulti::operator==(ReadIOMulti &rhs)
+{
+  if (this->num_elements_ != rhs.num_elements_)
+    return false;
+
+  for (shared_int i = 0; i < this->num_elements_; ++i)
+  {
+    if (this->address_[i] != rhs.address_[i] || this->size_[i] != rhs.size_[i])
+      return false;
+  }
+  return true;
+}
+
+bool ReadIOMulti::load(industrial::byte_array::ByteArray *buffer)
+{
+  LOG_COMM("Executing ReadIOMulti command load");
+
+  if (!buffer->load(this->num_elements_))
+  {
+    LOG_ERROR("Failed to load ReadIOMulti num_elements");
+    return false;
+  }
+
+  for (shared_int i = 0; i < this->num_elements_; ++i)
+  {
+    if (!buffer->load(this->address_[i]) || !buffer->load(this->size_[i]))
+    {
+      LOG_ERROR("Failed to load ReadIOMulti element %d", i);
+      return false;
+    }
+  }
+
+  LOG_COMM("ReadIOMulti data successfully loaded");
+  return true;
+}
+
+// The length of the data is only known from its header: it is unloaded from
+// the front of the buffer, which must start with the data.
+bool ReadIOMulti::unload(industrial::byte_array::ByteArray *buffer)
+{
+  LOG_COMM("Executing ReadIOMulti command unload");
+
+  this->init();
+
+  shared_int num_elements;
+  if (!buffer->unloadFront(num_elements))
+  {
+    LOG_ERROR("Failed to unload ReadIOMulti num_elements");
+    return false;
+  }
+
+  if (num_elements < 0 || num_elements > MAX_ELEMENTS)
+  {
+    LOG_ERROR("Invalid ReadIOMulti size (%d elements)", num_elements);
+    return false;
+  }
+
+  for (shared_int i = 0; i < num_elements; ++i)
+  {
+    if (!buffer->unloadFront(this->address_[i]) || !buffer->unloadFront(this->size_[i]))
+    {
+      LOG_ERROR("Failed to unload ReadIOMulti element %d", i);
+      return false;
+    }
+  }
+  this->num_elements_ = num_elements;
+
+  LOG_COMM("ReadIOMulti data successfully unloaded");
+  return true;
+}
+
+}  // namespace io_ctrl
+}  // namespace simple_message
+}  // namespace motoman
@@ -0,0 +1,192 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+#ifdef ROS
+#include "motoman_driver/simple_message/motoman_read_io_multi_reply.h"
+#include "simple_message/shared_types.h"
+#include "simple_message/log_wrapper.h"
+#endif
+
+#ifdef MOTOPLUS
+#include "motoman_read_io_multi_reply.h"  // NOLINT(build/include)
+#include "shared_types.h"                 // NOLINT(build/include)
+#include "log_wrapper.h"                  // NOLINT(build/include)
+#endif
+
+using industrial::shared_types::shared_int;
+namespace IoMultiReplyResultCodes = motoman::simple_message::io_ctrl_reply::IoMultiReplyResultCodes;
+
+namespace motoman
+{
+namespace simple_message
+{
+namespace io_ctrl_reply
+{
+
+const shared_int ReadIOMultiReply::MAX_ELEMENTS;
+
+ReadIOMultiReply::ReadIOMultiReply(void)
+{
+  this->init();
+}
+ReadIOMultiReply::~ReadIOMultiReply(void)
+{
+}
+
+void ReadIOMultiReply::init()
+{
+  this->num_elements_ = 0;
+  this->result_code_ = IoMultiReplyResultCodes::SUCCESS;
+}
+
+bool ReadIOMultiReply::addElement(shared_int value, shared_int result_code)
+{
+  if (this->num_elements_ >= MAX_ELEMENTS)
+    return false;
+
+  this->value_[this->num_elements_] = value;
+  this->element_result_code_[this->num_elements_] = result_code;
+  this->num_elements_++;
+  return true;
+}
+
+std::string ReadIOMultiReply::getResultString(shared_int result_code)
+{
+  switch (result_code)
+  {
+  case IoMultiReplyResultCodes::READ_ADDRESS_INVALID:
+     return "Illegal address for read: outside permitted range on this controller, "
+            "see documentation (" + std::to_string(IoMultiReplyResultCodes::READ_ADDRESS_INVALID) + ")";
+  case IoMultiReplyResultCodes::WRITE_ADDRESS_INVALID:
+     return "Illegal address for write: outside permitted range on this controller, "
+            "see documentation (" + std::to_string(IoMultiReplyResultCodes::WRITE_ADDRESS_INVALID) + ")";
+  case IoMultiReplyResultCodes::WRITE_VALUE_INVALID:
+     return "Illegal value for the type of IO element addressed "
+            "(" + std::to_string(IoMultiReplyResultCodes::WRITE_VALUE_INVALID) + ")";
+  case IoMultiReplyResultCodes::READ_API_ERROR:
+     return "The MotoPlus function MpReadIO returned -1. No further information is available "
+            "(" + std::to_string(IoMultiReplyResultCodes::READ_API_ERROR) + ")";
+  case IoMultiReplyResultCodes::WRITE_API_ERROR:
+     return "The MotoPlus function MpWriteIO returned -1. No further information is available "
+            "(" + std::to_string(IoMultiReplyResultCodes::WRITE_API_ERROR) + ")";
+  case IoMultiReplyResultCodes::SUCCESS:
+    return "Success";
+  default:
+    return "Unknown";
+  }
+}
+
+void ReadIOMultiReply::copyFrom(ReadIOMultiReply &src)
+{
+  this->num_elements_ = src.num_elements_;
+  this->result_code_ = src.result_code_;
+  for (shared_int i = 0; i < src.num_elements_; ++i)
+  {
+    this->value_[i] = src.value_[i];
+    this->element_result_code_[i] = src.element_result_code_[i];
+  }
+}
+
+bool ReadIOMultiReply::operator==(ReadIOMultiReply &rhs)
+{
+  if (this->num_elements_ != rhs.num_elements_ || this->result_code_ != rhs.result_code_)
+    return false;
+
+  for (shared_int i = 0; i < this->num_elements_; ++i)
+  {
+    if (this->value_[i] != rhs.value_[i] || this->element_result_code_[i] != rhs.element_result_code_[i])
+      return false;
+  }
+  return true;
+}
+
+bool ReadIOMultiReply::load(industrial::byte_array::ByteArray *buffer)
+{
+  LOG_COMM("Executing ReadIOMultiReply load");
+
+  if (!buffer->load(this->num_elements_) || !buffer->load(this->result_code_))
+  {
+    LOG_ERROR("Failed to load ReadIOMultiReply header");
+    return false;
+  }
+
+  for (shared_int i = 0; i < this->num_elements_; ++i)
+  {
+    if (!buffer->load(this->value_[i]) || !buffer->load(this->element_result_code_[i]))
+    {
+      LOG_ERROR("Failed to load ReadIOMultiReply element %d", i);
+      return false;
+    }
+  }
+
+  LOG_COMM("ReadIOMultiReply data successfully loaded");
+  return true;
+}
+
+// The length of the reply is only known from its header: it is unloaded from
+// the front of the buffer, which must start with the reply.
+bool ReadIOMultiReply::unload(industrial::byte_array::ByteArray *buffer)
+{
+  LOG_COMM("Executing ReadIOMultiReply unload");
+
+  this->init();
+
+  shared_int num_elements;
+  if (!buffer->unloadFront(num_elements) || !buffer->unloadFront(this->result_code_))
+  {
+    LOG_ERROR("Failed to unload ReadIOMultiReply header");
+    return false;
+  }
+
+  if (num_elements < 0 || num_elements > MAX_ELEMENTS)
+  {
+    LOG_ERROR("Invalid ReadIOMultiReply size (%d elements)", num_elements);
+    return false;
+  }
+
+  for (shared_int i = 0; i < num_elements; ++i)
+  {
+    if (!buffer->unloadFront(this->value_[i]) || !buffer->unloadFront(this->element_result_code_[i]))
+    {
+      LOG_ERROR("Failed to unload ReadIOMultiReply element %d", i);
+      return false;
+    }
+  }
+  this->num_elements_ = num_elements;
+
+  LOG_COMM("ReadIOMultiReply data successfully unloaded");
+  return true;
+}
+
+}  // namespace io_ctrl_reply
+}  // namespace simple_message
+}  // namespace motoman
@@ -0,0 +1,161 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef ROS
+#include "motoman_driver/simple_message/motoman_write_io_multi_reply.h"
+#include "simple_message/shared_types.h"
+#include "simple_message/log_wrapper.h"
+#endif
+
+#ifdef MOTOPLUS
+#include "motoman_write_io_multi_reply.h"  // NOLINT(build/include)
+#include "shared_types.h"                  // NOLINT(build/include)
+#include "log_wrapper.h"                   // NOLINT(build/include)
+#endif
+
+using industrial::shared_types::shared_int;
+namespace IoMultiReplyResultCodes = motoman::simple_message::io_ctrl_reply::IoMultiReplyResultCodes;
+
+namespace motoman
+{
+namespace simple_message
+{
+namespace io_ctrl_reply
+{
+
+const shared_int WriteIOMultiReply::MAX_ELEMENTS;
+
+WriteIOMultiReply::WriteIOMultiReply(void)
+{
+  this->init();
+}
+WriteIOMultiReply::~WriteIOMultiReply(void)
+{
+}
+
+void WriteIOMultiReply::init()
+{
+  this->num_elements_ = 0;
+  this->result_code_ = IoMultiReplyResultCodes::SUCCESS;
+}
+
+bool WriteIOMultiReply::addElement(shared_int result_code)
+{
+  if (this->num_elements_ >= MAX_ELEMENTS)
+    return false;
+
+  this->element_result_code_[this->num_elements_] = result_code;
+  this->num_elements_++;
+  return true;
+}
+
+void WriteIOMultiReply::copyFrom(WriteIOMultiReply &src)
+{
+  this->num_elements_ = src.num_elements_;
+  this->result_code_ = src.result_code_;
+  for (shared_int i = 0; i < src.num_elements_; ++i)
+    this->element_result_code_[i] = src.element_result_code_[i];
+}
+
+bool WriteIOMultiReply::operator==(WriteIOMultiReply &rhs)
+{
+  if (this->num_elements_ != rhs.num_elements_ || this->result_code_ != rhs.result_code_)
+    return false;
+
+  for (shared_int i = 0; i < this->num_elements_; ++i)
+  {
+    if (this->element_result_code_[i] != rhs.element_result_code_[i])
+      return false;
+  }
+  return true;
+}
+
+bool WriteIOMultiReply::load(industrial::byte_array::ByteArray *buffer)
+{
+  LOG_COMM("Executing WriteIOMultiReply load");
+
+  if (!buffer->load(this->num_elements_) || !buffer->load(this->result_code_))
+  {
+    LOG_ERROR("Failed to load WriteIOMultiReply header");
+    return false;
+  }
+
+  for (shared_int i = 0; i < this->num_elements_; ++i)
+  {
+    if (!buffer->load(this->element_result_code_[i]))
+    {
+      LOG_ERROR("Failed to load WriteIOMultiReply element %d", i);
+      return false;
+    }
+  }
+
+  LOG_COMM("WriteIOMultiReply data successfully loaded");
+  return true;
+}
+
+// The length of the reply is only known from its header: it is unloaded from
+// the front of the buffer, which must start with the reply.
+bool WriteIOMultiReply::unload(industrial::byte_array::ByteArray *buffer)
+{
+  LOG_COMM("Executing WriteIOMultiReply unload");
+
+  this->init();
+
+  shared_int num_elements;
+  if (!buffer->unloadFront(num_elements) || !buffer->unloadFront(this->result_code_))
+  {
+    LOG_ERROR("Failed to unload WriteIOMultiReply header");
+    return false;
+  }
+
+  if (num_elements < 0 || num_elements > MAX_ELEMENTS)
+  {
+    LOG_ERROR("Invalid WriteIOMultiReply size (%d elements)", num_elements);
+    return false;
+  }
+
+  for (shared_int i = 0; i < num_elements; ++i)
+  {
+    if (!buffer->unloadFront(this->element_result_code_[i]))
+    {
+      LOG_ERROR("Failed to unload WriteIOMultiReply element %d", i);
+      return false;
+    }
+  }
+  this->num_elements_ = num_elements;
+
+  LOG_COMM("WriteIOMultiReply data successfully unloaded");
+  return true;
+}
+
+}  // namespace io_ctrl_reply
+}  // namespace simple_message
+}  // namespace motoman
@@ -0,0 +1,159 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/industrial_robot_client/controller_clock.h"
+#include <gtest/gtest.h>
+#include <ros/time.h>
+#include <cmath>
+
+using industrial_robot_client::controller_clock::ControllerClock;
+
+namespace
+{
+
+const double PERIOD = 0.004;  // between the samples, on the controller clock (sec)
+const double BASE = 100.0;    // ROS time of controller time 0 (sec)
+const double TOLERANCE = 1e-6;
+
+// sample taken at the given unwrapped controller time, received with the given latency
+double sample(ControllerClock* clock, double time, double latency = 0.0)
+{
+  return clock->toRosTime(std::fmod(time, 1024.0), ros::Time(BASE + time + latency)).toSec();
+}
+
+}  // namespace
+
+TEST(ControllerClock, wrapAround)
+{
+  ControllerClock clock;
+
+  EXPECT_NEAR(BASE + 1023.992, sample(&clock, 1023.992), TOLERANCE);
+  EXPECT_NEAR(BASE + 1023.996, sample(&clock, 1023.996), TOLERANCE);
+
+  // 1024 s is sent as 0, and it keeps the offset even though it is received late
+  EXPECT_NEAR(BASE + 1024.0, sample(&clock, 1024.0, 0.002), TOLERANCE);
+  EXPECT_EQ(2u, clock.sequence());
+  EXPECT_NEAR(BASE + 1024.004, sample(&clock, 1024.004), TOLERANCE);
+  EXPECT_EQ(3u, clock.sequence());
+  EXPECT_EQ(0u, clock.dropped());
+}
+
+TEST(ControllerClock, droppedSample)
+{
+  ControllerClock clock;
+
+  sample(&clock, 10.0);
+  sample(&clock, 10.0 + PERIOD);
+  EXPECT_EQ(0u, clock.lastDropped());
+
+  // the sample of 10.008 is missing
+  EXPECT_NEAR(BASE + 10.0 + 3 * PERIOD, sample(&clock, 10.0 + 3 * PERIOD), TOLERANCE);
+  EXPECT_EQ(1u, clock.lastDropped());
+  EXPECT_EQ(1u, clock.dropped());
+  EXPECT_EQ(3u, clock.sequence());
+
+  sample(&clock, 10.0 + 4 * PERIOD);
+  EXPECT_EQ(0u, clock.lastDropped());
+  EXPECT_EQ(1u, clock.dropped());
+  EXPECT_EQ(4u, clock.sequence());
+}
+
+// the messages of the other groups of a sample have the same time
+TEST(ControllerClock, sameSample)
+{
+  ControllerClock clock;
+
+  sample(&clock, 10.0);
+  double time = sample(&clock, 10.0 + PERIOD);
+  EXPECT_EQ(time, sample(&clock, 10.0 + PERIOD, 0.0005));
+  EXPECT_EQ(1u, clock.sequence());
+}
+
+// past a 1 s gap the clocks are synchronized again: the controller may have restarted its clock
+TEST(ControllerClock, longGap)
+{
+  ControllerClock clock;
+
+  sample(&clock, 10.0, 0.002);
+  sample(&clock, 10.0 + PERIOD);
+  EXPECT_NEAR(BASE + 10.0 + 2 * PERIOD, sample(&clock, 10.0 + 2 * PERIOD, 0.001), TOLERANCE);
+
+  // the first sample after the gap sets the offset, even though it is received late
+  EXPECT_NEAR(BASE + 12.003, sample(&clock, 12.0, 0.003), TOLERANCE);
+  EXPECT_EQ(0u, clock.lastDropped());
+  EXPECT_EQ(0u, clock.dropped());
+  EXPECT_EQ(2u, clock.sequence());
+
+  // clock restarted
+  EXPECT_NEAR(BASE + 12.0 + PERIOD, sample(&clock, 12.0 + PERIOD), TOLERANCE);
+  EXPECT_NEAR(BASE + 50.0, clock.toRosTime(1.0, ros::Time(BASE + 50.0)).toSec(), TOLERANCE);
+  EXPECT_NEAR(BASE + 50.0 + PERIOD, clock.toRosTime(1.0 + PERIOD, ros::Time(BASE + 50.0 + PERIOD)).toSec(),
+              TOLERANCE);
+  EXPECT_EQ(0u, clock.dropped());
+}
+
+// the offset is the one of the sample received the fastest
+TEST(ControllerClock, minOffset)
+{
+  ControllerClock clock;
+
+  EXPECT_NEAR(BASE + 10.005, sample(&clock, 10.0, 0.005), TOLERANCE);
+  EXPECT_NEAR(BASE + 10.0 + PERIOD + 0.001, sample(&clock, 10.0 + PERIOD, 0.001), TOLERANCE);
+
+  // a late sample keeps the offset
+  EXPECT_NEAR(BASE + 10.0 + 2 * PERIOD + 0.001, sample(&clock, 10.0 + 2 * PERIOD, 0.010), TOLERANCE);
+  EXPECT_NEAR(BASE + 10.0 + 3 * PERIOD, sample(&clock, 10.0 + 3 * PERIOD), TOLERANCE);
+  EXPECT_NEAR(BASE + 10.0 + 4 * PERIOD, sample(&clock, 10.0 + 4 * PERIOD, 0.002), TOLERANCE);
+}
+
+// the offset drifts up by at most 1e-4 sec/sec, and follows a slower drift between the clocks
+TEST(ControllerClock, drift)
+{
+  ControllerClock clock;
+  const double drift = 5e-5;
+  double time = 10.0;
+
+  for (int i = 0; i < 2500; ++i, time += PERIOD)
+    EXPECT_NEAR(BASE + time + (time - 10.0) * drift, sample(&clock, time, (time - 10.0) * drift), TOLERANCE);
+
+  // all the samples are late from now on: the offset follows them at the maximum drift only
+  double start = time;
+  for (int i = 0; i < 2500; ++i, time += PERIOD)
+    sample(&clock, time, (start - 10.0) * drift + 0.050);
+  double offset = sample(&clock, time, (start - 10.0) * drift + 0.050) - (BASE + time);
+  EXPECT_NEAR((start - 10.0) * drift + (time - start) * 1e-4, offset, 1e-5);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,222 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/industrial_robot_client/frame_recorder.h"
+#include "simple_message/byte_array.h"
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using industrial::byte_array::ByteArray;
+using industrial::shared_types::shared_int;
+using industrial::simple_message::SimpleMessage;
+using industrial_robot_client::frame_recorder::FrameReader;
+using industrial_robot_client::frame_recorder::FrameRecorder;
+using industrial_robot_client::frame_recorder::RecordHeader;
+namespace CommTypes = industrial::simple_message::CommTypes;
+namespace FrameDirections = industrial_robot_client::frame_recorder::FrameDirections;
+namespace ReplyTypes = industrial::simple_message::ReplyTypes;
+
+namespace
+{
+
+const size_t RECORDING_SIZE = 4096;
+
+// a recording file, removed when the test ends
+class RecordingFile
+{
+public:
+  RecordingFile()
+  {
+    char path[] = "/tmp/test_frame_recorder_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd >= 0)
+      ::close(fd);
+    path_ = path;
+  }
+
+  ~RecordingFile()
+  {
+    unlink(path_.c_str());
+  }
+
+  const std::string &path() const
+  {
+    return path_;
+  }
+
+  size_t size() const
+  {
+    struct stat st;
+    return (stat(path_.c_str(), &st) == 0) ? st.st_size : 0;
+  }
+
+private:
+  std::string path_;
+};
+
+SimpleMessage message(int msg_type, int comm_type, int values)
+{
+  ByteArray data;
+  for (int i = 0; i < values; i++)
+    data.load(static_cast<shared_int>(i));
+  SimpleMessage msg;
+  msg.init(msg_type, comm_type, ReplyTypes::INVALID, data);
+  return msg;
+}
+
+// the frame as SmplMsgConnection puts it on the wire
+std::vector<char> wireFrame(SimpleMessage msg)
+{
+  ByteArray body, frame;
+  msg.toByteArray(body);
+  frame.load(static_cast<shared_int>(body.getBufferSize()));
+  frame.load(body);
+  std::vector<char> bytes(frame.getBufferSize());
+  frame.unloadFront(bytes.data(), bytes.size());
+  return bytes;
+}
+
+void expectFrame(FrameReader* reader, int direction, unsigned int connection, SimpleMessage msg)
+{
+  RecordHeader header;
+  const char* frame;
+  ASSERT_TRUE(reader->next(&header, &frame));
+  EXPECT_EQ(direction, header.direction);
+  EXPECT_EQ(connection, header.connection);
+  std::vector<char> expected = wireFrame(msg);
+  ASSERT_EQ(expected.size(), header.size);
+  EXPECT_EQ(0, std::memcmp(expected.data(), frame, expected.size()));
+}
+
+}  // namespace
+
+// the frames are read back as they were recorded, in order, with their direction and connection
+TEST(FrameRecorder, roundTrip)
+{
+  RecordingFile file;
+  SimpleMessage request = message(2001, CommTypes::SERVICE_REQUEST, 3);
+  SimpleMessage reply = message(2002, CommTypes::SERVICE_REPLY, 0);
+  SimpleMessage topic = message(15, CommTypes::TOPIC, 11);
+
+  FrameRecorder recorder;
+  ASSERT_TRUE(recorder.open(file.path(), RECORDING_SIZE));
+  unsigned int first = recorder.addConnection(), second = recorder.addConnection();
+  EXPECT_EQ(0u, first);
+  EXPECT_EQ(1u, second);
+  recorder.record(FrameDirections::SENT, first, request);
+  recorder.record(FrameDirections::RECEIVED, first, reply);
+  recorder.record(FrameDirections::RECEIVED, second, topic);
+  recorder.close();
+  EXPECT_EQ(0u, recorder.dropped());
+  EXPECT_LT(file.size(), RECORDING_SIZE);  // trimmed
+
+  FrameReader reader;
+  ASSERT_TRUE(reader.open(file.path()));
+  for (int pass = 0; pass < 2; pass++)
+  {
+    expectFrame(&reader, FrameDirections::SENT, first, request);
+    expectFrame(&reader, FrameDirections::RECEIVED, first, reply);
+    expectFrame(&reader, FrameDirections::RECEIVED, second, topic);
+    RecordHeader header;
+    const char* frame;
+    EXPECT_FALSE(reader.next(&header, &frame));
+    reader.rewind();
+  }
+}
+
+// the stamps follow the recording order
+TEST(FrameRecorder, stamps)
+{
+  RecordingFile file;
+  SimpleMessage msg = message(15, CommTypes::TOPIC, 1);
+
+  FrameRecorder recorder;
+  ASSERT_TRUE(recorder.open(file.path(), RECORDING_SIZE));
+  recorder.record(FrameDirections::RECEIVED, 0, msg);
+  recorder.record(FrameDirections::RECEIVED, 0, msg);
+  recorder.close();
+
+  FrameReader reader;
+  ASSERT_TRUE(reader.open(file.path()));
+  RecordHeader first, second;
+  const char* frame;
+  ASSERT_TRUE(reader.next(&first, &frame));
+  ASSERT_TRUE(reader.next(&second, &frame));
+  EXPECT_GT(first.stamp, 0u);
+  EXPECT_LE(first.stamp, second.stamp);
+}
+
+// the frames that do not fit are dropped, and the ones recorded before are kept
+TEST(FrameRecorder, full)
+{
+  RecordingFile file;
+  SimpleMessage msg = message(15, CommTypes::TOPIC, 100);
+
+  FrameRecorder recorder;
+  ASSERT_TRUE(recorder.open(file.path(), 1024));
+  for (int i = 0; i < 5; i++)
+    recorder.record(FrameDirections::RECEIVED, 0, msg);
+  EXPECT_EQ(3u, recorder.dropped());
+  recorder.close();
+
+  FrameReader reader;
+  ASSERT_TRUE(reader.open(file.path()));
+  expectFrame(&reader, FrameDirections::RECEIVED, 0, msg);
+  expectFrame(&reader, FrameDirections::RECEIVED, 0, msg);
+  RecordHeader header;
+  const char* frame;
+  EXPECT_FALSE(reader.next(&header, &frame));
+}
+
+TEST(FrameRecorder, notARecording)
+{
+  RecordingFile file;
+  FILE* f = fopen(file.path().c_str(), "w");
+  ASSERT_TRUE(f != NULL);
+  fputs("not a recording, but long enough", f);
+  fclose(f);
+
+  FrameReader reader;
+  EXPECT_FALSE(reader.open(file.path()));
+  EXPECT_FALSE(reader.open(file.path() + ".missing"));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
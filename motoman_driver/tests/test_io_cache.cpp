@@ -0,0 +1,270 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/io_cache.h"
+#include "motoman_driver/simple_message/motoman_read_io_multi_reply.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using industrial::shared_types::shared_int;
+using motoman::io_cache::IoCache;
+using motoman::simple_message::io_ctrl::IoMultiSize;
+namespace IoMultiReplyResultCodes = motoman::simple_message::io_ctrl_reply::IoMultiReplyResultCodes;
+namespace IoMultiSizes = motoman::simple_message::io_ctrl::IoMultiSizes;
+
+namespace
+{
+
+// long enough for the values not to age during a test
+const double MAX_AGE = 10.0;
+
+std::vector<shared_int> ints(shared_int a, shared_int b)
+{
+  std::vector<shared_int> v;
+  v.push_back(a);
+  v.push_back(b);
+  return v;
+}
+
+std::vector<IoMultiSize> sizes(IoMultiSize a, IoMultiSize b)
+{
+  std::vector<IoMultiSize> v;
+  v.push_back(a);
+  v.push_back(b);
+  return v;
+}
+
+// reads an element, filling it with fill_value on a miss
+bool readOrFill(IoCache &cache, shared_int address, IoMultiSize size, shared_int fill_value, shared_int &value)
+{
+  unsigned int ticket;
+  if (cache.read(address, size, value, ticket))
+    return true;
+  cache.fill(address, size, fill_value, ticket);
+  value = fill_value;
+  return false;
+}
+
+}  // namespace
+
+TEST(IoCache, disabled)
+{
+  IoCache cache;
+  shared_int value;
+  unsigned int ticket;
+
+  cache.init(0.0);
+  EXPECT_FALSE(cache.isEnabled());
+  cache.write(5, IoMultiSizes::MREGISTER, 11, true);
+  EXPECT_FALSE(cache.read(5, IoMultiSizes::MREGISTER, value, ticket));
+
+  // nor counted
+  std::vector<shared_int> addresses;
+  std::vector<IoMultiSize> element_sizes;
+  std::vector<unsigned int> hits, misses;
+  cache.getStats(addresses, element_sizes, hits, misses);
+  EXPECT_TRUE(addresses.empty());
+}
+
+TEST(IoCache, readFill)
+{
+  IoCache cache;
+  shared_int value;
+
+  cache.init(MAX_AGE);
+  ASSERT_TRUE(cache.isEnabled());
+  EXPECT_FALSE(readOrFill(cache, 5, IoMultiSizes::MREGISTER, 11, value));
+  EXPECT_TRUE(readOrFill(cache, 5, IoMultiSizes::MREGISTER, 12, value));
+  EXPECT_EQ(11, value);
+
+  // M registers are the same with or without 1000000 added
+  EXPECT_TRUE(readOrFill(cache, 1000005, IoMultiSizes::MREGISTER, 12, value));
+  EXPECT_EQ(11, value);
+
+  // but not the same as IO of another size at the same address
+  EXPECT_FALSE(readOrFill(cache, 5, IoMultiSizes::GROUP, 12, value));
+}
+
+TEST(IoCache, maxAge)
+{
+  IoCache cache;
+  shared_int value;
+
+  cache.init(0.05);
+  EXPECT_FALSE(readOrFill(cache, 5, IoMultiSizes::MREGISTER, 11, value));
+  EXPECT_TRUE(readOrFill(cache, 5, IoMultiSizes::MREGISTER, 12, value));
+  ros::WallDuration(0.1).sleep();
+  EXPECT_FALSE(readOrFill(cache, 5, IoMultiSizes::MREGISTER, 12, value));
+  EXPECT_TRUE(readOrFill(cache, 5, IoMultiSizes::MREGISTER, 13, value));
+  EXPECT_EQ(12, value);
+}
+
+TEST(IoCache, write)
+{
+  IoCache cache;
+  shared_int value;
+  unsigned int ticket;
+
+  cache.init(MAX_AGE);
+  cache.write(5, IoMultiSizes::MREGISTER, 11, true);
+  ASSERT_TRUE(cache.read(5, IoMultiSizes::MREGISTER, value, ticket));
+  EXPECT_EQ(11, value);
+
+  // a failed write leaves the value unknown
+  cache.write(5, IoMultiSizes::MREGISTER, 12, false);
+  EXPECT_FALSE(cache.read(5, IoMultiSizes::MREGISTER, value, ticket));
+}
+
+TEST(IoCache, writeOvertakesRead)
+{
+  IoCache cache;
+  shared_int value;
+  unsigned int ticket;
+
+  cache.init(MAX_AGE);
+  ASSERT_FALSE(cache.read(5, IoMultiSizes::MREGISTER, value, ticket));
+
+  // written on another connection before the reply to the read arrived
+  cache.write(5, IoMultiSizes::MREGISTER, 12, true);
+  cache.fill(5, IoMultiSizes::MREGISTER, 11, ticket);
+  ASSERT_TRUE(cache.read(5, IoMultiSizes::MREGISTER, value, ticket));
+  EXPECT_EQ(12, value);
+}
+
+TEST(IoCache, groupAndBits)
+{
+  IoCache cache;
+  shared_int value;
+  unsigned int ticket;
+
+  cache.init(MAX_AGE);
+  cache.write(1001, IoMultiSizes::GROUP, 0, true);
+  cache.write(10012, IoMultiSizes::BIT, 1, true);
+
+  // IO point 10012 is bit 2 of group 1001
+  EXPECT_FALSE(cache.read(1001, IoMultiSizes::GROUP, value, ticket));
+  EXPECT_TRUE(cache.read(10012, IoMultiSizes::BIT, value, ticket));
+
+  cache.write(1001, IoMultiSizes::GROUP, 0, true);
+  EXPECT_FALSE(cache.read(10012, IoMultiSizes::BIT, value, ticket));
+
+  // another group is not affected
+  cache.write(10022, IoMultiSizes::BIT, 1, true);
+  EXPECT_TRUE(cache.read(1001, IoMultiSizes::GROUP, value, ticket));
+}
+
+TEST(IoCache, readMulti)
+{
+  IoCache cache;
+  std::vector<shared_int> values;
+  std::vector<unsigned int> tickets;
+
+  cache.init(MAX_AGE);
+  cache.write(5, IoMultiSizes::MREGISTER, 11, true);
+
+  // all the elements must be fresh
+  ASSERT_FALSE(cache.read(ints(5, 6), sizes(IoMultiSizes::MREGISTER, IoMultiSizes::MREGISTER), values, tickets));
+  ASSERT_EQ(2u, tickets.size());
+
+  // only the elements read are filled
+  std::vector<shared_int> result_codes = ints(IoMultiReplyResultCodes::SUCCESS,
+                                              IoMultiReplyResultCodes::READ_ADDRESS_INVALID);
+  cache.fill(ints(5, 99999), sizes(IoMultiSizes::MREGISTER, IoMultiSizes::BIT), ints(11, 0), result_codes,
+             tickets);
+  EXPECT_FALSE(cache.read(ints(5, 99999), sizes(IoMultiSizes::MREGISTER, IoMultiSizes::BIT), values, tickets));
+
+  cache.fill(ints(5, 6), sizes(IoMultiSizes::MREGISTER, IoMultiSizes::MREGISTER), ints(11, 22),
+             ints(IoMultiReplyResultCodes::SUCCESS, IoMultiReplyResultCodes::SUCCESS), tickets);
+  ASSERT_TRUE(cache.read(ints(6, 5), sizes(IoMultiSizes::MREGISTER, IoMultiSizes::MREGISTER), values, tickets));
+  EXPECT_EQ(22, values[0]);
+  EXPECT_EQ(11, values[1]);
+}
+
+TEST(IoCache, subscription)
+{
+  IoCache cache;
+  shared_int value;
+  unsigned int ticket;
+
+  // the values subscribed to are confirmed by each message of the subscription, and age from the last one
+  cache.init(0.05);
+  cache.subscribe(ints(5, 99999), sizes(IoMultiSizes::MREGISTER, IoMultiSizes::BIT), ints(11, 0),
+                  ints(IoMultiReplyResultCodes::SUCCESS, IoMultiReplyResultCodes::READ_ADDRESS_INVALID));
+  ASSERT_TRUE(cache.read(5, IoMultiSizes::MREGISTER, value, ticket));
+  EXPECT_EQ(11, value);
+  EXPECT_FALSE(cache.read(99999, IoMultiSizes::BIT, value, ticket));
+  ros::WallDuration(0.1).sleep();
+  EXPECT_FALSE(cache.read(5, IoMultiSizes::MREGISTER, value, ticket));
+  cache.change(std::vector<shared_int>(), std::vector<IoMultiSize>(), std::vector<shared_int>());
+  ASSERT_TRUE(cache.read(5, IoMultiSizes::MREGISTER, value, ticket));
+  EXPECT_EQ(11, value);
+
+  cache.change(std::vector<shared_int>(1, 5), std::vector<IoMultiSize>(1, IoMultiSizes::MREGISTER),
+               std::vector<shared_int>(1, 12));
+  ASSERT_TRUE(cache.read(5, IoMultiSizes::MREGISTER, value, ticket));
+  EXPECT_EQ(12, value);
+
+  // once lost, they age from its last message
+  cache.change(std::vector<shared_int>(), std::vector<IoMultiSize>(), std::vector<shared_int>());
+  cache.unsubscribe();
+  EXPECT_TRUE(cache.read(5, IoMultiSizes::MREGISTER, value, ticket));
+  ros::WallDuration(0.1).sleep();
+  EXPECT_FALSE(cache.read(5, IoMultiSizes::MREGISTER, value, ticket));
+}
+
+TEST(IoCache, stats)
+{
+  IoCache cache;
+  shared_int value;
+
+  cache.init(MAX_AGE);
+  readOrFill(cache, 5, IoMultiSizes::MREGISTER, 11, value);
+  readOrFill(cache, 5, IoMultiSizes::MREGISTER, 11, value);
+  readOrFill(cache, 1000005, IoMultiSizes::MREGISTER, 11, value);
+  cache.write(6, IoMultiSizes::MREGISTER, 22, true);
+
+  // the elements only written are not listed
+  std::vector<shared_int> addresses;
+  std::vector<IoMultiSize> element_sizes;
+  std::vector<unsigned int> hits, misses;
+  cache.getStats(addresses, element_sizes, hits, misses);
+  ASSERT_EQ(1u, addresses.size());
+  EXPECT_EQ(1000005, addresses[0]);
+  EXPECT_EQ(IoMultiSizes::MREGISTER, element_sizes[0]);
+  EXPECT_EQ(2u, hits[0]);
+  EXPECT_EQ(1u, misses[0]);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,681 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/io_relay.h"
+#include "motoman_driver/simple_message/motoman_simple_message.h"
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+#include <boost/thread/thread.hpp>
+
+using industrial::shared_types::shared_int;
+using motoman::simple_message::io_ctrl::IoMultiSize;
+namespace IoMultiReplyResultCodes = motoman::simple_message::io_ctrl_reply::IoMultiReplyResultCodes;
+namespace IoMultiSizes = motoman::simple_message::io_ctrl::IoMultiSizes;
+namespace MotomanMsgTypes = motoman::simple_message::MotomanMsgTypes;
+
+namespace
+{
+
+// simple message header fields
+const shared_int COMM_TOPIC = 1;
+const shared_int COMM_SERVICE_REPLY = 3;
+const shared_int REPLY_INVALID = 0;
+const shared_int REPLY_SUCCESS = 1;
+
+// elements at this address do not exist on the fake controller
+const shared_int INVALID_ADDRESS = 99999;
+
+/**
+ * \brief Controller answering the IO messages of MotoROS from a table of
+ * values, on as many connections as it is given.
+ *
+ * Group IO are stored as such, their IO points being their bits.
+ */
+class FakeController
+{
+public:
+  FakeController() : listen_sd_(-1), port_(0), connections_(0), subscription_sd_(-1), subscription_period_(0),
+    reply_delay_(0.0), in_flight_(0), max_in_flight_(0) {}
+
+  bool start()
+  {
+    this->listen_sd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (this->listen_sd_ < 0)
+      return false;
+
+    sockaddr_in address = sockaddr_in();
+    socklen_t length = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;  // any free port
+    if (bind(this->listen_sd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(this->listen_sd_, 8) < 0 ||
+        getsockname(this->listen_sd_, reinterpret_cast<sockaddr*>(&address), &length) < 0)
+      return false;
+    this->port_ = ntohs(address.sin_port);
+
+    boost::thread(&FakeController::acceptConnections, this).detach();
+    return true;
+  }
+
+  int getPort() const
+  {
+    return this->port_;
+  }
+
+  int getConnections()
+  {
+    boost::mutex::scoped_lock lock(this->mutex_);
+    return this->connections_;
+  }
+
+  /**
+   * \brief Number of messages of a type received
+   */
+  int getReceived(shared_int msg_type)
+  {
+    boost::mutex::scoped_lock lock(this->mutex_);
+    return this->received_[msg_type];
+  }
+
+  /**
+   * \brief Changes an element on the controller side, as a program would
+   */
+  void set(shared_int address, IoMultiSize size, shared_int value)
+  {
+    boost::mutex::scoped_lock lock(this->mutex_);
+    writeElement(address, size, value);
+  }
+
+  /**
+   * \brief Sends a keepalive of the subscription (IO_CHANGED without elements)
+   */
+  void keepalive()
+  {
+    boost::mutex::scoped_lock lock(this->mutex_);
+    if (this->subscription_sd_ < 0)
+      return;
+
+    std::vector<shared_int> body;
+    body.push_back(0);  // time
+    body.push_back(0);
+    send(this->subscription_sd_, MotomanMsgTypes::MOTOMAN_IO_CHANGED, COMM_TOPIC, REPLY_INVALID, body);
+  }
+
+  std::vector<std::pair<shared_int, shared_int> > getWatched(shared_int &period)
+  {
+    boost::mutex::scoped_lock lock(this->mutex_);
+    period = this->subscription_period_;
+    return this->watched_;
+  }
+
+  /**
+   * \brief How long replies take, to keep several requests in flight
+   */
+  void setReplyDelay(double seconds)
+  {
+    boost::mutex::scoped_lock lock(this->mutex_);
+    this->reply_delay_ = seconds;
+    this->max_in_flight_ = 0;
+  }
+
+  int getMaxInFlight()
+  {
+    boost::mutex::scoped_lock lock(this->mutex_);
+    return this->max_in_flight_;
+  }
+
+private:
+  int listen_sd_;
+  int port_;
+  boost::mutex mutex_;
+  int connections_;
+  std::map<shared_int, int> received_;
+  std::map<shared_int, shared_int> groups_;
+  std::map<shared_int, shared_int> mregisters_;
+  int subscription_sd_;
+  shared_int subscription_period_;
+  std::vector<std::pair<shared_int, shared_int> > watched_;  // address, size
+  double reply_delay_;
+  int in_flight_;
+  int max_in_flight_;
+
+  void acceptConnections()
+  {
+    for (;;)
+    {
+      int sd = accept(this->listen_sd_, NULL, NULL);
+      if (sd < 0)
+        return;
+      boost::mutex::scoped_lock lock(this->mutex_);
+      this->connections_++;
+      boost::thread(&FakeController::serve, this, sd).detach();
+    }
+  }
+
+  static bool receiveAll(int sd, void *buffer, size_t size)
+  {
+    char *data = static_cast<char*>(buffer);
+    while (size > 0)
+    {
+      ssize_t received = recv(sd, data, size, 0);
+      if (received <= 0)
+        return false;
+      data += received;
+      size -= received;
+    }
+    return true;
+  }
+
+  static bool receive(int sd, shared_int &msg_type, std::vector<shared_int> &body)
+  {
+    shared_int header[4];  // length, message type, comm type, reply code
+    if (!receiveAll(sd, header, sizeof(header)))
+      return false;
+    msg_type = header[1];
+    body.resize((header[0] - 3 * sizeof(shared_int)) / sizeof(shared_int));
+    return body.empty() || receiveAll(sd, &body[0], body.size() * sizeof(shared_int));
+  }
+
+  static void send(int sd, shared_int msg_type, shared_int comm_type, shared_int reply_code,
+                   const std::vector<shared_int> &body)
+  {
+    std::vector<shared_int> frame;
+    frame.push_back(static_cast<shared_int>((3 + body.size()) * sizeof(shared_int)));
+    frame.push_back(msg_type);
+    frame.push_back(comm_type);
+    frame.push_back(reply_code);
+    frame.insert(frame.end(), body.begin(), body.end());
+    ::send(sd, &frame[0], frame.size() * sizeof(shared_int), MSG_NOSIGNAL);
+  }
+
+  shared_int readElement(shared_int address, IoMultiSize size, shared_int &value)
+  {
+    value = 0;
+    if (address == INVALID_ADDRESS)
+      return IoMultiReplyResultCodes::READ_ADDRESS_INVALID;
+    switch (size)
+    {
+    case IoMultiSizes::BIT:
+      value = (this->groups_[address / 10] >> (address % 10)) & 1;
+      break;
+    case IoMultiSizes::GROUP:
+      value = this->groups_[address];
+      break;
+    default:
+      value = this->mregisters_[address % 1000000];
+      break;
+    }
+    return IoMultiReplyResultCodes::SUCCESS;
+  }
+
+  shared_int writeElement(shared_int address, IoMultiSize size, shared_int value)
+  {
+    if (address == INVALID_ADDRESS)
+      return IoMultiReplyResultCodes::WRITE_ADDRESS_INVALID;
+    switch (size)
+    {
+    case IoMultiSizes::BIT:
+      this->groups_[address / 10] &= ~(1 << (address % 10));
+      this->groups_[address / 10] |= (value & 1) << (address % 10);
+      break;
+    case IoMultiSizes::GROUP:
+      this->groups_[address] = value;
+      break;
+    default:
+      this->mregisters_[address % 1000000] = value;
+      break;
+    }
+    notifyChange(address, size, value);
+    return IoMultiReplyResultCodes::SUCCESS;
+  }
+
+  // sends the change of an element watched (without the group of a bit and conversely)
+  void notifyChange(shared_int address, IoMultiSize size, shared_int value)
+  {
+    std::pair<shared_int, shared_int> element(address, size);
+    if (this->subscription_sd_ < 0 ||
+        std::find(this->watched_.begin(), this->watched_.end(), element) == this->watched_.end())
+      return;
+
+    std::vector<shared_int> body;
+    body.push_back(0);  // time
+    body.push_back(1);
+    body.push_back(address);
+    body.push_back(size);
+    body.push_back(value);
+    send(this->subscription_sd_, MotomanMsgTypes::MOTOMAN_IO_CHANGED, COMM_TOPIC, REPLY_INVALID, body);
+  }
+
+  void serve(int sd)
+  {
+    shared_int msg_type;
+    std::vector<shared_int> body;
+
+    while (receive(sd, msg_type, body))
+    {
+      boost::mutex::scoped_lock lock(this->mutex_);
+      this->received_[msg_type]++;
+      if (++this->in_flight_ > this->max_in_flight_)
+        this->max_in_flight_ = this->in_flight_;
+      double reply_delay = this->reply_delay_;
+
+      std::vector<shared_int> reply;
+      shared_int reply_type = msg_type;
+      shared_int value, result_code;
+      switch (msg_type)
+      {
+      case MotomanMsgTypes::MOTOMAN_READ_SINGLE_IO:
+      case MotomanMsgTypes::MOTOMAN_READ_GROUP_IO:
+      case MotomanMsgTypes::MOTOMAN_READ_MREGISTER:
+        result_code = readElement(body[0], sizeOf(msg_type), value);
+        reply.push_back(value);
+        reply.push_back(result_code);
+        if (msg_type != MotomanMsgTypes::MOTOMAN_READ_MREGISTER)
+          reply_type = msg_type + 1;
+        break;
+
+      case MotomanMsgTypes::MOTOMAN_WRITE_SINGLE_IO:
+      case MotomanMsgTypes::MOTOMAN_WRITE_GROUP_IO:
+      case MotomanMsgTypes::MOTOMAN_WRITE_MREGISTER:
+        reply.push_back(writeElement(body[0], sizeOf(msg_type), body[1]));
+        if (msg_type != MotomanMsgTypes::MOTOMAN_WRITE_MREGISTER)
+          reply_type = msg_type + 1;
+        break;
+
+      case MotomanMsgTypes::MOTOMAN_READ_IO_MULTI:
+      case MotomanMsgTypes::MOTOMAN_IO_SUBSCRIBE:
+      {
+        size_t first = (msg_type == MotomanMsgTypes::MOTOMAN_IO_SUBSCRIBE) ? 2 : 1;
+        if (msg_type == MotomanMsgTypes::MOTOMAN_IO_SUBSCRIBE)
+        {
+          this->subscription_sd_ = sd;
+          this->subscription_period_ = body[1];
+          this->watched_.clear();
+        }
+        reply.push_back(body[0]);
+        reply.push_back(IoMultiReplyResultCodes::SUCCESS);
+        for (shared_int i = 0; i < body[0]; ++i)
+        {
+          shared_int address = body[first + 2 * i];
+          IoMultiSize size = static_cast<IoMultiSize>(body[first + 2 * i + 1]);
+          result_code = readElement(address, size, value);
+          if (result_code != IoMultiReplyResultCodes::SUCCESS && reply[1] == IoMultiReplyResultCodes::SUCCESS)
+            reply[1] = result_code;
+          reply.push_back(value);
+          reply.push_back(result_code);
+          if (msg_type == MotomanMsgTypes::MOTOMAN_IO_SUBSCRIBE)
+            this->watched_.push_back(std::make_pair(address, size));
+        }
+        reply_type = msg_type + 1;
+        break;
+      }
+
+      case MotomanMsgTypes::MOTOMAN_WRITE_IO_MULTI:
+        reply.push_back(body[0]);
+        reply.push_back(IoMultiReplyResultCodes::SUCCESS);
+        for (shared_int i = 0; i < body[0]; ++i)
+        {
+          result_code = writeElement(body[1 + 3 * i], static_cast<IoMultiSize>(body[2 + 3 * i]), body[3 + 3 * i]);
+          if (result_code != IoMultiReplyResultCodes::SUCCESS && reply[1] == IoMultiReplyResultCodes::SUCCESS)
+            reply[1] = result_code;
+          reply.push_back(result_code);
+        }
+        reply_type = msg_type + 1;
+        break;
+
+      default:
+        ADD_FAILURE() << "Unexpected message type " << msg_type;
+        return;
+      }
+
+      lock.unlock();
+      if (reply_delay > 0.0)
+        ros::WallDuration(reply_delay).sleep();
+      lock.lock();
+      send(sd, reply_type, COMM_SERVICE_REPLY, REPLY_SUCCESS, reply);
+      this->in_flight_--;
+    }
+  }
+
+  static IoMultiSize sizeOf(shared_int msg_type)
+  {
+    switch (msg_type)
+    {
+    case MotomanMsgTypes::MOTOMAN_READ_SINGLE_IO:
+    case MotomanMsgTypes::MOTOMAN_WRITE_SINGLE_IO:
+      return IoMultiSizes::BIT;
+    case MotomanMsgTypes::MOTOMAN_READ_GROUP_IO:
+    case MotomanMsgTypes::MOTOMAN_WRITE_GROUP_IO:
+      return IoMultiSizes::GROUP;
+    default:
+      return IoMultiSizes::MREGISTER;
+    }
+  }
+};
+
+/**
+ * \brief Relay which services are called directly
+ */
+class TestRelay : public motoman::io_relay::MotomanIORelay
+{
+public:
+  using MotomanIORelay::idle_;
+  using MotomanIORelay::readMRegisterCB;
+  using MotomanIORelay::readGroupIoCB;
+  using MotomanIORelay::writeMRegisterCB;
+  using MotomanIORelay::writeSingleIoCB;
+  using MotomanIORelay::writeGroupIoCB;
+  using MotomanIORelay::readIoMultiCB;
+  using MotomanIORelay::writeIoMultiCB;
+  using MotomanIORelay::subscribeIoCB;
+  using MotomanIORelay::ioCacheStatsCB;
+
+  bool readMRegister(uint32_t address, shared_int &value)
+  {
+    motoman_msgs::ReadMRegister::Request req;
+    motoman_msgs::ReadMRegister::Response res;
+    req.address = address;
+    readMRegisterCB(req, res);
+    value = res.value;
+    return res.success;
+  }
+
+  bool writeMRegister(uint32_t address, shared_int value)
+  {
+    motoman_msgs::WriteMRegister::Request req;
+    motoman_msgs::WriteMRegister::Response res;
+    req.address = address;
+    req.value = value;
+    writeMRegisterCB(req, res);
+    return res.success;
+  }
+};
+
+// shared by the tests, as a node cannot advertise the services twice
+FakeController *controller;
+TestRelay *relay;
+
+const int CONNECTIONS = 3;
+const double CACHE_MAX_AGE = 0.5;
+
+}  // namespace
+
+TEST(IoRelay, connectionPool)
+{
+  ASSERT_EQ(static_cast<size_t>(CONNECTIONS), relay->getConnectionCount());
+  EXPECT_EQ(CONNECTIONS, controller->getConnections());
+
+  // more callers than connections: they queue for one
+  const int CALLERS = 2 * CONNECTIONS;
+  const int WRITES = 10;
+  std::vector<int> failures(CALLERS, 0);
+  boost::thread_group callers;
+
+  controller->setReplyDelay(0.01);
+  for (int caller = 0; caller < CALLERS; ++caller)
+  {
+    callers.create_thread([caller, &failures]
+    {
+      for (int i = 0; i < WRITES; ++i)
+      {
+        motoman_msgs::WriteIOMulti::Request req;
+        motoman_msgs::WriteIOMulti::Response res;
+        req.addresses.push_back(100 + caller);
+        req.sizes.push_back(IoMultiSizes::MREGISTER);
+        req.values.push_back(10 * i + caller);
+        relay->writeIoMultiCB(req, res);
+        if (!res.success)
+          failures[caller]++;
+      }
+    });
+  }
+  callers.join_all();
+  EXPECT_EQ(CONNECTIONS, controller->getMaxInFlight());
+  controller->setReplyDelay(0.0);
+
+  EXPECT_EQ(static_cast<size_t>(CONNECTIONS), relay->idle_.size());
+  for (int caller = 0; caller < CALLERS; ++caller)
+  {
+    EXPECT_EQ(0, failures[caller]);
+    shared_int value;
+    ASSERT_TRUE(relay->readMRegister(100 + caller, value));
+    EXPECT_EQ(10 * (WRITES - 1) + caller, value);
+  }
+}
+
+TEST(IoRelay, tooManyConnections)
+{
+  // the controller accepts MAX_IO_CONNECTIONS, one of which is kept for the subscription
+  TestRelay other;
+  ros::param::set("~io_connections", TestRelay::MAX_IO_CONNECTIONS);
+  EXPECT_FALSE(other.init(controller->getPort()));
+  ros::param::set("~io_connections", 0);
+  EXPECT_FALSE(other.init(controller->getPort()));
+  ros::param::set("~io_connections", CONNECTIONS);
+}
+
+TEST(IoRelay, cacheReads)
+{
+  shared_int value;
+
+  controller->set(7, IoMultiSizes::MREGISTER, 11);
+  int sent = controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_MREGISTER);
+  ASSERT_TRUE(relay->readMRegister(7, value));
+  EXPECT_EQ(11, value);
+  EXPECT_EQ(sent + 1, controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_MREGISTER));
+
+  // answered from the cache, until the value is too old
+  controller->set(7, IoMultiSizes::MREGISTER, 12);
+  ASSERT_TRUE(relay->readMRegister(1000007, value));
+  EXPECT_EQ(11, value);
+  EXPECT_EQ(sent + 1, controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_MREGISTER));
+  ros::WallDuration(CACHE_MAX_AGE + 0.1).sleep();
+  ASSERT_TRUE(relay->readMRegister(7, value));
+  EXPECT_EQ(12, value);
+  EXPECT_EQ(sent + 2, controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_MREGISTER));
+
+  // a value written is known
+  ASSERT_TRUE(relay->writeMRegister(7, 13));
+  ASSERT_TRUE(relay->readMRegister(7, value));
+  EXPECT_EQ(13, value);
+  EXPECT_EQ(sent + 2, controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_MREGISTER));
+
+  motoman_msgs::IOCacheStats::Request stats_req;
+  motoman_msgs::IOCacheStats::Response stats;
+  relay->ioCacheStatsCB(stats_req, stats);
+  EXPECT_TRUE(stats.enabled);
+  size_t i = std::find(stats.addresses.begin(), stats.addresses.end(), 1000007u) - stats.addresses.begin();
+  ASSERT_LT(i, stats.addresses.size());
+  EXPECT_EQ(2u, stats.hits[i]);
+  EXPECT_EQ(2u, stats.misses[i]);
+}
+
+TEST(IoRelay, cacheGroupAndBits)
+{
+  motoman_msgs::WriteGroupIO::Request group_req;
+  motoman_msgs::WriteGroupIO::Response group_res;
+  group_req.address = 1001;
+  group_req.value = 0;
+  ASSERT_TRUE(relay->writeGroupIoCB(group_req, group_res) && group_res.success);
+
+  // writing an IO point of the group makes the cached group stale
+  motoman_msgs::WriteSingleIO::Request bit_req;
+  motoman_msgs::WriteSingleIO::Response bit_res;
+  bit_req.address = 10012;
+  bit_req.value = 1;
+  ASSERT_TRUE(relay->writeSingleIoCB(bit_req, bit_res) && bit_res.success);
+
+  int sent = controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_GROUP_IO);
+  motoman_msgs::ReadGroupIO::Request read_req;
+  motoman_msgs::ReadGroupIO::Response read_res;
+  read_req.address = 1001;
+  ASSERT_TRUE(relay->readGroupIoCB(read_req, read_res) && read_res.success);
+  EXPECT_EQ(4u, read_res.value);
+  EXPECT_EQ(sent + 1, controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_GROUP_IO));
+}
+
+TEST(IoRelay, cacheReadMulti)
+{
+  ASSERT_TRUE(relay->writeMRegister(8, 21));
+  controller->set(9, IoMultiSizes::MREGISTER, 22);
+
+  // all the elements are read from the controller unless all are cached
+  int sent = controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_IO_MULTI);
+  motoman_msgs::ReadIOMulti::Request req;
+  motoman_msgs::ReadIOMulti::Response res;
+  req.addresses.push_back(8);
+  req.addresses.push_back(9);
+  req.sizes.assign(2, IoMultiSizes::MREGISTER);
+  ASSERT_TRUE(relay->readIoMultiCB(req, res) && res.success);
+  ASSERT_EQ(2u, res.values.size());
+  EXPECT_EQ(21u, res.values[0]);
+  EXPECT_EQ(22u, res.values[1]);
+  EXPECT_EQ(sent + 1, controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_IO_MULTI));
+
+  res = motoman_msgs::ReadIOMulti::Response();
+  ASSERT_TRUE(relay->readIoMultiCB(req, res) && res.success);
+  EXPECT_EQ(22u, res.values[1]);
+  EXPECT_EQ(sent + 1, controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_IO_MULTI));
+}
+
+TEST(IoRelay, subscribe)
+{
+  controller->set(5, IoMultiSizes::MREGISTER, 31);
+  motoman_msgs::SubscribeIO::Request req;
+  motoman_msgs::SubscribeIO::Response res;
+  req.addresses.push_back(5);
+  req.sizes.push_back(IoMultiSizes::MREGISTER);
+  req.period = 50;
+  ASSERT_TRUE(relay->subscribeIoCB(req, res));
+  ASSERT_TRUE(res.success) << res.message;
+  ASSERT_EQ(1u, res.values.size());
+  EXPECT_EQ(31u, res.values[0]);
+
+  // the changes keep the cache fresh: reads are not sent any more
+  int sent = controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_MREGISTER);
+  shared_int value = 0;
+  controller->set(5, IoMultiSizes::MREGISTER, 32);
+  for (int i = 0; i < 100 && value != 32; ++i)
+  {
+    ros::WallDuration(0.01).sleep();
+    ASSERT_TRUE(relay->readMRegister(5, value));
+  }
+  EXPECT_EQ(32, value);
+  EXPECT_EQ(sent, controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_MREGISTER));
+
+  // without any message for longer than the cache max age, they are read again
+  ros::WallDuration(CACHE_MAX_AGE + 0.1).sleep();
+  ASSERT_TRUE(relay->readMRegister(5, value));
+  EXPECT_EQ(32, value);
+  EXPECT_EQ(sent + 1, controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_MREGISTER));
+
+  // a keepalive confirms them
+  ros::WallDuration(CACHE_MAX_AGE + 0.1).sleep();
+  controller->keepalive();
+  ros::WallDuration(0.1).sleep();
+  ASSERT_TRUE(relay->readMRegister(5, value));
+  EXPECT_EQ(32, value);
+  EXPECT_EQ(sent + 1, controller->getReceived(MotomanMsgTypes::MOTOMAN_READ_MREGISTER));
+}
+
+TEST(IoRelay, subscribeMore)
+{
+  int subscriptions = controller->getReceived(MotomanMsgTypes::MOTOMAN_IO_SUBSCRIBE);
+
+  // the elements are added to those watched, at the shortest period
+  controller->set(6, IoMultiSizes::MREGISTER, 41);
+  motoman_msgs::SubscribeIO::Request req;
+  motoman_msgs::SubscribeIO::Response res;
+  req.addresses.push_back(INVALID_ADDRESS);
+  req.addresses.push_back(5);
+  req.addresses.push_back(6);
+  req.sizes.push_back(IoMultiSizes::BIT);
+  req.sizes.push_back(IoMultiSizes::MREGISTER);
+  req.sizes.push_back(IoMultiSizes::MREGISTER);
+  req.period = 20;
+  ASSERT_TRUE(relay->subscribeIoCB(req, res));
+  EXPECT_FALSE(res.success);
+  ASSERT_EQ(3u, res.values.size());
+  EXPECT_EQ(IoMultiReplyResultCodes::READ_ADDRESS_INVALID, res.result_codes[0]);
+  EXPECT_EQ(IoMultiReplyResultCodes::SUCCESS, res.result_codes[1]);
+  EXPECT_EQ(32u, res.values[1]);
+  EXPECT_EQ(41u, res.values[2]);
+  EXPECT_EQ(subscriptions + 1, controller->getReceived(MotomanMsgTypes::MOTOMAN_IO_SUBSCRIBE));
+
+  shared_int period;
+  std::vector<std::pair<shared_int, shared_int> > watched = controller->getWatched(period);
+  EXPECT_EQ(20, period);
+  ASSERT_EQ(3u, watched.size());
+  EXPECT_EQ(std::make_pair(5, static_cast<shared_int>(IoMultiSizes::MREGISTER)), watched[0]);
+
+  // elements already watched, at a longer period: nothing to send
+  req.addresses.assign(1, 6);
+  req.sizes.assign(1, IoMultiSizes::MREGISTER);
+  req.period = 100;
+  res = motoman_msgs::SubscribeIO::Response();
+  ASSERT_TRUE(relay->subscribeIoCB(req, res));
+  EXPECT_TRUE(res.success) << res.message;
+  ASSERT_EQ(1u, res.values.size());
+  EXPECT_EQ(41u, res.values[0]);
+  EXPECT_EQ(subscriptions + 1, controller->getReceived(MotomanMsgTypes::MOTOMAN_IO_SUBSCRIBE));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "test_io_relay");
+
+  controller = new FakeController();
+  if (!controller->start())
+  {
+    ROS_FATAL("Failed to start the fake controller");
+    return 1;
+  }
+  ros::param::set("robot_ip_address", "127.0.0.1");
+  ros::param::set("~port", controller->getPort());
+  ros::param::set("~io_connections", CONNECTIONS);
+  ros::param::set("~io_cache_max_age", CACHE_MAX_AGE);
+
+  relay = new TestRelay();
+  if (!relay->init(controller->getPort()))
+    return 1;
+
+  // the relay and the controller are left running: their threads block in recv()
+  return RUN_ALL_TESTS();
+}
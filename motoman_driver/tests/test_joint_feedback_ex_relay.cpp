@@ -0,0 +1,217 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/industrial_robot_client/joint_feedback_ex_relay_handler.h"
+#include "motoman_driver/simple_message/motoman_simple_message.h"
+#include "simple_message/socket/tcp_client.h"
+#include <gtest/gtest.h>
+#include <ros/ros.h>
+#include <stdlib.h>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using industrial::byte_array::ByteArray;
+using industrial::joint_data::JointData;
+using industrial::joint_feedback::JointFeedback;
+using industrial::joint_feedback_message::JointFeedbackMessage;
+using industrial::shared_types::shared_int;
+using industrial::simple_message::SimpleMessage;
+using industrial::tcp_client::TcpClient;
+using industrial_robot_client::joint_feedback_ex_relay_handler::JointFeedbackExRelayHandler;
+namespace CommTypes = industrial::simple_message::CommTypes;
+namespace MotomanMsgTypes = motoman::simple_message::MotomanMsgTypes;
+namespace ReplyTypes = industrial::simple_message::ReplyTypes;
+namespace ValidFieldTypes = industrial::joint_feedback::ValidFieldTypes;
+
+namespace
+{
+
+// allocations made by the calling thread while counting: ROS threads allocate concurrently
+__thread bool counting = false;
+__thread size_t allocations = 0;
+
+}  // namespace
+
+void* operator new(size_t size)
+{
+  if (counting)
+    allocations++;
+  void* p = malloc(size ? size : 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept
+{
+  free(p);
+}
+
+namespace
+{
+
+const int GROUPS = 4;
+const int JOINTS = 6;
+const int WARMUP = 100;
+const int FRAMES = 10000;
+
+class TestHandler : public JointFeedbackExRelayHandler
+{
+public:
+  using JointFeedbackExRelayHandler::create_messages;
+};
+
+TcpClient connection;  // never connected: the handler only replies to service requests
+TestHandler* handler;
+
+void startCounting()
+{
+  allocations = 0;
+  counting = true;
+}
+
+size_t stopCounting()
+{
+  counting = false;
+  return allocations;
+}
+
+std::map<int, RobotGroup> robotGroups()
+{
+  std::map<int, RobotGroup> groups;
+  for (int g = 0; g < GROUPS; g++)
+  {
+    std::vector<std::string> names;
+    for (int j = 0; j < JOINTS; j++)
+    {
+      std::stringstream name;
+      name << "group_" << g << "_joint_" << j + 1;
+      names.push_back(name.str());
+    }
+    std::stringstream group_name;
+    group_name << "group_" << g;
+    groups[g].set_group_id(g);
+    groups[g].set_name(group_name.str());
+    groups[g].set_ns("");
+    groups[g].set_joint_names(names);
+  }
+  return groups;
+}
+
+JointFeedbackMessage groupFeedback(int group, double time)
+{
+  JointData positions, velocities, accelerations;
+  for (int j = 0; j < JOINTS; j++)
+  {
+    positions.setJoint(j, group + 0.1 * j + time);
+    velocities.setJoint(j, 0.5);
+    accelerations.setJoint(j, -0.5);
+  }
+  JointFeedback feedback;
+  feedback.init(group, ValidFieldTypes::TIME | ValidFieldTypes::POSITION | ValidFieldTypes::VELOCITY |
+                ValidFieldTypes::ACCELERATION, time, positions, velocities, accelerations);
+  JointFeedbackMessage msg;
+  msg.init(feedback);
+  return msg;
+}
+
+// a frame as the controller sends it: the group count, then the feedback of every group slot
+SimpleMessage frame(double time)
+{
+  ByteArray data;
+  data.load(static_cast<shared_int>(GROUPS));
+  for (int g = 0; g < GROUPS; g++)
+  {
+    JointFeedbackMessage feedback = groupFeedback(g, time);
+    data.load(feedback);
+  }
+  SimpleMessage frame;
+  frame.init(MotomanMsgTypes::ROS_MSG_MOTO_JOINT_FEEDBACK_EX, CommTypes::TOPIC, ReplyTypes::INVALID, data);
+  return frame;
+}
+
+}  // namespace
+
+// the conversion and publishing of each group reuses the messages of the previous frame
+TEST(JointFeedbackExRelay, groupsDoNotAllocate)
+{
+  std::vector<JointFeedbackMessage> groups;
+  for (int g = 0; g < GROUPS; g++)
+    groups.push_back(groupFeedback(g, 1.0));
+  motoman_msgs::DynamicJointState states[GROUPS];
+
+  for (int i = 0; i < WARMUP; i++)
+    for (int g = 0; g < GROUPS; g++)
+      ASSERT_TRUE(handler->create_messages(groups[g], NULL, g, &states[g]));
+
+  startCounting();
+  for (int i = 0; i < FRAMES; i++)
+    for (int g = 0; g < GROUPS; g++)
+      handler->create_messages(groups[g], NULL, g, &states[g]);
+  size_t count = stopCounting();
+
+  EXPECT_EQ(0u, count);
+  for (int g = 0; g < GROUPS; g++)
+  {
+    ASSERT_EQ(static_cast<size_t>(JOINTS), states[g].positions.size());
+    EXPECT_EQ(g, states[g].group_number);
+    EXPECT_DOUBLE_EQ(g + 0.1 * (JOINTS - 1) + 1.0, states[g].positions[JOINTS - 1]);
+    EXPECT_DOUBLE_EQ(-0.5, states[g].accelerations[0]);
+  }
+}
+
+// the whole frame, decoding included: the copies made by industrial_core's SimpleMessage and ByteArray
+// depend on its version, so the allocations are not checked
+TEST(JointFeedbackExRelay, frames)
+{
+  std::vector<SimpleMessage> frames;
+  for (int i = 0; i < FRAMES; i++)
+    frames.push_back(frame(0.004 * i));
+
+  for (int i = 0; i < FRAMES; i++)
+    EXPECT_TRUE(handler->callback(frames[i]));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "test_joint_feedback_ex_relay");
+
+  std::map<int, RobotGroup> groups = robotGroups();
+  handler = new TestHandler();
+  if (!handler->init(&connection, groups))
+    return 1;
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,229 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/industrial_robot_client/joint_map.h"
+#include "motoman_driver/industrial_robot_client/joint_trajectory_interface.h"
+#include <gtest/gtest.h>
+#include <ros/ros.h>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using industrial::simple_message::SimpleMessage;
+using industrial_robot_client::joint_map::JointMap;
+using industrial_robot_client::joint_trajectory_interface::JointTrajectoryInterface;
+using trajectory_msgs::JointTrajectory;
+using trajectory_msgs::JointTrajectoryPoint;
+
+namespace
+{
+
+const int GROUPS = 4;
+const int JOINTS = 6;
+const int POINTS = 10000;
+
+class TestInterface : public JointTrajectoryInterface
+{
+public:
+  using JointTrajectoryInterface::map_joints;
+  using JointTrajectoryInterface::select;
+
+protected:
+  bool send_to_robot(const std::vector<SimpleMessage>&)
+  {
+    return true;
+  }
+};
+
+TestInterface* interface;
+
+std::vector<std::string> names(const char* a, const char* b, const char* c)
+{
+  std::vector<std::string> v;
+  v.push_back(a);
+  v.push_back(b);
+  v.push_back(c);
+  return v;
+}
+
+std::vector<double> values(double a, double b, double c)
+{
+  std::vector<double> v;
+  v.push_back(a);
+  v.push_back(b);
+  v.push_back(c);
+  return v;
+}
+
+std::string jointName(int group, int joint)
+{
+  std::stringstream name;
+  name << "group_" << group + 1 << "_joint_" << joint + 1;
+  return name.str();
+}
+
+std::vector<std::string> groupJointNames(int group)
+{
+  std::vector<std::string> names;
+  for (int j = 0; j < JOINTS; j++)
+    names.push_back(jointName(group, j));
+  return names;
+}
+
+// all the joints of all the groups, the groups in reverse order and their joints interleaved
+JointTrajectory trajectory()
+{
+  JointTrajectory traj;
+  for (int j = 0; j < JOINTS; j++)
+    for (int g = GROUPS - 1; g >= 0; g--)
+      traj.joint_names.push_back(jointName(g, j));
+
+  traj.points.resize(POINTS);
+  for (int i = 0; i < POINTS; i++)
+  {
+    JointTrajectoryPoint &pt = traj.points[i];
+    for (size_t j = 0; j < traj.joint_names.size(); j++)
+    {
+      pt.positions.push_back(0.001 * i + j);
+      pt.velocities.push_back(0.1 * j);
+      pt.accelerations.push_back(-0.1 * j);
+    }
+    pt.time_from_start = ros::Duration(0.01 * i);
+  }
+  return traj;
+}
+
+// the joint selection of each point before JointMap: a search for every joint name
+void selectByName(const std::vector<std::string> &ros_joint_names, const JointTrajectoryPoint &ros_pt,
+                  const std::vector<std::string> &rbt_joint_names, JointTrajectoryPoint* rbt_pt)
+{
+  rbt_pt->positions.clear();
+  rbt_pt->velocities.clear();
+  rbt_pt->accelerations.clear();
+  for (size_t rbt_idx = 0; rbt_idx < rbt_joint_names.size(); rbt_idx++)
+  {
+    size_t ros_idx = std::find(ros_joint_names.begin(), ros_joint_names.end(), rbt_joint_names[rbt_idx]) -
+                     ros_joint_names.begin();
+    rbt_pt->positions.push_back(ros_pt.positions[ros_idx]);
+    rbt_pt->velocities.push_back(ros_pt.velocities[ros_idx]);
+    rbt_pt->accelerations.push_back(ros_pt.accelerations[ros_idx]);
+  }
+  rbt_pt->effort = ros_pt.effort;
+  rbt_pt->time_from_start = ros_pt.time_from_start;
+}
+
+}  // namespace
+
+TEST(JointMap, init)
+{
+  JointMap map;
+  EXPECT_TRUE(map.init(names("a", "b", "c"), names("c", "", "a")));
+  ASSERT_EQ(3u, map.size());
+  EXPECT_EQ(2, map.index(0));
+  EXPECT_EQ(JointMap::NONE, map.index(1));
+  EXPECT_EQ(0, map.index(2));
+  EXPECT_EQ(names("c", "", "a"), map.names());
+  EXPECT_EQ("", map.missing());
+
+  EXPECT_FALSE(map.init(names("a", "b", "c"), names("c", "d", "e")));
+  EXPECT_EQ("d", map.missing());
+}
+
+TEST(JointMap, initPublished)
+{
+  JointMap map;
+  map.initPublished(names("a", "", "c"));
+  ASSERT_EQ(2u, map.size());
+  EXPECT_EQ(0, map.index(0));
+  EXPECT_EQ(2, map.index(1));
+  EXPECT_EQ("c", map.names()[1]);
+}
+
+TEST(JointMap, apply)
+{
+  JointMap map;
+  map.init(names("a", "b", "c"), names("c", "", "a"));
+
+  std::vector<double> dst;
+  EXPECT_TRUE(map.apply(values(1.0, 2.0, 3.0), -1.0, &dst));
+  EXPECT_EQ(values(3.0, -1.0, 1.0), dst);
+
+  // no values, no mapped values
+  EXPECT_TRUE(map.apply(std::vector<double>(), -1.0, &dst));
+  EXPECT_TRUE(dst.empty());
+
+  EXPECT_FALSE(map.apply(std::vector<double>(2, 0.0), -1.0, &dst));
+}
+
+// every group of a 4-group, 10000-point trajectory, selected with the joint names matched for every point
+// (by search, and by select() building a map) or once per group
+TEST(JointMap, selectTrajectory)
+{
+  JointTrajectory traj = trajectory();
+  std::vector<JointTrajectoryPoint> by_search(POINTS), by_name(POINTS), by_map(POINTS);
+
+  for (int g = 0; g < GROUPS; g++)
+  {
+    std::vector<std::string> group_names = groupJointNames(g);
+
+    for (int i = 0; i < POINTS; i++)
+      selectByName(traj.joint_names, traj.points[i], group_names, &by_search[i]);
+
+    for (int i = 0; i < POINTS; i++)
+      ASSERT_TRUE(interface->select(traj.joint_names, traj.points[i], group_names, &by_name[i]));
+
+    JointMap map;
+    ASSERT_TRUE(TestInterface::map_joints(traj.joint_names, group_names, &map));
+    for (int i = 0; i < POINTS; i++)
+      ASSERT_TRUE(interface->select(map, traj.points[i], &by_map[i]));
+
+    for (int i = 0; i < POINTS; i++)
+    {
+      ASSERT_EQ(by_search[i].positions, by_map[i].positions);
+      ASSERT_EQ(by_search[i].velocities, by_map[i].velocities);
+      ASSERT_EQ(by_search[i].accelerations, by_map[i].accelerations);
+      ASSERT_EQ(by_name[i].positions, by_map[i].positions);
+    }
+    EXPECT_DOUBLE_EQ(traj.points[7].positions[GROUPS * 2 + (GROUPS - 1 - g)], by_map[7].positions[2]);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "test_joint_map");
+
+  // left running: stopping it would send a stop command to a robot that is not connected
+  interface = new TestInterface();
+
+  return RUN_ALL_TESTS();
+}
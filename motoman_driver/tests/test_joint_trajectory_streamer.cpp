@@ -0,0 +1,674 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/joint_trajectory_streamer.h"
+#include "motoman_driver/simple_message/messages/joint_traj_pt_full_ex_message.h"
+#include "motoman_driver/simple_message/messages/motoman_motion_ctrl_message.h"
+#include "motoman_driver/simple_message/messages/motoman_motion_reply_message.h"
+#include "motoman_driver/simple_message/motoman_simple_message.h"
+#include "simple_message/messages/joint_traj_pt_full_message.h"
+#include "simple_message/smpl_msg_connection.h"
+#include <gtest/gtest.h>
+#include <ros/ros.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+using industrial::byte_array::ByteArray;
+using industrial::joint_data::JointData;
+using industrial::joint_traj_pt_full::JointTrajPtFull;
+using industrial::joint_traj_pt_full_ex::JointTrajPtFullEx;
+using industrial::joint_traj_pt_full_ex_message::JointTrajPtFullExMessage;
+using industrial::joint_traj_pt_full_message::JointTrajPtFullMessage;
+using industrial::shared_types::shared_int;
+using industrial::shared_types::shared_real;
+using industrial::simple_message::SimpleMessage;
+using industrial::smpl_msg_connection::SmplMsgConnection;
+using motoman::joint_trajectory_streamer::MotomanJointTrajectoryStreamer;
+using motoman::simple_message::motion_ctrl_message::MotionCtrlMessage;
+using motoman::simple_message::motion_reply::MotionReply;
+using motoman::simple_message::motion_reply_message::MotionReplyMessage;
+using motoman_msgs::DynamicJointPoint;
+using motoman_msgs::DynamicJointTrajectory;
+using motoman_msgs::DynamicJointTrajectoryPtr;
+using motoman_msgs::DynamicJointsGroup;
+namespace CommTypes = industrial::simple_message::CommTypes;
+namespace MotionControlCmds = motoman::simple_message::motion_ctrl::MotionControlCmds;
+namespace MotionReplyResults = motoman::simple_message::motion_reply::MotionReplyResults;
+namespace MotomanMsgTypes = motoman::simple_message::MotomanMsgTypes;
+namespace ReplyTypes = industrial::simple_message::ReplyTypes;
+namespace StandardMsgTypes = industrial::simple_message::StandardMsgTypes;
+namespace TransferStates = industrial_robot_client::joint_trajectory_streamer::TransferStates;
+
+namespace
+{
+
+const int GROUPS = 4;
+const int JOINTS = 6;
+const int POINTS = 10000;
+
+// words of a JOINT_TRAJ_PT_FULL_EX message: the group count and sequence, then the
+// robot id, valid fields, time, positions, velocities and accelerations of every group
+const size_t HEADER_WORDS = 2;
+const size_t GROUP_WORDS = 3 + 3 * JointData::MAX_NUM_JOINTS;
+const size_t VALID_FIELDS_WORD = 1;
+
+MotomanJointTrajectoryStreamer* streamer;
+
+DynamicJointTrajectoryPtr trajectory()
+{
+  DynamicJointTrajectoryPtr traj(new DynamicJointTrajectory());
+  traj->points.resize(POINTS);
+  for (int i = 0; i < POINTS; i++)
+  {
+    DynamicJointPoint &pt = traj->points[i];
+    pt.num_groups = GROUPS;
+    pt.groups.resize(GROUPS);
+    for (int g = 0; g < GROUPS; g++)
+    {
+      DynamicJointsGroup &group = pt.groups[g];
+      group.group_number = g;
+      group.num_joints = JOINTS;
+      for (int j = 0; j < JOINTS; j++)
+      {
+        group.positions.push_back(0.001 * i + j);
+        group.velocities.push_back(0.1 * j);
+        group.accelerations.push_back(-0.1 * j);
+      }
+      group.time_from_start = ros::Duration(0.01 * i);
+    }
+  }
+  return traj;
+}
+
+JointData jointData(const std::vector<double> &values)
+{
+  JointData joints;
+  for (size_t j = 0; j < values.size(); j++)
+    joints.setJoint(j, values[j]);
+  return joints;
+}
+
+// a point encoded the way create_message_ex did before it wrote the message data itself:
+// through JointTrajPtFull, JointTrajPtFullEx and JointTrajPtFullExMessage
+bool encodeThroughJointTrajPtFullEx(int seq, const DynamicJointPoint &point, SimpleMessage* msg)
+{
+  std::vector<JointTrajPtFull> groups;
+  for (int g = 0; g < point.num_groups; g++)
+  {
+    const DynamicJointsGroup &group = point.groups[g];
+    JointData positions = jointData(group.positions);
+    JointData velocities = jointData(group.velocities);
+    JointData accelerations = jointData(group.accelerations);
+
+    JointTrajPtFull data;
+    data.setPositions(positions);
+    data.setVelocities(velocities);
+    data.setAccelerations(accelerations);
+    data.setRobotID(group.group_number);
+    data.setSequence(seq);
+    data.setTime(group.time_from_start.toSec());
+    groups.push_back(data);
+  }
+
+  JointTrajPtFullEx data_ex;
+  data_ex.setMultiJointTrajPtData(groups);
+  data_ex.setNumGroups(point.num_groups);
+  data_ex.setSequence(seq);
+  JointTrajPtFullExMessage msg_ex;
+  msg_ex.init(data_ex);
+  return msg_ex.toRequest(*msg);
+}
+
+std::vector<shared_int> words(SimpleMessage &msg)
+{
+  ByteArray data;
+  data.copyFrom(msg.getData());
+  std::vector<shared_int> words(data.getBufferSize() / sizeof(shared_int));
+  for (size_t i = 0; i < words.size(); i++)
+    data.unloadFront(words[i]);
+  return words;
+}
+
+// A controller that accepts trajectory points the way MotoROS does: strictly in sequence,
+// a point already accepted is acknowledged again, a point past the next one or a point
+// sent while there is no room is BUSY.  Replies are sent in the order of the requests.
+class FakeController : public SmplMsgConnection
+{
+public:
+  FakeController() : last_sequence_(-1), room_(1000), splice_time_(0.0), exec_time_(0.0) {}
+
+  bool isConnected() { return true; }
+  bool makeConnect() { return true; }
+
+  bool sendBytes(ByteArray &buffer)
+  {
+    shared_int length;
+    if (!buffer.unloadFront(length) || length != static_cast<shared_int>(buffer.getBufferSize()))
+      return false;
+    std::vector<char> bytes(length);
+    buffer.unloadFront(bytes.data(), length);
+    ByteArray data;
+    data.init(bytes.data(), length);
+    SimpleMessage request;
+    if (!request.init(data))
+      return false;
+
+    MotionReply reply;
+    reply.init();
+    reply.setCommand(request.getMessageType());
+    if (request.getMessageType() == StandardMsgTypes::JOINT_TRAJ_PT_FULL)
+    {
+      JointTrajPtFullMessage point;
+      point.init(request);
+      int sequence = point.point_.getSequence();
+      reply.setSequence(sequence);
+      if (sequence <= last_sequence_)
+        reply.setResult(MotionReplyResults::SUCCESS);
+      else if (sequence == last_sequence_ + 1 && room_ > 0)
+      {
+        reply.setResult(MotionReplyResults::SUCCESS);
+        last_sequence_ = sequence;
+        room_--;
+        accepted_.push_back(sequence);
+      }
+      else
+        reply.setResult(MotionReplyResults::BUSY);
+    }
+    else
+    {
+      MotionCtrlMessage ctrl;
+      ctrl.init(request);
+      reply.setCommand(ctrl.cmd_.getCommand());
+      if (ctrl.cmd_.getCommand() == MotionControlCmds::TRUNCATE_TRAJ)
+      {
+        reply.setResult(MotionReplyResults::SUCCESS);
+        reply.setData(0, splice_time_);
+        reply.setData(1, exec_time_);
+      }
+      else if (ctrl.cmd_.getCommand() == MotionControlCmds::GET_QUEUE_END_STATE)
+      {
+        const std::vector<double> &state = (ctrl.cmd_.getData(0) == 0) ? end_positions_ : end_velocities_;
+        reply.setResult(MotionReplyResults::SUCCESS);
+        for (size_t j = 0; j < state.size(); j++)
+          reply.setData(j, state[j]);
+        end_state_groups_.push_back(ctrl.cmd_.getRobotID());
+      }
+      else
+      {
+        reply.setResult(MotionReplyResults::TRUE);
+        reply.setData(0, 0.0);  // buffered motion
+        reply.setData(1, 0.0);  // time in the incremental queue
+        reply.setData(2, 1.0);  // capacity of the incremental queue
+      }
+    }
+
+    while (!extra_replies_.empty())
+    {
+      queueReply(extra_replies_.front());
+      extra_replies_.pop_front();
+    }
+    queueReply(reply);
+    return true;
+  }
+
+  bool receiveBytes(ByteArray &buffer, shared_int num_bytes, shared_int timeout_ms)
+  {
+    if (static_cast<size_t>(num_bytes) > inbox_.size())
+      return false;
+    std::vector<char> bytes(inbox_.begin(), inbox_.begin() + num_bytes);
+    inbox_.erase(inbox_.begin(), inbox_.begin() + num_bytes);
+    return buffer.init(bytes.data(), num_bytes);
+  }
+
+  // a reply sent ahead of the reply to the next request
+  void injectReply(int sequence, int result)
+  {
+    MotionReply reply;
+    reply.init();
+    reply.setCommand(StandardMsgTypes::JOINT_TRAJ_PT_FULL);
+    reply.setSequence(sequence);
+    reply.setResult(result);
+    extra_replies_.push_back(reply);
+  }
+
+  int last_sequence_;
+  int room_;  // points accepted before the queue is full
+  std::vector<int> accepted_;
+
+  // reply to TRUNCATE_TRAJ and GET_QUEUE_END_STATE (the same state for every group)
+  double splice_time_;
+  double exec_time_;
+  std::vector<double> end_positions_;
+  std::vector<double> end_velocities_;
+  std::vector<int> end_state_groups_;
+
+private:
+  void queueReply(MotionReply &reply)
+  {
+    MotionReplyMessage reply_msg;
+    SimpleMessage msg;
+    ByteArray data;
+    reply_msg.init(reply);
+    reply_msg.toReply(msg, ReplyTypes::SUCCESS);
+    msg.toByteArray(data);
+    shared_int length = data.getBufferSize();
+    ByteArray prefix;
+    prefix.load(length);
+    appendBytes(prefix);
+    appendBytes(data);
+  }
+
+  void appendBytes(ByteArray &data)
+  {
+    std::vector<char> bytes(data.getBufferSize());
+    data.unloadFront(bytes.data(), bytes.size());
+    inbox_.insert(inbox_.end(), bytes.begin(), bytes.end());
+  }
+
+  std::deque<char> inbox_;
+  std::deque<MotionReply> extra_replies_;
+};
+
+// a streamer loaded with a trajectory, streaming to a FakeController
+class StreamingTest : public MotomanJointTrajectoryStreamer
+{
+public:
+  StreamingTest(FakeController* controller, int points, int max_window)
+  {
+    this->connection_ = controller;
+    this->motion_ctrl_.init(controller, 0);  // the destructor releases trajectory mode through it
+    this->streaming_thread_ = NULL;  // not started: windows are streamed by the test
+    this->pub_motion_reply_ = this->node_.advertise<motoman_msgs::MotionReplyResult>("joint_path_motion_reply", 1);
+    this->max_window_ = max_window;
+    this->current_point_ = 0;
+    this->all_joint_names_ = jointNames(0);
+    for (int i = 0; i < points; i++)
+    {
+      trajectory_msgs::JointTrajectoryPoint pt;
+      pt.positions.assign(JOINTS, 0.001 * i);
+      pt.velocities.assign(JOINTS, 0.0);
+      pt.time_from_start = ros::Duration(0.01 * i);
+      SimpleMessage msg;
+      this->create_message(i, pt, &msg);
+      this->current_traj_.push_back(msg);
+    }
+  }
+
+  // streams windows until the trajectory is sent, aborted, or makes no progress
+  bool stream(int max_windows = 100)
+  {
+    for (int i = 0; i < max_windows && this->current_point_ < static_cast<int>(this->current_traj_.size()); i++)
+    {
+      bool busy = false;
+      double buffered_time;
+      if (!this->streamWindow(&busy, &buffered_time))
+        return false;
+    }
+    return true;
+  }
+
+  // the robot groups of a robot_groups setup, each with its own MotomanMotionCtrl
+  void setGroups(FakeController* controller, int groups)
+  {
+    for (int g = 0; g < groups; g++)
+    {
+      RobotGroup group;
+      group.set_group_id(g);
+      group.set_joint_names(jointNames(g));
+      this->robot_groups_[g] = group;
+      this->motion_ctrl_map_[g].init(controller, g);
+    }
+  }
+
+  static std::vector<std::string> jointNames(int group)
+  {
+    std::vector<std::string> names;
+    for (int j = 0; j < JOINTS; j++)
+      names.push_back("group_" + std::to_string(group) + "_joint_" + std::to_string(j));
+    return names;
+  }
+
+  using MotomanJointTrajectoryStreamer::current_point_;
+  using MotomanJointTrajectoryStreamer::current_traj_;
+  using MotomanJointTrajectoryStreamer::splice;
+  using MotomanJointTrajectoryStreamer::state_;
+  using MotomanJointTrajectoryStreamer::streamWindow;
+  using MotomanJointTrajectoryStreamer::window_;
+};
+
+std::vector<int> range(int first, int last)
+{
+  std::vector<int> values;
+  for (int i = first; i < last; i++)
+    values.push_back(i);
+  return values;
+}
+
+// splicing: the robot is executing t=0.125 s of the streaming trajectory and keeps
+// its motion up to t=0.25 s.  The new trajectory moves every joint at 0.5 rad/s from
+// 0.1 rad: received now, its t=0.125 s is at the splice time.
+const double EXEC_TIME = 0.125;
+const double SPLICE_TIME = 0.25;
+const int SPLICE_POINTS = 40;
+const int SPLICED_POINTS = 27;  // t=0.13..0.39 s
+
+double line(double t)
+{
+  return 0.1 + 0.5 * t;
+}
+
+trajectory_msgs::JointTrajectoryPtr lineTrajectory()
+{
+  trajectory_msgs::JointTrajectoryPtr traj(new trajectory_msgs::JointTrajectory());
+  traj->joint_names = StreamingTest::jointNames(0);
+  traj->points.resize(SPLICE_POINTS);
+  for (int i = 0; i < SPLICE_POINTS; i++)
+  {
+    traj->points[i].positions.assign(JOINTS, line(0.01 * i));
+    traj->points[i].velocities.assign(JOINTS, 0.5);
+    traj->points[i].time_from_start = ros::Duration(0.01 * i);
+  }
+  return traj;
+}
+
+DynamicJointTrajectoryPtr lineTrajectory(int groups)
+{
+  DynamicJointTrajectoryPtr traj(new DynamicJointTrajectory());
+  for (int g = 0; g < groups; g++)
+  {
+    std::vector<std::string> names = StreamingTest::jointNames(g);
+    traj->joint_names.insert(traj->joint_names.end(), names.begin(), names.end());
+  }
+  traj->points.resize(SPLICE_POINTS);
+  for (int i = 0; i < SPLICE_POINTS; i++)
+  {
+    traj->points[i].num_groups = groups;
+    traj->points[i].groups.resize(groups);
+    for (int g = 0; g < groups; g++)
+    {
+      DynamicJointsGroup &group = traj->points[i].groups[g];
+      group.group_number = g;
+      group.num_joints = JOINTS;
+      group.positions.assign(JOINTS, line(0.01 * i));
+      group.velocities.assign(JOINTS, 0.5);
+      group.time_from_start = ros::Duration(0.01 * i);
+    }
+  }
+  return traj;
+}
+
+// the motion kept on the robot, deviating from the new trajectory by dp (rad) and dv (rad/s)
+void keepMotion(FakeController* controller, double dp, double dv)
+{
+  controller->splice_time_ = SPLICE_TIME;
+  controller->exec_time_ = EXEC_TIME;
+  controller->end_positions_.assign(JOINTS, line(SPLICE_TIME - EXEC_TIME) + dp);
+  controller->end_velocities_.assign(JOINTS, 0.5 + dv);
+}
+
+JointTrajPtFull point(SimpleMessage &msg)
+{
+  JointTrajPtFullMessage pt_msg;
+  pt_msg.init(msg);
+  return pt_msg.point_;
+}
+
+double pointTime(JointTrajPtFull &pt)
+{
+  shared_real time;
+  pt.getTime(time);
+  return time;
+}
+
+double pointPosition(JointTrajPtFull &pt, int joint)
+{
+  JointData positions;
+  pt.getPositions(positions);
+  return positions.getJoint(joint);
+}
+
+}  // namespace
+
+// the valid fields written through JointTrajPtFullEx carry uninitialized upper bits: only the flags are compared
+TEST(MotomanJointTrajectoryStreamer, createMessageEx)
+{
+  DynamicJointTrajectoryPtr traj = trajectory();
+  for (int i = 0; i < POINTS; i += POINTS / 10)
+  {
+    SimpleMessage expected, actual;
+    ASSERT_TRUE(encodeThroughJointTrajPtFullEx(i, traj->points[i], &expected));
+    ASSERT_TRUE(streamer->create_message_ex(i, traj->points[i], &actual));
+
+    EXPECT_EQ(expected.getMessageType(), actual.getMessageType());
+    EXPECT_EQ(CommTypes::SERVICE_REQUEST, actual.getCommType());
+    std::vector<shared_int> expected_words = words(expected), actual_words = words(actual);
+    ASSERT_EQ(HEADER_WORDS + GROUPS * GROUP_WORDS, actual_words.size());
+    ASSERT_EQ(expected_words.size(), actual_words.size());
+    for (size_t w = 0; w < actual_words.size(); w++)
+    {
+      if (w >= HEADER_WORDS && (w - HEADER_WORDS) % GROUP_WORDS == VALID_FIELDS_WORD)
+        EXPECT_EQ(expected_words[w] & 0xF, actual_words[w]) << "point " << i << ", word " << w;
+      else
+        EXPECT_EQ(expected_words[w], actual_words[w]) << "point " << i << ", word " << w;
+    }
+  }
+}
+
+// a 4-group, 10000-point trajectory converted by trajectory_to_msgs(): a service request per point, the same
+// size as the message encoded through JointTrajPtFullEx
+TEST(MotomanJointTrajectoryStreamer, trajectoryToMsgs)
+{
+  DynamicJointTrajectoryPtr traj = trajectory();
+
+  std::vector<SimpleMessage> msgs;
+  ASSERT_TRUE(streamer->trajectory_to_msgs(traj, &msgs));
+
+  ASSERT_EQ(static_cast<size_t>(POINTS), msgs.size());
+  for (int i = 0; i < POINTS; i += POINTS / 10)
+  {
+    SimpleMessage expected;
+    ASSERT_TRUE(encodeThroughJointTrajPtFullEx(i, traj->points[i], &expected));
+    EXPECT_EQ(expected.getMessageType(), msgs[i].getMessageType());
+    EXPECT_EQ(CommTypes::SERVICE_REQUEST, msgs[i].getCommType());
+    EXPECT_EQ(expected.getDataLength(), msgs[i].getDataLength());
+  }
+}
+
+TEST(MotomanJointTrajectoryStreamer, streamInOrder)
+{
+  FakeController controller;
+  StreamingTest streaming(&controller, 50, 8);
+
+  ASSERT_TRUE(streaming.stream());
+  EXPECT_EQ(50, streaming.current_point_);
+  EXPECT_EQ(range(0, 50), controller.accepted_);
+  EXPECT_EQ(8, streaming.window_);  // grown while the controller had room
+}
+
+TEST(MotomanJointTrajectoryStreamer, streamBusyHalvesWindow)
+{
+  FakeController controller;
+  StreamingTest streaming(&controller, 20, 8);
+  streaming.window_ = 8;
+  controller.room_ = 3;
+
+  // the points past the third one are busy, and so is the rest of the window
+  bool busy = false;
+  double buffered_time;
+  ASSERT_TRUE(streaming.streamWindow(&busy, &buffered_time));
+  EXPECT_TRUE(busy);
+  EXPECT_EQ(3, streaming.current_point_);
+  EXPECT_EQ(4, streaming.window_);
+
+  busy = false;
+  ASSERT_TRUE(streaming.streamWindow(&busy, &buffered_time));
+  EXPECT_TRUE(busy);
+  EXPECT_EQ(3, streaming.current_point_);
+  EXPECT_EQ(2, streaming.window_);
+
+  // the busy points are resent in order once there is room
+  controller.room_ = 1000;
+  ASSERT_TRUE(streaming.stream());
+  EXPECT_EQ(20, streaming.current_point_);
+  EXPECT_EQ(range(0, 20), controller.accepted_);
+}
+
+TEST(MotomanJointTrajectoryStreamer, streamResendAcknowledged)
+{
+  // the points up to #5 were accepted but their replies were lost
+  FakeController controller;
+  controller.last_sequence_ = 5;
+  StreamingTest streaming(&controller, 10, 4);
+  streaming.window_ = 4;
+
+  ASSERT_TRUE(streaming.stream());
+  EXPECT_EQ(10, streaming.current_point_);
+  EXPECT_EQ(range(6, 10), controller.accepted_);
+}
+
+TEST(MotomanJointTrajectoryStreamer, streamReplyMatching)
+{
+  FakeController controller;
+  StreamingTest streaming(&controller, 10, 4);
+  streaming.window_ = 4;
+  ASSERT_TRUE(streaming.stream(1));
+  ASSERT_EQ(4, streaming.current_point_);
+
+  // a late reply to a point already acknowledged is skipped
+  controller.injectReply(3, MotionReplyResults::SUCCESS);
+  ASSERT_TRUE(streaming.stream(1));
+  EXPECT_GT(streaming.current_point_, 4);
+
+  // a reply to a point that wasn't sent yet aborts the trajectory
+  controller.injectReply(streaming.current_point_ + 1, MotionReplyResults::SUCCESS);
+  EXPECT_FALSE(streaming.stream(1));
+}
+
+TEST(MotomanJointTrajectoryStreamer, spliceContinuous)
+{
+  FakeController controller;
+  StreamingTest streaming(&controller, 50, 8);
+  ASSERT_TRUE(streaming.stream(2));
+  int sent = streaming.current_point_;
+  streaming.state_ = TransferStates::STREAMING;
+  keepMotion(&controller, 0.0, 0.0);
+
+  // the points past the splice time replace the points not sent, as they are
+  ASSERT_TRUE(streaming.splice(lineTrajectory()));
+  ASSERT_EQ(static_cast<size_t>(sent + SPLICED_POINTS), streaming.current_traj_.size());
+  for (int i = sent; i < sent + SPLICED_POINTS; i++)
+  {
+    JointTrajPtFull pt = point(streaming.current_traj_[i]);
+    EXPECT_EQ(i, pt.getSequence());
+    EXPECT_NEAR(SPLICE_TIME + 0.005 + 0.01 * (i - sent), pointTime(pt), 1e-3);
+    EXPECT_NEAR(line(pointTime(pt) - EXEC_TIME), pointPosition(pt, 0), 1e-4);
+  }
+}
+
+TEST(MotomanJointTrajectoryStreamer, spliceBlendsDeviation)
+{
+  FakeController controller;
+  StreamingTest streaming(&controller, 50, 8);
+  ASSERT_TRUE(streaming.stream(2));
+  int sent = streaming.current_point_;
+  streaming.state_ = TransferStates::STREAMING;
+  keepMotion(&controller, 0.01, 0.0);
+
+  // the deviation fades out over the blend time (0.2 s)
+  ASSERT_TRUE(streaming.splice(lineTrajectory()));
+  ASSERT_EQ(static_cast<size_t>(sent + SPLICED_POINTS), streaming.current_traj_.size());
+  double deviation = 0.01;
+  for (int i = sent; i < sent + SPLICED_POINTS; i++)
+  {
+    JointTrajPtFull pt = point(streaming.current_traj_[i]);
+    double next = pointPosition(pt, 0) - line(pointTime(pt) - EXEC_TIME);
+    if (pointTime(pt) < SPLICE_TIME + 0.2)
+      EXPECT_LT(next, deviation);
+    else
+      EXPECT_NEAR(0.0, next, 1e-4);
+    deviation = next;
+  }
+  JointTrajPtFull first = point(streaming.current_traj_[sent]);
+  EXPECT_NEAR(0.01, pointPosition(first, 0) - line(pointTime(first) - EXEC_TIME), 1e-3);
+}
+
+TEST(MotomanJointTrajectoryStreamer, spliceRejectsDeviation)
+{
+  FakeController controller;
+  StreamingTest streaming(&controller, 50, 8);
+  ASSERT_TRUE(streaming.stream(2));
+  streaming.state_ = TransferStates::STREAMING;
+
+  keepMotion(&controller, 0.05, 0.0);
+  EXPECT_FALSE(streaming.splice(lineTrajectory()));
+  keepMotion(&controller, 0.0, 0.2);
+  EXPECT_FALSE(streaming.splice(lineTrajectory()));
+  EXPECT_EQ(50u, streaming.current_traj_.size());
+}
+
+// robot_groups setups stream through jointTrajectoryExCB()
+TEST(MotomanJointTrajectoryStreamer, spliceMultiGroup)
+{
+  FakeController controller;
+  StreamingTest streaming(&controller, 50, 8);
+  streaming.setGroups(&controller, 2);
+  ASSERT_TRUE(streaming.stream(2));
+  int sent = streaming.current_point_;
+  streaming.state_ = TransferStates::STREAMING;
+  keepMotion(&controller, 0.0, 0.0);
+
+  streaming.jointTrajectoryExCB(lineTrajectory(2));
+  EXPECT_EQ(TransferStates::STREAMING, streaming.state_);
+  EXPECT_EQ((std::vector<int>{0, 0, 1, 1}), controller.end_state_groups_);
+  ASSERT_EQ(static_cast<size_t>(sent + SPLICED_POINTS), streaming.current_traj_.size());
+  for (int i = sent; i < sent + SPLICED_POINTS; i++)
+  {
+    EXPECT_EQ(MotomanMsgTypes::ROS_MSG_MOTO_JOINT_TRAJ_PT_FULL_EX, streaming.current_traj_[i].getMessageType());
+    EXPECT_EQ(i, words(streaming.current_traj_[i])[1]);
+  }
+
+  // a trajectory that can't be spliced stops the motion
+  keepMotion(&controller, 0.05, 0.0);
+  streaming.jointTrajectoryExCB(lineTrajectory(2));
+  EXPECT_EQ(TransferStates::IDLE, streaming.state_);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "test_joint_trajectory_streamer");
+
+  // never initialized: only the conversion is tested, streaming goes through StreamingTest
+  streamer = new MotomanJointTrajectoryStreamer();
+
+  return RUN_ALL_TESTS();
+}
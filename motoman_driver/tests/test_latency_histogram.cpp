@@ -0,0 +1,95 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/industrial_robot_client/latency_histogram.h"
+#include <gtest/gtest.h>
+#include <ros/duration.h>
+#include <string>
+
+using industrial_robot_client::latency_histogram::LatencyHistogram;
+
+TEST(LatencyHistogram, empty)
+{
+  LatencyHistogram histogram;
+
+  EXPECT_EQ(0u, histogram.count());
+  EXPECT_EQ(0.0, histogram.max());
+  EXPECT_EQ("n=0", histogram.toString());
+}
+
+TEST(LatencyHistogram, record)
+{
+  LatencyHistogram histogram;
+
+  histogram.record(ros::Duration(0.00005));
+  histogram.record(ros::Duration(0.0003));
+  histogram.record(ros::Duration(0.0004));
+  histogram.record(ros::Duration(0.003));
+
+  EXPECT_EQ(4u, histogram.count());
+  EXPECT_NEAR(0.003, histogram.max(), 1e-9);
+  EXPECT_EQ("n=4, mean=0.9375ms, max=3ms | <0.1ms:1 <0.5ms:2 <5ms:1", histogram.toString());
+}
+
+// the samples past the last bound are collected in the last bucket
+TEST(LatencyHistogram, overflow)
+{
+  LatencyHistogram histogram;
+
+  histogram.record(ros::Duration(0.0015));
+  histogram.record(ros::Duration(0.6));
+  histogram.record(ros::Duration(2.4));
+
+  EXPECT_EQ(3u, histogram.count());
+  EXPECT_NEAR(2.4, histogram.max(), 1e-6);
+  EXPECT_EQ("n=3, mean=1000.5ms, max=2400ms | <2ms:1 >=500ms:2", histogram.toString());
+}
+
+TEST(LatencyHistogram, reset)
+{
+  LatencyHistogram histogram;
+
+  histogram.record(ros::Duration(0.01));
+  histogram.reset();
+  EXPECT_EQ(0u, histogram.count());
+  EXPECT_EQ(0.0, histogram.max());
+  EXPECT_EQ("n=0", histogram.toString());
+
+  histogram.record(ros::Duration(0.00015));
+  EXPECT_EQ(1u, histogram.count());
+  EXPECT_EQ("n=1, mean=0.15ms, max=0.15ms | <0.2ms:1", histogram.toString());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
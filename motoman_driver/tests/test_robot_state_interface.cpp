@@ -0,0 +1,241 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/industrial_robot_client/robot_state_interface.h"
+#include <gtest/gtest.h>
+#include <ros/ros.h>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/thread/thread.hpp>
+
+using industrial::byte_array::ByteArray;
+using industrial::message_handler::MessageHandler;
+using industrial::shared_types::shared_int;
+using industrial::simple_message::SimpleMessage;
+using industrial::smpl_msg_connection::SmplMsgConnection;
+using industrial_robot_client::robot_state_interface::RobotStateInterface;
+namespace CommTypes = industrial::simple_message::CommTypes;
+namespace ReplyTypes = industrial::simple_message::ReplyTypes;
+namespace StandardMsgTypes = industrial::simple_message::StandardMsgTypes;
+
+namespace
+{
+
+// message types of the test handlers, and one without a handler
+const int TYPE_A = 9001;
+const int TYPE_B = 9002;
+const int TYPE_UNHANDLED = 9003;
+
+const int FRAMES = 1008;
+const int BATCH = 16;  // frames of each type queued at once: both fit in the receive queue
+
+// controller sending the frames queued by the test, and recording the replies it gets
+class FakeController : public SmplMsgConnection
+{
+public:
+  bool isConnected() { return true; }
+  bool makeConnect() { return true; }
+
+  void queue(int msg_type, int comm_type, shared_int value)
+  {
+    ByteArray data, frame;
+    data.load(value);
+    SimpleMessage msg;
+    msg.init(msg_type, comm_type, ReplyTypes::INVALID, data);
+    msg.toByteArray(data);
+    frame.load(static_cast<shared_int>(data.getBufferSize()));
+    frame.load(data);
+
+    std::vector<char> bytes(frame.getBufferSize());
+    frame.unloadFront(bytes.data(), bytes.size());
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    bytes_.insert(bytes_.end(), bytes.begin(), bytes.end());
+    cond_.notify_one();
+  }
+
+  bool sendBytes(ByteArray &buffer)
+  {
+    shared_int length;
+    if (!buffer.unloadFront(length) || length != static_cast<shared_int>(buffer.getBufferSize()))
+      return false;
+    std::vector<char> bytes(length);
+    buffer.unloadFront(bytes.data(), length);
+    ByteArray data;
+    data.init(bytes.data(), length);
+    SimpleMessage reply;
+    if (!reply.init(data))
+      return false;
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    replies_.push_back(std::make_pair(reply.getMessageType(), reply.getReplyCode()));
+    return true;
+  }
+
+  // waits a little for the bytes, so that the interface gets to check whether ROS is still running
+  bool receiveBytes(ByteArray &buffer, shared_int num_bytes, shared_int)
+  {
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    if (bytes_.size() < static_cast<size_t>(num_bytes))
+      cond_.timed_wait(lock, boost::posix_time::milliseconds(10));
+    if (bytes_.size() < static_cast<size_t>(num_bytes))
+      return false;
+    std::vector<char> bytes(bytes_.begin(), bytes_.begin() + num_bytes);
+    bytes_.erase(bytes_.begin(), bytes_.begin() + num_bytes);
+    return buffer.init(bytes.data(), num_bytes);
+  }
+
+  std::vector<std::pair<int, int> > replies()
+  {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    return replies_;
+  }
+
+private:
+  boost::mutex mutex_;
+  boost::condition_variable cond_;
+  std::deque<char> bytes_;
+  std::vector<std::pair<int, int> > replies_;
+};
+
+// records the value of each message it is called back for
+class RecordingHandler : public MessageHandler
+{
+public:
+  bool init(int msg_type, SmplMsgConnection* connection)
+  {
+    return MessageHandler::init(msg_type, connection);
+  }
+
+  std::vector<shared_int> values()
+  {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    return values_;
+  }
+
+protected:
+  bool internalCB(SimpleMessage &in)
+  {
+    shared_int value;
+    ByteArray data = in.getData();
+    data.unloadFront(value);
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    values_.push_back(value);
+    return true;
+  }
+
+private:
+  boost::mutex mutex_;
+  std::vector<shared_int> values_;
+};
+
+FakeController controller;
+RecordingHandler handler_a, handler_b;
+
+bool waitForValues(RecordingHandler* handler, size_t count)
+{
+  for (int i = 0; i < 500 && handler->values().size() < count; i++)
+    ros::WallDuration(0.01).sleep();
+  return handler->values().size() == count;
+}
+
+bool waitForReplies(size_t count)
+{
+  for (int i = 0; i < 500 && controller.replies().size() < count; i++)
+    ros::WallDuration(0.01).sleep();
+  return controller.replies().size() == count;
+}
+
+}  // namespace
+
+// the frames of each type are published in the order they are received
+TEST(RobotStateInterface, publishInOrder)
+{
+  for (int i = 0; i < FRAMES; i += BATCH)
+  {
+    for (int j = i; j < i + BATCH; j++)
+    {
+      controller.queue(TYPE_A, CommTypes::TOPIC, j);
+      controller.queue(TYPE_B, CommTypes::TOPIC, -j);
+    }
+    ASSERT_TRUE(waitForValues(&handler_a, i + BATCH));
+    ASSERT_TRUE(waitForValues(&handler_b, i + BATCH));
+  }
+
+  std::vector<shared_int> values_a = handler_a.values(), values_b = handler_b.values();
+  for (int i = 0; i < FRAMES; i++)
+  {
+    ASSERT_EQ(i, values_a[i]);
+    ASSERT_EQ(-i, values_b[i]);
+  }
+}
+
+// the types without a handler are answered as the message manager does
+TEST(RobotStateInterface, unrouted)
+{
+  size_t replies = controller.replies().size();
+
+  controller.queue(StandardMsgTypes::PING, CommTypes::SERVICE_REQUEST, 0);
+  ASSERT_TRUE(waitForReplies(replies + 1));
+  EXPECT_EQ(std::make_pair(static_cast<int>(StandardMsgTypes::PING), static_cast<int>(ReplyTypes::SUCCESS)),
+            controller.replies().back());
+
+  controller.queue(TYPE_UNHANDLED, CommTypes::SERVICE_REQUEST, 0);
+  ASSERT_TRUE(waitForReplies(replies + 2));
+  EXPECT_EQ(std::make_pair(TYPE_UNHANDLED, static_cast<int>(ReplyTypes::FAILURE)), controller.replies().back());
+
+  // topics are not answered, and do not hold up the next frames
+  controller.queue(TYPE_UNHANDLED, CommTypes::TOPIC, 0);
+  controller.queue(TYPE_A, CommTypes::TOPIC, FRAMES);
+  ASSERT_TRUE(waitForValues(&handler_a, FRAMES + 1));
+  EXPECT_EQ(replies + 2, controller.replies().size());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "test_robot_state_interface");
+
+  RobotStateInterface interface;
+  std::vector<std::string> joint_names(6, "");
+  if (!interface.init(&controller, joint_names) || !handler_a.init(TYPE_A, &controller) ||
+      !handler_b.init(TYPE_B, &controller))
+    return 1;
+  interface.add_handler(&handler_a);
+  interface.add_handler(&handler_b);
+
+  boost::thread thread(&RobotStateInterface::run, &interface);
+  int result = RUN_ALL_TESTS();
+  ros::shutdown();
+  thread.join();
+  return result;
+}
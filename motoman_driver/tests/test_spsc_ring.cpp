@@ -0,0 +1,140 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ * Copyright (c) 2026, the motoman_driver contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *       * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *       * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *       * Neither the name of the copyright holder, nor the names
+ *       of its contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "motoman_driver/industrial_robot_client/spsc_ring.h"
+#include <gtest/gtest.h>
+#include <boost/thread/thread.hpp>
+
+using industrial_robot_client::spsc_ring::SpscRing;
+
+namespace
+{
+
+const int ITEMS = 100000;
+
+void produce(SpscRing<int>* ring)
+{
+  for (int i = 0; i < ITEMS; i++)
+  {
+    int* slot;
+    while (!(slot = ring->claim()))
+      boost::this_thread::yield();
+    *slot = i;
+    ring->commit();
+  }
+}
+
+}  // namespace
+
+TEST(SpscRing, fillAndDrain)
+{
+  SpscRing<int> ring(3);
+  EXPECT_EQ(3u, ring.capacity());
+  EXPECT_EQ(0u, ring.size());
+  EXPECT_TRUE(ring.front() == NULL);
+
+  for (int i = 0; i < 3; i++)
+  {
+    int* slot = ring.claim();
+    ASSERT_TRUE(slot != NULL);
+    *slot = i;
+    ring.commit();
+  }
+  EXPECT_EQ(3u, ring.size());
+  EXPECT_TRUE(ring.claim() == NULL);
+
+  for (int i = 0; i < 3; i++)
+  {
+    int* front = ring.front();
+    ASSERT_TRUE(front != NULL);
+    EXPECT_EQ(i, *front);
+    ring.release();
+  }
+  EXPECT_EQ(0u, ring.size());
+  EXPECT_TRUE(ring.front() == NULL);
+}
+
+// a claimed slot is not seen by the consumer until it is committed, and can be claimed again instead
+TEST(SpscRing, claimWithoutCommit)
+{
+  SpscRing<int> ring(2);
+
+  int* slot = ring.claim();
+  *slot = 1;
+  EXPECT_TRUE(ring.front() == NULL);
+  EXPECT_EQ(slot, ring.claim());
+  *slot = 2;
+  ring.commit();
+  ASSERT_TRUE(ring.front() != NULL);
+  EXPECT_EQ(2, *ring.front());
+}
+
+// the slots are reused in place as the ring wraps around
+TEST(SpscRing, wrapAround)
+{
+  SpscRing<int> ring(2);
+
+  for (int i = 0; i < 10; i++)
+  {
+    int* slot = ring.claim();
+    ASSERT_TRUE(slot != NULL);
+    *slot = i;
+    ring.commit();
+    EXPECT_EQ(1u, ring.size());
+    EXPECT_EQ(slot, ring.front());
+    EXPECT_EQ(i, *ring.front());
+    ring.release();
+  }
+}
+
+// every element gets through, in order, with the producer and consumer on their own threads
+TEST(SpscRing, threads)
+{
+  SpscRing<int> ring(16);
+  boost::thread producer(produce, &ring);
+
+  for (int i = 0; i < ITEMS; i++)
+  {
+    int* front;
+    while (!(front = ring.front()))
+      boost::this_thread::yield();
+    ASSERT_EQ(i, *front);
+    ring.release();
+  }
+  producer.join();
+  EXPECT_EQ(0u, ring.size());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}